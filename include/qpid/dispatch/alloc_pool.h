@@ -53,6 +53,7 @@ typedef struct {
     uint64_t held_by_threads;
     uint64_t batches_rebalanced_to_threads;
     uint64_t batches_rebalanced_to_global;
+    uint64_t total_allocs;  ///< number of objects handed out, whether from the pools or the heap
 } qd_alloc_stats_t;
 
 /** Allocation type descriptor. */
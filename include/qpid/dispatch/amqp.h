@@ -118,6 +118,7 @@ typedef enum {
 /** @name Standard codepoints */
 /// @{
 extern const char * const QD_CONTENT_TYPE_APP_OCTETS;  ///< application/octet-stream
+extern const char * const QD_CONTENT_TYPE_APP_HTTP1;   ///< application/http
 /// @}
 
 /** @name Application Property Names */
@@ -140,6 +141,8 @@ extern const char * const QD_CAPABILITY_ROUTER_DATA;
 extern const char * const QD_CAPABILITY_EDGE_DOWNLINK;
 extern const char * const QD_CAPABILITY_STREAMING_DELIVERIES;
 extern const char * const QD_CAPABILITY_RESEND_RELEASED;
+extern const char * const QD_CAPABILITY_EDGE_ADDRESS_BATCH;
+extern const char * const QD_CAPABILITY_EDGE_ADDRESS_INTEREST;
 /// @}
 
 /** @name Dynamic Node Properties */
@@ -170,6 +173,7 @@ extern const char * const QD_CONNECTION_PROPERTY_ACCESS_ID;
 /** @name Terminus Addresses */
 /// @{
 extern const char * const QD_TERMINUS_EDGE_ADDRESS_TRACKING;
+extern const char * const QD_TERMINUS_EDGE_ADDRESS_INTEREST;
 extern const char * const QD_TERMINUS_HEARTBEAT;
 extern const char * const QD_TERMINUS_MESH_ID_NEGOTIATION;
 extern const char * const QD_TERMINUS_MESH_DISCOVERY;
@@ -32,6 +32,7 @@ extern "C++" {
 #include <atomic>
 }
 using std::atomic_uint;
+using std::atomic_uint_fast64_t;
 #else
 #include <stdatomic.h>
 #endif
@@ -162,6 +162,15 @@ static inline uint32_t qd_buffer_inc_fanout(qd_buffer_t *buf)
     return sys_atomic_inc(&buf->bfanout);
 }
 
+/**
+ * Increase the fanout by count.
+ * @return the _old_ count (pre increment)
+ */
+static inline uint32_t qd_buffer_add_fanout(qd_buffer_t *buf, uint32_t count)
+{
+    return sys_atomic_add(&buf->bfanout, count);
+}
+
 /**
  * Decrease the fanout by one
  * @return the _old_ count (pre decrement)
@@ -20,7 +20,7 @@
  */
 
 /**@file
- * System-wide counters for tracking open connections per protocol type.
+ * System-wide counters for tracking open connections per protocol type and the read buffers granted to them.
  */
 
 #include "qpid/dispatch/protocols.h"
@@ -39,5 +39,17 @@ void qd_connection_counter_dec(qd_protocol_t proto);
 //
 uint64_t qd_connection_count(qd_protocol_t proto);
 
+// Add 'count' to the number of read buffers granted to raw connections that have not been filled yet
+//
+void qd_granted_read_buffers_inc(uint64_t count);
+
+// Subtract 'count' from the number of granted read buffers
+//
+void qd_granted_read_buffers_dec(uint64_t count);
+
+// Fetch the current number of read buffers granted to raw connections but not yet filled
+//
+uint64_t qd_granted_read_buffers_count(void);
+
 
 #endif
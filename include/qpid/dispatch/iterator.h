@@ -44,6 +44,24 @@
  */
 typedef struct qd_iterator_t qd_iterator_t;
 
+/**
+ * Caller-provided storage for a short-lived iterator.
+ *
+ * Iterators that do not outlive the function that creates them can be
+ * initialized in storage of this type (typically on the stack) instead of
+ * being allocated from the qd_iterator_t pool.  The storage is opaque: use
+ * the qd_iterator_t pointer returned by the *_init function to access it.
+ */
+#define QD_ITERATOR_STORAGE_SIZE 160
+
+typedef struct qd_iterator_storage_t {
+    union {
+        void          *align_ptr;
+        uint64_t       align_u64;
+        unsigned char  octets[QD_ITERATOR_STORAGE_SIZE];
+    } u;
+} qd_iterator_storage_t;
+
 /**
  * Address Hash Prefix Values
  */
@@ -198,6 +216,28 @@ qd_iterator_t *qd_iterator_buffer(qd_buffer_t        *buffer,
                                   int                 length,
                                   qd_iterator_view_t  view);
 
+/**
+ * Initialize an iterator over a field in a buffer chain in caller-provided storage.
+ *
+ * Identical to qd_iterator_buffer() except that no iterator is allocated.  The
+ * returned iterator must not outlive the storage.  It must still be passed to
+ * qd_iterator_free() when no longer needed (hash segments created by
+ * qd_iterator_hash_view_segments() are allocated), which releases everything
+ * but the storage itself.
+ *
+ * @param storage Storage for the iterator
+ * @param buffer Pointer to the first buffer in the buffer chain
+ * @param offset The offset in the first buffer where the first octet of the field is
+ * @param length Number of octets in the field
+ * @param view The view for the iterator
+ * @return The iterator, located in storage.
+ */
+qd_iterator_t *qd_iterator_buffer_init(qd_iterator_storage_t *storage,
+                                       qd_buffer_t           *buffer,
+                                       int                    offset,
+                                       int                    length,
+                                       qd_iterator_view_t     view);
+
 /**
  * Free an allocated iterator
  *
@@ -354,6 +394,16 @@ uint8_t qd_iterator_uint8(qd_iterator_t *iter);
  */
 qd_iterator_t *qd_iterator_dup(const qd_iterator_t *iter);
 
+/**
+ * Duplicate an iterator into caller-provided storage.  See qd_iterator_dup()
+ * and qd_iterator_buffer_init().
+ *
+ * @param storage Storage for the duplicate
+ * @param iter Input iterator
+ * @return Pointer to the duplicate (located in storage) or NULL if iter is NULL.
+ */
+qd_iterator_t *qd_iterator_dup_init(qd_iterator_storage_t *storage, const qd_iterator_t *iter);
+
 /**
  * Copy the iterator's view into buffer as a null terminated string,
  * up to a maximum of n bytes. Cursor is advanced by the number of bytes
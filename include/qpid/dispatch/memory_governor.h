@@ -0,0 +1,81 @@
+#ifndef __memory_governor_h__
+#define __memory_governor_h__ 1
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**@file
+ * Router-wide memory governor.
+ *
+ * The governor compares the number of message buffers in use against the router's buffer ceiling and reduces that to a
+ * pressure level shared by all adaptors. Each adaptor scales the resources it hands out (raw connection read grants,
+ * Q2 buffer limits, AMQP session windows) by the current level so that backpressure is applied proportionally across
+ * protocols rather than by one adaptor alone.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct qd_dispatch_t;
+
+// Pressure levels, by fraction of the buffer ceiling in use. A level is entered at the lower bound given here and left
+// again once usage drops 5% of the ceiling below it.
+//
+typedef enum {
+    QD_MEMORY_PRESSURE_NORMAL = 0,  // [0% .. 50%)
+    QD_MEMORY_PRESSURE_ELEVATED,    // [50% .. 75%)
+    QD_MEMORY_PRESSURE_HIGH,        // [75% .. 85%)
+    QD_MEMORY_PRESSURE_CRITICAL,    // [85% .. 100%]
+} qd_memory_pressure_t;
+
+typedef struct qd_memory_governor_stats_t {
+    uint64_t             buffer_ceiling;  // maximum number of buffers the router should hold
+    uint64_t             buffers_in_use;  // buffers in use at the last evaluation
+    uint64_t             transitions;     // number of pressure level changes
+    uint64_t             shed;            // number of new connections refused under CRITICAL pressure
+    qd_memory_pressure_t level;
+    bool                 shedding;        // refuse new connections under CRITICAL pressure
+} qd_memory_governor_stats_t;
+
+// Compute the buffer ceiling from the SKUPPER_ROUTER_MEMORY_CEILING environment variable or the platform memory size.
+//
+void qd_memory_governor_initialize(bool shedding);
+
+// Start and stop the timer that periodically re-evaluates the pressure level. The level stays NORMAL until started.
+//
+void qd_memory_governor_start(struct qd_dispatch_t *qd);
+void qd_memory_governor_stop(void);
+
+// Return the pressure level of the last evaluation. This is a single atomic load, cheap enough to call on the I/O path
+// and with locks held.
+//
+qd_memory_pressure_t qd_memory_pressure(void);
+
+// Scale 'amount' down by the current pressure level: halved for each level above NORMAL but never below 'minimum' (or
+// 'amount' if it is already smaller than 'minimum').
+//
+uint64_t qd_memory_governor_scale(uint64_t amount, uint64_t minimum);
+
+// Return true if new low priority work (e.g. an incoming adaptor connection) should be refused in order to protect the
+// flows already in progress. This is only the case under CRITICAL pressure when shedding is enabled.
+//
+bool qd_memory_governor_shed(void);
+
+void qd_memory_governor_stats(qd_memory_governor_stats_t *stats);
+
+#endif
@@ -47,13 +47,24 @@ typedef struct qd_link_t      qd_link_t;
 // will be read from an incoming link for the current message. Once Q2 is enabled no further input data will be read
 // from the link. Q2 remains in effect until enough bytes have been consumed by the outgoing link(s) to drop the number
 // of buffered bytes below the lower threshold.
+//
+// Both limits are scaled down by the memory governor as router-wide memory pressure rises, but never below
+// QD_QLIMIT_Q2_LOWER_MIN and QD_QLIMIT_Q2_UPPER_MIN (see memory_governor.h).
 
 #define QD_QLIMIT_Q2_LOWER 32                        // Re-enable link receive
 #define QD_QLIMIT_Q2_UPPER (QD_QLIMIT_Q2_LOWER * 2)  // Disable link receive
+#define QD_QLIMIT_Q2_LOWER_MIN 8
+#define QD_QLIMIT_Q2_UPPER_MIN (QD_QLIMIT_Q2_LOWER_MIN * 2)
+
+// Maximum number of full buffers received from a link before they are appended to the message content under one lock
+// acquisition.  Q2 is evaluated once per batch so the buffer chain may exceed QD_QLIMIT_Q2_UPPER by less than a batch.
+
+#define QD_MESSAGE_RX_BATCH (QD_QLIMIT_Q2_LOWER / 4)
 
 // Callback for status change (confirmed persistent, loaded-in-memory, etc.)
 
 typedef struct qd_message_t             qd_message_t;
+typedef struct qd_message_account_t     qd_message_account_t;
 
 /** Amount of message to be parsed.  */
 typedef enum {
@@ -311,6 +322,18 @@ qd_message_depth_status_t qd_message_check_depth(const qd_message_t *msg, qd_mes
 qd_iterator_t *qd_message_field_iterator_typed(qd_message_t *msg, qd_message_field_t field);
 qd_iterator_t *qd_message_field_iterator(qd_message_t *msg, qd_message_field_t field);
 
+/**
+ * As qd_message_field_iterator() but initializes the iterator in caller-provided
+ * storage rather than allocating it.  The returned iterator must still be
+ * released with qd_iterator_free().
+ *
+ * @param storage Storage for the iterator
+ * @param msg A pointer to a message.
+ * @param field The field to be returned via iterator.
+ * @return A field iterator located in storage or NULL if the field is not present.
+ */
+qd_iterator_t *qd_message_field_iterator_init(qd_iterator_storage_t *storage, qd_message_t *msg, qd_message_field_t field);
+
 ssize_t qd_message_field_length(qd_message_t *msg, qd_message_field_t field);
 ssize_t qd_message_field_copy(qd_message_t *msg, qd_message_field_t field, char *buffer, size_t *hdr_length);
 
@@ -486,6 +509,20 @@ void qd_message_set_tag_sent(qd_message_t *msg, bool tag_sent);
  */
 void qd_message_add_fanout(qd_message_t *out_msg);
 
+/**
+ * Make count new references to an existing message for a multicast fanout.
+ *
+ * Equivalent to calling qd_message_copy() followed by qd_message_add_fanout()
+ * count times, but the content lock is taken and the buffer chain is walked
+ * only once for the whole batch.
+ *
+ * @param msg A pointer to a qd_message_t referencing a message.
+ * @param copies Array of at least count entries that receives the new references.
+ * @param count The number of references to make.
+ * @return The number of references made, less than count only if an allocation failed.
+ */
+int qd_message_copy_fanout(qd_message_t *msg, qd_message_t **copies, int count);
+
 /**
  * Disable the Q2-holdoff for this message.
  *
@@ -548,6 +585,47 @@ uint8_t qd_message_get_priority(qd_message_t *msg);
  */
 bool qd_message_oversize(const qd_message_t *msg);
 
+/**
+ * Create an account that counts the buffers held by the messages charged to it (see qd_message_set_account()).
+ * Charged messages hold a reference to the account, so it remains valid until the creator has called
+ * qd_message_account_decref() and the last charged message has been freed.
+ *
+ * @return A new account holding no buffers, with a reference for the caller.
+ */
+qd_message_account_t *qd_message_account(void);
+
+/**
+ * Release the caller's reference to an account.
+ * @param account The account, may be null.
+ */
+void qd_message_account_decref(qd_message_account_t *account);
+
+/**
+ * The number of buffers currently held by the messages charged to an account: content buffers that have not been
+ * released after sending and buffers in cut-through slots.
+ * @param account The account
+ * @return The number of buffers
+ */
+uint64_t qd_message_account_buffers(const qd_message_account_t *account);
+
+/**
+ * The number of the buffers counted by qd_message_account_buffers() that are in cut-through slots.
+ * @param account The account
+ * @return The number of buffers
+ */
+uint64_t qd_message_account_slot_buffers(const qd_message_account_t *account);
+
+/**
+ * Charge the buffers of a message to an account, typically that of the connection the message is received on. The
+ * buffers the content already holds are charged immediately, buffers added later as they arrive and buffers released
+ * after sending are credited back. Must be called by the producer of the message before it is forwarded. A message's
+ * account cannot be changed once set.
+ *
+ * @param msg A pointer to the message
+ * @param account The account to charge
+ */
+void qd_message_set_account(qd_message_t *msg, qd_message_account_t *account);
+
 //=====================================================================================================
 // Unicast/Cut-through API
 //
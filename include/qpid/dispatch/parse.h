@@ -42,6 +42,56 @@ typedef struct qd_parsed_field_t qd_parsed_field_t;
  */
 qd_parsed_field_t *qd_parse(const qd_iterator_t *iter);
 
+/**
+ * Parse a field delimited by an iterator into an arena-backed tree.
+ *
+ * The resulting tree is used exactly like one returned by qd_parse(), but
+ * its nodes are carved out of a single arena owned by the root rather than
+ * allocated one by one, and the children of a compound field are only
+ * materialized when they are first accessed.  The whole encoding is still
+ * validated up front so qd_parse_ok() on the root reports the same errors
+ * as qd_parse().
+ *
+ * Use this for short-lived trees where only part of the data is examined
+ * (control messages, application properties).  Free the tree with
+ * qd_parse_free() on the root; nodes cannot be freed individually.
+ *
+ * @param iter holds the data to be parsed
+ * @return A pointer to the root of the newly created tree.
+ */
+qd_parsed_field_t *qd_parse_lazy(const qd_iterator_t *iter);
+
+/**
+ * Caller-provided storage for a short-lived tree from qd_parse_lazy_init().
+ *
+ * The storage holds the root and up to QD_PARSE_STORAGE_FIELDS - 1 children,
+ * enough for small fixed lists such as the message header.  Larger trees
+ * continue in arena blocks allocated from the pool.  The storage is opaque:
+ * use the qd_parsed_field_t pointer returned by qd_parse_lazy_init().
+ */
+#define QD_PARSE_STORAGE_FIELDS 6
+#define QD_PARSE_STORAGE_SIZE   1024
+
+typedef struct qd_parse_storage_t {
+    union {
+        void          *align_ptr;
+        uint64_t       align_u64;
+        unsigned char  octets[QD_PARSE_STORAGE_SIZE];
+    } u;
+} qd_parse_storage_t;
+
+/**
+ * Parse a field delimited by an iterator into an arena-backed tree that
+ * starts in caller-provided storage (typically on the stack).  See
+ * qd_parse_lazy().  The tree must not outlive the storage and must still be
+ * released with qd_parse_free() on the root.
+ *
+ * @param storage Storage for the root of the tree
+ * @param iter holds the data to be parsed
+ * @return A pointer to the root of the tree, located in storage.
+ */
+qd_parsed_field_t *qd_parse_lazy_init(qd_parse_storage_t *storage, const qd_iterator_t *iter);
+
 /**
  * Free the resources associated with a parsed field.
  *
@@ -51,6 +101,8 @@ void qd_parse_free(qd_parsed_field_t *field);
 
 /**
  * Create a duplicate parsed field, referring to the same base data.
+ * The duplicate of a field from qd_parse_lazy() is a regular (fully
+ * materialized) tree.
  *
  * @param field A field pointer returned by qd_parse.
  * @return A separate field that is a duplicate of the supplied field.
@@ -274,7 +326,7 @@ qd_parsed_field_t *qd_parse_value_by_key(qd_parsed_field_t *field, const char *k
  * @param ra_ingress returned parsed field: ingress router id
  * @param ra_to_override returned parsed field: destination address override
  * @param ra_trace returned parsed field: router trace list
- * @param ra_flags returned parsed field: message flags
+ * @param ra_flags returned message flags value (the flags field itself is not kept)
  * @return 0 on success else a parse error message
  */
 const char *qd_parse_router_annotations(
@@ -283,7 +335,7 @@ const char *qd_parse_router_annotations(
     qd_parsed_field_t **ra_ingress_mesh,
     qd_parsed_field_t **ra_to_override,
     qd_parsed_field_t **ra_trace,
-    qd_parsed_field_t **ra_flags);
+    uint32_t           *ra_flags);
 
 /**
  * Parse a 32 bit unsigned integer in network order to a native uint32 value.
@@ -62,4 +62,10 @@ uint64_t qd_router_virtual_memory_usage(void);
  */
 uint64_t qd_router_rss_memory_usage(void);
 
+/**
+ * Return the current value of a monotonic clock in microseconds.  Suitable for measuring intervals that are too
+ * short for the millisecond resolution of qd_timer_now().  Thread safe.
+ */
+uint64_t qd_platform_monotonic_usec(void);
+
 #endif
@@ -441,6 +441,19 @@ void qdr_connection_set_context(qdr_connection_t *conn, void *context);
 void *qdr_connection_get_context(const qdr_connection_t *conn);
 
 
+/**
+ * qdr_connection_raw_buffers_held
+ *
+ * Account for raw I/O buffers (e.g. read buffers granted to a proton raw connection) that the protocol adaptor holds
+ * on behalf of this connection. The total is reported by management as the connection's rawBuffers. May be called
+ * from any thread.
+ *
+ * @param conn The pointer returned by qdr_connection_opened
+ * @param delta The change in the number of buffers held
+ */
+void qdr_connection_raw_buffers_held(qdr_connection_t *conn, int delta);
+
+
 /**
  * qdr_connection_role
  *
@@ -738,6 +751,23 @@ bool qdr_link_strip_annotations_out(const qdr_link_t *link);
  */
 void qdr_link_stalled_outbound(qdr_link_t *link);
 
+/**
+ * qdr_link_charge_octets
+ *
+ * Charge octets written by the deliver handler against the link's deficit-round-robin scheduling
+ * deficit.  Called on the I/O thread from within the deliver handler.  Links whose adaptor does
+ * not report octets are never limited by the deficit.
+ *
+ * Only the AMQP adaptor charges the deficit: it multiplexes many outgoing links on one connection.
+ * The TCP adaptor opens a core connection per flow with a single outgoing link, and writes the
+ * stream body from its raw connection events rather than from the deliver handler, so there is
+ * no other link on the connection to share the I/O turn with.
+ *
+ * @param link Pointer to the outgoing link
+ * @param octets The number of octets just sent on the link
+ */
+void qdr_link_charge_octets(qdr_link_t *link, uint64_t octets);
+
 /**
  * qdr_link_set_user_streaming
  *
@@ -784,6 +814,18 @@ qdr_link_t *qdr_link_first_attach(qdr_connection_t *conn,
                                   qdr_delivery_t   *initial_delivery,
                                   uint64_t         *link_id);
 
+/**
+ * qdr_link_move_delivery
+ *
+ * Move a delivery from its existing link to the tail of an attached outgoing link's buffer, as the initial_delivery
+ * of qdr_link_first_attach does for a new link. This lets an adaptor reuse one outgoing link for a sequence of
+ * deliveries routed to its connector.
+ *
+ * @param link The outgoing link pointer returned by qdr_link_first_attach
+ * @param delivery The delivery to move
+ */
+void qdr_link_move_delivery(qdr_link_t *link, qdr_delivery_t *delivery);
+
 /**
  * qdr_link_second_attach
  *
@@ -899,6 +941,16 @@ void qdr_link_complete_sent_message(qdr_core_t *core, qdr_link_t *link);
 
 void qdr_link_flow(qdr_core_t *core, qdr_link_t *link, int credit, bool drain_mode);
 
+/**
+ * Change the capacity of a link.  For an outgoing link the capacity is the number of unsettled
+ * deliveries the link may hold before the balanced forwarder prefers other destinations.
+ *
+ * @param core Pointer to the router core object
+ * @param link The link to be modified
+ * @param capacity The new capacity (>= 1)
+ */
+void qdr_link_set_capacity(qdr_core_t *core, qdr_link_t *link, int capacity);
+
 /**
  * Sets the link's drain flag to false and sets credit to core to zero.
  * The passed in link has been drained and hence no longer in drain mode.
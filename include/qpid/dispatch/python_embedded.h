@@ -45,6 +45,13 @@ void qd_python_initialize(qd_dispatch_t *qd, const char *python_pkgdir);
  */
 void qd_python_finalize(void);
 
+/**
+ * Stop the thread that runs queued Python work.  Work still queued, or posted
+ * after this call, is discarded.  Call during shutdown before freeing the
+ * objects that queued work may refer to.
+ */
+void qd_python_stop_work(void);
+
 /**
  * Start using embedded python.  This is called once by each module that plans
  * to use embedded python capabilities.  It must call qd_python_start before
@@ -406,6 +406,12 @@ typedef struct {
     (!QDR_ROUTER_VERSION_AT_LEAST(V, MAJOR, MINOR, PATCH))
 
 
+//
+// Delivery latency histogram buckets: time from a delivery arriving at the router core until it is settled. Upper
+// bounds: 100us, 200us, 500us, 1ms, 2ms, 5ms, 10ms, 100ms, 1s, unbounded.
+//
+#define QDR_DELIVERY_LATENCY_BUCKETS 10
+
 typedef struct {
     size_t connections;
     size_t links;
@@ -428,6 +434,7 @@ typedef struct {
     size_t deliveries_stuck;
     size_t links_blocked;
     size_t deliveries_redirected_to_fallback;
+    size_t delivery_latency_histogram[QDR_DELIVERY_LATENCY_BUCKETS];
 }  qdr_global_stats_t;
 ALLOC_DECLARE(qdr_global_stats_t);
 
@@ -25,15 +25,40 @@
 
 #include <assert.h>
 #include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 #include "qpid/dispatch/internal/thread_annotations.h"
 
+typedef struct sys_lock_class_t sys_lock_class_t;
+
 typedef struct sys_mutex_t TA_CAP("mutex") sys_mutex_t;
 struct sys_mutex_t {
-    pthread_mutex_t mutex;
+    pthread_mutex_t   mutex;
+#ifdef QD_LOCK_PROFILING
+    sys_lock_class_t *lock_class;     // 0 unless lock profiling is enabled
+    uint64_t          acquired_nsec;  // when the current holder took the mutex
+#endif
 };
 
 void sys_mutex_init(sys_mutex_t *mutex);
+
+// Initialize a mutex that is accounted to the lock class NAME when lock profiling is enabled (see below). NAME must
+// be a string literal. All mutexes initialized with the same NAME share one set of contention statistics, those
+// initialized with sys_mutex_init() are accounted to the class "other". Do not call sys_mutex_init_class() directly.
+//
+#ifdef QD_LOCK_PROFILING
+#define sys_mutex_init_named(M, NAME)                                  \
+    do {                                                               \
+        static sys_lock_class_t *_sys_lock_class;                      \
+        sys_mutex_init_class((M), &_sys_lock_class, (NAME));           \
+    } while (0)
+
+void sys_mutex_init_class(sys_mutex_t *mutex, sys_lock_class_t **site_class, const char *name);
+#else
+#define sys_mutex_init_named(M, NAME) sys_mutex_init(M)
+#endif
+
 void sys_mutex_free(sys_mutex_t *mutex);
 void sys_mutex_lock(sys_mutex_t *mutex) TA_ACQ(*mutex);
 void sys_mutex_unlock(sys_mutex_t *mutex) TA_REL(*mutex);
@@ -67,6 +92,8 @@ typedef enum {
     SYS_THREAD_PROACTOR,
     SYS_THREAD_VFLOW,
     SYS_THREAD_LWS_HTTP,
+    SYS_THREAD_PYTHON,
+    SYS_THREAD_TLS_HANDSHAKE,
     // add new thread roles here and update _thread_names in threading.c
     SYS_THREAD_ROLE_COUNT
 } sys_thread_role_t;
@@ -122,6 +149,35 @@ void sys_spinlock_lock(sys_spinlock_t *lock) TA_ACQ(*lock);
 void sys_spinlock_unlock(sys_spinlock_t *lock) TA_REL(*lock);
 
 
+//
+// Lock contention profiling
+//
+// Built in only when the router is configured with -DQD_LOCK_PROFILING=ON, otherwise sys_mutex_t carries no profiling
+// state and no lock classes are ever registered. In a profiling build it is enabled by setting the environment
+// variable SKUPPER_ROUTER_LOCK_PROFILING before the router starts: every sys_mutex_t acquisition is then timed and
+// accounted to the mutex's lock class. When disabled the only cost is a test of a pointer in sys_mutex_lock() and
+// sys_mutex_unlock().
+//
+
+// histogram buckets: under 1us, 10us, 100us, 1ms, 10ms and 10ms or longer
+#define SYS_LOCK_HISTOGRAM_BUCKETS 6
+
+typedef struct sys_lock_stats_t {
+    uint64_t acquired;   // total acquisitions
+    uint64_t contended;  // acquisitions that had to wait for another holder
+    uint64_t wait_nsec;  // total time spent waiting to acquire
+    uint64_t hold_nsec;  // total time held
+    uint64_t wait_histogram[SYS_LOCK_HISTOGRAM_BUCKETS];  // contended acquisitions only
+    uint64_t hold_histogram[SYS_LOCK_HISTOGRAM_BUCKETS];
+} sys_lock_stats_t;
+
+bool              sys_lock_profiling_enabled(void);
+sys_lock_class_t *sys_lock_class_first(void);
+sys_lock_class_t *sys_lock_class_next(const sys_lock_class_t *lock_class);
+const char       *sys_lock_class_name(const sys_lock_class_t *lock_class);  // NAME of sys_mutex_init_named
+void              sys_lock_class_stats(const sys_lock_class_t *lock_class, sys_lock_stats_t *stats);
+
+
 typedef struct sys_thread_t sys_thread_t;
 
 sys_thread_t *sys_thread(sys_thread_role_t role, void *(*run_function)(void *), void *arg);
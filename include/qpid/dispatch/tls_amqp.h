@@ -37,9 +37,23 @@ typedef struct pn_transport_t pn_transport_t;
  * @param config the TLS configuration used to create the session
  * @param tport transport associated with the session's connection
  * @param allow_unencrypted if true permit accepting incoming unencrypted connections
+ * @param session_id client mode only: identifies the remote peer so that a later session to the same peer may resume
+ * this one rather than perform a full handshake. May be 0.
  * @return a new TLS session or 0 on error. If error qd_error() is set.
  */
-qd_tls_session_t *qd_tls_session_amqp(qd_tls_config_t *config, pn_transport_t *tport, bool allow_unencrypted);
+qd_tls_session_t *qd_tls_session_amqp(qd_tls_config_t *config, pn_transport_t *tport, bool allow_unencrypted,
+                                      const char *session_id);
+
+
+/**
+ * Account for the completed handshake of the TLS session in its parent configuration's handshake statistics.
+ *
+ * Proton does not signal the end of the AMQP TLS handshake so the caller invokes this when the connection opens.
+ * Subsequent calls have no effect.
+ *
+ * @param session the TLS session of an opened connection
+ */
+void qd_tls_session_amqp_handshake_done(qd_tls_session_t *session);
 
 
 /**
@@ -24,6 +24,7 @@
  */
 
 
+#include "qpid/dispatch/error.h"
 #include "qpid/dispatch/log.h"
 
 #include <stdbool.h>
@@ -34,6 +35,7 @@
 typedef struct qd_tls_config_t   qd_tls_config_t;    // run-time TLS configuration state
 typedef struct qd_tls_session_t  qd_tls_session_t;  // per connection TLS state
 typedef struct qd_ssl2_profile_t qd_ssl2_profile_t;  // sslProfile configuration record
+typedef struct qd_entity_t       qd_entity_t;
 
 // Proton has two different TLS implementations: one for AMQP and a buffer-based one for use with Raw Connections:
 typedef enum {
@@ -89,8 +91,24 @@ struct qd_ssl2_profile_t {
      */
     long version;
     long oldest_valid_version;
+
+    /**
+     * session_cache_rotation: Interval in seconds after which listeners using this profile reload their TLS context,
+     * discarding the server-side session cache and session ticket keys. Zero disables rotation.
+     */
+    long session_cache_rotation;
 };
 
+// TLS handshake accounting per qd_tls_config_t (i.e. per listener/connector). The histogram buckets handshakes by
+// duration: under 1 millisecond, 10ms, 100ms, 1 second, 10 seconds and 10 seconds or longer.
+#define QD_TLS_HANDSHAKE_HISTOGRAM_BUCKETS 6
+
+typedef struct qd_tls_handshake_stats_t {
+    uint64_t full;
+    uint64_t resumed;
+    uint64_t histogram[QD_TLS_HANDSHAKE_HISTOGRAM_BUCKETS];
+} qd_tls_handshake_stats_t;
+
 /**
  * Create a new TLS qd_tls_config_t instance with the given configuration
  *
@@ -110,13 +128,34 @@ qd_tls_config_t *qd_tls_config(const char *ssl_profile_name,
 
 
 /**
- * Release a reference to the qd_tls_config_t
+ * Release the owner's reference to the qd_tls_config_t returned by qd_tls_config(). The configuration is considered no
+ * longer in use by its listener or connector from this point, even if TLS sessions still reference it.
  *
  * @param config to be released. The config pointer must no longer be referenced
  */
 void qd_tls_config_decref(qd_tls_config_t *config);
 
 
+/**
+ * Get a snapshot of the handshake statistics of all sessions created from the qd_tls_config_t
+ *
+ * @param config the TLS configuration to query
+ * @param stats filled with the current counters
+ */
+void qd_tls_config_get_handshake_stats(qd_tls_config_t *config, qd_tls_handshake_stats_t *stats);
+
+
+/**
+ * Set the TLS handshake attributes (tlsHandshakesFull, tlsHandshakesResumed and tlsHandshakeHistogram) of a
+ * listener/connector management entity from its TLS configuration.
+ *
+ * @param config the TLS configuration of the listener/connector. May be 0 if TLS is not configured.
+ * @param entity the entity being refreshed
+ * @return QD_ERROR_NONE on success
+ */
+qd_error_t qd_tls_config_refresh_handshake_stats(qd_tls_config_t *config, qd_entity_t *entity);
+
+
 /**
  * Release a TLS session context.
  *
@@ -175,6 +214,42 @@ qd_ssl2_profile_t *qd_tls_read_ssl_profile(const char *ssl_profile_name, qd_ssl2
 void qd_tls_cleanup_ssl_profile(qd_ssl2_profile_t *profile);
 
 
+/**
+ * Handshake offload statistics, see qd_tls_handshake_pool_stats()
+ */
+typedef struct qd_tls_handshake_pool_stats_t {
+    uint64_t offloads;     // handshake steps run by the worker pool
+    uint64_t busy_usec;    // total time the workers spent in pn_tls_process()
+    uint64_t queue_depth;  // handshake steps waiting for a worker
+    uint64_t threads;      // 0 if handshakes run inline on the I/O threads
+} qd_tls_handshake_pool_stats_t;
+
+/**
+ * Start the handshake worker pool.
+ *
+ * While the handshake of a raw connection TLS session is in progress the pn_tls_process() call that consumes handshake
+ * records from the peer is handed to one of thread_count worker threads instead of running inline on the proactor
+ * thread servicing the raw connection. The raw connection is woken when the worker is done. If thread_count is zero
+ * (the default) handshakes run inline.
+ *
+ * Adaptors using offload must free the TLS session no later than the handling of the PN_RAW_CONNECTION_DISCONNECTED
+ * event for its raw connection.
+ *
+ * @param thread_count number of worker threads.
+ */
+void qd_tls_handshake_pool_start(int thread_count);
+
+/**
+ * Stop the handshake worker pool. Queued handshake steps are completed before the workers exit.
+ */
+void qd_tls_handshake_pool_stop(void);
+
+/**
+ * Get a snapshot of the handshake worker pool statistics. Thread safe.
+ */
+void qd_tls_handshake_pool_stats(qd_tls_handshake_pool_stats_t *stats);
+
+
 // Module initialization/finalization
 void qd_tls_initialize(void);
 void qd_tls_finalize(void);
@@ -537,6 +537,14 @@ class AllocatorEntity(EntityAdapter):
         return super(AllocatorEntity, self).__str__().replace("Entity(", "AllocatorEntity(")
 
 
+class LockClassEntity(EntityAdapter):
+    def _identifier(self):
+        return self.attributes.get('lockName')
+
+    def __str__(self):
+        return super(LockClassEntity, self).__str__().replace("Entity(", "LockClassEntity(")
+
+
 class TcpListenerEntity(EntityAdapter):
     def create(self):
         config_listener = self._qd.qd_dispatch_configure_tcp_listener(self._dispatch, self)
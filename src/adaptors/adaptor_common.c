@@ -89,6 +89,45 @@ qd_error_t qd_load_adaptor_config(qdr_core_t *core, qd_adaptor_config_t *config,
     CHECK();
     if (config->backlog <= 0 || config->backlog > SOMAXCONN)
         config->backlog = SOMAXCONN;
+    char *encapsulation =       qd_entity_opt_string(entity, "encapsulation", "tcp");  CHECK();
+    config->encapsulation =     strcmp(encapsulation, "http1") == 0 ? QD_ENCAPSULATION_HTTP1 : QD_ENCAPSULATION_TCP;
+    free(encapsulation);
+    config->max_pooled_connections = qd_entity_opt_long(entity, "maxPooledConnections", 16);
+    CHECK();
+    if (config->max_pooled_connections <= 0)
+        config->max_pooled_connections = 1;
+    config->link_capacity = qd_entity_opt_long(entity, "linkCapacity", 5);
+    CHECK();
+    if (config->link_capacity <= 0)
+        config->link_capacity = 1;
+    config->adaptive_link_capacity = qd_entity_opt_bool(entity, "adaptiveLinkCapacity", false);
+    CHECK();
+    config->accept_rate = qd_entity_opt_long(entity, "acceptRate", 0);
+    CHECK();
+    if (config->accept_rate < 0)
+        config->accept_rate = 0;
+    config->accept_burst = qd_entity_opt_long(entity, "acceptBurst", 0);
+    CHECK();
+    if (config->accept_burst <= 0)
+        config->accept_burst = MAX(config->accept_rate, 1);
+    config->max_pending_setup = qd_entity_opt_long(entity, "maxPendingSetup", 0);
+    CHECK();
+    if (config->max_pending_setup < 0)
+        config->max_pending_setup = 0;
+    config->warm_pool_min_idle = qd_entity_opt_long(entity, "warmPoolMinIdle", 0);
+    CHECK();
+    if (config->warm_pool_min_idle < 0)
+        config->warm_pool_min_idle = 0;
+    config->warm_pool_max_idle = qd_entity_opt_long(entity, "warmPoolMaxIdle", 0);
+    CHECK();
+    if (config->warm_pool_max_idle < config->warm_pool_min_idle)
+        config->warm_pool_max_idle = config->warm_pool_min_idle;
+    config->warm_pool_idle_timeout = qd_entity_opt_long(entity, "warmPoolIdleTimeout", 60);
+    CHECK();
+    if (config->warm_pool_idle_timeout < 0)
+        config->warm_pool_idle_timeout = 0;
+    config->warm_pool_liveness = qd_entity_opt_bool(entity, "warmPoolLivenessCheck", true);
+    CHECK();
 
     int hplen = strlen(config->host) + strlen(config->port) + 2;
     config->host_port = malloc(hplen);
@@ -115,6 +154,38 @@ error:
     return qd_error_code();
 }
 
+#define TOKEN_UNITS 1000000
+
+void qd_token_bucket_init(qd_token_bucket_t *bucket, uint64_t rate, uint64_t burst)
+{
+    bucket->rate        = rate;
+    bucket->burst_units = MAX(burst, 1) * TOKEN_UNITS;
+    bucket->units       = bucket->burst_units;
+    bucket->last_usec   = 0;
+}
+
+bool qd_token_bucket_take(qd_token_bucket_t *bucket, uint64_t now_usec, uint64_t *wait_usec)
+{
+    if (bucket->rate == 0)
+        return true;
+
+    if (now_usec > bucket->last_usec) {
+        // Cap the elapsed time so the refill cannot overflow. With rate >= 1 an empty bucket refills in at most
+        // burst_units usec so the cap does not affect the result.
+        uint64_t elapsed = MIN(now_usec - bucket->last_usec, bucket->burst_units);
+        bucket->units     = MIN(bucket->units + elapsed * bucket->rate, bucket->burst_units);
+        bucket->last_usec = now_usec;
+    }
+
+    if (bucket->units >= TOKEN_UNITS) {
+        bucket->units -= TOKEN_UNITS;
+        return true;
+    }
+
+    *wait_usec = (TOKEN_UNITS - bucket->units + bucket->rate - 1) / bucket->rate;
+    return false;
+}
+
 size_t qd_raw_conn_get_address_buf(pn_raw_connection_t *pn_raw_conn, char *buf, size_t buflen)
 {
     assert(pn_raw_conn);
@@ -41,6 +41,11 @@ typedef enum {
     QD_AGGREGATION_MULTIPART
 } qd_http_aggregation_t;
 
+typedef enum {
+    QD_ENCAPSULATION_TCP,    // one streaming delivery per TCP connection
+    QD_ENCAPSULATION_HTTP1   // one delivery per HTTP/1.x request and response
+} qd_adaptor_encapsulation_t;
+
 typedef struct qd_adaptor_config_t qd_adaptor_config_t;
 
 struct qd_adaptor_config_t
@@ -53,6 +58,17 @@ struct qd_adaptor_config_t
     char                       *host_port;
     int                         backlog;
     qd_observer_t  observer;
+    qd_adaptor_encapsulation_t  encapsulation;
+    int                         max_pooled_connections;  // http1 encapsulation, connector only
+    int                         link_capacity;           // capacity of the core links carrying the flows
+    bool                        adaptive_link_capacity;  // connector only: adjust capacity to connect latency
+    int                         accept_rate;             // listener only: connection setups per second, 0 == no limit
+    int                         accept_burst;            // listener only: setups allowed at once before accept_rate applies
+    int                         max_pending_setup;       // listener only: reject connections beyond this many in setup, 0 == no limit
+    int                         warm_pool_min_idle;      // tcp connector only: pre-connected server conns to keep, 0 == no pool
+    int                         warm_pool_max_idle;      // tcp connector only: upper bound the pool may grow to on misses
+    int                         warm_pool_idle_timeout;  // tcp connector only: seconds before an idle warm conn is replaced, 0 == never
+    bool                        warm_pool_liveness;      // tcp connector only: watch idle warm conns for the server closing them
     //TLS related info
     char                       *ssl_profile_name;
     bool                        authenticate_peer;
@@ -62,6 +78,25 @@ struct qd_adaptor_config_t
 
 ALLOC_DECLARE(qd_adaptor_config_t);
 
+/**
+ * Token bucket rate limiter. Tokens accrue at 'rate' per second up to 'burst' tokens. Not thread safe: the caller
+ * provides the locking.
+ */
+typedef struct qd_token_bucket_t {
+    uint64_t rate;          // tokens per second, 0 == unlimited
+    uint64_t burst_units;   // capacity of the bucket
+    uint64_t units;         // current fill level: one token is 1000000 units
+    uint64_t last_usec;     // time of the last refill
+} qd_token_bucket_t;
+
+void qd_token_bucket_init(qd_token_bucket_t *bucket, uint64_t rate, uint64_t burst);
+
+/**
+ * Take a token if one is available and return true. Otherwise return false and set *wait_usec to the time until the
+ * next token becomes available.
+ */
+bool qd_token_bucket_take(qd_token_bucket_t *bucket, uint64_t now_usec, uint64_t *wait_usec);
+
 qd_error_t qd_load_adaptor_config(qdr_core_t *core, qd_adaptor_config_t *config, qd_entity_t *entity);
 void qd_free_adaptor_config(qd_adaptor_config_t *config);
 
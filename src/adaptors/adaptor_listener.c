@@ -23,6 +23,7 @@
 
 #include <qpid/dispatch/protocol_adaptor.h>
 #include <qpid/dispatch/log.h>
+#include <qpid/dispatch/memory_governor.h>
 
 #include <proton/listener.h>
 #include <proton/proactor.h>
@@ -147,6 +148,16 @@ static void _listener_event_handler(pn_event_t *e, qd_server_t *qd_server, void
              qd_log(log_module, QD_LOG_DEBUG, "Listener %s: new incoming client connection to %s", li->name,
                     li->host_port);
 
+             // New connections are the lowest priority work: under critical memory pressure refuse them (if so
+             // configured) so the flows already in progress can complete.
+             if (qd_memory_governor_shed()) {
+                 qd_adaptor_listener_deny_conn(li, pn_event_listener(e));
+                 qd_log(log_module, QD_LOG_DEBUG,
+                        "Listener %s: denied new incoming client connection to %s: critical memory pressure",
+                        li->name, li->host_port);
+                 break;
+             }
+
              // block qd_adapter_listener_close() from returning during the accept call:
              sys_mutex_lock(&li->lock);
              if (li->on_accept)
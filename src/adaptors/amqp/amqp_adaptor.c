@@ -778,7 +778,8 @@ static bool AMQP_rx_handler(qd_router_t *router, qd_link_t *link)
     //
     if (check_user) {
         // This connection must not allow proxied user_id
-        qd_iterator_t *userid_iter  = qd_message_field_iterator(msg, QD_FIELD_USER_ID);
+        qd_iterator_storage_t  userid_storage;
+        qd_iterator_t         *userid_iter = qd_message_field_iterator_init(&userid_storage, msg, QD_FIELD_USER_ID);
         if (userid_iter) {
             // The user_id property has been specified
             if (qd_iterator_remaining(userid_iter) > 0) {
@@ -1528,13 +1529,17 @@ static void AMQP_opened_handler(qd_router_t *router, qd_connection_t *conn, bool
     char *cipher = 0;
     int ssl_ssf = 0;
 
+    bool encrypted     = tport && pn_transport_is_encrypted(tport);
+
     if (conn->ssl) {
         proto = qd_tls_session_get_protocol_version(conn->ssl);
         cipher = qd_tls_session_get_protocol_ciphers(conn->ssl);
         ssl_ssf = qd_tls_session_get_ssf(conn->ssl);
+        if (encrypted) {
+            qd_tls_session_amqp_handshake_done(conn->ssl);
+        }
     }
 
-    bool encrypted     = tport && pn_transport_is_encrypted(tport);
     bool authenticated = tport && pn_transport_is_authenticated(tport);
 
     qdr_connection_info_t *connection_info = qdr_connection_info(encrypted,
@@ -2114,6 +2119,8 @@ static uint64_t CORE_link_deliver(void *context, qdr_link_t *link, qdr_delivery_
 
     octets_sent = qd_message_send(msg_out, qlink, ra_flags, &q3_stalled);
     bool send_complete = qdr_delivery_send_complete(dlv);
+    if (octets_sent > 0)
+        qdr_link_charge_octets(link, (uint64_t) octets_sent);
 
     //
     // Bump LINK metrics if appropriate
@@ -2307,7 +2314,7 @@ static void qd_amqp_adaptor_init(qdr_core_t *core, void **adaptor_context)
 {
     qd_dispatch_t *qd = qdr_core_dispatch(core);
 
-    sys_mutex_init(&amqp_adaptor.lock);
+    sys_mutex_init_named(&amqp_adaptor.lock, "amqp.adaptor.lock");
 
     // not necessary but keeps thread analyizer happy:
     sys_mutex_lock(&amqp_adaptor.lock);
@@ -120,7 +120,8 @@ QD_EXPORT qd_listener_t *qd_dispatch_configure_listener(qd_dispatch_t *qd, qd_en
 
 QD_EXPORT qd_error_t qd_entity_refresh_listener(qd_entity_t* entity, void *impl)
 {
-    return QD_ERROR_NONE;
+    qd_listener_t *li = (qd_listener_t*) impl;
+    return qd_tls_config_refresh_handshake_stats(li->tls_config, entity);
 }
 
 
@@ -258,7 +259,7 @@ QD_EXPORT qd_error_t qd_entity_refresh_connector(qd_entity_t* entity, void *impl
 
         sys_mutex_unlock(&connector->lock);
         free(failover_info);
-        return QD_ERROR_NONE;
+        return qd_tls_config_refresh_handshake_stats(connector->tls_config, entity);
     }
 
     sys_mutex_unlock(&connector->lock);
@@ -29,6 +29,7 @@
 #include "qpid/dispatch/hash.h"
 #include "qpid/dispatch/iterator.h"
 #include "qpid/dispatch/log.h"
+#include "qpid/dispatch/memory_governor.h"
 #include "qpid/dispatch/message.h"
 #include "qpid/dispatch/server.h"
 #include "qpid/dispatch/threading.h"
@@ -1069,6 +1070,9 @@ static void qd_session_configure_incoming_window(qd_session_t *qd_ssn, uint32_t
 #if USE_PN_SESSION_WINDOWS
     // Use new window configuration API to set the maximum in window and low water mark
     assert(in_window >= 2);
+    // Sessions opened under memory pressure get a proportionally smaller window. The window of an established session
+    // is not changed since the peer may already have frames in flight.
+    in_window = (uint32_t) qd_memory_governor_scale(in_window, 2);
     int rc = pn_session_set_incoming_window_and_lwm(qd_ssn->pn_session, in_window, in_window / 2);
     (void) rc;
     assert(rc == 0);
@@ -246,7 +246,7 @@ void qd_connection_init(qd_connection_t *ctx, qd_server_t *server, qd_server_con
 {
     ctx->pn_conn = pn_connection();
     assert(ctx->pn_conn);
-    sys_mutex_init(&ctx->deferred_call_lock);
+    sys_mutex_init_named(&ctx->deferred_call_lock, "amqp.connection.deferred_call_lock");
     ctx->role = qd_strdup(config->role);
     ctx->server = server;
     ctx->wake = connection_wake; /* Default, over-ridden for HTTP connections */
@@ -602,7 +602,7 @@ static bool setup_ssl_sasl_and_open(qd_connection_t *ctx)
     // Create an SSL session if required
     //
     if (ct->tls_config) {
-        ctx->ssl = qd_tls_session_amqp(ct->tls_config, tport, false);
+        ctx->ssl = qd_tls_session_amqp(ct->tls_config, tport, false, config->host_port);
         if (!ctx->ssl) {
             qd_log(LOG_SERVER, QD_LOG_ERROR,
                    "Failed to create TLS session for connection [C%" PRIu64 "] to %s:%s (%s)",
@@ -661,7 +661,7 @@ static void on_connection_bound(qd_server_t *server, pn_event_t *e) {
         if (ctx->listener->tls_config) {
             qd_log(LOG_SERVER, QD_LOG_DEBUG, "[C%" PRIu64 "] Configuring SSL on %s", ctx->connection_id, name);
 
-            ctx->ssl = qd_tls_session_amqp(ctx->listener->tls_config, tport, config->ssl_required == false);
+            ctx->ssl = qd_tls_session_amqp(ctx->listener->tls_config, tport, config->ssl_required == false, 0);
             if (!ctx->ssl) {
                 connect_fail(ctx, QD_AMQP_COND_INTERNAL_ERROR, "%s on %s", qd_error_message(), name);
                 return;
@@ -27,6 +27,7 @@
 #include <qpid/dispatch/log.h>
 #include <qpid/dispatch/platform.h>
 #include <qpid/dispatch/connection_counters.h>
+#include <qpid/dispatch/memory_governor.h>
 #include <qpid/dispatch/vanflow.h>
 #include <qpid/dispatch/tls_raw.h>
 #include <qpid/dispatch/threading.h>
@@ -52,6 +53,7 @@
 ALLOC_DEFINE(qd_tcp_listener_t);
 ALLOC_DEFINE(qd_tcp_connector_t);
 ALLOC_DEFINE_SAFE(qd_tcp_connection_t);
+ALLOC_DEFINE(qd_tcp_pending_request_t);
 
 static const char *const state_names[] =
 {
@@ -61,11 +63,14 @@ static const char *const state_names[] =
     [LSIDE_STREAM_START]  = "LSIDE_STREAM_START",
     [LSIDE_FLOW]          = "LSIDE_FLOW",
     [LSIDE_TLS_FLOW]      = "LSIDE_TLS_FLOW",
+    [LSIDE_HTTP1_FLOW]    = "LSIDE_HTTP1_FLOW",
 
+    [CSIDE_WARM]          = "CSIDE_WARM",
     [CSIDE_INITIAL]       = "CSIDE_INITIAL",
     [CSIDE_LINK_SETUP]    = "CSIDE_LINK_SETUP",
     [CSIDE_FLOW]          = "CSIDE_FLOW",
     [CSIDE_TLS_FLOW]      = "CSIDE_TLS_FLOW",
+    [CSIDE_HTTP1_FLOW]    = "CSIDE_HTTP1_FLOW",
 
     [XSIDE_CLOSING] = "XSIDE_CLOSING"
 };
@@ -90,6 +95,35 @@ ENUM_DEFINE(qd_tcp_connection_state, state_names);
 #define TCP_NUM_ALPN_PROTOCOLS 2
 static const char *tcp_alpn_protocols[TCP_NUM_ALPN_PROTOCOLS] = {"http/1.1", "h2"};
 
+// HTTP/1.x encapsulation
+//
+// When a tcpListener/tcpConnector is configured with encapsulation "http1" the TCP byte stream is split at HTTP/1.x
+// message boundaries and each request and each response is carried in its own streaming delivery, rather than one
+// delivery per TCP connection in each direction. This allows the connector side to keep a bounded pool of keep-alive
+// connections to the server and to run requests from many client connections over them, one exchange at a time.
+//
+// Request pipelining is not supported: the listener side stops reading from the client until the response to the
+// current request has been written. Exchanges that cannot be kept alive (HTTP/1.0, "Connection: close",
+// close-delimited response bodies) close the connection once they complete.
+//
+#define HTTP1_SERVICE_UNAVAILABLE "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+
+//
+// Warm connection pool
+//
+// A tcpConnector configured with warmPoolMinIdle/warmPoolMaxIdle keeps connections to the server open before any flow
+// needs them so that a new flow does not wait for the TCP (but still the TLS) handshake with the server. A flow claims
+// an idle warm connection if there is one (a hit), otherwise it connects as usual (a miss). Each miss grows the
+// number of warm connections kept, up to warmPoolMaxIdle. A warm connection not claimed within warmPoolIdleTimeout is
+// closed: it is replaced while the pool is at warmPoolMinIdle, otherwise the pool shrinks by one. With
+// warmPoolLivenessCheck a read buffer is granted to each idle connection so that the server closing it is noticed and
+// the connection is replaced before a flow can claim it. Octets a server sends on connect are held until the flow
+// starts. Warm connections are only used with tcp encapsulation.
+//
+#define WARM_POOL_RETRY_MSEC 1000  // delay before replacing a warm connection that failed
+
+#define SETUP_TIMEOUT_USEC 10000000  // a conn in setup this long no longer counts against maxPendingSetup
+
 
 //
 // Global Adaptor State
@@ -108,11 +142,6 @@ typedef struct {
 
 static qd_tcp_context_t *tcp_context;
 
-static uint64_t buffer_ceiling = 0;
-static uint64_t buffer_threshold_50;
-static uint64_t buffer_threshold_75;
-static uint64_t buffer_threshold_85;
-
 // Window Flow Control
 //
 // This adaptor uses a simple window with acknowledge algorithm to enforce backpressure on the TCP sender. The ingress
@@ -145,13 +174,19 @@ static void on_connection_event_CSIDE_IO(pn_event_t *e, qd_server_t *qd_server,
 static void connection_run_LSIDE_IO(qd_tcp_connection_t *conn);
 static void connection_run_CSIDE_IO(qd_tcp_connection_t *conn);
 static void connection_run_XSIDE_IO(qd_tcp_connection_t *conn);
-static uint64_t validate_outbound_message(const qdr_delivery_t *out_dlv);
+static uint64_t validate_outbound_message(const qdr_delivery_t *out_dlv, const char *content_type);
 static void on_accept(qd_adaptor_listener_t *listener, pn_listener_t *pn_listener, void *context);
 static void on_tls_connection_secured(qd_tls_session_t *tls, void *user_context);
 static char *get_tls_negotiated_alpn(qd_message_t *msg);  // caller must free() returned string!
 static int setup_tls_session(qd_tcp_connection_t *conn, qd_tls_config_t *parent_config, const char *peer_hostname,
                              const char **alpn_protocols, size_t alpn_protocol_count);
 static void free_tcp_resource(qd_tcp_common_t *resource);
+static qd_tcp_connection_t *new_http1_connection_CSIDE_LH(qd_tcp_connector_t *connector, qdr_delivery_t *request);
+static void set_read_grant_outstanding_XSIDE_IO(qd_tcp_connection_t *conn, size_t outstanding);
+static size_t take_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, pn_raw_buffer_t *buffers, size_t num);
+static qd_tcp_connection_t *new_connection_CSIDE_LH(qd_tcp_connector_t *connector, qdr_delivery_t *delivery);
+static void warm_pool_fill_IO(qd_tcp_connector_t *connector);
+static const qd_http1_decoder_config_t http1_decoder_config;
 
 //=================================================================================
 // Thread assertions
@@ -210,6 +245,9 @@ static void _setup_protocol_observer_LH(qd_tcp_listener_t *listener)
  */
 static void qd_tcp_listener_free(qd_tcp_listener_t *listener)
 {
+    qd_timer_free(listener->setup_timer);
+    listener->setup_timer = 0;
+
     sys_mutex_lock(&tcp_context->lock);
     DEQ_REMOVE(tcp_context->listeners, listener);
     sys_mutex_unlock(&tcp_context->lock);
@@ -246,6 +284,10 @@ static void qd_tcp_listener_decref(qd_tcp_listener_t *listener)
  */
 static void qd_tcp_connector_free(qd_tcp_connector_t *connector)
 {
+    // The warm pool timer takes the connector lock, free it first. It is already gone if the connector was deleted.
+    qd_timer_free(connector->warm_timer);
+    connector->warm_timer = 0;
+
     // Disable activation by the Core thread.
     sys_mutex_lock(&connector->lock);
     qd_timer_free(connector->activate_timer);
@@ -263,6 +305,14 @@ static void qd_tcp_connector_free(qd_tcp_connector_t *connector)
             "Deleted TcpConnector for %s, %s:%s",
             connector->adaptor_config->address, connector->adaptor_config->host, connector->adaptor_config->port);
 
+    // Any requests still pending belong to deliveries that are discarded at shutdown
+    qd_tcp_pending_request_t *pending = DEQ_HEAD(connector->pending_requests);
+    while (pending) {
+        DEQ_REMOVE_HEAD(connector->pending_requests);
+        free_qd_tcp_pending_request_t(pending);
+        pending = DEQ_HEAD(connector->pending_requests);
+    }
+
     qd_tls_config_decref(connector->tls_config);
     qd_free_adaptor_config(connector->adaptor_config);
 
@@ -296,9 +346,109 @@ static void on_core_activate_TIMER_IO(void *context)
 }
 
 
+/**
+ * This function is invoked in a timer thread to start the setup of the connections waiting on a listener's setup_queue
+ * as its acceptRate allows.  The connections are woken and begin their setup in their own IO context.
+ */
+static void on_setup_TIMER_IO(void *context)
+{
+    SET_THREAD_TIMER_IO;
+    qd_tcp_listener_t *listener  = (qd_tcp_listener_t*) context;
+    uint64_t           now       = qd_platform_monotonic_usec();
+    uint64_t           wait_usec = 0;
+
+    sys_mutex_lock(&listener->lock);
+    qd_tcp_connection_t *conn = DEQ_HEAD(listener->setup_queue);
+    while (!!conn && qd_token_bucket_take(&listener->accept_bucket, now, &wait_usec)) {
+        DEQ_REMOVE_HEAD_N(SETUP, listener->setup_queue);
+        conn->setup.queued   = false;
+        conn->setup.released = true;
+        pn_raw_connection_wake(conn->raw_conn);
+        conn = DEQ_HEAD(listener->setup_queue);
+    }
+    if (!!conn)
+        qd_timer_schedule(listener->setup_timer, (wait_usec + 999) / 1000);
+    sys_mutex_unlock(&listener->lock);
+}
+
+
+/**
+ * Take an idle connection out of the connector's warm pool and wake it so it closes itself. The caller must hold the
+ * connector lock.
+ */
+static void evict_warm_connection_LH(qd_tcp_connector_t *connector, qd_tcp_connection_t *conn)
+{
+    assert(conn->warm.pooled);
+    DEQ_REMOVE_N(IDLE, connector->warm_connections, conn);
+    conn->warm.pooled = false;
+
+    // a connection that is still connecting closes itself on PN_RAW_CONNECTION_CONNECTED
+    sys_mutex_lock(&conn->activation_lock);
+    if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+        pn_raw_connection_wake(conn->raw_conn);
+    }
+    sys_mutex_unlock(&conn->activation_lock);
+}
+
+
+/**
+ * This function is invoked in a timer thread to maintain a connector's warm pool: warm connections that have not been
+ * claimed within the idle timeout are closed, the pool is refilled to its target and the timer is rescheduled for the
+ * next expiry.
+ */
+static void on_warm_pool_TIMER_IO(void *context)
+{
+    SET_THREAD_TIMER_IO;
+    qd_tcp_connector_t  *connector    = (qd_tcp_connector_t*) context;
+    qd_adaptor_config_t *config       = connector->adaptor_config;
+    const uint64_t       timeout_usec = (uint64_t) config->warm_pool_idle_timeout * 1000000;
+    uint64_t             now          = qd_platform_monotonic_usec();
+
+    sys_mutex_lock(&connector->lock);
+    if (!connector->out_link) {
+        // connector deleted
+        sys_mutex_unlock(&connector->lock);
+        return;
+    }
+    if (timeout_usec > 0) {
+        qd_tcp_connection_t *conn = DEQ_HEAD(connector->warm_connections);
+        while (!!conn && now - conn->warm.idle_since >= timeout_usec) {
+            qd_tcp_connection_t *next = DEQ_NEXT_N(IDLE, conn);
+            // Not needed within the idle timeout: the pool is larger than the load requires
+            connector->warm_pool.target = MAX(connector->warm_pool.target - 1, config->warm_pool_min_idle);
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] CSIDE warm connection idle timeout (pool target %d)",
+                   conn->conn_id, connector->warm_pool.target);
+            evict_warm_connection_LH(connector, conn);
+            conn = next;
+        }
+    }
+    sys_mutex_unlock(&connector->lock);
+
+    warm_pool_fill_IO(connector);
+
+    if (timeout_usec > 0) {
+        now = qd_platform_monotonic_usec();
+        sys_mutex_lock(&connector->lock);
+        qd_tcp_connection_t *oldest = DEQ_HEAD(connector->warm_connections);
+        uint64_t wait_usec = !!oldest && oldest->warm.idle_since + timeout_usec > now
+            ? oldest->warm.idle_since + timeout_usec - now : timeout_usec;
+        if (!!connector->warm_timer) {
+            qd_timer_schedule(connector->warm_timer, (wait_usec + 999) / 1000);
+        }
+        sys_mutex_unlock(&connector->lock);
+    }
+}
+
+
 //=================================================================================
 // Helper Functions
 //=================================================================================
+static inline const char *TL_content_type(const qd_adaptor_config_t *config)
+{
+    return config->encapsulation == QD_ENCAPSULATION_HTTP1 ? QD_CONTENT_TYPE_APP_HTTP1 : QD_CONTENT_TYPE_APP_OCTETS;
+}
+
+
 static pn_data_t *TL_conn_properties(void)
 {
    // Return a new tcp connection properties map.
@@ -316,7 +466,7 @@ static pn_data_t *TL_conn_properties(void)
 }
 
 
-static qdr_connection_t *TL_open_core_connection(uint64_t conn_id, bool incoming, const char *host)
+static qdr_connection_t *TL_open_core_connection(uint64_t conn_id, bool incoming, const char *host, int link_capacity)
 {
     qdr_connection_t *conn;
 
@@ -353,7 +503,7 @@ static qdr_connection_t *TL_open_core_connection(uint64_t conn_id, bool incoming
                                  0,               // remote_container_id
                                  false,           // strip_annotations_in
                                  false,           // strip_annotations_out
-                                 5,               // link_capacity
+                                 link_capacity,   // link_capacity
                                  0,               // policy_spec
                                  info,            // connection_info
                                  0,               // context_binder
@@ -401,7 +551,9 @@ static void TL_setup_connector(qd_tcp_connector_t *connector)
     // Set up a core connection to handle all of the links and deliveries for this connector
     //
     connector->conn_id   = qd_server_allocate_connection_id(tcp_context->server);
-    connector->core_conn = TL_open_core_connection(connector->conn_id, false, "egress-dispatch");
+    connector->link_capacity.current = connector->adaptor_config->link_capacity;
+    connector->core_conn = TL_open_core_connection(connector->conn_id, false, "egress-dispatch",
+                                                    connector->adaptor_config->link_capacity);
     qdr_connection_set_context(connector->core_conn, connector);
     connector->connections_opened = 1;  // for legacy compatibility: it counted the egress-dispatch conn
 
@@ -429,7 +581,14 @@ static void TL_setup_connector(qd_tcp_connector_t *connector)
     connector->out_link = qdr_link_first_attach(connector->core_conn, QD_OUTGOING, source, 0, "tcp.connector.out", 0, false, 0, &connector->link_id);
     qdr_link_set_user_streaming(connector->out_link);
     qdr_link_set_context(connector->out_link, connector);
-    qdr_link_flow(tcp_context->core, connector->out_link, 5, false);
+    qdr_link_flow(tcp_context->core, connector->out_link, connector->adaptor_config->link_capacity, false);
+
+    if (!!connector->warm_timer) {
+        warm_pool_fill_IO(connector);
+        if (connector->adaptor_config->warm_pool_idle_timeout > 0) {
+            qd_timer_schedule(connector->warm_timer, (qd_duration_t) connector->adaptor_config->warm_pool_idle_timeout * 1000);
+        }
+    }
 }
 
 
@@ -556,6 +715,14 @@ static void close_connection_XSIDE_IO(qd_tcp_connection_t *conn)
             qd_tcp_listener_t *listener = (qd_tcp_listener_t*) conn->common.parent;
             sys_mutex_lock(&listener->lock);
             listener->connections_closed++;
+            if (conn->setup.queued) {
+                DEQ_REMOVE_N(SETUP, listener->setup_queue, conn);
+                conn->setup.queued = false;
+            }
+            if (conn->setup.pending) {
+                conn->setup.pending = false;
+                listener->setup_pending--;
+            }
             if (IS_ATOMIC_FLAG_SET(&listener->closing)) {
                 // Wake up the next conn on the list to get it closed
                 // See qd_dispatch_delete_tcp_listener() where the head connection is woken up.
@@ -571,9 +738,11 @@ static void close_connection_XSIDE_IO(qd_tcp_connection_t *conn)
             conn->common.parent = 0;
             qd_tcp_listener_decref(listener);
         } else {
-            qd_tcp_connector_t *connector = (qd_tcp_connector_t*) conn->common.parent;
+            qd_tcp_connector_t  *connector   = (qd_tcp_connector_t*) conn->common.parent;
+            qd_tcp_connection_t *replacement = 0;
             sys_mutex_lock(&connector->lock);
-            connector->connections_closed++;
+            if (!conn->warm.spare)
+                connector->connections_closed++;
             if (IS_ATOMIC_FLAG_SET(&connector->closing)) {
                 // Wake up the next conn on the list to get it closed
                 // See qd_dispatch_delete_tcp_connector() where the head connection is woken up.
@@ -582,7 +751,74 @@ static void close_connection_XSIDE_IO(qd_tcp_connection_t *conn)
                     pn_raw_connection_wake(next_conn->raw_conn);
             }
             DEQ_REMOVE(connector->connections, conn);
+            if (!!conn->http1.decoder) {
+                if (conn->http1.idle) {
+                    DEQ_REMOVE_N(IDLE, connector->idle_connections, conn);
+                    conn->http1.idle = false;
+                }
+
+                sys_mutex_lock(&conn->activation_lock);
+                qdr_delivery_t *request = conn->http1.next_request;
+                conn->http1.next_request = 0;
+                sys_mutex_unlock(&conn->activation_lock);
+
+                if (!!request) {
+                    qdr_delivery_set_context(request, 0);
+                    if (conn->http1.exchanges > 0) {
+                        // A keep-alive connection closed by the server before the request was started: hand the
+                        // request to another connection.
+                        qd_tcp_pending_request_t *pending = new_qd_tcp_pending_request_t();
+                        ZERO(pending);
+                        DEQ_ITEM_INIT(pending);
+                        pending->delivery = request;
+                        DEQ_INSERT_HEAD(connector->pending_requests, pending);
+                    } else {
+                        // The connection to the server never worked, fail the request like a TCP stream would be
+                        qdr_delivery_remote_state_updated(tcp_context->core, request, PN_MODIFIED, true, 0, false);
+                        qdr_delivery_decref(tcp_context->core, request, "close_connection_XSIDE_IO - request released");
+                    }
+                }
+
+                // Replace the connection if requests are waiting for one
+                qd_tcp_pending_request_t *pending = DEQ_HEAD(connector->pending_requests);
+                if (!!pending && !IS_ATOMIC_FLAG_SET(&connector->closing)) {
+                    DEQ_REMOVE_HEAD(connector->pending_requests);
+                    replacement = new_http1_connection_CSIDE_LH(connector, pending->delivery);
+                    free_qd_tcp_pending_request_t(pending);
+                }
+            } else {
+                if (conn->warm.pooled) {
+                    DEQ_REMOVE_N(IDLE, connector->warm_connections, conn);
+                    conn->warm.pooled = false;
+                }
+
+                sys_mutex_lock(&conn->activation_lock);
+                qdr_delivery_t *flow = conn->warm.next_flow;
+                conn->warm.next_flow = 0;
+                sys_mutex_unlock(&conn->activation_lock);
+
+                if (!!flow) {
+                    if (!IS_ATOMIC_FLAG_SET(&connector->closing) && !!connector->out_link) {
+                        // The warm connection failed before the flow was started on it: connect the flow anew
+                        replacement = new_connection_CSIDE_LH(connector, flow);
+                    } else {
+                        qdr_delivery_set_context(flow, 0);
+                        qdr_delivery_remote_state_updated(tcp_context->core, flow, PN_MODIFIED, true, 0, false);
+                        qdr_delivery_decref(tcp_context->core, flow, "close_connection_XSIDE_IO - warm flow released");
+                    }
+                }
+
+                // Replace a lost warm connection after a delay so a failing server is not connected to in a loop
+                if (conn->warm.spare && !!connector->warm_timer && !!connector->out_link
+                    && !IS_ATOMIC_FLAG_SET(&connector->closing)) {
+                    qd_timer_schedule(connector->warm_timer, WARM_POOL_RETRY_MSEC);
+                }
+            }
             sys_mutex_unlock(&connector->lock);
+
+            if (!!replacement) {
+                pn_proactor_raw_connect(tcp_context->proactor, replacement->raw_conn, connector->adaptor_config->host_port);
+            }
             //
             // Call connector decref when a connection associated with the connector is removed (DEQ_REMOVE(connector->connections, conn))
             //
@@ -597,6 +833,7 @@ static void close_connection_XSIDE_IO(qd_tcp_connection_t *conn)
         pn_raw_connection_close(conn->raw_conn);
         drain_read_buffers_XSIDE_IO(conn->raw_conn);
         drain_write_buffers_XSIDE_IO(conn->raw_conn);
+        set_read_grant_outstanding_XSIDE_IO(conn, 0);
 
         // note: this disables the raw connection event handler. No further PN_RAW_CONNECTION_* events will occur,
         // including DISCONNECTED!
@@ -661,6 +898,9 @@ static void close_connection_XSIDE_IO(qd_tcp_connection_t *conn)
     qd_tls_session_free(conn->tls_session);
     free(conn->alpn_protocol);
     free(conn->reply_to);
+    qd_http1_decoder_connection_free(conn->http1.decoder);
+    qd_buffer_list_free_buffers(&conn->http1.rx_pending);
+    qd_buffer_list_free_buffers(&conn->warm.rx_pending);
 
     conn->reply_to          = 0;
     conn->inbound_link      = 0;
@@ -672,6 +912,7 @@ static void close_connection_XSIDE_IO(qd_tcp_connection_t *conn)
     conn->observer_handle   = 0;
     conn->common.vflow      = 0;
     conn->tls_session       = 0;
+    conn->http1.decoder     = 0;
 
     // No thread assertion here - can be RAW_IO or TIMER_IO
     qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] Cleaning up resources", conn->conn_id);
@@ -690,6 +931,43 @@ static void close_connection_XSIDE_IO(qd_tcp_connection_t *conn)
 }
 
 
+//
+// Track the number of read buffers held by the raw connection in the router-wide granted-read-buffers gauge and in the
+// core connection's memory accounting
+//
+static void set_read_grant_outstanding_XSIDE_IO(qd_tcp_connection_t *conn, size_t outstanding)
+{
+    ASSERT_RAW_IO;
+
+    if (outstanding > conn->read_grant.outstanding) {
+        qd_granted_read_buffers_inc(outstanding - conn->read_grant.outstanding);
+    } else if (outstanding < conn->read_grant.outstanding) {
+        qd_granted_read_buffers_dec(conn->read_grant.outstanding - outstanding);
+    }
+    if (!!conn->core_conn) {
+        qdr_connection_raw_buffers_held(conn->core_conn, (int) outstanding - (int) conn->read_grant.outstanding);
+    }
+    conn->read_grant.outstanding = outstanding;
+}
+
+
+//
+// Take the filled read buffers back from the raw connection, keeping the granted-read-buffers gauge current
+//
+static size_t take_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, pn_raw_buffer_t *buffers, size_t num)
+{
+    ASSERT_RAW_IO;
+
+    size_t count = pn_raw_connection_take_read_buffers(conn->raw_conn, buffers, num);
+    if (count > 0) {
+        const size_t taken = MIN(count, conn->read_grant.outstanding);
+        conn->read_grant.consumed += taken;
+        set_read_grant_outstanding_XSIDE_IO(conn, conn->read_grant.outstanding - taken);
+    }
+    return count;
+}
+
+
 static void grant_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, const size_t capacity)
 {
     ASSERT_RAW_IO;
@@ -703,12 +981,16 @@ static void grant_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, const size_t
 
     //
     // Define the allocation tiers.  The tier values are the number of read buffers to be granted
-    // to raw connections based on the percentage of usage of the router-wide buffer ceiling.
+    // to raw connections based on the router-wide memory pressure level.
     //
-#define TIER_1 8  // [0% .. 50%)
-#define TIER_2 4  // [50% .. 75%)
-#define TIER_3 2  // [75% .. 85%)
-#define TIER_4 1  // [85% .. 100%]
+#define READ_GRANT_IDLE 1  // grant for a connection that has not read recently
+#define READ_GRANT_DECAY_USEC 100000  // the grant limit halves for each such period without a grant
+    static const size_t tiers[] = {
+        [QD_MEMORY_PRESSURE_NORMAL]   = 8,  // [0% .. 50%)
+        [QD_MEMORY_PRESSURE_ELEVATED] = 4,  // [50% .. 75%)
+        [QD_MEMORY_PRESSURE_HIGH]     = 2,  // [75% .. 85%)
+        [QD_MEMORY_PRESSURE_CRITICAL] = 1,  // [85% .. 100%]
+    };
 
     //
     // Since we can't query Proton for the maximum read-buffer capacity, we will infer it from
@@ -722,25 +1004,9 @@ static void grant_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, const size_t
     }
 
     //
-    // Get the "held_by_threads" stats for router buffers as an approximation of how many
-    // buffers are in-use.  This is an approximation since it also counts free buffers held
-    // in the per-thread free-pools.  Since we will be dealing with large numbers here, the
-    // number of buffers in free-pools will not be significant.
-    //
-    qd_alloc_stats_t  stats          = alloc_stats_qd_buffer_t();
-    uint64_t          buffers_in_use = stats.held_by_threads;
-
-    //
-    // Choose the grant-allocation tier based on the number of buffers in use.
+    // Choose the grant-allocation tier based on the memory governor's pressure level.
     //
-    size_t desired = TIER_4;
-    if (buffers_in_use < buffer_threshold_50) {
-        desired = TIER_1;
-    } else if (buffers_in_use < buffer_threshold_75) {
-        desired = TIER_2;
-    } else if (buffers_in_use < buffer_threshold_85) {
-        desired = TIER_3;
-    }
+    size_t desired = tiers[qd_memory_pressure()];
 
     //
     // Determine how many buffers are already granted.  This will always be a non-negative value.
@@ -749,10 +1015,40 @@ static void grant_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, const size_t
     assert(current_mc >= capacity);
     size_t already_granted = current_mc - capacity;
 
+    //
+    // Scale the per-connection grant with recent read volume so that idle connections do not pin a full tier of
+    // buffers.  A connection starts with a single buffer.  Each time reads consumed all of its granted buffers the
+    // limit doubles up to the tier; when they used at most a quarter of the limit it halves.  The limit also halves
+    // for every READ_GRANT_DECAY_USEC since the last grant, so a connection that bursts and then goes quiet does not
+    // top its grant up to the burst level when it reads again.  Buffers already held by the raw connection cannot be
+    // taken back, they are released as reads consume them.
+    //
+    const uint64_t now      = qd_platform_monotonic_usec();
+    const size_t   consumed = conn->read_grant.consumed
+                              + (conn->read_grant.outstanding > already_granted ? conn->read_grant.outstanding - already_granted : 0);
+    conn->read_grant.consumed = 0;
+    if (conn->read_grant.limit == 0) {
+        conn->read_grant.limit = READ_GRANT_IDLE;
+    } else {
+        for (uint64_t idle = now - conn->read_grant.last_grant;
+             idle >= READ_GRANT_DECAY_USEC && conn->read_grant.limit > READ_GRANT_IDLE;
+             idle -= READ_GRANT_DECAY_USEC) {
+            conn->read_grant.limit /= 2;
+        }
+        if (consumed > 0 && already_granted == 0 && consumed >= conn->read_grant.limit) {
+            conn->read_grant.limit = MIN(conn->read_grant.limit * 2, tiers[QD_MEMORY_PRESSURE_NORMAL]);
+        } else if (consumed > 0 && consumed * 4 <= conn->read_grant.limit) {
+            conn->read_grant.limit = MAX(conn->read_grant.limit / 2, READ_GRANT_IDLE);
+        }
+    }
+    conn->read_grant.last_grant = now;
+    desired = MIN(desired, conn->read_grant.limit);
+
     //
     // If we desire to grant additional buffers, calculate the number to grant now.
     //
     const size_t granted = desired > already_granted ? desired - already_granted : 0;
+    set_read_grant_outstanding_XSIDE_IO(conn, already_granted + granted);
 
     if (granted > 0) {
         //
@@ -789,7 +1085,7 @@ static uint64_t produce_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, qd_mess
         pn_raw_buffer_t  raw_buffers[RAW_BUFFER_BATCH_SIZE];
         size_t           count;
 
-        count = pn_raw_connection_take_read_buffers(conn->raw_conn, raw_buffers, RAW_BUFFER_BATCH_SIZE);
+        count = take_read_buffers_XSIDE_IO(conn, raw_buffers, RAW_BUFFER_BATCH_SIZE);
         while (count > 0) {
             for (size_t i = 0; i < count; i++) {
                 qd_buffer_t *buf = (qd_buffer_t*) raw_buffers[i].context;
@@ -804,7 +1100,7 @@ static uint64_t produce_read_buffers_XSIDE_IO(qd_tcp_connection_t *conn, qd_mess
                     qd_buffer_free(buf);
                 }
             }
-            count = pn_raw_connection_take_read_buffers(conn->raw_conn, raw_buffers, RAW_BUFFER_BATCH_SIZE);
+            count = take_read_buffers_XSIDE_IO(conn, raw_buffers, RAW_BUFFER_BATCH_SIZE);
         }
 
         // ISSUE-1446: it is only safe to check pn_raw_connection_is_read_closed() after all read buffers are drained since
@@ -839,6 +1135,9 @@ static uint64_t consume_write_buffers_XSIDE_IO(qd_tcp_connection_t *conn, qd_mes
                 if (conn->listener_side && !!conn->observer_handle) {
                     qdpo_data(conn->observer_handle, false, qd_buffer_base(buf), qd_buffer_size(buf));
                 }
+                if (!!conn->http1.decoder) {
+                    qd_http1_decoder_connection_rx_data(conn->http1.decoder, !conn->listener_side, qd_buffer_base(buf), qd_buffer_size(buf));
+                }
                 raw_buffers[i].context  = (uintptr_t) buf;
                 raw_buffers[i].bytes    = (char*) qd_buffer_base(buf);
                 raw_buffers[i].capacity = qd_buffer_capacity(buf);
@@ -919,6 +1218,9 @@ static uint64_t consume_message_body_XSIDE_IO(qd_tcp_connection_t *conn, qd_mess
         if (observe) {
             qdpo_data(conn->observer_handle, false, bytes, size);
         }
+        if (!!conn->http1.decoder) {
+            qd_http1_decoder_connection_rx_data(conn->http1.decoder, !conn->listener_side, bytes, size);
+        }
         pn_raw_buffer_t raw_buffer;
         raw_buffer.context  = 0;
         raw_buffer.bytes    = (char*) bytes;
@@ -940,6 +1242,86 @@ static uint64_t consume_message_body_XSIDE_IO(qd_tcp_connection_t *conn, qd_mess
 }
 
 
+//
+// Apply the listener's acceptRate before starting the TLS handshake and core setup of a new connection.  Returns true if
+// the setup may start now.  Otherwise the connection waits on the listener's setup_queue until on_setup_TIMER_IO wakes
+// it with a token.  Connections are admitted in the order they were accepted.
+//
+static bool admit_setup_LSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    qd_tcp_listener_t *li = (qd_tcp_listener_t*) conn->common.parent;
+    if (li->adaptor_config->accept_rate == 0)
+        return true;
+
+    bool     admitted  = false;
+    bool     queued    = false;
+    uint64_t wait_usec = 0;
+
+    sys_mutex_lock(&li->lock);
+    if (conn->setup.released) {
+        admitted = true;
+    } else if (!conn->setup.queued) {
+        if (DEQ_IS_EMPTY(li->setup_queue)
+            && qd_token_bucket_take(&li->accept_bucket, qd_platform_monotonic_usec(), &wait_usec)) {
+            admitted = true;
+        } else {
+            if (DEQ_IS_EMPTY(li->setup_queue))
+                qd_timer_schedule(li->setup_timer, (wait_usec + 999) / 1000);
+            DEQ_INSERT_TAIL_N(SETUP, li->setup_queue, conn);
+            conn->setup.queued = true;
+            li->connections_queued++;
+            queued = true;
+        }
+    }
+    sys_mutex_unlock(&li->lock);
+
+    if (queued)
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] LSIDE_IO connection setup queued: acceptRate exceeded",
+               conn->conn_id);
+    return admitted;
+}
+
+
+//
+// Stop counting the connections that have been in setup for longer than SETUP_TIMEOUT_USEC against maxPendingSetup, so
+// that clients stalled in their TLS handshake cannot lock out new clients. Connections waiting on the setup_queue are
+// not expired: they are admitted at the acceptRate. This walks all the listener's connections, so it is only run when
+// a client is about to be rejected and at most ten times per SETUP_TIMEOUT_USEC. The caller must hold the listener lock.
+//
+static void expire_setup_LH(qd_tcp_listener_t *listener, uint64_t now)
+{
+    if (now - listener->setup_expired_usec < SETUP_TIMEOUT_USEC / 10)
+        return;
+    listener->setup_expired_usec = now;
+
+    for (qd_tcp_connection_t *conn = DEQ_HEAD(listener->connections); !!conn; conn = DEQ_NEXT(conn)) {
+        if (conn->setup.pending && !conn->setup.queued && now - conn->setup.start_usec >= SETUP_TIMEOUT_USEC) {
+            conn->setup.pending = false;
+            listener->setup_pending--;
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] LSIDE connection setup timed out: slot released",
+                   conn->conn_id);
+        }
+    }
+}
+
+
+//
+// The core has completed the setup of the connection's links: it no longer counts against maxPendingSetup.
+//
+static void end_setup_LSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    qd_tcp_listener_t *li = (qd_tcp_listener_t*) conn->common.parent;
+    sys_mutex_lock(&li->lock);
+    if (conn->setup.pending) {
+        conn->setup.pending = false;
+        li->setup_pending--;
+    }
+    sys_mutex_unlock(&li->lock);
+}
+
+
 static void link_setup_LSIDE_IO(qd_tcp_connection_t *conn)
 {
     ASSERT_RAW_IO;
@@ -952,8 +1334,9 @@ static void link_setup_LSIDE_IO(qd_tcp_connection_t *conn)
     qdr_terminus_set_dynamic(source);
 
     qd_raw_conn_get_address_buf(conn->raw_conn, host, sizeof(host));
-    conn->core_conn = TL_open_core_connection(conn->conn_id, true, host);
+    conn->core_conn = TL_open_core_connection(conn->conn_id, true, host, li->adaptor_config->link_capacity);
     qdr_connection_set_context(conn->core_conn, conn);
+    qdr_connection_raw_buffers_held(conn->core_conn, (int) conn->read_grant.outstanding);
     conn->inbound_link = qdr_link_first_attach(conn->core_conn, QD_INCOMING, qdr_terminus(0), target, "tcp.lside.in", 0, false, 0, &conn->inbound_link_id);
     qdr_link_set_context(conn->inbound_link, conn);
     conn->outbound_link = qdr_link_first_attach(conn->core_conn, QD_OUTGOING, source, qdr_terminus(0), "tcp.lside.out", 0, false, 0, &conn->outbound_link_id);
@@ -968,13 +1351,20 @@ static void link_setup_CSIDE_IO(qd_tcp_connection_t *conn, qdr_delivery_t *deliv
     ASSERT_RAW_IO;
 
     assert(conn->common.parent->context_type == TL_CONNECTOR);
-    const char *host = ((qd_tcp_connector_t *) conn->common.parent)->adaptor_config->host_port;
-    conn->core_conn  = TL_open_core_connection(conn->conn_id, false, host);
+    qd_adaptor_config_t *config = ((qd_tcp_connector_t *) conn->common.parent)->adaptor_config;
+    conn->core_conn  = TL_open_core_connection(conn->conn_id, false, config->host_port, config->link_capacity);
     qdr_connection_set_context(conn->core_conn, conn);
+    qdr_connection_raw_buffers_held(conn->core_conn, (int) conn->read_grant.outstanding);
 
     // use an anonymous inbound link in order to ensure credit arrives otherwise if the client has dropped the state machine will stall waiting for credit
     conn->inbound_link = qdr_link_first_attach(conn->core_conn, QD_INCOMING, qdr_terminus(0), qdr_terminus(0), "tcp.cside.in", 0, false, 0, &conn->inbound_link_id);
     qdr_link_set_context(conn->inbound_link, conn);
+
+    // With http1 encapsulation the outbound link is attached with the first request, see start_http1_request_CSIDE_IO()
+    if (!delivery) {
+        return;
+    }
+
     conn->outbound_link = qdr_link_first_attach(conn->core_conn, QD_OUTGOING, qdr_terminus(0), qdr_terminus(0), "tcp.cside.out", 0, false, delivery, &conn->outbound_link_id);
     qdr_link_set_context(conn->outbound_link, conn);
 
@@ -1013,7 +1403,7 @@ static bool try_compose_and_send_client_stream_LSIDE_IO(qd_tcp_connection_t *con
         qd_compose_insert_null(message);                                // subject
         qd_compose_insert_string(message, conn->reply_to);              // reply-to
         vflow_serialize_identity(conn->common.vflow, message);          // correlation-id
-        qd_compose_insert_string(message, QD_CONTENT_TYPE_APP_OCTETS);  // content-type
+        qd_compose_insert_string(message, TL_content_type(li->adaptor_config));  // content-type
         //qd_compose_insert_null(message);                              // content-encoding
         //qd_compose_insert_timestamp(message, 0);                      // absolute-expiry-time
         //qd_compose_insert_timestamp(message, 0);                      // creation-time
@@ -1099,7 +1489,7 @@ static void compose_and_send_server_stream_CSIDE_IO(qd_tcp_connection_t *conn)
     qd_compose_insert_null(message);                                // subject
     qd_compose_insert_null(message);                                // reply-to
     qd_compose_insert_null(message);                                // correlation-id
-    qd_compose_insert_string(message, QD_CONTENT_TYPE_APP_OCTETS);  // content-type
+    qd_compose_insert_string(message, TL_content_type(((qd_tcp_connector_t *) conn->common.parent)->adaptor_config));  // content-type
     //qd_compose_insert_null(message);                              // content-encoding
     //qd_compose_insert_timestamp(message, 0);                      // absolute-expiry-time
     //qd_compose_insert_timestamp(message, 0);                      // creation-time
@@ -1151,9 +1541,11 @@ static void compose_and_send_server_stream_CSIDE_IO(qd_tcp_connection_t *conn)
 
 static void extract_metadata_from_stream_CSIDE(qd_tcp_connection_t *conn)
 {
-    ASSERT_TIMER_IO;
-    qd_iterator_t *rt_iter = qd_message_field_iterator(conn->outbound_stream, QD_FIELD_REPLY_TO);
-    qd_iterator_t *ci_iter = qd_message_field_iterator(conn->outbound_stream, QD_FIELD_CORRELATION_ID);
+    // No thread assertion here - TIMER_IO, or RAW_IO when a flow is started on a warm connection
+    qd_iterator_storage_t rt_storage;
+    qd_iterator_storage_t ci_storage;
+    qd_iterator_t *rt_iter = qd_message_field_iterator_init(&rt_storage, conn->outbound_stream, QD_FIELD_REPLY_TO);
+    qd_iterator_t *ci_iter = qd_message_field_iterator_init(&ci_storage, conn->outbound_stream, QD_FIELD_CORRELATION_ID);
 
     if (!!rt_iter) {
         conn->reply_to = (char*) qd_iterator_copy(rt_iter);
@@ -1184,7 +1576,8 @@ static uint64_t handle_outbound_delivery_LSIDE_IO(qd_tcp_connection_t *conn, qdr
         // newly arrived delivery: Verify the message sections up to and including the dummy BODY_AMQP_VALUE have
         // arrived and are valid.
         //
-        uint64_t dispo = validate_outbound_message(delivery);
+        qd_tcp_listener_t *li = (qd_tcp_listener_t*) conn->common.parent;
+        uint64_t dispo = validate_outbound_message(delivery, TL_content_type(li->adaptor_config));
         if (dispo != PN_RECEIVED) {
             // PN_RELEASED: since this message was delivered to this listener's unique reply-to, it cannot be
             // redelivered to another consumer. PN_RELEASED means incompatible encapsulation so this is a
@@ -1195,8 +1588,12 @@ static uint64_t handle_outbound_delivery_LSIDE_IO(qd_tcp_connection_t *conn, qdr
         }
 
         qdr_delivery_incref(delivery, "handle_outbound_delivery_LSIDE_IO");
-        conn->outbound_delivery = delivery;
-        conn->outbound_stream   = qdr_delivery_message(delivery);
+        conn->outbound_delivery      = delivery;
+        conn->outbound_stream        = qdr_delivery_message(delivery);
+        conn->outbound_body          = 0;
+        conn->outbound_body_complete = false;
+        conn->window.ack_base        = conn->outbound_octets;
+        conn->window.pending_ack     = 0;
         qdr_delivery_set_context(delivery, conn);
 
         //
@@ -1217,32 +1614,18 @@ static uint64_t handle_outbound_delivery_LSIDE_IO(qd_tcp_connection_t *conn, qdr
 
 
 /**
- * Handle the first indication of a new outbound delivery on CSIDE.  This is where the raw connection to the
- * external service is established.  This function executes in an IO thread not associated with a raw connection.
+ * Allocate a connection to the server. The caller must hold the connector lock and must start the raw connection
+ * (pn_proactor_raw_connect) after releasing it.
  *
- * @return disposition. MOVED_TO_NEW_LINK on success, 0 if more message needed, else error outcome
+ * @param connector The parent connector
+ * @param delivery The outbound delivery of the flow to run on the connection, or zero for a warm pool connection. The
+ * caller's reference to the delivery is inherited by the connection.
  */
-static uint64_t handle_first_outbound_delivery_CSIDE(qd_tcp_connector_t *connector, qdr_link_t *link, qdr_delivery_t *delivery)
+static qd_tcp_connection_t *new_connection_CSIDE_LH(qd_tcp_connector_t *connector, qdr_delivery_t *delivery)
 {
-    ASSERT_TIMER_IO;
-    assert(!qdr_delivery_get_context(delivery));
-
-    // Verify the message sections up to and including the dummy BODY_AMQP_VALUE have arrived and are valid.
-    //
-    uint64_t dispo = validate_outbound_message(delivery);
-    if (dispo != PN_RECEIVED) {
-        return dispo;
-    }
-
-    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " CSIDE new outbound delivery", DLV_ARGS(delivery));
-
-    qd_message_t         *msg = qdr_delivery_message(delivery);
     qd_tcp_connection_t *conn = new_qd_tcp_connection_t();
     ZERO(conn);
 
-    qdr_delivery_incref(delivery, "CORE_deliver_outbound CSIDE");
-    qdr_delivery_set_context(delivery, conn);
-
     conn->conn_id  = qd_server_allocate_connection_id(tcp_context->server);
     conn->common.context_type = TL_CONNECTION;
     conn->common.parent       = (qd_tcp_common_t*) connector;
@@ -1251,13 +1634,36 @@ static uint64_t handle_first_outbound_delivery_CSIDE(qd_tcp_connector_t *connect
     //
     qd_tcp_connector_incref(connector);
 
+    sys_mutex_init_named(&conn->activation_lock, "tcp.connection.activation_lock");
     sys_atomic_init(&conn->core_activation, 0);
     sys_atomic_init(&conn->raw_opened, 0);
+    conn->connect_start_usec = qd_platform_monotonic_usec();
+    conn->listener_side      = false;
+
+    conn->context.context = conn;
+    conn->context.handler = on_connection_event_CSIDE_IO;
+
+    conn->raw_conn = pn_raw_connection();
+    pn_raw_connection_set_context(conn->raw_conn, &conn->context);
+
+    DEQ_ITEM_INIT_N(IDLE, conn);
+    DEQ_INSERT_TAIL(connector->connections, conn);
+
+    if (!delivery) {
+        conn->state           = CSIDE_WARM;
+        conn->warm.spare      = true;
+        conn->warm.pooled     = true;
+        conn->warm.idle_since = conn->connect_start_usec;
+        DEQ_INSERT_TAIL_N(IDLE, connector->warm_connections, conn);
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] CSIDE opening warm connection (%zu warm)",
+               conn->conn_id, DEQ_SIZE(connector->warm_connections));
+        return conn;
+    }
 
-    conn->listener_side     = false;
+    qdr_delivery_set_context(delivery, conn);
     conn->state             = CSIDE_INITIAL;
     conn->outbound_delivery = delivery;
-    conn->outbound_stream   = msg;
+    conn->outbound_stream   = qdr_delivery_message(delivery);
 
     //
     // Get relevant data from the connection stream.  If there is base-record data in the stream,
@@ -1266,76 +1672,219 @@ static uint64_t handle_first_outbound_delivery_CSIDE(qd_tcp_connector_t *connect
     extract_metadata_from_stream_CSIDE(conn);
     //vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_WINDOW_SIZE, TCP_MAX_CAPACITY_BYTES);
 
-    conn->context.context = conn;
-    conn->context.handler = on_connection_event_CSIDE_IO;
-
-    conn->raw_conn = pn_raw_connection();
-    pn_raw_connection_set_context(conn->raw_conn, &conn->context);
-
-    sys_mutex_lock(&connector->lock);
-    DEQ_INSERT_TAIL(connector->connections, conn);
     connector->connections_opened++;
     vflow_set_uint64(connector->common.vflow, VFLOW_ATTRIBUTE_FLOW_COUNT_L4, connector->connections_opened);
     vflow_set_ref_from_record(conn->common.vflow, VFLOW_ATTRIBUTE_CONNECTOR, connector->common.vflow);
-    sys_mutex_unlock(&connector->lock);
-
-    //
-    // The raw connection establishment must be the last thing done in this function.
-    // After this call, a separate IO thread may immediately be invoked in the context
-    // of the new connection to handle raw connection events.
-    //
-    pn_proactor_raw_connect(tcp_context->proactor, conn->raw_conn, connector->adaptor_config->host_port);
-
-    return QD_DELIVERY_MOVED_TO_NEW_LINK;
+    return conn;
 }
 
 
 /**
- * Handle subsequent pushes of the outbound delivery on CSIDE.  This is where delivery completion will be 
- * detected and raw connection write-close will occur.
+ * Hand a flow to a connection of the connector's warm pool, preferring the most recently opened connection that has
+ * finished connecting. The caller must hold the connector lock.
+ *
+ * @param opened set to true if the claimed connection had finished connecting, false if it is still connecting
+ * @return the warm connection the flow was handed to, or zero if the pool is empty
  */
-static void handle_outbound_delivery_CSIDE(qd_tcp_connection_t *conn, qdr_link_t *link, qdr_delivery_t *delivery, bool settled)
+static qd_tcp_connection_t *claim_warm_connection_CSIDE_LH(qd_tcp_connector_t *connector, qdr_delivery_t *delivery,
+                                                           bool *opened)
 {
-    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] handle_outbound_delivery_CSIDE - receive_complete=%s",
-           conn->conn_id, qd_message_receive_complete(conn->outbound_stream) ? "true" : "false");
+    qd_tcp_connection_t *conn = DEQ_TAIL(connector->warm_connections);
+    while (!!conn && !IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+        conn = DEQ_PREV_N(IDLE, conn);
+    }
+    if (!conn) {
+        conn = DEQ_TAIL(connector->warm_connections);
+        if (!conn) {
+            return 0;
+        }
+    }
 
-    //
-    // It is not guaranteed that this function will be called on the proper IO thread.  Wake the raw connection for
-    // continued processing in the correct context.
-    //
+    DEQ_REMOVE_N(IDLE, connector->warm_connections, conn);
+    conn->warm.pooled = false;
+    conn->warm.spare  = false;
+    connector->connections_opened++;
+    vflow_set_uint64(connector->common.vflow, VFLOW_ATTRIBUTE_FLOW_COUNT_L4, connector->connections_opened);
+
+    // The flow is started on the connection's I/O thread, see manage_warm_CSIDE_IO()
     sys_mutex_lock(&conn->activation_lock);
-    if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+    qdr_delivery_set_context(delivery, conn);
+    conn->warm.next_flow = delivery;
+    *opened = IS_ATOMIC_FLAG_SET(&conn->raw_opened);
+    if (*opened) {
         pn_raw_connection_wake(conn->raw_conn);
     }
     sys_mutex_unlock(&conn->activation_lock);
+
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " CSIDE flow claimed warm connection [C%"PRIu64"] (%zu warm)",
+           DLV_ARGS(delivery), conn->conn_id, DEQ_SIZE(connector->warm_connections));
+    return conn;
 }
 
 
 /**
- * Manage the steady-state flow of a bi-directional connection from either-side point of view.
- *
- * @param conn Pointer to the TCP connection record
- * @return true if IO processing should be repeated due to state changes
- * @return false if IO processing should suspend until the next external event
+ * Open connections to the server until the connector's warm pool holds its target number of connections.
  */
-static bool manage_flow_XSIDE_IO(qd_tcp_connection_t *conn)
+static void warm_pool_fill_IO(qd_tcp_connector_t *connector)
 {
-    ASSERT_RAW_IO;
-    //
-    // Inbound stream (producer-side) processing
-    //
-    if (!!conn->inbound_stream && !!conn->raw_conn) {
-        //
-        // Produce available read buffers into the inbound stream
-        //
-        bool read_closed = false;
-        bool was_blocked = window_full(conn);
-        uint64_t octet_count = produce_read_buffers_XSIDE_IO(conn, conn->inbound_stream, &read_closed);
-        conn->inbound_octets += octet_count;
+    sys_mutex_lock(&connector->lock);
+    if (!connector->out_link) {
+        // connector deleted
+        sys_mutex_unlock(&connector->lock);
+        return;
+    }
+    // hold the connector: the new connections may fail and release it before the pool is filled
+    qd_tcp_connector_incref(connector);
+    sys_mutex_unlock(&connector->lock);
 
-        if (octet_count > 0) {
-            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] %cSIDE Raw read: Produced %"PRIu64" octets into stream", conn->conn_id, conn->listener_side ? 'L' : 'C', octet_count);
-            if (!was_blocked && window_full(conn) && !read_closed) {
+    qd_tcp_connection_t *conn;
+    do {
+        conn = 0;
+        sys_mutex_lock(&connector->lock);
+        if (!!connector->out_link && !IS_ATOMIC_FLAG_SET(&connector->closing)
+            && DEQ_SIZE(connector->warm_connections) < connector->warm_pool.target) {
+            conn = new_connection_CSIDE_LH(connector, 0);
+        }
+        sys_mutex_unlock(&connector->lock);
+
+        if (!!conn) {
+            pn_proactor_raw_connect(tcp_context->proactor, conn->raw_conn, connector->adaptor_config->host_port);
+        }
+    } while (!!conn);
+
+    qd_tcp_connector_decref(connector);
+}
+
+
+/**
+ * Handle the first indication of a new outbound delivery on CSIDE.  This is where the raw connection to the
+ * external service is established.  This function executes in an IO thread not associated with a raw connection.
+ *
+ * @return disposition. MOVED_TO_NEW_LINK on success, 0 if more message needed, else error outcome
+ */
+static uint64_t handle_first_outbound_delivery_CSIDE(qd_tcp_connector_t *connector, qdr_link_t *link, qdr_delivery_t *delivery)
+{
+    ASSERT_TIMER_IO;
+    assert(!qdr_delivery_get_context(delivery));
+
+    // Verify the message sections up to and including the dummy BODY_AMQP_VALUE have arrived and are valid.
+    //
+    uint64_t dispo = validate_outbound_message(delivery, QD_CONTENT_TYPE_APP_OCTETS);
+    if (dispo != PN_RECEIVED) {
+        return dispo;
+    }
+
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " CSIDE new outbound delivery", DLV_ARGS(delivery));
+
+    qdr_delivery_incref(delivery, "CORE_deliver_outbound CSIDE");
+
+    qd_tcp_connection_t *new_conn  = 0;
+    bool                 warm_pool = false;
+    bool                 claimed   = false;
+    bool                 opened    = false;
+
+    sys_mutex_lock(&connector->lock);
+    warm_pool = !!connector->warm_timer;
+    if (warm_pool) {
+        claimed = !!claim_warm_connection_CSIDE_LH(connector, delivery, &opened);
+        if (opened) {
+            connector->warm_pool.hits++;
+        } else {
+            // The pool was too small for the load, the flow waits for a server connection: keep one more warm
+            // connection
+            connector->warm_pool.misses++;
+            connector->warm_pool.target = MIN(connector->warm_pool.target + 1, connector->adaptor_config->warm_pool_max_idle);
+        }
+    }
+    if (!claimed) {
+        new_conn = new_connection_CSIDE_LH(connector, delivery);
+    }
+    sys_mutex_unlock(&connector->lock);
+
+    if (warm_pool) {
+        warm_pool_fill_IO(connector);
+    }
+
+    //
+    // The raw connection establishment must be the last thing done in this function.
+    // After this call, a separate IO thread may immediately be invoked in the context
+    // of the new connection to handle raw connection events.
+    //
+    if (!!new_conn) {
+        pn_proactor_raw_connect(tcp_context->proactor, new_conn->raw_conn, connector->adaptor_config->host_port);
+    }
+
+    return QD_DELIVERY_MOVED_TO_NEW_LINK;
+}
+
+
+/**
+ * Handle subsequent pushes of the outbound delivery on CSIDE.  This is where delivery completion will be 
+ * detected and raw connection write-close will occur.
+ */
+static void handle_outbound_delivery_CSIDE(qd_tcp_connection_t *conn, qdr_link_t *link, qdr_delivery_t *delivery, bool settled)
+{
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] handle_outbound_delivery_CSIDE - receive_complete=%s",
+           conn->conn_id, qd_message_receive_complete(conn->outbound_stream) ? "true" : "false");
+
+    //
+    // It is not guaranteed that this function will be called on the proper IO thread.  Wake the raw connection for
+    // continued processing in the correct context.
+    //
+    sys_mutex_lock(&conn->activation_lock);
+    if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+        pn_raw_connection_wake(conn->raw_conn);
+    }
+    sys_mutex_unlock(&conn->activation_lock);
+}
+
+
+/**
+ * Send a PN_RECEIVED update to the ingress adaptor once enough octets of the outbound delivery have been written out
+ * the raw connection. See Window Flow Control above.
+ */
+static void send_window_update_XSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    if (conn->window.pending_ack >= TCP_ACK_THRESHOLD_BYTES) {
+        qd_delivery_state_t *dstate = qd_delivery_state();
+        dstate->section_number = 0;
+        dstate->section_offset = conn->outbound_octets - conn->window.ack_base;
+        qdr_delivery_remote_state_updated(tcp_context->core, conn->outbound_delivery, PN_RECEIVED,
+                                          false, dstate, false);  // received, !settled, !ref_given
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG,
+               DLV_FMT " PN_RECEIVED sent with section_offset=%" PRIu64 " pending=%" PRIu64,
+               DLV_ARGS(conn->outbound_delivery), conn->outbound_octets - conn->window.ack_base, conn->window.pending_ack);
+        conn->window.pending_ack = 0;
+    }
+}
+
+
+/**
+ * Manage the steady-state flow of a bi-directional connection from either-side point of view.
+ *
+ * @param conn Pointer to the TCP connection record
+ * @return true if IO processing should be repeated due to state changes
+ * @return false if IO processing should suspend until the next external event
+ */
+static bool manage_flow_XSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    //
+    // Inbound stream (producer-side) processing
+    //
+    if (!!conn->inbound_stream && !!conn->raw_conn) {
+        //
+        // Produce available read buffers into the inbound stream
+        //
+        bool read_closed = false;
+        bool was_blocked = window_full(conn);
+        uint64_t octet_count = produce_read_buffers_XSIDE_IO(conn, conn->inbound_stream, &read_closed);
+        conn->inbound_octets += octet_count;
+
+        if (octet_count > 0) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] %cSIDE Raw read: Produced %"PRIu64" octets into stream", conn->conn_id, conn->listener_side ? 'L' : 'C', octet_count);
+            if (!was_blocked && window_full(conn) && !read_closed) {
                 uint64_t unacked = conn->inbound_octets - conn->window.last_update;
                 conn->window.closed_count += 1;
                 //vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_OCTETS_UNACKED, unacked);
@@ -1360,120 +1909,827 @@ static bool manage_flow_XSIDE_IO(qd_tcp_connection_t *conn)
             }
         }
 
-        //
-        // If the raw connection is read-closed and the last produce did not block, settle and complete
-        // the inbound stream/delivery and close out the inbound half of the connection.
-        //
+        //
+        // If the raw connection is read-closed and the last produce did not block, settle and complete
+        // the inbound stream/delivery and close out the inbound half of the connection.
+        //
+
+        if (read_closed) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG,
+                   DLV_FMT " Raw conn read-closed - close inbound delivery, cancel producer activation",
+                   DLV_ARGS(conn->inbound_delivery));
+            qd_message_set_receive_complete(conn->inbound_stream);
+            qd_message_cancel_producer_activation(conn->inbound_stream);
+            qdr_delivery_continue(tcp_context->core, conn->inbound_delivery, false);
+            qdr_delivery_set_context(conn->inbound_delivery, 0);
+            qdr_delivery_decref(tcp_context->core, conn->inbound_delivery, "FLOW_XSIDE_IO - inbound_delivery released");
+            conn->inbound_delivery = 0;
+            conn->inbound_stream   = 0;
+            return true;
+        }
+
+        //
+        // Issue read buffers when the client stream is producible and the raw connection has capacity for read buffers
+        //
+        size_t capacity = pn_raw_connection_read_buffers_capacity(conn->raw_conn);
+        if (qd_message_can_produce_buffers(conn->inbound_stream) && capacity > 0) {
+            grant_read_buffers_XSIDE_IO(conn, capacity);
+        }
+    }
+
+    //
+    // Outbound stream (consumer-side) processing
+    //
+    if (!!conn->outbound_stream && !!conn->raw_conn) {
+        //
+        // Drain completed write buffers from the raw connection
+        //
+        drain_write_buffers_XSIDE_IO(conn->raw_conn);
+
+        //
+        // If this is the beginning of an outbound stream, send any body payload that is in the
+        // normal non-cut-through buffers of the message before switching to cut-through
+        //
+        if (!conn->outbound_body_complete) {
+            uint64_t body_octets = consume_message_body_XSIDE_IO(conn, conn->outbound_stream);
+            conn->outbound_octets += body_octets;
+            conn->window.pending_ack += body_octets;
+            if (body_octets > 0) {
+                qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] %cSIDE Raw write: Consumed %"PRIu64" octets from stream (body-field)", conn->conn_id, conn->listener_side ? 'L' : 'C', body_octets);
+            }
+        }
+
+        //
+        // Consume available write buffers from the outbound stream
+        //
+        if (conn->outbound_body_complete) {
+            uint64_t octets = consume_write_buffers_XSIDE_IO(conn, conn->outbound_stream);
+            conn->outbound_octets += octets;
+            conn->window.pending_ack += octets;
+            if (octets > 0) {
+                qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] %cSIDE Raw write: Consumed %"PRIu64" octets from stream", conn->conn_id, conn->listener_side ? 'L' : 'C', octets);
+                if (conn->listener_side) {
+                    vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_OCTETS_REVERSE, conn->outbound_octets);
+                }
+            }
+        }
+
+        //
+        // Manage latency measurements
+        //
+        if (!conn->outbound_first_octet && conn->outbound_octets > 0) {
+            conn->outbound_first_octet = true;
+            if (conn->listener_side) {
+                vflow_latency_end(conn->common.vflow, VFLOW_ATTRIBUTE_LATENCY);
+            } else {
+                vflow_latency_start(conn->common.vflow);
+            }
+        }
+
+        //
+        // Check the outbound stream for completion.  If complete, write-close the raw connection.
+        // Note that this is not done if there are stream buffers yet to consume.  Wait until all of the
+        // payload has been consumed and written before write-closing the connection.
+        //
+        if (qd_message_receive_complete(conn->outbound_stream) && !qd_message_can_consume_buffers(conn->outbound_stream)) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " Rx-complete, rings empty: Write-closing the raw connection, consumer activation cancelled",
+                   DLV_ARGS(conn->outbound_delivery));
+            pn_raw_connection_write_close(conn->raw_conn);
+            qd_message_set_send_complete(conn->outbound_stream);
+            qd_message_cancel_consumer_activation(conn->outbound_stream);
+            qdr_delivery_set_context(conn->outbound_delivery, 0);
+            qdr_delivery_remote_state_updated(tcp_context->core, conn->outbound_delivery, PN_ACCEPTED, true, 0, true); // accepted, settled, ref_given
+            // do NOT decref outbound_delivery - ref count passed to qdr_delivery_remote_state_updated()!
+            conn->outbound_delivery = 0;
+            conn->outbound_stream   = 0;
+        } else {
+            //
+            // More to send. Check if enough octets have been written to open up the window
+            //
+            send_window_update_XSIDE_IO(conn);
+        }
+    }
+
+    return false;
+}
+
+//=================================================================================
+// HTTP/1.x encapsulation
+//=================================================================================
+
+//
+// Decoder callbacks. These are invoked from qd_http1_decoder_connection_rx_data() on the I/O thread of the connection.
+// The listener side decodes requests as they are read and responses as they are written, the connector side the reverse.
+//
+static int http1_rx_request(qd_http1_decoder_connection_t *hconn, const char *method, const char *target,
+                            uint32_t version_major, uint32_t version_minor, uintptr_t *request_context)
+{
+    qd_tcp_connection_t *conn = (qd_tcp_connection_t *) qd_http1_decoder_connection_get_context(hconn);
+
+    // CONNECT turns the connection into an opaque tunnel which cannot be split into requests
+    if (strcmp(method, "CONNECT") == 0) {
+        return -1;
+    }
+    if (version_major == 1 && version_minor == 0) {
+        conn->http1.close_after = true;
+    }
+    return 0;
+}
+
+
+static int http1_rx_response(qd_http1_decoder_connection_t *hconn, uintptr_t request_context, int status_code,
+                             const char *reason_phrase, uint32_t version_major, uint32_t version_minor)
+{
+    qd_tcp_connection_t *conn = (qd_tcp_connection_t *) qd_http1_decoder_connection_get_context(hconn);
+
+    // 101 Switching Protocols: the rest of the connection is no longer HTTP/1.x
+    if (status_code == 101) {
+        return -1;
+    }
+    if (version_major == 1 && version_minor == 0) {
+        conn->http1.close_after = true;
+    }
+    // 1xx responses precede the final response to the request
+    conn->http1.informational = status_code / 100 == 1;
+    return 0;
+}
+
+
+static int http1_rx_header(qd_http1_decoder_connection_t *hconn, uintptr_t request_context, bool from_client,
+                           const char *key, const char *value)
+{
+    qd_tcp_connection_t *conn = (qd_tcp_connection_t *) qd_http1_decoder_connection_get_context(hconn);
+
+    if (strcasecmp(key, "Connection") == 0 && !!value) {
+        char *copy    = strdup(value);
+        char *saveptr = 0;
+        char *token   = strtok_r(copy, " ,", &saveptr);
+        while (token) {
+            if (strcasecmp(token, "close") == 0) {
+                conn->http1.close_after = true;
+                break;
+            }
+            token = strtok_r(0, " ,", &saveptr);
+        }
+        free(copy);
+    }
+    return 0;
+}
+
+
+static int http1_message_done(qd_http1_decoder_connection_t *hconn, uintptr_t request_context, bool from_client)
+{
+    qd_tcp_connection_t *conn = (qd_tcp_connection_t *) qd_http1_decoder_connection_get_context(hconn);
+
+    if (from_client == conn->listener_side && (from_client || !conn->http1.informational)) {
+        // The message was read from the raw connection: note where it ends so the read buffer can be split
+        conn->http1.rx_split = qd_http1_decoder_connection_rx_offset(hconn);
+    }
+    if (from_client) {
+        conn->http1.request_done = true;
+    } else if (!conn->http1.informational) {
+        conn->http1.response_done = true;
+    }
+    return 0;
+}
+
+
+static int http1_transaction_complete(qd_http1_decoder_connection_t *hconn, uintptr_t request_context)
+{
+    return 0;
+}
+
+
+static void http1_protocol_error(qd_http1_decoder_connection_t *hconn, const char *reason)
+{
+    qd_tcp_connection_t *conn = (qd_tcp_connection_t *) qd_http1_decoder_connection_get_context(hconn);
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_WARNING, "[C%" PRIu64 "] HTTP/1.x encapsulation protocol error: %s", conn->conn_id, reason);
+    conn->http1.error = true;
+}
+
+
+static const qd_http1_decoder_config_t http1_decoder_config = {
+    .rx_request           = http1_rx_request,
+    .rx_response          = http1_rx_response,
+    .rx_header            = http1_rx_header,
+    .message_done         = http1_message_done,
+    .transaction_complete = http1_transaction_complete,
+    .protocol_error       = http1_protocol_error
+};
+
+
+/**
+ * Read the next HTTP/1.x message from the raw connection into the inbound stream. Reading stops at the end of the
+ * message: any octets that follow it are held in http1.rx_pending for the next exchange. The inbound stream and its
+ * delivery are created when the first octet of the message arrives.
+ *
+ * @param conn Pointer to the TCP connection record
+ * @param read_closed Set true if the raw connection is read-closed and all read buffers have been taken
+ * @return the number of octets produced into the inbound stream
+ */
+static uint64_t produce_http1_message_XSIDE_IO(qd_tcp_connection_t *conn, bool *read_closed)
+{
+    ASSERT_RAW_IO;
+    const bool      *message_done = conn->listener_side ? &conn->http1.request_done : &conn->http1.response_done;
+    qd_buffer_list_t input        = DEQ_EMPTY;
+    qd_buffer_list_t qd_buffers   = DEQ_EMPTY;
+    uint64_t         octet_count  = 0;
+
+    *read_closed = false;
+    if (*message_done || (!!conn->inbound_stream && !qd_message_can_produce_buffers(conn->inbound_stream))) {
+        return 0;
+    }
+
+    DEQ_MOVE(conn->http1.rx_pending, input);
+
+    pn_raw_buffer_t raw_buffers[RAW_BUFFER_BATCH_SIZE];
+    size_t          count;
+    while ((count = take_read_buffers_XSIDE_IO(conn, raw_buffers, RAW_BUFFER_BATCH_SIZE))) {
+        for (size_t i = 0; i < count; i++) {
+            qd_buffer_t *buf = (qd_buffer_t*) raw_buffers[i].context;
+            qd_buffer_insert(buf, raw_buffers[i].size);
+            if (qd_buffer_size(buf) > 0) {
+                DEQ_INSERT_TAIL(input, buf);
+            } else {
+                qd_buffer_free(buf);
+            }
+        }
+    }
+
+    // ISSUE-1446: only check for read-closed after all read buffers are drained
+    *read_closed = pn_raw_connection_is_read_closed(conn->raw_conn);
+
+    qd_buffer_t *buf = DEQ_HEAD(input);
+    while (!!buf && !*message_done && !conn->http1.error) {
+        DEQ_REMOVE_HEAD(input);
+        conn->http1.rx_split = qd_buffer_size(buf);
+        qd_http1_decoder_connection_rx_data(conn->http1.decoder, conn->listener_side, qd_buffer_base(buf), qd_buffer_size(buf));
+
+        if (*message_done && conn->http1.rx_split < qd_buffer_size(buf)) {
+            // The next message starts within this buffer. Move its octets to a buffer of their own.
+            const size_t tail_size = qd_buffer_size(buf) - conn->http1.rx_split;
+            qd_buffer_t *tail      = qd_buffer();
+            memcpy(qd_buffer_base(tail), qd_buffer_base(buf) + conn->http1.rx_split, tail_size);
+            qd_buffer_insert(tail, tail_size);
+            buf->size = conn->http1.rx_split;
+            DEQ_INSERT_HEAD(input, tail);
+        }
+
+        octet_count += qd_buffer_size(buf);
+        if (conn->listener_side && !!conn->observer_handle) {
+            qdpo_data(conn->observer_handle, true, qd_buffer_base(buf), qd_buffer_size(buf));
+        }
+        DEQ_INSERT_TAIL(qd_buffers, buf);
+        buf = DEQ_HEAD(input);
+    }
+    DEQ_APPEND(conn->http1.rx_pending, input);
+
+    if (conn->http1.error) {
+        qd_buffer_list_free_buffers(&qd_buffers);
+        return 0;
+    }
+
+    if (!DEQ_IS_EMPTY(qd_buffers)) {
+        if (!conn->inbound_stream) {
+            //
+            // First octets of a new message: start a fresh window for the new delivery
+            //
+            conn->window.base        = conn->inbound_octets;
+            conn->window.last_update = conn->inbound_octets;
+            conn->window.disabled    = false;
+            if (conn->listener_side) {
+                try_compose_and_send_client_stream_LSIDE_IO(conn);
+            } else {
+                compose_and_send_server_stream_CSIDE_IO(conn);
+            }
+        }
+        qd_message_produce_buffers(conn->inbound_stream, &qd_buffers);
+    }
+
+    return octet_count;
+}
+
+
+/**
+ * Complete the inbound stream of the current exchange. The inbound delivery is kept on the listener side so that a
+ * failure to deliver the request can be reported to the client.
+ */
+static void complete_http1_inbound_stream_XSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    if (!!conn->inbound_stream) {
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " HTTP/1.x message complete - close inbound delivery, cancel producer activation",
+               DLV_ARGS(conn->inbound_delivery));
+        qd_message_set_receive_complete(conn->inbound_stream);
+        qd_message_cancel_producer_activation(conn->inbound_stream);
+        qdr_delivery_continue(tcp_context->core, conn->inbound_delivery, false);
+        conn->inbound_stream = 0;
+        if (!conn->listener_side) {
+            qdr_delivery_set_context(conn->inbound_delivery, 0);
+            qdr_delivery_decref(tcp_context->core, conn->inbound_delivery, "complete_http1_inbound_stream_XSIDE_IO - inbound_delivery released");
+            conn->inbound_delivery = 0;
+        }
+    }
+}
+
+
+/**
+ * Write the outbound stream of the current exchange out the raw connection.
+ *
+ * @return true when the entire outbound message has been written
+ */
+static bool write_http1_message_XSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    drain_write_buffers_XSIDE_IO(conn->raw_conn);
+
+    uint64_t octets = 0;
+    if (!conn->outbound_body_complete) {
+        octets += consume_message_body_XSIDE_IO(conn, conn->outbound_stream);
+    }
+    if (conn->outbound_body_complete) {
+        octets += consume_write_buffers_XSIDE_IO(conn, conn->outbound_stream);
+    }
+
+    conn->outbound_octets    += octets;
+    conn->window.pending_ack += octets;
+    if (octets > 0) {
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] %cSIDE Raw write: Consumed %"PRIu64" octets from HTTP/1.x message", conn->conn_id, conn->listener_side ? 'L' : 'C', octets);
+        if (conn->listener_side) {
+            vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_OCTETS_REVERSE, conn->outbound_octets);
+        }
+    }
+
+    if (qd_message_receive_complete(conn->outbound_stream) && !qd_message_can_consume_buffers(conn->outbound_stream)) {
+        qd_message_set_send_complete(conn->outbound_stream);
+        qd_message_cancel_consumer_activation(conn->outbound_stream);
+        return true;
+    }
+
+    send_window_update_XSIDE_IO(conn);
+    return false;
+}
+
+
+/**
+ * The exchange is over and the connection will not be reused: write-close it and wait for the peer to close its end.
+ */
+static void write_close_http1_XSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] HTTP/1.x connection not reusable: write-closing the raw connection", conn->conn_id);
+    conn->http1.write_closed = true;
+    conn->window.disabled    = true;
+    pn_raw_connection_write_close(conn->raw_conn);
+}
+
+
+/**
+ * Manage the request/response exchanges of an http1 encapsulated client connection.
+ *
+ * @return true if IO processing should be repeated due to state changes
+ */
+static bool manage_http1_flow_LSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+
+    if (conn->http1.write_closed) {
+        // Discard anything the client sends while waiting for it to close the connection
+        drain_write_buffers_XSIDE_IO(conn->raw_conn);
+        drain_read_buffers_XSIDE_IO(conn->raw_conn);
+        if (!pn_raw_connection_is_read_closed(conn->raw_conn)) {
+            grant_read_buffers_XSIDE_IO(conn, pn_raw_connection_read_buffers_capacity(conn->raw_conn));
+        }
+        return false;
+    }
+
+    //
+    // Request: read from the client until the end of the request message. No further data is read from the client
+    // until the response has been written (no pipelining).
+    //
+    if (!conn->http1.request_done && !conn->http1.failed) {
+        bool     read_closed = false;
+        uint64_t octets      = produce_http1_message_XSIDE_IO(conn, &read_closed);
+        conn->inbound_octets += octets;
+        if (octets > 0) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] LSIDE Raw read: Produced %"PRIu64" octets into HTTP/1.x request", conn->conn_id, octets);
+            vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_OCTETS, conn->inbound_octets);
+        }
+
+        if (conn->http1.error) {
+            close_raw_connection(conn, "http1-protocol-error", "Cannot encapsulate HTTP/1.x request");
+            set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+            return false;
+        }
+
+        if (conn->http1.request_done) {
+            complete_http1_inbound_stream_XSIDE_IO(conn);
+        } else if (read_closed) {
+            if (!conn->inbound_stream && !conn->outbound_stream) {
+                // Client closed the connection between requests
+                write_close_http1_XSIDE_IO(conn);
+            } else {
+                close_raw_connection(conn, "http1-truncated", "Client closed during request");
+                set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+            }
+            return false;
+        } else if (!conn->inbound_stream || qd_message_can_produce_buffers(conn->inbound_stream)) {
+            size_t capacity = pn_raw_connection_read_buffers_capacity(conn->raw_conn);
+            if (capacity > 0) {
+                grant_read_buffers_XSIDE_IO(conn, capacity);
+            }
+        }
+    }
+
+    //
+    // Response: the request could not be delivered. If no response has been started, answer the client directly.
+    //
+    if (conn->http1.failed && !conn->outbound_stream) {
+        static const char response[] = HTTP1_SERVICE_UNAVAILABLE;
+        qd_buffer_t *buf = qd_buffer();
+        memcpy(qd_buffer_base(buf), response, sizeof(response) - 1);
+        qd_buffer_insert(buf, sizeof(response) - 1);
+
+        pn_raw_buffer_t raw_buffer;
+        raw_buffer.context  = (uintptr_t) buf;
+        raw_buffer.bytes    = (char*) qd_buffer_base(buf);
+        raw_buffer.capacity = qd_buffer_capacity(buf);
+        raw_buffer.size     = qd_buffer_size(buf);
+        raw_buffer.offset   = 0;
+        if (pn_raw_connection_write_buffers(conn->raw_conn, &raw_buffer, 1) != 1) {
+            qd_buffer_free(buf);
+        }
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] HTTP/1.x request not delivered, responded 503", conn->conn_id);
+        conn->http1.outbound_done = true;
+    }
+
+    //
+    // Response: write the response from the server
+    //
+    if (!!conn->outbound_stream) {
+        if (write_http1_message_XSIDE_IO(conn)) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " HTTP/1.x response written, consumer activation cancelled",
+                   DLV_ARGS(conn->outbound_delivery));
+            qdr_delivery_set_context(conn->outbound_delivery, 0);
+            qdr_delivery_remote_state_updated(tcp_context->core, conn->outbound_delivery, PN_ACCEPTED, true, 0, true); // accepted, settled, ref_given
+            // do NOT decref outbound_delivery - ref count passed to qdr_delivery_remote_state_updated()!
+            conn->outbound_delivery   = 0;
+            conn->outbound_stream     = 0;
+            conn->http1.outbound_done = true;
+        }
+    }
+
+    //
+    // Exchange complete: release the request and prepare for the next one, or close the connection
+    //
+    if (conn->http1.outbound_done) {
+        const bool keep_alive = conn->http1.request_done && conn->http1.response_done
+            && !conn->http1.close_after && !conn->http1.failed && !conn->http1.error;
+
+        complete_http1_inbound_stream_XSIDE_IO(conn);
+        if (!!conn->inbound_delivery) {
+            qdr_delivery_set_context(conn->inbound_delivery, 0);
+            qdr_delivery_decref(tcp_context->core, conn->inbound_delivery, "manage_http1_flow_LSIDE_IO - request released");
+            conn->inbound_delivery = 0;
+        }
+
+        qd_tcp_listener_t *listener = (qd_tcp_listener_t*) conn->common.parent;
+        if (!!listener) {
+            sys_mutex_lock(&listener->lock);
+            listener->requests++;
+            sys_mutex_unlock(&listener->lock);
+        }
+        conn->http1.exchanges++;
+
+        if (!keep_alive) {
+            write_close_http1_XSIDE_IO(conn);
+            return false;
+        }
+
+        conn->http1.request_done  = false;
+        conn->http1.response_done = false;
+        conn->http1.outbound_done = false;
+        conn->window.last_update  = conn->inbound_octets;  // request released, no acks outstanding
+        qdr_link_flow(tcp_context->core, conn->outbound_link, 1, false);  // credit for the next response
+        return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * Start the request handed to this server connection. The outbound link is attached with the first request and kept
+ * for the life of the connection, later requests are moved onto it.
+ */
+static void start_http1_request_CSIDE_IO(qd_tcp_connection_t *conn, qdr_delivery_t *delivery)
+{
+    ASSERT_RAW_IO;
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " CSIDE starting HTTP/1.x request", DLV_ARGS(delivery));
+
+    // the reference taken in handle_http1_request_CSIDE() is inherited here
+    conn->outbound_delivery      = delivery;
+    conn->outbound_stream        = qdr_delivery_message(delivery);
+    conn->outbound_body          = 0;
+    conn->outbound_body_complete = false;
+    conn->window.ack_base        = conn->outbound_octets;
+    conn->window.pending_ack     = 0;
+
+    free(conn->reply_to);
+    conn->reply_to = 0;
+    qd_iterator_storage_t rt_storage;
+    qd_iterator_t *rt_iter = qd_message_field_iterator_init(&rt_storage, conn->outbound_stream, QD_FIELD_REPLY_TO);
+    if (!!rt_iter) {
+        conn->reply_to = (char*) qd_iterator_copy(rt_iter);
+        qd_iterator_free(rt_iter);
+    }
+
+    if (!conn->outbound_link) {
+        conn->outbound_link = qdr_link_first_attach(conn->core_conn, QD_OUTGOING, qdr_terminus(0), qdr_terminus(0), "tcp.cside.out", 0, false, delivery, &conn->outbound_link_id);
+        qdr_link_set_context(conn->outbound_link, conn);
+    } else {
+        qdr_link_move_delivery(conn->outbound_link, delivery);
+    }
+
+    qd_message_activation_t activation;
+    activation.type     = QD_ACTIVATION_TCP;
+    activation.delivery = 0;
+    qd_alloc_set_safe_ptr(&activation.safeptr, conn);
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " TCP enabling consumer activation", DLV_ARGS(delivery));
+    qd_message_set_consumer_activation(conn->outbound_stream, &activation);
+    qd_message_start_unicast_cutthrough(conn->outbound_stream);
+}
+
+
+/**
+ * Manage the request/response exchanges of a pooled server connection.
+ *
+ * @return true if IO processing should be repeated due to state changes
+ */
+static bool manage_http1_flow_CSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+
+    //
+    // Pick up the next request if this connection is free
+    //
+    if (!conn->outbound_delivery) {
+        sys_mutex_lock(&conn->activation_lock);
+        qdr_delivery_t *request  = conn->http1.next_request;
+        conn->http1.next_request = 0;
+        sys_mutex_unlock(&conn->activation_lock);
+
+        if (!!request) {
+            start_http1_request_CSIDE_IO(conn, request);
+        }
+    }
+
+    if (!conn->outbound_delivery) {
+        //
+        // Idle: the server is not expected to send anything. Keep a read buffer granted to learn when it closes the
+        // connection.
+        //
+        pn_raw_buffer_t raw_buffers[RAW_BUFFER_BATCH_SIZE];
+        bool unsolicited = false;
+        size_t count;
+        while ((count = take_read_buffers_XSIDE_IO(conn, raw_buffers, RAW_BUFFER_BATCH_SIZE))) {
+            for (size_t i = 0; i < count; i++) {
+                unsolicited = unsolicited || raw_buffers[i].size > 0;
+                qd_buffer_free((qd_buffer_t*) raw_buffers[i].context);
+            }
+        }
+        if (unsolicited || !DEQ_IS_EMPTY(conn->http1.rx_pending) || pn_raw_connection_is_read_closed(conn->raw_conn)) {
+            close_raw_connection(conn, 0, 0);
+            set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+        } else if (pn_raw_connection_read_buffers_capacity(conn->raw_conn) > 0) {
+            grant_read_buffers_XSIDE_IO(conn, pn_raw_connection_read_buffers_capacity(conn->raw_conn));
+        }
+        return false;
+    }
+
+    //
+    // Request: write the request to the server
+    //
+    if (!conn->http1.outbound_done) {
+        if (write_http1_message_XSIDE_IO(conn)) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " HTTP/1.x request written, consumer activation cancelled",
+                   DLV_ARGS(conn->outbound_delivery));
+            conn->http1.outbound_done = true;
+        }
+    }
+
+    //
+    // Response: read the response from the server until the end of the response message
+    //
+    if (!conn->http1.response_done) {
+        bool     read_closed = false;
+        uint64_t octets      = produce_http1_message_XSIDE_IO(conn, &read_closed);
+        conn->inbound_octets += octets;
+        if (octets > 0) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] CSIDE Raw read: Produced %"PRIu64" octets into HTTP/1.x response", conn->conn_id, octets);
+        }
+
+        if (conn->http1.error) {
+            close_raw_connection(conn, "http1-protocol-error", "Cannot encapsulate HTTP/1.x response");
+            set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+            return false;
+        }
+
+        if (conn->http1.response_done) {
+            if (!DEQ_IS_EMPTY(conn->http1.rx_pending)) {
+                // data following the response cannot belong to any request: do not reuse the connection
+                conn->http1.close_after = true;
+            }
+            complete_http1_inbound_stream_XSIDE_IO(conn);
+        } else if (read_closed) {
+            if (!conn->inbound_stream) {
+                // closed without a response: the outbound delivery is failed by the connection cleanup
+                close_raw_connection(conn, 0, 0);
+                set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+                return false;
+            }
+            // response body delimited by the connection close
+            complete_http1_inbound_stream_XSIDE_IO(conn);
+            conn->http1.response_done = true;
+            conn->http1.close_after   = true;
+        } else if (!conn->inbound_stream || qd_message_can_produce_buffers(conn->inbound_stream)) {
+            size_t capacity = pn_raw_connection_read_buffers_capacity(conn->raw_conn);
+            if (capacity > 0) {
+                grant_read_buffers_XSIDE_IO(conn, capacity);
+            }
+        }
+    }
+
+    //
+    // Exchange complete: settle the request and return the connection to the pool
+    //
+    if (conn->http1.outbound_done && conn->http1.response_done) {
+        qdr_delivery_set_context(conn->outbound_delivery, 0);
+        qdr_delivery_remote_state_updated(tcp_context->core, conn->outbound_delivery, PN_ACCEPTED, true, 0, true); // accepted, settled, ref_given
+        // do NOT decref outbound_delivery - ref count passed to qdr_delivery_remote_state_updated()!
+        conn->outbound_delivery = 0;
+        conn->outbound_stream   = 0;
+
+        conn->http1.exchanges++;
+        conn->http1.request_done  = false;
+        conn->http1.response_done = false;
+        conn->http1.outbound_done = false;
+        conn->window.last_update  = conn->inbound_octets;  // response released, no acks outstanding
+
+        qd_tcp_connector_t *connector = (qd_tcp_connector_t*) conn->common.parent;
+        qdr_delivery_t     *request   = 0;
+        assert(connector);
+        sys_mutex_lock(&connector->lock);
+        connector->requests++;
+        if (!conn->http1.close_after && !IS_ATOMIC_FLAG_SET(&connector->closing)) {
+            qd_tcp_pending_request_t *pending = DEQ_HEAD(connector->pending_requests);
+            if (!!pending) {
+                DEQ_REMOVE_HEAD(connector->pending_requests);
+                request = pending->delivery;
+                free_qd_tcp_pending_request_t(pending);
+            } else {
+                DEQ_INSERT_TAIL_N(IDLE, connector->idle_connections, conn);
+                conn->http1.idle = true;
+            }
+        }
+        sys_mutex_unlock(&connector->lock);
+
+        if (conn->http1.close_after) {
+            close_raw_connection(conn, 0, 0);
+            set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+            return false;
+        }
+
+        if (!!request) {
+            sys_mutex_lock(&conn->activation_lock);
+            qdr_delivery_set_context(request, conn);
+            conn->http1.next_request = request;
+            sys_mutex_unlock(&conn->activation_lock);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * Allocate a connection to the server for the http1 encapsulation pool. The caller must hold the connector lock and
+ * must start the raw connection (pn_proactor_raw_connect) after releasing it.
+ *
+ * @param connector The parent connector
+ * @param request Optional request delivery to be run on the new connection
+ */
+static qd_tcp_connection_t *new_http1_connection_CSIDE_LH(qd_tcp_connector_t *connector, qdr_delivery_t *request)
+{
+    qd_tcp_connection_t *conn = new_qd_tcp_connection_t();
+    ZERO(conn);
+
+    conn->conn_id             = qd_server_allocate_connection_id(tcp_context->server);
+    conn->common.context_type = TL_CONNECTION;
+    conn->common.parent       = (qd_tcp_common_t*) connector;
+    //
+    // Call connector incref when a connection references a connector via conn->common.parent
+    //
+    qd_tcp_connector_incref(connector);
+
+    sys_mutex_init_named(&conn->activation_lock, "tcp.connection.activation_lock");
+    sys_atomic_init(&conn->core_activation, 0);
+    sys_atomic_init(&conn->raw_opened, 0);
+    conn->connect_start_usec = qd_platform_monotonic_usec();
+
+    conn->listener_side      = false;
+    conn->state              = CSIDE_INITIAL;
+    conn->http1.decoder      = qd_http1_decoder_connection(&http1_decoder_config, (uintptr_t) conn);
+    conn->http1.next_request = request;
+    if (!!request) {
+        qdr_delivery_set_context(request, conn);
+    }
+
+    conn->context.context = conn;
+    conn->context.handler = on_connection_event_CSIDE_IO;
+
+    conn->raw_conn = pn_raw_connection();
+    pn_raw_connection_set_context(conn->raw_conn, &conn->context);
+
+    DEQ_ITEM_INIT_N(IDLE, conn);
+    DEQ_INSERT_TAIL(connector->connections, conn);
+    connector->connections_opened++;
+    vflow_set_uint64(connector->common.vflow, VFLOW_ATTRIBUTE_FLOW_COUNT_L4, connector->connections_opened);
+
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] CSIDE opening pooled HTTP/1.x connection (%zu open)",
+           conn->conn_id, DEQ_SIZE(connector->connections));
+    return conn;
+}
+
 
-        if (read_closed) {
-            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG,
-                   DLV_FMT " Raw conn read-closed - close inbound delivery, cancel producer activation",
-                   DLV_ARGS(conn->inbound_delivery));
-            qd_message_set_receive_complete(conn->inbound_stream);
-            qd_message_cancel_producer_activation(conn->inbound_stream);
-            qdr_delivery_continue(tcp_context->core, conn->inbound_delivery, false);
-            qdr_delivery_set_context(conn->inbound_delivery, 0);
-            qdr_delivery_decref(tcp_context->core, conn->inbound_delivery, "FLOW_XSIDE_IO - inbound_delivery released");
-            conn->inbound_delivery = 0;
-            conn->inbound_stream   = 0;
-            return true;
-        }
+/**
+ * Handle a new request delivery arriving at an http1 encapsulated connector. The request is run on an idle pooled
+ * connection if there is one, otherwise on a new connection if the pool is not full, otherwise it waits for a
+ * connection to become free.  This function executes in an IO thread not associated with a raw connection.
+ *
+ * @return disposition. MOVED_TO_NEW_LINK on success, 0 if more message needed, else error outcome
+ */
+static uint64_t handle_http1_request_CSIDE(qd_tcp_connector_t *connector, qdr_link_t *link, qdr_delivery_t *delivery)
+{
+    ASSERT_TIMER_IO;
+    assert(!qdr_delivery_get_context(delivery));
 
-        //
-        // Issue read buffers when the client stream is producible and the raw connection has capacity for read buffers
-        //
-        size_t capacity = pn_raw_connection_read_buffers_capacity(conn->raw_conn);
-        if (qd_message_can_produce_buffers(conn->inbound_stream) && capacity > 0) {
-            grant_read_buffers_XSIDE_IO(conn, capacity);
-        }
+    uint64_t dispo = validate_outbound_message(delivery, QD_CONTENT_TYPE_APP_HTTP1);
+    if (dispo != PN_RECEIVED) {
+        return dispo;
     }
 
-    //
-    // Outbound stream (consumer-side) processing
-    //
-    if (!!conn->outbound_stream && !!conn->raw_conn) {
-        //
-        // Drain completed write buffers from the raw connection
-        //
-        drain_write_buffers_XSIDE_IO(conn->raw_conn);
+    qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " CSIDE new HTTP/1.x request", DLV_ARGS(delivery));
+    qdr_delivery_incref(delivery, "CORE_deliver_outbound CSIDE HTTP/1.x");
 
-        //
-        // If this is the beginning of an outbound stream, send any body payload that is in the
-        // normal non-cut-through buffers of the message before switching to cut-through
-        //
-        if (!conn->outbound_body_complete) {
-            uint64_t body_octets = consume_message_body_XSIDE_IO(conn, conn->outbound_stream);
-            conn->outbound_octets += body_octets;
-            conn->window.pending_ack += body_octets;
-            if (body_octets > 0) {
-                qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] %cSIDE Raw write: Consumed %"PRIu64" octets from stream (body-field)", conn->conn_id, conn->listener_side ? 'L' : 'C', body_octets);
-            }
-        }
+    qd_tcp_connection_t *new_conn = 0;
+    bool                 assigned = false;
 
-        //
-        // Consume available write buffers from the outbound stream
-        //
-        if (conn->outbound_body_complete) {
-            uint64_t octets = consume_write_buffers_XSIDE_IO(conn, conn->outbound_stream);
-            conn->outbound_octets += octets;
-            conn->window.pending_ack += octets;
-            if (octets > 0) {
-                qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] %cSIDE Raw write: Consumed %"PRIu64" octets from stream", conn->conn_id, conn->listener_side ? 'L' : 'C', octets);
-                if (conn->listener_side) {
-                    vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_OCTETS_REVERSE, conn->outbound_octets);
-                }
-            }
-        }
+    sys_mutex_lock(&connector->lock);
+    while (!assigned && !!DEQ_HEAD(connector->idle_connections)) {
+        qd_tcp_connection_t *conn = DEQ_HEAD(connector->idle_connections);
+        DEQ_REMOVE_HEAD_N(IDLE, connector->idle_connections);
+        conn->http1.idle = false;
 
-        //
-        // Manage latency measurements
-        //
-        if (!conn->outbound_first_octet && conn->outbound_octets > 0) {
-            conn->outbound_first_octet = true;
-            if (conn->listener_side) {
-                vflow_latency_end(conn->common.vflow, VFLOW_ATTRIBUTE_LATENCY);
-            } else {
-                vflow_latency_start(conn->common.vflow);
-            }
+        // skip connections that are closing, they will be cleaned up on their own I/O thread
+        sys_mutex_lock(&conn->activation_lock);
+        if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+            assert(!conn->http1.next_request);
+            qdr_delivery_set_context(delivery, conn);
+            conn->http1.next_request = delivery;
+            pn_raw_connection_wake(conn->raw_conn);
+            assigned = true;
         }
+        sys_mutex_unlock(&conn->activation_lock);
+    }
 
-        //
-        // Check the outbound stream for completion.  If complete, write-close the raw connection.
-        // Note that this is not done if there are stream buffers yet to consume.  Wait until all of the
-        // payload has been consumed and written before write-closing the connection.
-        //
-        if (qd_message_receive_complete(conn->outbound_stream) && !qd_message_can_consume_buffers(conn->outbound_stream)) {
-            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " Rx-complete, rings empty: Write-closing the raw connection, consumer activation cancelled",
-                   DLV_ARGS(conn->outbound_delivery));
-            pn_raw_connection_write_close(conn->raw_conn);
-            qd_message_set_send_complete(conn->outbound_stream);
-            qd_message_cancel_consumer_activation(conn->outbound_stream);
-            qdr_delivery_set_context(conn->outbound_delivery, 0);
-            qdr_delivery_remote_state_updated(tcp_context->core, conn->outbound_delivery, PN_ACCEPTED, true, 0, true); // accepted, settled, ref_given
-            // do NOT decref outbound_delivery - ref count passed to qdr_delivery_remote_state_updated()!
-            conn->outbound_delivery = 0;
-            conn->outbound_stream   = 0;
+    if (!assigned) {
+        if (DEQ_SIZE(connector->connections) < connector->adaptor_config->max_pooled_connections) {
+            new_conn = new_http1_connection_CSIDE_LH(connector, delivery);
         } else {
-            //
-            // More to send. Check if enough octets have been written to open up the window
-            //
-            if (conn->window.pending_ack >= TCP_ACK_THRESHOLD_BYTES) {
-                qd_delivery_state_t *dstate = qd_delivery_state();
-                dstate->section_number = 0;
-                dstate->section_offset = conn->outbound_octets;
-                qdr_delivery_remote_state_updated(tcp_context->core, conn->outbound_delivery, PN_RECEIVED,
-                                                  false, dstate, false);  // received, !settled, !ref_given
-                qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG,
-                       DLV_FMT " PN_RECEIVED sent with section_offset=%" PRIu64 " pending=%" PRIu64,
-                       DLV_ARGS(conn->outbound_delivery), conn->outbound_octets, conn->window.pending_ack);
-                conn->window.pending_ack = 0;
-            }
+            qd_tcp_pending_request_t *pending = new_qd_tcp_pending_request_t();
+            ZERO(pending);
+            DEQ_ITEM_INIT(pending);
+            pending->delivery = delivery;
+            DEQ_INSERT_TAIL(connector->pending_requests, pending);
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " CSIDE connection pool full, request queued (%zu pending)",
+                   DLV_ARGS(delivery), DEQ_SIZE(connector->pending_requests));
         }
     }
+    sys_mutex_unlock(&connector->lock);
 
-    return false;
+    //
+    // The raw connection establishment must be the last thing done in this function.
+    //
+    if (!!new_conn) {
+        pn_proactor_raw_connect(tcp_context->proactor, new_conn->raw_conn, connector->adaptor_config->host_port);
+    }
+
+    return QD_DELIVERY_MOVED_TO_NEW_LINK;
 }
 
+
 // Callback from TLS layer to get up to limit qd_buffer_t from the outgoing message for encryption and transmit out raw
 // connection.
 //
@@ -1680,7 +2936,7 @@ static void connection_run_LSIDE_IO(qd_tcp_connection_t *conn)
 
         switch (conn->state) {
         case LSIDE_INITIAL:
-            if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) { // raw connection is active
+            if (IS_ATOMIC_FLAG_SET(&conn->raw_opened) && admit_setup_LSIDE_IO(conn)) { // raw connection is active
                 qd_tcp_listener_t *li = (qd_tcp_listener_t *) conn->common.parent;
                 if (li->tls_config) {
                     if (setup_tls_session(conn, li->tls_config, li->adaptor_config->host,
@@ -1728,12 +2984,26 @@ static void connection_run_LSIDE_IO(qd_tcp_connection_t *conn)
             break;
 
         case LSIDE_LINK_SETUP:
+            //
+            // With http1 encapsulation a stream is sent per request rather than per connection. Once the reply-to
+            // address is available begin reading requests from the client.
+            //
+            if (!!conn->http1.decoder) {
+                if (!!conn->reply_to) {
+                    end_setup_LSIDE_IO(conn);
+                    set_state_XSIDE_IO(conn, LSIDE_HTTP1_FLOW);
+                    repeat = true;
+                }
+                break;
+            }
+
             //
             // If we have a reply-to address, compose the stream message, convert it to a
             // unicast/cut-through stream and send it.
             // Set the state to LSIDE_STREAM_START and wait for the connector side to respond.
             //
             if (try_compose_and_send_client_stream_LSIDE_IO(conn)) {
+                end_setup_LSIDE_IO(conn);
                 set_state_XSIDE_IO(conn, LSIDE_STREAM_START);
                 repeat = true;
             }
@@ -1764,6 +3034,13 @@ static void connection_run_LSIDE_IO(qd_tcp_connection_t *conn)
             repeat = manage_tls_flow_XSIDE_IO(conn);
             break;
 
+        case LSIDE_HTTP1_FLOW:
+            //
+            // Manage the request/response exchanges of the connection.
+            //
+            repeat = manage_http1_flow_LSIDE_IO(conn);
+            break;
+
         case XSIDE_CLOSING:
             //
             // Don't do anything
@@ -1790,6 +3067,95 @@ static void connection_run_LSIDE_IO(qd_tcp_connection_t *conn)
 }
 
 
+/**
+ * Run a connection of the connector's warm pool: start the flow handed to it by claim_warm_connection_CSIDE_LH(),
+ * close it once it has been evicted from the pool, otherwise keep it ready.
+ *
+ * @return true if IO processing should be repeated due to state changes
+ */
+static bool manage_warm_CSIDE_IO(qd_tcp_connection_t *conn)
+{
+    ASSERT_RAW_IO;
+    qd_tcp_connector_t *connector = (qd_tcp_connector_t *) conn->common.parent;
+
+    if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+        //
+        // Hold any octets the server sends on connect for the flow. Read buffers are not granted again once it has
+        // sent some so a chatty server cannot make the pool buffer without limit.
+        //
+        pn_raw_buffer_t raw_buffers[RAW_BUFFER_BATCH_SIZE];
+        size_t          count;
+        while ((count = take_read_buffers_XSIDE_IO(conn, raw_buffers, RAW_BUFFER_BATCH_SIZE))) {
+            for (size_t i = 0; i < count; i++) {
+                qd_buffer_t *buf = (qd_buffer_t*) raw_buffers[i].context;
+                qd_buffer_insert(buf, raw_buffers[i].size);
+                if (qd_buffer_size(buf) > 0) {
+                    DEQ_INSERT_TAIL(conn->warm.rx_pending, buf);
+                } else {
+                    qd_buffer_free(buf);
+                }
+            }
+        }
+
+        // A TLS server does not speak first: octets before the handshake mean the connection is unusable
+        const bool unusable = !!connector->tls_config && !DEQ_IS_EMPTY(conn->warm.rx_pending);
+        if (unusable || pn_raw_connection_is_read_closed(conn->raw_conn)) {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "[C%"PRIu64"] CSIDE warm connection %s by the server", conn->conn_id,
+                   unusable ? "written to" : "closed");
+            sys_mutex_lock(&connector->lock);
+            if (conn->warm.pooled) {
+                DEQ_REMOVE_N(IDLE, connector->warm_connections, conn);
+                conn->warm.pooled = false;
+            }
+            sys_mutex_unlock(&connector->lock);
+            // a flow already handed to the connection is connected anew, see close_connection_XSIDE_IO()
+            close_raw_connection(conn, 0, 0);
+            set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+            return false;
+        }
+    }
+
+    sys_mutex_lock(&connector->lock);
+    const bool evicted = !conn->warm.pooled;
+    sys_mutex_lock(&conn->activation_lock);
+    qdr_delivery_t *flow = conn->warm.next_flow;
+    conn->warm.next_flow = 0;
+    sys_mutex_unlock(&conn->activation_lock);
+    sys_mutex_unlock(&connector->lock);
+
+    if (!!flow) {
+        // the reference taken in handle_first_outbound_delivery_CSIDE() is inherited here
+        conn->outbound_delivery = flow;
+        conn->outbound_stream   = qdr_delivery_message(flow);
+        extract_metadata_from_stream_CSIDE(conn);
+
+        sys_mutex_lock(&connector->lock);
+        vflow_set_ref_from_record(conn->common.vflow, VFLOW_ATTRIBUTE_CONNECTOR, connector->common.vflow);
+        sys_mutex_unlock(&connector->lock);
+        if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+            // the vflow record did not exist yet when the connection was established
+            qd_set_vflow_netaddr_string(conn->common.vflow, conn->raw_conn, conn->listener_side);
+        }
+
+        set_state_XSIDE_IO(conn, CSIDE_INITIAL);
+        return true;
+    }
+
+    if (evicted) {
+        close_raw_connection(conn, 0, 0);
+        set_state_XSIDE_IO(conn, XSIDE_CLOSING);  // prevent further connection I/O
+        return false;
+    }
+
+    if (IS_ATOMIC_FLAG_SET(&conn->raw_opened) && connector->adaptor_config->warm_pool_liveness
+        && DEQ_IS_EMPTY(conn->warm.rx_pending) && conn->read_grant.outstanding == 0) {
+        // the read buffer lets the raw connection notice the server closing the idle connection
+        grant_read_buffers_XSIDE_IO(conn, pn_raw_connection_read_buffers_capacity(conn->raw_conn));
+    }
+    return false;
+}
+
+
 static void connection_run_CSIDE_IO(qd_tcp_connection_t *conn)
 {
     ASSERT_RAW_IO;
@@ -1800,6 +3166,13 @@ static void connection_run_CSIDE_IO(qd_tcp_connection_t *conn)
         repeat = false;
 
         switch (conn->state) {
+        case CSIDE_WARM:
+            //
+            // Wait in the connector's warm pool for a flow.
+            //
+            repeat = manage_warm_CSIDE_IO(conn);
+            break;
+
         case CSIDE_INITIAL:
             if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) { // raw connection is active
                 qd_tcp_connector_t *connector = (qd_tcp_connector_t *) conn->common.parent;
@@ -1818,7 +3191,7 @@ static void connection_run_CSIDE_IO(qd_tcp_connection_t *conn)
                         break;
                     }
                 }
-                link_setup_CSIDE_IO(conn, conn->outbound_delivery);
+                link_setup_CSIDE_IO(conn, conn->outbound_delivery);  // no outbound_delivery with http1 encapsulation
                 set_state_XSIDE_IO(conn, CSIDE_LINK_SETUP);
             }
             break;
@@ -1826,8 +3199,17 @@ static void connection_run_CSIDE_IO(qd_tcp_connection_t *conn)
         case CSIDE_LINK_SETUP:
             credit = conn->inbound_credit;
 
-            if (credit) {
+            if (credit && !!conn->http1.decoder) {
+                // response streams are sent as responses arrive
+                set_state_XSIDE_IO(conn, CSIDE_HTTP1_FLOW);
+                repeat = true;
+            } else if (credit) {
                 compose_and_send_server_stream_CSIDE_IO(conn);
+                if (!DEQ_IS_EMPTY(conn->warm.rx_pending) && qd_message_can_produce_buffers(conn->inbound_stream)) {
+                    // octets the server sent while the connection was in the warm pool
+                    conn->inbound_octets += qd_buffer_list_length(&conn->warm.rx_pending);
+                    qd_message_produce_buffers(conn->inbound_stream, &conn->warm.rx_pending);
+                }
                 set_state_XSIDE_IO(conn, (conn->tls_session) ? CSIDE_TLS_FLOW : CSIDE_FLOW);
                 repeat = true;
             }
@@ -1847,6 +3229,13 @@ static void connection_run_CSIDE_IO(qd_tcp_connection_t *conn)
             repeat = manage_tls_flow_XSIDE_IO(conn);
             break;
 
+        case CSIDE_HTTP1_FLOW:
+            //
+            // Manage the request/response exchanges of the pooled connection.
+            //
+            repeat = manage_http1_flow_CSIDE_IO(conn);
+            break;
+
         case XSIDE_CLOSING:
             //
             // Don't do anything
@@ -1887,13 +3276,14 @@ static void connection_run_XSIDE_IO(qd_tcp_connection_t *conn)
 // proper encapsulation.
 //
 // @param out_dlv Outgoing delivery holding the message
+// @param content_type The content-type identifying the encapsulation expected by this adaptor
 // @return a disposition value indicating the validity of the message:
 // 0: message headers incomplete, wait for more data to arrive
 // PN_REJECTED: corrupt headers, cannot be re-delivered
 // PN_RELEASED: headers ok, incompatible body format: deliver elsewhere
 // PN_RECEIVED: headers & body ok
 //
-static uint64_t validate_outbound_message(const qdr_delivery_t *out_dlv)
+static uint64_t validate_outbound_message(const qdr_delivery_t *out_dlv, const char *content_type)
 {
     qd_message_t *msg = qdr_delivery_message(out_dlv);
     qd_message_depth_status_t depth_ok = qd_message_check_depth(msg, QD_DEPTH_RAW_BODY);
@@ -1911,9 +3301,10 @@ static uint64_t validate_outbound_message(const qdr_delivery_t *out_dlv)
     // ISSUE-1136: ensure the message body is using the proper encapsulation.
     //
     bool encaps_ok = false;
-    qd_iterator_t *encaps = qd_message_field_iterator(msg, QD_FIELD_CONTENT_TYPE);
+    qd_iterator_storage_t encaps_storage;
+    qd_iterator_t *encaps = qd_message_field_iterator_init(&encaps_storage, msg, QD_FIELD_CONTENT_TYPE);
     if (encaps) {
-        encaps_ok = qd_iterator_equal(encaps, (unsigned char *) QD_CONTENT_TYPE_APP_OCTETS);
+        encaps_ok = qd_iterator_equal(encaps, (unsigned char *) content_type);
         qd_iterator_free(encaps);
     }
     if (!encaps_ok) {
@@ -1952,13 +3343,14 @@ static void on_tls_connection_secured(qd_tls_session_t *tls_session, void *user_
 //
 static char *get_tls_negotiated_alpn(qd_message_t *msg)
 {
-    qd_iterator_t *ap_iter = qd_message_field_iterator(msg, QD_FIELD_APPLICATION_PROPERTIES);
+    qd_iterator_storage_t ap_storage;
+    qd_iterator_t *ap_iter = qd_message_field_iterator_init(&ap_storage, msg, QD_FIELD_APPLICATION_PROPERTIES);
     if (!ap_iter) {
         return 0;
     }
 
     char *alpn_protocol = 0;
-    qd_parsed_field_t *ap = qd_parse(ap_iter);
+    qd_parsed_field_t *ap = qd_parse_lazy(ap_iter);
     if (ap && qd_parse_ok(ap) && qd_parse_is_map(ap)) {
         uint32_t count = qd_parse_sub_count(ap);
         for (uint32_t i = 0; i < count; i++) {
@@ -2035,6 +3427,48 @@ static void on_connection_event_LSIDE_IO(pn_event_t *e, qd_server_t *qd_server,
 }
 
 
+//
+// Adaptive link capacity: the capacity of the connector's out-link determines how many connection streams the
+// balanced forwarder will route to this connector before preferring other destinations.  Use the outcome of each
+// backend connect as a measure of the backend's health: back off multiplicatively when connects fail, additively
+// when connect latency rises well above the best observed, and grow back towards the configured capacity otherwise.
+//
+static void adapt_link_capacity_IO(qd_tcp_connector_t *connector, bool failed, uint64_t latency_usec)
+{
+    qd_adaptor_config_t *config = connector->adaptor_config;
+    if (!config->adaptive_link_capacity) {
+        return;
+    }
+
+    sys_mutex_lock(&connector->lock);
+    int capacity = connector->link_capacity.current;
+    if (failed) {
+        capacity = MAX(capacity / 2, 1);
+    } else {
+        uint64_t average = connector->link_capacity.latency_usec;
+        average = average == 0 ? latency_usec : (average * 7 + latency_usec) / 8;
+        connector->link_capacity.latency_usec = average;
+        if (connector->link_capacity.baseline_usec == 0 || average < connector->link_capacity.baseline_usec) {
+            connector->link_capacity.baseline_usec = average;
+        }
+        if (average > 2 * connector->link_capacity.baseline_usec) {
+            capacity = MAX(capacity - 1, 1);
+        } else {
+            capacity = MIN(capacity + 1, config->link_capacity);
+        }
+    }
+
+    if (capacity != connector->link_capacity.current && !!connector->out_link) {
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, "Connector %s: link capacity %d -> %d (connect %s, average latency %"PRIu64" usec)",
+               config->name, connector->link_capacity.current, capacity, failed ? "failed" : "succeeded",
+               connector->link_capacity.latency_usec);
+        connector->link_capacity.current = capacity;
+        qdr_link_set_capacity(tcp_context->core, connector->out_link, capacity);
+    }
+    sys_mutex_unlock(&connector->lock);
+}
+
+
 static void on_connection_event_CSIDE_IO(pn_event_t *e, qd_server_t *qd_server, void *context)
 {
     SET_THREAD_RAW_IO;
@@ -2047,7 +3481,14 @@ static void on_connection_event_CSIDE_IO(pn_event_t *e, qd_server_t *qd_server,
         qd_set_vflow_netaddr_string(conn->common.vflow, conn->raw_conn, conn->listener_side);
         assert(!IS_ATOMIC_FLAG_SET(&conn->raw_opened));
         SET_ATOMIC_FLAG(&conn->raw_opened);
+        if (!!conn->common.parent && conn->common.parent->context_type == TL_CONNECTOR) {
+            adapt_link_capacity_IO((qd_tcp_connector_t*) conn->common.parent, false,
+                                   qd_platform_monotonic_usec() - conn->connect_start_usec);
+        }
     } else if (etype == PN_RAW_CONNECTION_DISCONNECTED) {
+        if (!IS_ATOMIC_FLAG_SET(&conn->raw_opened) && !!conn->common.parent && conn->common.parent->context_type == TL_CONNECTOR) {
+            adapt_link_capacity_IO((qd_tcp_connector_t*) conn->common.parent, true, 0);
+        }
         conn->error = !!conn->raw_conn ? pn_raw_connection_condition(conn->raw_conn) : 0;
         vflow_set_pn_condition_string(conn->common.vflow, VFLOW_ATTRIBUTE_ERROR_CONNECTOR_SIDE, conn->error);
         close_connection_XSIDE_IO(conn);
@@ -2065,6 +3506,29 @@ static void on_connection_event_CSIDE_IO(pn_event_t *e, qd_server_t *qd_server,
 static void on_accept(qd_adaptor_listener_t *adaptor_listener, pn_listener_t *pn_listener, void *context)
 {
     qd_tcp_listener_t *listener      = (qd_tcp_listener_t*) context;
+
+    //
+    // During a connection storm refuse new clients rather than queue unbounded setup work for the core.
+    //
+    const int max_pending = listener->adaptor_config->max_pending_setup;
+    if (max_pending > 0) {
+        sys_mutex_lock(&listener->lock);
+        if (listener->setup_pending >= (uint64_t) max_pending)
+            expire_setup_LH(listener, qd_platform_monotonic_usec());
+        const uint64_t pending = listener->setup_pending;
+        const bool     reject  = pending >= (uint64_t) max_pending;
+        if (reject)
+            listener->connections_rejected++;
+        sys_mutex_unlock(&listener->lock);
+        if (reject) {
+            qd_adaptor_listener_deny_conn(adaptor_listener, pn_listener);
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG,
+                   "Listener %s: denied new incoming client connection: %"PRIu64" connections in setup (maxPendingSetup)",
+                   listener->adaptor_config->name, pending);
+            return;
+        }
+    }
+
     qd_tcp_connection_t *conn  = new_qd_tcp_connection_t();
 
     ZERO(conn);
@@ -2076,12 +3540,15 @@ static void on_accept(qd_adaptor_listener_t *adaptor_listener, pn_listener_t *pn
     //
     qd_tcp_listener_incref(listener);
 
-    sys_mutex_init(&conn->activation_lock);
+    sys_mutex_init_named(&conn->activation_lock, "tcp.connection.activation_lock");
     sys_atomic_init(&conn->core_activation, 0);
     sys_atomic_init(&conn->raw_opened, 0);
 
     conn->listener_side = true;
     conn->state         = LSIDE_INITIAL;
+    if (listener->adaptor_config->encapsulation == QD_ENCAPSULATION_HTTP1) {
+        conn->http1.decoder = qd_http1_decoder_connection(&http1_decoder_config, (uintptr_t) conn);
+    }
 
     conn->common.vflow = vflow_start_record(VFLOW_RECORD_BIFLOW_TPORT, listener->common.vflow);
     vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_OCTETS, 0);
@@ -2102,6 +3569,9 @@ static void on_accept(qd_adaptor_listener_t *adaptor_listener, pn_listener_t *pn
         conn->observer_handle = qdpo_begin(listener->protocol_observer, conn->common.vflow, conn, conn->conn_id);
     }
     DEQ_INSERT_TAIL(listener->connections, conn);
+    conn->setup.pending    = true;
+    conn->setup.start_usec = qd_platform_monotonic_usec();
+    listener->setup_pending++;
     listener->connections_opened++;
     vflow_set_uint64(listener->common.vflow, VFLOW_ATTRIBUTE_FLOW_COUNT_L4, listener->connections_opened);
     sys_mutex_unlock(&listener->lock);
@@ -2238,7 +3708,11 @@ static uint64_t CORE_deliver_outbound(void *context, qdr_link_t *link, qdr_deliv
     }
 
     if (common->context_type == TL_CONNECTOR) {
-        return handle_first_outbound_delivery_CSIDE((qd_tcp_connector_t*) common, link, delivery);
+        qd_tcp_connector_t *connector = (qd_tcp_connector_t*) common;
+        if (connector->adaptor_config->encapsulation == QD_ENCAPSULATION_HTTP1) {
+            return handle_http1_request_CSIDE(connector, link, delivery);
+        }
+        return handle_first_outbound_delivery_CSIDE(connector, link, delivery);
     } else if (common->context_type == TL_CONNECTION) {
         qd_tcp_connection_t *conn = (qd_tcp_connection_t*) common;
         if (conn->listener_side) {
@@ -2275,7 +3749,16 @@ static void CORE_delivery_update(void *context, qdr_delivery_t *dlv, uint64_t di
             qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG, DLV_FMT " Inbound delivery update - disposition: %s", DLV_ARGS(dlv), pn_disposition_type_name(disp));
             conn->inbound_disposition = disp;
             const bool final_outcome = qd_delivery_state_is_terminal(disp);
-            if (final_outcome && disp != PN_ACCEPTED) {
+            if (final_outcome && disp != PN_ACCEPTED && conn->listener_side && !!conn->http1.decoder) {
+                // The request could not be delivered. Let the I/O thread answer the client.
+                conn->http1.failed    = true;
+                conn->window.disabled = true;
+                sys_mutex_lock(&conn->activation_lock);
+                if (IS_ATOMIC_FLAG_SET(&conn->raw_opened)) {
+                    pn_raw_connection_wake(conn->raw_conn);
+                }
+                sys_mutex_unlock(&conn->activation_lock);
+            } else if (final_outcome && disp != PN_ACCEPTED) {
                 // The delivery failed - this is unrecoverable.
                 if (!!conn->raw_conn) {
                     close_raw_connection(conn, "delivery-failed", "destination unreachable");
@@ -2295,16 +3778,19 @@ static void CORE_delivery_update(void *context, qdr_delivery_t *dlv, uint64_t di
 
                     // Resend released will generate a PN_RECEIVED with section_offset == 0, ignore it.  Ensure updates
                     // arrive in order, which may not happen if cut-through for disposition updates is implemented.
+                    // The section_offset counts the octets of this delivery only, window.base accounts for the octets
+                    // of any earlier deliveries on this connection (http1 encapsulation).
+                    const uint64_t acked = dstate ? conn->window.base + dstate->section_offset : 0;
                     if (dstate && dstate->section_offset > 0
-                        && (int64_t)(dstate->section_offset - conn->window.last_update) > 0) {
+                        && (int64_t)(acked - conn->window.last_update) > 0) {
 
                         qd_log(LOG_TCP_ADAPTOR, QD_LOG_DEBUG,
                                DLV_FMT " PN_RECEIVED inbound_bytes=%" PRIu64 ", was_unacked=%" PRIu64 ", rcv_offset=%" PRIu64 " now_unacked=%" PRIu64,
                                DLV_ARGS(dlv), conn->inbound_octets,
                                (conn->inbound_octets - conn->window.last_update),
                                dstate->section_offset,
-                               (conn->inbound_octets - dstate->section_offset));
-                        conn->window.last_update = dstate->section_offset;
+                               (conn->inbound_octets - acked));
+                        conn->window.last_update = acked;
                         //vflow_set_uint64(conn->common.vflow, VFLOW_ATTRIBUTE_OCTETS_UNACKED, conn->inbound_octets - dstate->section_offset);
 
                         qd_delivery_state_free(dstate);
@@ -2378,6 +3864,14 @@ QD_EXPORT void *qd_dispatch_configure_tcp_listener(qd_dispatch_t *qd, qd_entity_
         return 0;
     }
 
+    if (listener->adaptor_config->encapsulation == QD_ENCAPSULATION_HTTP1 && listener->adaptor_config->ssl_profile_name) {
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_ERROR, "tcpListener %s: http1 encapsulation cannot be used with sslProfile",
+               listener->adaptor_config->name);
+        qd_free_adaptor_config(listener->adaptor_config);
+        free_qd_tcp_listener_t(listener);
+        return 0;
+    }
+
     if (listener->adaptor_config->ssl_profile_name) {
         // On the TCP TLS listener side, send "http/1.1", "http/1.0" and "h2" as ALPN protocols
         listener->tls_config = qd_tls_config(listener->adaptor_config->ssl_profile_name,
@@ -2401,6 +3895,10 @@ QD_EXPORT void *qd_dispatch_configure_tcp_listener(qd_dispatch_t *qd, qd_entity_
     listener->common.context_type = TL_LISTENER;
     sys_mutex_init(&listener->lock);
     sys_atomic_init(&listener->closing, 0);
+    qd_token_bucket_init(&listener->accept_bucket, listener->adaptor_config->accept_rate,
+                         listener->adaptor_config->accept_burst);
+    if (listener->adaptor_config->accept_rate > 0)
+        listener->setup_timer = qd_timer(tcp_context->qd, on_setup_TIMER_IO, listener);
 
     sys_mutex_lock(&tcp_context->lock);
     DEQ_INSERT_TAIL(tcp_context->listeners, listener);
@@ -2499,15 +3997,47 @@ QD_EXPORT void qd_dispatch_delete_tcp_connector(qd_dispatch_t *qd, void *impl)
         // Explicitly drop the out-link so that we notify any link event monitors and stop new deliveries from being
         // forwarded to this connector
         //
-        if (!!connector->out_link) {
-            qdr_link_set_context(connector->out_link, 0);
-            qdr_link_notify_closed(connector->out_link, true);
-            connector->out_link = 0;
+        sys_mutex_lock(&connector->lock);
+        qdr_link_t *out_link = connector->out_link;
+        connector->out_link  = 0;  // adapt_link_capacity_IO() may be running on an I/O thread
+        sys_mutex_unlock(&connector->lock);
+        if (!!out_link) {
+            qdr_link_set_context(out_link, 0);
+            qdr_link_notify_closed(out_link, true);
         }
 
         qdr_connection_notify_closed(connector->core_conn);
         connector->core_conn = 0;
         qd_connection_counter_dec(QD_PROTOCOL_TCP);
+
+        //
+        // Close the idle connections of the warm pool. The timer is freed outside the lock since its handler takes it.
+        //
+        sys_mutex_lock(&connector->lock);
+        qd_timer_t *warm_timer = connector->warm_timer;
+        connector->warm_timer  = 0;
+        while (DEQ_HEAD(connector->warm_connections)) {
+            evict_warm_connection_LH(connector, DEQ_HEAD(connector->warm_connections));
+        }
+        sys_mutex_unlock(&connector->lock);
+        qd_timer_free(warm_timer);
+
+        //
+        // Requests waiting for a pooled connection (http1 encapsulation) will not be run, release them so they may
+        // be forwarded elsewhere
+        //
+        sys_mutex_lock(&connector->lock);
+        qd_tcp_pending_request_list_t pending_requests;
+        DEQ_MOVE(connector->pending_requests, pending_requests);
+        sys_mutex_unlock(&connector->lock);
+        qd_tcp_pending_request_t *pending = DEQ_HEAD(pending_requests);
+        while (pending) {
+            DEQ_REMOVE_HEAD(pending_requests);
+            qdr_delivery_remote_state_updated(tcp_context->core, pending->delivery, PN_RELEASED, true, 0, false);
+            qdr_delivery_decref(tcp_context->core, pending->delivery, "qd_dispatch_delete_tcp_connector - pending request released");
+            free_qd_tcp_pending_request_t(pending);
+            pending = DEQ_HEAD(pending_requests);
+        }
         //
         // Initiate termination of existing connections
         //
@@ -2543,6 +4073,10 @@ QD_EXPORT qd_error_t qd_entity_refresh_tcpListener(qd_entity_t* entity, void *im
     SET_THREAD_UNKNOWN;
     uint64_t co = 0;
     uint64_t cc = 0;
+    uint64_t rq = 0;
+    uint64_t cq = 0;
+    uint64_t cj = 0;
+    uint64_t sp = 0;
     qd_listener_oper_status_t os = QD_LISTENER_OPER_DOWN;
     qd_tcp_listener_t *li = (qd_tcp_listener_t*) impl;
 
@@ -2551,6 +4085,10 @@ QD_EXPORT qd_error_t qd_entity_refresh_tcpListener(qd_entity_t* entity, void *im
         sys_mutex_lock(&li->lock);
         co = li->connections_opened;
         cc = li->connections_closed;
+        rq = li->requests;
+        cq = li->connections_queued;
+        cj = li->connections_rejected;
+        sp = li->setup_pending;
         sys_mutex_unlock(&li->lock);
     }
 
@@ -2558,9 +4096,13 @@ QD_EXPORT qd_error_t qd_entity_refresh_tcpListener(qd_entity_t* entity, void *im
         && qd_entity_set_long(entity, "bytesOut",          0) == 0
         && qd_entity_set_long(entity, "connectionsOpened", co) == 0
         && qd_entity_set_long(entity, "connectionsClosed", cc) == 0
+        && qd_entity_set_long(entity, "requests",          rq) == 0
+        && qd_entity_set_long(entity, "connectionsQueued",   cq) == 0
+        && qd_entity_set_long(entity, "connectionsRejected", cj) == 0
+        && qd_entity_set_long(entity, "connectionsPendingSetup", sp) == 0
         && qd_entity_set_string(entity, "operStatus", os == QD_LISTENER_OPER_UP ? "up" : "down") == 0)
     {
-        return QD_ERROR_NONE;
+        return qd_tls_config_refresh_handshake_stats(li->tls_config, entity);
     }
 
     return qd_error_code();
@@ -2585,6 +4127,14 @@ qd_tcp_connector_t *qd_dispatch_configure_tcp_connector(qd_dispatch_t *qd, qd_en
         return 0;
     }
 
+    if (connector->adaptor_config->encapsulation == QD_ENCAPSULATION_HTTP1 && connector->adaptor_config->ssl_profile_name) {
+        qd_log(LOG_TCP_ADAPTOR, QD_LOG_ERROR, "tcpConnector %s: http1 encapsulation cannot be used with sslProfile",
+               connector->adaptor_config->name);
+        qd_free_adaptor_config(connector->adaptor_config);
+        free_qd_tcp_connector_t(connector);
+        return 0;
+    }
+
     if (connector->adaptor_config->ssl_profile_name) {
         connector->tls_config = qd_tls_config(connector->adaptor_config->ssl_profile_name,
                                               QD_TLS_TYPE_PROTON_RAW,
@@ -2601,6 +4151,15 @@ qd_tcp_connector_t *qd_dispatch_configure_tcp_connector(qd_dispatch_t *qd, qd_en
     }
 
     connector->activate_timer = qd_timer(tcp_context->qd, on_core_activate_TIMER_IO, connector);
+    if (connector->adaptor_config->warm_pool_max_idle > 0) {
+        if (connector->adaptor_config->encapsulation == QD_ENCAPSULATION_TCP) {
+            connector->warm_pool.target = connector->adaptor_config->warm_pool_min_idle;
+            connector->warm_timer       = qd_timer(tcp_context->qd, on_warm_pool_TIMER_IO, connector);
+        } else {
+            qd_log(LOG_TCP_ADAPTOR, QD_LOG_WARNING, "tcpConnector %s: the warm pool is not used with http1 encapsulation",
+                   connector->adaptor_config->name);
+        }
+    }
     connector->common.context_type = TL_CONNECTOR;
     sys_mutex_init(&connector->lock);
     sys_atomic_init(&connector->closing, 0);
@@ -2625,14 +4184,30 @@ QD_EXPORT qd_error_t qd_entity_refresh_tcpConnector(qd_entity_t* entity, void *i
     sys_mutex_lock(&cr->lock);
     uint64_t co = cr->connections_opened;
     uint64_t cc = cr->connections_closed;
+    uint64_t rq = cr->requests;
+    uint64_t ic = DEQ_SIZE(cr->idle_connections);
+    uint64_t lc = cr->link_capacity.current;
+    uint64_t wh = cr->warm_pool.hits;
+    uint64_t wm = cr->warm_pool.misses;
+    uint64_t wi = 0;
+    for (qd_tcp_connection_t *conn = DEQ_HEAD(cr->warm_connections); !!conn; conn = DEQ_NEXT_N(IDLE, conn)) {
+        if (IS_ATOMIC_FLAG_SET(&conn->raw_opened))
+            wi++;
+    }
     sys_mutex_unlock(&cr->lock);
 
     if (   qd_entity_set_long(entity, "bytesIn",           0) == 0
         && qd_entity_set_long(entity, "bytesOut",          0) == 0
         && qd_entity_set_long(entity, "connectionsOpened", co) == 0
-        && qd_entity_set_long(entity, "connectionsClosed", cc) == 0)
+        && qd_entity_set_long(entity, "connectionsClosed", cc) == 0
+        && qd_entity_set_long(entity, "requests",          rq) == 0
+        && qd_entity_set_long(entity, "idleConnections",   ic) == 0
+        && qd_entity_set_long(entity, "currentLinkCapacity", lc) == 0
+        && qd_entity_set_long(entity, "warmPoolHits",      wh) == 0
+        && qd_entity_set_long(entity, "warmPoolMisses",    wm) == 0
+        && qd_entity_set_long(entity, "warmPoolIdle",      wi) == 0)
     {
-        return QD_ERROR_NONE;
+        return qd_tls_config_refresh_handshake_stats(cr->tls_config, entity);
     }
 
     return qd_error_code();
@@ -2668,35 +4243,6 @@ static void ADAPTOR_init(qdr_core_t *core, void **adaptor_context)
                                                    CORE_connection_trace);
     sys_mutex_init(&tcp_context->lock);
     tcp_context->proactor = qd_server_proactor(tcp_context->server);
-
-    //
-    // Determine the configured buffer memory ceiling.
-    //
-    char     *ceiling_string = getenv("SKUPPER_ROUTER_MEMORY_CEILING");
-    uint64_t  memory_ceiling = (uint64_t) qd_platform_memory_size();
-
-    //
-    // Use 4Gig as a default if the platform fails to return a valid size
-    //
-    if (memory_ceiling == 0) {
-        memory_ceiling = (uint64_t) 4 * (uint64_t) 1024 * (uint64_t) 1024 * (uint64_t) 1024;
-    }
-
-    if (!!ceiling_string) {
-        long long convert = atoll(ceiling_string);
-        if (convert > 0) {
-            memory_ceiling = (uint64_t) convert;
-        }
-    }
-
-    buffer_ceiling = MAX(memory_ceiling / QD_BUFFER_SIZE, 100);
-    buffer_threshold_50 = buffer_ceiling / 2;
-    buffer_threshold_75 = (buffer_ceiling / 20) * 15;
-    buffer_threshold_85 = (buffer_ceiling / 20) * 17;
-
-    const char *mc_unit;
-    double mc_normalized = normalize_memory_size(memory_ceiling, &mc_unit);
-    qd_log(LOG_TCP_ADAPTOR, QD_LOG_INFO, "Router buffer memory ceiling: %.2f %s (%"PRIu64" buffers)", mc_normalized, mc_unit, buffer_ceiling);
 }
 
 
@@ -2727,6 +4273,7 @@ static void ADAPTOR_final(void *adaptor_context)
         // free the connector. Then we call qd_tcp_connector_free() to forcefully free the connector without checking the connector->ref_count
         //
         qd_tcp_connector_incref(connector);
+        connector->out_link = 0;  // no warm or replacement connections while shutting down
 
         qd_tcp_connection_t *conn = DEQ_HEAD(connector->connections);
         while (conn) {
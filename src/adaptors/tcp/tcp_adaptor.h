@@ -23,6 +23,7 @@
 #include "delivery.h"
 #include "adaptors/adaptor_common.h"
 #include "adaptors/adaptor_listener.h"
+#include "decoders/http1/http1_decoder.h"
 #include <qpid/dispatch/protocol_observer.h>
 
 
@@ -32,14 +33,17 @@ typedef struct qd_tcp_connector_t  qd_tcp_connector_t;
 typedef struct qd_tcp_connection_t qd_tcp_connection_t;
 typedef struct qd_tls_config_t     qd_tls_config_t;
 typedef struct qd_tls_session_t    qd_tls_session_t;
+typedef struct qd_tcp_pending_request_t qd_tcp_pending_request_t;
 
 ALLOC_DECLARE(qd_tcp_listener_t);
 ALLOC_DECLARE(qd_tcp_connector_t);
 ALLOC_DECLARE_SAFE(qd_tcp_connection_t);
+ALLOC_DECLARE(qd_tcp_pending_request_t);
 
 DEQ_DECLARE(qd_tcp_listener_t,   qd_tcp_listener_list_t);
 DEQ_DECLARE(qd_tcp_connector_t,  qd_tcp_connector_list_t);
 DEQ_DECLARE(qd_tcp_connection_t, qd_tcp_connection_list_t);
+DEQ_DECLARE(qd_tcp_pending_request_t, qd_tcp_pending_request_list_t);
 
 #define QDR_TCP_CONNECTION_COLUMN_COUNT 10
 extern const char *qdr_tcp_connection_columns[QDR_TCP_CONNECTION_COLUMN_COUNT + 1];
@@ -67,11 +71,28 @@ struct qd_tcp_listener_t {
     qdpo_t                    *protocol_observer;
     uint64_t                   connections_opened;
     uint64_t                   connections_closed;
+    uint64_t                   requests;  // http1 encapsulation: completed request/response exchanges
+    qd_token_bucket_t          accept_bucket;        // acceptRate limit on starting connection setup
+    qd_tcp_connection_list_t   setup_queue;          // accepted conns waiting for an accept_bucket token
+    qd_timer_t                *setup_timer;          // releases setup_queue as tokens become available
+    uint64_t                   setup_pending;        // accepted conns that have not completed setup
+    uint64_t                   setup_expired_usec;   // when expire_setup_LH() last ran
+    uint64_t                   connections_queued;   // conns that waited in setup_queue
+    uint64_t                   connections_rejected; // conns refused because of maxPendingSetup
     sys_atomic_t               ref_count;
     sys_atomic_t               closing;
 };
 
 
+//
+// A request delivery waiting for a pooled server connection (http1 encapsulation only)
+//
+struct qd_tcp_pending_request_t {
+    DEQ_LINKS(qd_tcp_pending_request_t);
+    qdr_delivery_t *delivery;
+};
+
+
 typedef struct qd_tcp_connector_t {
     qd_tcp_common_t           common;
     DEQ_LINKS(qd_tcp_connector_t);
@@ -85,8 +106,23 @@ typedef struct qd_tcp_connector_t {
     uint64_t                   link_id;
     qdr_link_t                *out_link;
     qd_tcp_connection_list_t  connections;
+    qd_tcp_connection_list_t  idle_connections;  // http1 encapsulation: keep-alive conns awaiting a request
+    qd_tcp_pending_request_list_t pending_requests;  // http1 encapsulation: requests awaiting a free conn
+    qd_tcp_connection_list_t  warm_connections;  // tcp encapsulation: pre-connected conns awaiting a flow
+    qd_timer_t                *warm_timer;       // expires idle warm conns and retries failed warm connects
     uint64_t                   connections_opened;
     uint64_t                   connections_closed;
+    uint64_t                   requests;
+    struct {
+        int                    current;        // capacity currently set on out_link
+        uint64_t               latency_usec;   // moving average of backend connect latency
+        uint64_t               baseline_usec;  // lowest average observed
+    } link_capacity;
+    struct {
+        int                    target;  // warm conns currently kept, between warmPoolMinIdle and warmPoolMaxIdle
+        uint64_t               hits;    // flows started on a warm conn
+        uint64_t               misses;  // flows that had to connect to the server
+    } warm_pool;
     sys_atomic_t               ref_count;
     sys_atomic_t               closing;
 } qd_tcp_connector_t;
@@ -101,11 +137,14 @@ typedef enum {
     LSIDE_STREAM_START,  // reply-to set, inbound delivery and streaming msg initialized, wait for out stream/delivery
     LSIDE_FLOW,          // in/out deliveries and msg active; doing cleartext I/O
     LSIDE_TLS_FLOW,      // in/out deliveries and msg active; doing TLS I/O
+    LSIDE_HTTP1_FLOW,    // reply-to set; one in/out delivery pair per HTTP/1.x request/response exchange
 
+    CSIDE_WARM,          // raw connection initiated for the connector's warm pool, waiting for a flow
     CSIDE_INITIAL,       // raw connection initiated, out delivery/msg available
     CSIDE_LINK_SETUP,    // raw conn/TLS opened, QDR conn and links attaching, waiting for inbound credit from core
     CSIDE_FLOW,          // in/out deliveries and msg active; doing I/O
     CSIDE_TLS_FLOW,      // in/out deliveries and msg active; doing TLS I/O
+    CSIDE_HTTP1_FLOW,    // pooled server conn; one out/in delivery pair per HTTP/1.x request/response exchange
     XSIDE_CLOSING        // raw conn closing
 } qd_tcp_connection_state_t;
 ENUM_DECLARE(qd_tcp_connection_state);
@@ -124,6 +163,8 @@ ENUM_DECLARE(qd_tcp_connection_state);
 typedef struct qd_tcp_connection_t {
     qd_tcp_common_t            common;
     DEQ_LINKS(qd_tcp_connection_t);
+    DEQ_LINKS_N(IDLE, qd_tcp_connection_t);
+    DEQ_LINKS_N(SETUP, qd_tcp_connection_t);
     pn_raw_connection_t        *raw_conn;
     sys_mutex_t                 activation_lock;
     sys_atomic_t                core_activation;
@@ -155,7 +196,45 @@ typedef struct qd_tcp_connection_t {
         uint64_t                pending_ack;  // egress: bytes sent since last PN_RECEIVED generated
         uint64_t                closed_count; // ingress: total count of window closures
         bool                    disabled;     // window flow control disabled, no backpressure allowed
+        uint64_t                base;         // ingress: inbound_octets at the start of the current inbound delivery
+        uint64_t                ack_base;     // egress: outbound_octets at the start of the current outbound delivery
     } window;
+    struct {
+        qd_http1_decoder_connection_t *decoder;       // 0 unless http1 encapsulation
+        qd_buffer_list_t               rx_pending;    // octets read beyond the end of the current message
+        qdr_delivery_t                *next_request;  // CSIDE: request handed to this conn, protected by activation_lock
+        uint64_t                       exchanges;     // completed request/response exchanges
+        size_t                         rx_split;      // offset of the end of the message in the current read buffer
+        bool                           request_done;  // request message fully decoded
+        bool                           response_done; // final response message fully decoded
+        bool                           outbound_done; // outbound delivery fully written
+        bool                           close_after;   // no keep-alive: close once the exchange completes
+        bool                           informational; // last response decoded was a 1xx response
+        bool                           failed;        // LSIDE: request could not be delivered
+        bool                           error;         // protocol error detected by the decoder
+        bool                           write_closed;  // exchange done, waiting for the peer to close
+        bool                           idle;          // CSIDE: on the connector's idle_connections list
+    } http1;
+    struct {
+        size_t                  limit;        // current cap on granted read buffers, ramps with read volume
+        size_t                  outstanding;  // read buffers currently held by the raw connection
+        size_t                  consumed;     // read buffers taken back from the raw connection since the last grant
+        uint64_t                last_grant;   // when buffers were last granted, for decaying the limit when idle
+    } read_grant;
+    uint64_t                    connect_start_usec;  // CSIDE: when the backend connect was initiated
+    struct {
+        bool                    pending;   // LSIDE: counted in the listener's setup_pending
+        bool                    queued;    // LSIDE: on the listener's setup_queue
+        bool                    released;  // LSIDE: taken off the setup_queue with a token
+        uint64_t                start_usec;  // LSIDE: when the conn was accepted
+    } setup;                                // protected by the listener lock
+    struct {
+        qdr_delivery_t         *next_flow;   // CSIDE: flow handed to this conn, protected by activation_lock
+        qd_buffer_list_t        rx_pending;  // octets sent by the server before the flow started
+        uint64_t                idle_since;  // when the conn was opened for the pool
+        bool                    spare;       // opened by the warm pool and not yet carrying a flow
+        bool                    pooled;      // on the connector's warm_connections list (protected by the connector lock)
+    } warm;
     bool                        listener_side;
     bool                        inbound_credit;
     bool                        inbound_first_octet;
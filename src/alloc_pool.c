@@ -29,6 +29,7 @@
 #include "qd_asan_interface.h"
 
 #include "qpid/dispatch/alloc.h"
+#include "qpid/dispatch/atomic.h"
 #include "qpid/dispatch/ctools.h"
 #include "qpid/dispatch/log.h"
 #include "qpid/dispatch/platform.h"
@@ -246,6 +247,7 @@ static inline int unordered_move_stack(qd_alloc_linked_stack_t *from, qd_alloc_l
 struct qd_alloc_pool_t {
     DEQ_LINKS(qd_alloc_pool_t);
     qd_alloc_linked_stack_t free_list;
+    atomic_uint_fast64_t    allocs;  // qd_alloc() calls served to the owning thread (written only by that thread)
 };
 
 const qd_alloc_config_t qd_alloc_default_config_big   = {16, 32, -1};
@@ -259,7 +261,6 @@ static char *debug_dump = 0;
 
 #ifdef QD_MEMORY_DEBUG
 // detect attempts to alloc prior to qd_alloc_initialize() or after qd_alloc_finalize()
-#include "qpid/dispatch/atomic.h"
 static atomic_bool alloc_pool_ready;
 #endif
 
@@ -281,6 +282,7 @@ void *qd_alloc(qd_alloc_type_desc_t *desc, qd_alloc_pool_t **tpool)
         NEW_CACHE_ALIGNED(qd_alloc_pool_t, *tpool);
         DEQ_ITEM_INIT(*tpool);
         init_stack(&(*tpool)->free_list);
+        atomic_init(&(*tpool)->allocs, 0);
         sys_mutex_lock(&desc->lock);
         DEQ_INSERT_TAIL(desc->tpool_list, *tpool);
         sys_mutex_unlock(&desc->lock);
@@ -288,6 +290,10 @@ void *qd_alloc(qd_alloc_type_desc_t *desc, qd_alloc_pool_t **tpool)
 
     qd_alloc_pool_t *pool = *tpool;
 
+    // Only this thread writes the counter: avoid a locked read-modify-write
+    atomic_store_explicit(&pool->allocs, atomic_load_explicit(&pool->allocs, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+
     //
     // Fast case: If there's an item on the local free list, take it off the
     // list and return it.  Since everything we've touched is thread-local,
@@ -408,6 +414,7 @@ void qd_dealloc(qd_alloc_type_desc_t *desc, qd_alloc_pool_t **tpool, char *p)
         NEW_CACHE_ALIGNED(qd_alloc_pool_t, *tpool);
         DEQ_ITEM_INIT(*tpool);
         init_stack(&(*tpool)->free_list);
+        atomic_init(&(*tpool)->allocs, 0);
         sys_mutex_lock(&desc->lock);
         DEQ_INSERT_TAIL(desc->tpool_list, *tpool);
         sys_mutex_unlock(&desc->lock);
@@ -487,7 +494,7 @@ void qd_alloc_initialize(void)
         desc->global_pool = NEW(qd_alloc_pool_t);
         DEQ_ITEM_INIT(desc->global_pool);
         init_stack(&desc->global_pool->free_list);
-        sys_mutex_init(&desc->lock);
+        sys_mutex_init_named(&desc->lock, "alloc_pool.type.lock");
         DEQ_INIT(desc->tpool_list);
         memset(&desc->stats, 0, sizeof(desc->stats));
 
@@ -658,6 +665,21 @@ void qd_alloc_finalize(void)
 }
 
 
+// Sum the per-thread allocation counters. Caller must hold desc->lock. Each thread only bumps its own counter with a
+// relaxed store, so qd_alloc() never contends on it; the total is computed when the statistics are read.
+//
+static uint64_t total_allocs_LH(const qd_alloc_type_desc_t *desc)
+{
+    uint64_t total = 0;
+    qd_alloc_pool_t *tpool = DEQ_HEAD(desc->tpool_list);
+    while (tpool) {
+        total += atomic_load_explicit(&tpool->allocs, memory_order_relaxed);
+        tpool = DEQ_NEXT(tpool);
+    }
+    return total;
+}
+
+
 QD_EXPORT qd_error_t qd_entity_refresh_allocator(qd_entity_t* entity, void *impl)
 {
     qd_alloc_type_desc_t *desc = (qd_alloc_type_desc_t *) impl;
@@ -673,7 +695,8 @@ QD_EXPORT qd_error_t qd_entity_refresh_allocator(qd_entity_t* entity, void *impl
         && qd_entity_set_long(entity, "totalFreeToHeap", desc->stats.total_free_to_heap) == 0
         && qd_entity_set_long(entity, "heldByThreads", desc->stats.held_by_threads) == 0
         && qd_entity_set_long(entity, "batchesRebalancedToThreads", desc->stats.batches_rebalanced_to_threads) == 0
-        && qd_entity_set_long(entity, "batchesRebalancedToGlobal", desc->stats.batches_rebalanced_to_global) == 0) {
+        && qd_entity_set_long(entity, "batchesRebalancedToGlobal", desc->stats.batches_rebalanced_to_global) == 0
+        && qd_entity_set_long(entity, "totalAllocs", total_allocs_LH(desc)) == 0) {
         sys_mutex_unlock(&desc->lock);
         return QD_ERROR_NONE;
     }
@@ -686,6 +709,7 @@ qd_alloc_stats_t qd_alloc_desc_stats(const qd_alloc_type_desc_t *desc)
     sys_mutex_t *lock = (sys_mutex_t *) &desc->lock;  // cast away const
     sys_mutex_lock(lock);
     qd_alloc_stats_t stats = desc->stats;
+    stats.total_allocs     = total_allocs_LH(desc);
     sys_mutex_unlock(lock);
 
     return stats;
@@ -27,6 +27,7 @@
 #include <string.h>
 
 const char * const QD_CONTENT_TYPE_APP_OCTETS = "application/octet-stream";
+const char * const QD_CONTENT_TYPE_APP_HTTP1  = "application/http";
 const char * const QD_AP_FLOW_ID              = ":flowid";
 
 const char * const QD_CAPABILITY_ROUTER_CONTROL       = "qd.router";
@@ -34,6 +35,8 @@ const char * const QD_CAPABILITY_ROUTER_DATA          = "qd.router-data";
 const char * const QD_CAPABILITY_EDGE_DOWNLINK        = "qd.router-edge-downlink";
 const char * const QD_CAPABILITY_STREAMING_DELIVERIES = "qd.streaming-deliveries";
 const char * const QD_CAPABILITY_RESEND_RELEASED      = "qd.resend-released";
+const char * const QD_CAPABILITY_EDGE_ADDRESS_BATCH   = "qd.edge-address-batch";
+const char * const QD_CAPABILITY_EDGE_ADDRESS_INTEREST = "qd.edge-address-interest";
 const char * const QD_CAPABILITY_ANONYMOUS_RELAY      = "ANONYMOUS-RELAY";
 const char * const QD_CAPABILITY_STREAMING_LINKS      = "qd.streaming-links";
 const char * const QD_CAPABILITY_INTER_EDGE           = "qd.router-inter-edge";
@@ -59,6 +62,7 @@ const char * const QD_CONNECTION_PROPERTY_ANNOTATIONS_VERSION_KEY = "qd.annotati
 const char * const QD_CONNECTION_PROPERTY_ACCESS_ID             = "qd.access-id";
 
 const char * const QD_TERMINUS_EDGE_ADDRESS_TRACKING = "_$qd.edge_addr_tracking";
+const char * const QD_TERMINUS_EDGE_ADDRESS_INTEREST = "_$qd.edge_addr_interest";
 const char * const QD_TERMINUS_HEARTBEAT             = "_$qd.edge_heartbeat";
 const char * const QD_TERMINUS_MESH_ID_NEGOTIATION   = "_$qd.mesh_id_negotiation";
 const char * const QD_TERMINUS_MESH_DISCOVERY        = "_$qd.mesh_discovery";
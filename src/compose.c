@@ -63,6 +63,17 @@ static inline void qd_insert(qd_composed_field_t *field, const uint8_t *seq, siz
     qd_buffer_t    *buf  = DEQ_TAIL(field->buffers);
     qd_composite_t *comp = DEQ_HEAD(field->fieldStack);
 
+    //
+    // Fast path: the octets fit in the tail buffer
+    //
+    if (len && buf && qd_buffer_capacity(buf) >= len) {
+        memcpy(qd_buffer_cursor(buf), seq, len);
+        qd_buffer_insert(buf, len);
+        if (comp)
+            comp->length += len;
+        return;
+    }
+
     while (len > 0) {
         if (buf == 0 || qd_buffer_capacity(buf) == 0) {
             buf = qd_buffer();
@@ -90,29 +101,53 @@ static inline void qd_insert_8(qd_composed_field_t *field, uint8_t value)
 }
 
 
-static inline void qd_insert_32(qd_composed_field_t *field, uint32_t value)
+//
+// Insert a type code followed by a fixed-width value with a single qd_insert() rather than one per octet.
+//
+static inline void qd_insert_tag_8(qd_composed_field_t *field, uint8_t tag, uint8_t value)
+{
+    uint8_t buf[2] = {tag, value};
+    qd_insert(field, buf, 2);
+}
+
+
+static inline void qd_insert_tag_32(qd_composed_field_t *field, uint8_t tag, uint32_t value)
+{
+    uint8_t buf[5];
+    buf[0] = tag;
+    buf[1] = (uint8_t) ((value & 0xFF000000) >> 24);
+    buf[2] = (uint8_t) ((value & 0x00FF0000) >> 16);
+    buf[3] = (uint8_t) ((value & 0x0000FF00) >> 8);
+    buf[4] = (uint8_t)  (value & 0x000000FF);
+    qd_insert(field, buf, 5);
+}
+
+
+static inline void qd_insert_tag_64(qd_composed_field_t *field, uint8_t tag, uint64_t value)
 {
-    uint8_t buf[4];
-    buf[0] = (uint8_t) ((value & 0xFF000000) >> 24);
-    buf[1] = (uint8_t) ((value & 0x00FF0000) >> 16);
-    buf[2] = (uint8_t) ((value & 0x0000FF00) >> 8);
-    buf[3] = (uint8_t)  (value & 0x000000FF);
-    qd_insert(field, buf, 4);
+    uint8_t buf[9];
+    buf[0] = tag;
+    buf[1] = (uint8_t) ((value & 0xFF00000000000000L) >> 56);
+    buf[2] = (uint8_t) ((value & 0x00FF000000000000L) >> 48);
+    buf[3] = (uint8_t) ((value & 0x0000FF0000000000L) >> 40);
+    buf[4] = (uint8_t) ((value & 0x000000FF00000000L) >> 32);
+    buf[5] = (uint8_t) ((value & 0x00000000FF000000L) >> 24);
+    buf[6] = (uint8_t) ((value & 0x0000000000FF0000L) >> 16);
+    buf[7] = (uint8_t) ((value & 0x000000000000FF00L) >> 8);
+    buf[8] = (uint8_t)  (value & 0x00000000000000FFL);
+    qd_insert(field, buf, 9);
 }
 
 
-static inline void qd_insert_64(qd_composed_field_t *field, uint64_t value)
+//
+// Insert the type code and length of a variable-width value: the one octet length form when the length permits.
+//
+static inline void qd_insert_variable_header(qd_composed_field_t *field, uint8_t tag8, uint8_t tag32, uint32_t len)
 {
-    uint8_t buf[8];
-    buf[0] = (uint8_t) ((value & 0xFF00000000000000L) >> 56);
-    buf[1] = (uint8_t) ((value & 0x00FF000000000000L) >> 48);
-    buf[2] = (uint8_t) ((value & 0x0000FF0000000000L) >> 40);
-    buf[3] = (uint8_t) ((value & 0x000000FF00000000L) >> 32);
-    buf[4] = (uint8_t) ((value & 0x00000000FF000000L) >> 24);
-    buf[5] = (uint8_t) ((value & 0x0000000000FF0000L) >> 16);
-    buf[6] = (uint8_t) ((value & 0x000000000000FF00L) >> 8);
-    buf[7] = (uint8_t)  (value & 0x00000000000000FFL);
-    qd_insert(field, buf, 8);
+    if (len < 256)
+        qd_insert_tag_8(field, tag8, (uint8_t) len);
+    else
+        qd_insert_tag_32(field, tag32, len);
 }
 
 
@@ -184,23 +219,94 @@ static inline void qd_compose_start_composite(qd_composed_field_t *field, int is
 }
 
 
+//
+// Re-encode a completed composite whose size and count fit in one octet as list0, list8 or map8.  The composite was
+// started with the 32-bit header (type code, four octet size, four octet count), so the body is copied out, the field
+// is truncated back to the type code and the compact header and body are inserted again.  The composite must already
+// be removed from the field stack: the reinserted octets are accounted to the enclosing composite.
+//
+static void qd_compose_compact_composite(qd_composed_field_t *field, qd_composite_t *comp)
+{
+    uint8_t  body[255];
+    uint32_t body_len = comp->length - 4;  // comp->length includes the count field
+    assert(body_len < 255);  // the one octet size also covers the count octet
+
+    //
+    // The type code is the last octet of the buffer holding the start of the size field
+    //
+    qd_buffer_t *type_buf    = comp->length_location.buffer;
+    size_t       type_offset = comp->length_location.offset - 1;
+
+    //
+    // Copy out the body that follows the eight octets of size and count placeholders
+    //
+    qd_buffer_t *buf    = type_buf;
+    size_t       cursor = type_offset + 9;
+    uint32_t     copied = 0;
+    while (copied < body_len) {
+        assert(buf);
+        if (cursor >= qd_buffer_size(buf)) {
+            cursor -= qd_buffer_size(buf);
+            buf = DEQ_NEXT(buf);
+            continue;
+        }
+        size_t to_copy = MIN(qd_buffer_size(buf) - cursor, body_len - copied);
+        memcpy(body + copied, qd_buffer_base(buf) + cursor, to_copy);
+        copied += to_copy;
+        cursor += to_copy;
+    }
+
+    //
+    // Truncate the field after the type code
+    //
+    type_buf->size = type_offset + 1;
+    buf = DEQ_NEXT(type_buf);
+    while (buf) {
+        DEQ_REMOVE(field->buffers, buf);
+        qd_buffer_free(buf);
+        buf = DEQ_NEXT(type_buf);
+    }
+
+    if (!comp->isMap && comp->count == 0) {
+        qd_buffer_base(type_buf)[type_offset] = QD_AMQP_LIST0;
+    } else {
+        qd_buffer_base(type_buf)[type_offset] = comp->isMap ? QD_AMQP_MAP8 : QD_AMQP_LIST8;
+        uint8_t header[2] = {(uint8_t) (body_len + 1), (uint8_t) comp->count};
+        qd_insert(field, header, 2);
+        qd_insert(field, body, body_len);
+    }
+}
+
+
 static inline void qd_compose_end_composite(qd_composed_field_t *field)
 {
     qd_composite_t *comp = DEQ_HEAD(field->fieldStack);
     assert(comp);
 
-    qd_overwrite_32(&comp->length_location, comp->length);
-    qd_overwrite_32(&comp->count_location,  comp->count);
-
     DEQ_REMOVE_HEAD(field->fieldStack);
+    qd_composite_t *enclosing = DEQ_HEAD(field->fieldStack);
 
     //
-    // If there is an enclosing composite, update its length and count
+    // The size includes the count field.  Composites that fit are re-encoded with one octet size and count.
     //
-    qd_composite_t *enclosing = DEQ_HEAD(field->fieldStack);
-    if (enclosing) {
-        enclosing->length += (comp->length - 4); // the length and count were already accounted for
-        enclosing->count++;
+    if (comp->length - 4 < 255 && comp->count <= 255) {
+        qd_compose_compact_composite(field, comp);
+        if (enclosing) {
+            // the body was reinserted after the type code, drop the removed 32-bit size and count
+            enclosing->length -= 8;
+            enclosing->count++;
+        }
+    } else {
+        qd_overwrite_32(&comp->length_location, comp->length);
+        qd_overwrite_32(&comp->count_location,  comp->count);
+
+        //
+        // If there is an enclosing composite, update its length and count
+        //
+        if (enclosing) {
+            enclosing->length += (comp->length - 4); // the length and count were already accounted for
+            enclosing->count++;
+        }
     }
 
     free_qd_composite_t(comp);
@@ -310,11 +416,9 @@ void qd_compose_insert_uint(qd_composed_field_t *field, uint32_t value)
     if (value == 0) {
         qd_insert_8(field, QD_AMQP_UINT0);
     } else if (value < 256) {
-        qd_insert_8(field, QD_AMQP_SMALLUINT);
-        qd_insert_8(field, (uint8_t) value);
+        qd_insert_tag_8(field, QD_AMQP_SMALLUINT, (uint8_t) value);
     } else {
-        qd_insert_8(field, QD_AMQP_UINT);
-        qd_insert_32(field, value);
+        qd_insert_tag_32(field, QD_AMQP_UINT, value);
     }
     bump_count(field);
 }
@@ -325,11 +429,9 @@ void qd_compose_insert_ulong(qd_composed_field_t *field, uint64_t value)
     if (value == 0) {
         qd_insert_8(field, QD_AMQP_ULONG0);
     } else if (value < 256) {
-        qd_insert_8(field, QD_AMQP_SMALLULONG);
-        qd_insert_8(field, (uint8_t) value);
+        qd_insert_tag_8(field, QD_AMQP_SMALLULONG, (uint8_t) value);
     } else {
-        qd_insert_8(field, QD_AMQP_ULONG);
-        qd_insert_64(field, value);
+        qd_insert_tag_64(field, QD_AMQP_ULONG, value);
     }
     bump_count(field);
 }
@@ -338,11 +440,9 @@ void qd_compose_insert_ulong(qd_composed_field_t *field, uint64_t value)
 void qd_compose_insert_int(qd_composed_field_t *field, int32_t value)
 {
     if (value >= -128 && value <= 127) {
-        qd_insert_8(field, QD_AMQP_SMALLINT);
-        qd_insert_8(field, (uint8_t) value);
+        qd_insert_tag_8(field, QD_AMQP_SMALLINT, (uint8_t) value);
     } else {
-        qd_insert_8(field, QD_AMQP_INT);
-        qd_insert_32(field, (uint32_t) value);
+        qd_insert_tag_32(field, QD_AMQP_INT, (uint32_t) value);
     }
     bump_count(field);
 }
@@ -351,11 +451,9 @@ void qd_compose_insert_int(qd_composed_field_t *field, int32_t value)
 void qd_compose_insert_long(qd_composed_field_t *field, int64_t value)
 {
     if (value >= -128 && value <= 127) {
-        qd_insert_8(field, QD_AMQP_SMALLLONG);
-        qd_insert_8(field, (uint8_t) value);
+        qd_insert_tag_8(field, QD_AMQP_SMALLLONG, (uint8_t) value);
     } else {
-        qd_insert_8(field, QD_AMQP_LONG);
-        qd_insert_64(field, (uint64_t) value);
+        qd_insert_tag_64(field, QD_AMQP_LONG, (uint64_t) value);
     }
     bump_count(field);
 }
@@ -363,8 +461,7 @@ void qd_compose_insert_long(qd_composed_field_t *field, int64_t value)
 
 void qd_compose_insert_timestamp(qd_composed_field_t *field, uint64_t value)
 {
-    qd_insert_8(field, QD_AMQP_TIMESTAMP);
-    qd_insert_64(field, value);
+    qd_insert_tag_64(field, QD_AMQP_TIMESTAMP, value);
     bump_count(field);
 }
 
@@ -379,13 +476,7 @@ void qd_compose_insert_uuid(qd_composed_field_t *field, const uint8_t *value)
 
 void qd_compose_insert_binary(qd_composed_field_t *field, const uint8_t *value, uint32_t len)
 {
-    if (len < 256) {
-        qd_insert_8(field, QD_AMQP_VBIN8);
-        qd_insert_8(field, (uint8_t) len);
-    } else {
-        qd_insert_8(field, QD_AMQP_VBIN32);
-        qd_insert_32(field, len);
-    }
+    qd_insert_variable_header(field, QD_AMQP_VBIN8, QD_AMQP_VBIN32, len);
     qd_insert(field, value, len);
     bump_count(field);
 }
@@ -407,13 +498,7 @@ void qd_compose_insert_binary_buffers(qd_composed_field_t *field, qd_buffer_list
     //
     // Supply the appropriate binary tag for the length.
     //
-    if (len < 256) {
-        qd_insert_8(field, QD_AMQP_VBIN8);
-        qd_insert_8(field, (uint8_t) len);
-    } else {
-        qd_insert_8(field, QD_AMQP_VBIN32);
-        qd_insert_32(field, len);
-    }
+    qd_insert_variable_header(field, QD_AMQP_VBIN8, QD_AMQP_VBIN32, len);
 
     //
     // Move the supplied buffers to the tail of the field's buffer list.
@@ -431,13 +516,7 @@ void qd_compose_insert_binary_buffers(qd_composed_field_t *field, qd_buffer_list
 
 void qd_compose_insert_string_n(qd_composed_field_t *field, const char *value, size_t len)
 {
-    if (len < 256) {
-        qd_insert_8(field, QD_AMQP_STR8_UTF8);
-        qd_insert_8(field, (uint8_t) len);
-    } else {
-        qd_insert_8(field, QD_AMQP_STR32_UTF8);
-        qd_insert_32(field, len);
-    }
+    qd_insert_variable_header(field, QD_AMQP_STR8_UTF8, QD_AMQP_STR32_UTF8, len);
     qd_insert(field, (const uint8_t*) value, len);
     bump_count(field);
 }
@@ -458,13 +537,7 @@ void qd_compose_insert_string2(qd_composed_field_t *field, const char *value1, c
     uint32_t len2 = strlen(value2);
     uint32_t len  = len1 + len2;
 
-    if (len < 256) {
-        qd_insert_8(field, QD_AMQP_STR8_UTF8);
-        qd_insert_8(field, (uint8_t) len);
-    } else {
-        qd_insert_8(field, QD_AMQP_STR32_UTF8);
-        qd_insert_32(field, len);
-    }
+    qd_insert_variable_header(field, QD_AMQP_STR8_UTF8, QD_AMQP_STR32_UTF8, len);
     qd_insert(field, (const uint8_t*) value1, len1);
     qd_insert(field, (const uint8_t*) value2, len2);
     bump_count(field);
@@ -488,13 +561,7 @@ void qd_compose_insert_symbol(qd_composed_field_t *field, const char *value)
     if (value)
         len = strlen(value);
 
-    if (len < 256) {
-        qd_insert_8(field, QD_AMQP_SYM8);
-        qd_insert_8(field, (uint8_t) len);
-    } else {
-        qd_insert_8(field, QD_AMQP_SYM32);
-        qd_insert_32(field, len);
-    }
+    qd_insert_variable_header(field, QD_AMQP_SYM8, QD_AMQP_SYM32, len);
     qd_insert(field, (const uint8_t*) value, len);
     bump_count(field);
 }
@@ -502,9 +569,10 @@ void qd_compose_insert_symbol(qd_composed_field_t *field, const char *value)
 
 void qd_compose_insert_typed_iterator(qd_composed_field_t *field, qd_iterator_t *iter)
 {
+    uint8_t chunk[128];
     while (!qd_iterator_end(iter)) {
-        uint8_t octet = qd_iterator_octet(iter);
-        qd_insert_8(field, octet);
+        size_t len = qd_iterator_ncopy_octets(iter, chunk, sizeof(chunk));
+        qd_insert(field, chunk, len);
     }
 
     bump_count(field);
@@ -557,7 +625,6 @@ void qd_compose_insert_double(qd_composed_field_t *field, double value)
     } converter;
     converter.d = value;
 
-    qd_insert_8(field, QD_AMQP_DOUBLE);
-    qd_insert_64(field, converter.l);
+    qd_insert_tag_64(field, QD_AMQP_DOUBLE, converter.l);
     bump_count(field);
 }
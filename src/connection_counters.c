@@ -21,6 +21,7 @@
 #include "qpid/dispatch/atomic.h"
 
 atomic_uint_fast64_t qd_connection_counters[QD_PROTOCOL_TOTAL];
+atomic_uint_fast64_t qd_granted_read_buffers;
 
 void qd_connection_counter_inc(qd_protocol_t proto)
 {
@@ -42,4 +43,19 @@ uint64_t qd_connection_count(qd_protocol_t proto)
     return (uint64_t) atomic_load_explicit(&qd_connection_counters[proto], memory_order_relaxed);
 }
 
+void qd_granted_read_buffers_inc(uint64_t count)
+{
+    atomic_fetch_add_explicit(&qd_granted_read_buffers, count, memory_order_relaxed);
+}
+
+void qd_granted_read_buffers_dec(uint64_t count)
+{
+    uint64_t old = atomic_fetch_sub_explicit(&qd_granted_read_buffers, count, memory_order_relaxed);
+    (void) old;
+    assert(old >= count);  // underflow!
+}
 
+uint64_t qd_granted_read_buffers_count(void)
+{
+    return (uint64_t) atomic_load_explicit(&qd_granted_read_buffers, memory_order_relaxed);
+}
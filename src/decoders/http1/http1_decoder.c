@@ -162,6 +162,10 @@ struct qd_http1_decoder_connection_t {
     const char *parse_error;  // if set parser has failed
     decoder_t   client;       // client stream decoder
     decoder_t   server;       // server stream decoder
+
+    // Position within the data passed to the in-progress rx_data() call. Valid only during callbacks.
+    const unsigned char        *rx_base;
+    const unsigned char *const *rx_cursor;
 };
 ALLOC_DECLARE(qd_http1_decoder_connection_t);
 ALLOC_DEFINE(qd_http1_decoder_connection_t);
@@ -931,6 +935,8 @@ int qd_http1_decoder_connection_rx_data(qd_http1_decoder_connection_t *hconn, bo
     }
 
     struct decoder_t *decoder = from_client ? &hconn->client : &hconn->server;
+    hconn->rx_base   = data;
+    hconn->rx_cursor = &data;
     while (more) {
 #if DEBUG_DECODER
         fprintf(stdout, "hconn: %p State: %s data length=%zu\n", (void *) hconn, decoder_state[decoder->state], length);
@@ -971,5 +977,14 @@ int qd_http1_decoder_connection_rx_data(qd_http1_decoder_connection_t *hconn, bo
         }
     }
 
+    hconn->rx_base   = 0;
+    hconn->rx_cursor = 0;
     return !!hconn->parse_error ? -1 : 0;
 }
+
+
+size_t qd_http1_decoder_connection_rx_offset(const qd_http1_decoder_connection_t *hconn)
+{
+    assert(hconn && hconn->rx_cursor);
+    return (size_t) (*hconn->rx_cursor - hconn->rx_base);
+}
@@ -134,4 +134,11 @@ void qd_http1_decoder_connection_free(qd_http1_decoder_connection_t *conn);
 //
 int qd_http1_decoder_connection_rx_data(qd_http1_decoder_connection_t *conn, bool from_client, const unsigned char *data, size_t len);
 
+// Return the number of octets of the data passed to the current qd_http1_decoder_connection_rx_data() call that have
+// been consumed by the decoder. Only valid when called from a callback. When called from message_done() this is the
+// offset of the first octet following the end of the message, which allows the caller to split the stream at message
+// boundaries.
+//
+size_t qd_http1_decoder_connection_rx_offset(const qd_http1_decoder_connection_t *conn);
+
 #endif // __http1_decoder_h__
@@ -35,6 +35,7 @@
 #include "qpid/dispatch/alloc.h"
 #include "qpid/dispatch/ctools.h"
 #include "qpid/dispatch/discriminator.h"
+#include "qpid/dispatch/memory_governor.h"
 #include "qpid/dispatch/server.h"
 #include "qpid/dispatch/static_assert.h"
 #include "qpid/dispatch/tls_common.h"
@@ -240,12 +241,19 @@ qd_error_t qd_dispatch_configure_router(qd_dispatch_t *qd, qd_entity_t *entity)
     }
 
     qd->thread_count = qd_entity_opt_long(entity, "workerThreads", 4); QD_ERROR_RET();
+    qd->tls_handshake_thread_count = qd_entity_opt_long(entity, "tlsHandshakeThreads", 0); QD_ERROR_RET();
     qd->data_connection_count = qd_entity_opt_string(entity, "dataConnectionCount", "auto"); QD_ERROR_RET();
     qd->timestamps_in_utc = qd_entity_opt_bool(entity, "timestampsInUTC", false); QD_ERROR_RET();
     qd->timestamp_format = qd_entity_opt_string(entity, "timestampFormat", 0); QD_ERROR_RET();
     qd->metadata = qd_entity_opt_string(entity, "metadata", 0); QD_ERROR_RET();
     qd->terminate_tcp_conns   = qd_entity_opt_bool(entity, "dropTcpConnections", true);
     QD_ERROR_RET();
+    qd->memory_shedding = qd_entity_opt_bool(entity, "memoryShedding", false); QD_ERROR_RET();
+    // edgeUplinkMode: 0 = active-standby, 1 = active-active
+    qd->edge_uplink_active_active = qd_entity_opt_long(entity, "edgeUplinkMode", 0) == 1; QD_ERROR_RET();
+    // edgeAddressProxy: 0 = per-address, 1 = multiplexed
+    qd->edge_address_proxy_multiplexed = qd_entity_opt_long(entity, "edgeAddressProxy", 0) == 1; QD_ERROR_RET();
+    qd->link_scheduling_quanta = qd_entity_opt_string(entity, "linkSchedulingQuanta", 0); QD_ERROR_RET();
 
     if (! qd->sasl_config_path) {
         qd->sasl_config_path = qd_entity_opt_string(entity, "saslConfigDir", 0); QD_ERROR_RET();
@@ -339,10 +347,12 @@ QD_EXPORT char * qd_dispatch_policy_host_pattern_lookup(qd_dispatch_t *qd, void
 qd_error_t qd_dispatch_prepare(qd_dispatch_t *qd)
 {
     qd_log_global_options(qd->timestamp_format, qd->timestamps_in_utc);
+    qd_memory_governor_initialize(qd->memory_shedding);
     qd->server             = qd_server(qd, qd->thread_count, qd->router_id, qd->sasl_config_path, qd->sasl_config_name);
     qd->router             = qd_router(qd, qd->router_mode, qd->router_area, qd->router_id);
     qd->connection_manager = qd_connection_manager(qd);
     qd->policy             = qd_policy(qd);
+    qd_tls_handshake_pool_start(qd->tls_handshake_thread_count);
     return qd_error_code();
 }
 
@@ -384,15 +394,22 @@ void qd_dispatch_free(qd_dispatch_t *qd)
     /* Stop HTTP threads immediately */
     qd_http_server_free(qd_server_http(qd->server));
 
+    /* Queued Python work refers to the agent and router freed below */
+    qd_python_stop_work();
+
+    /* Offloaded TLS handshakes refer to connections freed below */
+    qd_tls_handshake_pool_stop();
+
     free(qd->sasl_config_path);
     free(qd->data_connection_count);
+    free(qd->link_scheduling_quanta);
     free(qd->sasl_config_name);
     qd_connection_manager_free(qd->connection_manager);
     qd_policy_free(qd->policy);
     Py_XDECREF((PyObject*) qd->agent);
     qd_router_free(qd->router);
+    qd_tls_finalize();  // frees sslProfile timers: before qd_server_free() finalizes the timer module
     qd_server_free(qd->server);
-    qd_tls_finalize();
     qd_log_finalize();
     qd_alloc_finalize();
     qd_python_finalize();
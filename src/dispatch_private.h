@@ -48,6 +48,7 @@ struct qd_dispatch_t {
     qd_address_treatment_t   default_treatment;
 
     int    thread_count;
+    int    tls_handshake_thread_count;
     char  *sasl_config_path;
     char  *sasl_config_name;
     char  *router_area;
@@ -59,6 +60,10 @@ struct qd_dispatch_t {
     bool   timestamps_in_utc;
     char  *data_connection_count;
     bool   terminate_tcp_conns;
+    bool   memory_shedding;
+    bool   edge_uplink_active_active;
+    bool   edge_address_proxy_multiplexed;
+    char  *link_scheduling_quanta;
 };
 
 qd_dispatch_t *qd_dispatch_get_dispatch(void);
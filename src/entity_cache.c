@@ -22,6 +22,7 @@
 #include "entity_cache.h"
 
 #include "entity.h"
+#include "lock_profile.h"
 
 #include "qpid/dispatch/ctools.h"
 #include "qpid/dispatch/threading.h"
@@ -90,6 +91,7 @@ void qd_entity_cache_remove(const char *type, void *object) { push_event(REMOVE,
 QD_EXPORT qd_error_t qd_entity_refresh_begin(PyObject *list) TA_ACQ(event_lock)
 {
     qd_error_clear();
+    qd_lock_profile_publish();
     sys_mutex_lock(&event_lock);
     entity_event_t *event = DEQ_HEAD(event_list);
     while (event) {
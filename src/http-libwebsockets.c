@@ -17,6 +17,7 @@
  * under the License.
  */
 
+#include "python_private.h"  // must be first: includes Python.h
 #include "config.h"
 #include "http.h"
 #include "server_private.h"
@@ -30,9 +31,11 @@
 #include "qpid/dispatch/atomic.h"
 #include "qpid/dispatch/ctools.h"
 #include "qpid/dispatch/protocol_adaptor.h"
+#include "qpid/dispatch/static_assert.h"
 #include "qpid/dispatch/threading.h"
 #include "qpid/dispatch/timer.h"
 #include "qpid/dispatch/connection_counters.h"
+#include "qpid/dispatch/memory_governor.h"
 #include "qpid/dispatch/tls_common.h"
 
 #include <proton/connection_driver.h>
@@ -111,6 +114,7 @@ typedef struct stats_request_state_t {
     qdr_global_stats_t stats;
     qd_http_server_t *server;
     struct lws *wsi;
+    size_t lock_classes;      // number of lock class metrics the output buffer was sized for
     size_t buffer_size;       // extra octets past lws_prefix[LWS_PRE] for HTTP output
     uint8_t lws_prefix[LWS_PRE];
     // buffer_size extra octets are appended to this structure when it is allocated. This space is used for the HTTP
@@ -509,6 +513,11 @@ static void connection_wake(qd_connection_t *qd_conn)
 #define MAX_METRIC_TYPE_LEN  7   // strlen("counter")
 #define PER_METRIC_BUF_SIZE ((2 * MAX_METRIC_NAME_LEN) + MAX_METRIC_VALUE_LEN + MAX_METRIC_TYPE_LEN + 11)
 #define PER_ALLOC_METRIC_COUNT 4  // 4 metrics per alloc type
+#define PER_LOCK_METRIC_COUNT  4  // 4 metrics per lock class (lock profiling only)
+#define PYTHON_METRIC_COUNT    5  // Python thread work queue metrics
+#define PER_IO_THREAD_METRIC_COUNT 2  // busy time metrics per proactor I/O thread
+#define TLS_HANDSHAKE_METRIC_COUNT 4  // TLS handshake worker pool metrics
+#define MEMORY_GOVERNOR_METRIC_COUNT 5  // memory pressure metrics
 
 #define HTTP_HEADER_LEN 128  // reserve space for headers added by LWS (128 is a guess, asserted in callback).
 #define HEALTHZ_BUF_SIZE 2048 // for /healthz url response data
@@ -568,6 +577,18 @@ static uint64_t stats_get_deliveries_delayed_1sec(const qdr_global_stats_t *stat
 static uint64_t stats_get_deliveries_delayed_10sec(const qdr_global_stats_t *stats) { return stats->deliveries_delayed_10sec; }
 static uint64_t stats_get_deliveries_stuck(const qdr_global_stats_t *stats) { return stats->deliveries_stuck; }
 static uint64_t stats_get_links_blocked(const qdr_global_stats_t *stats) { return stats->links_blocked; }
+// delivery latency histogram, see QDR_DELIVERY_LATENCY_BUCKETS
+STATIC_ASSERT(QDR_DELIVERY_LATENCY_BUCKETS == 10, update_delivery_latency_metrics);
+static uint64_t stats_get_delivery_latency_lt_100us(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[0]; }
+static uint64_t stats_get_delivery_latency_lt_200us(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[1]; }
+static uint64_t stats_get_delivery_latency_lt_500us(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[2]; }
+static uint64_t stats_get_delivery_latency_lt_1ms(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[3]; }
+static uint64_t stats_get_delivery_latency_lt_2ms(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[4]; }
+static uint64_t stats_get_delivery_latency_lt_5ms(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[5]; }
+static uint64_t stats_get_delivery_latency_lt_10ms(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[6]; }
+static uint64_t stats_get_delivery_latency_lt_100ms(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[7]; }
+static uint64_t stats_get_delivery_latency_lt_1s(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[8]; }
+static uint64_t stats_get_delivery_latency_ge_1s(const qdr_global_stats_t *stats) { return stats->delivery_latency_histogram[9]; }
 
 static const struct metric_definition metrics[] = {
     {"qdr_connections_total", "gauge", stats_get_connections},
@@ -587,6 +608,16 @@ static const struct metric_definition metrics[] = {
     {"qdr_deliveries_delayed_10sec_total", "counter", stats_get_deliveries_delayed_10sec},
     {"qdr_deliveries_stuck_total", "gauge", stats_get_deliveries_stuck},
     {"qdr_links_blocked_total", "gauge", stats_get_links_blocked},
+    {"qdr_delivery_latency_lt_100us_total", "counter", stats_get_delivery_latency_lt_100us},
+    {"qdr_delivery_latency_lt_200us_total", "counter", stats_get_delivery_latency_lt_200us},
+    {"qdr_delivery_latency_lt_500us_total", "counter", stats_get_delivery_latency_lt_500us},
+    {"qdr_delivery_latency_lt_1ms_total", "counter", stats_get_delivery_latency_lt_1ms},
+    {"qdr_delivery_latency_lt_2ms_total", "counter", stats_get_delivery_latency_lt_2ms},
+    {"qdr_delivery_latency_lt_5ms_total", "counter", stats_get_delivery_latency_lt_5ms},
+    {"qdr_delivery_latency_lt_10ms_total", "counter", stats_get_delivery_latency_lt_10ms},
+    {"qdr_delivery_latency_lt_100ms_total", "counter", stats_get_delivery_latency_lt_100ms},
+    {"qdr_delivery_latency_lt_1s_total", "counter", stats_get_delivery_latency_lt_1s},
+    {"qdr_delivery_latency_ge_1s_total", "counter", stats_get_delivery_latency_ge_1s},
 };
 static const size_t metrics_length = sizeof(metrics)/sizeof(metrics[0]);
 
@@ -631,8 +662,8 @@ static size_t _write_metric(uint8_t **start, size_t available, const char *name,
     return rc1 + rc2;
 }
 
-// Write all the per-protocol connection counters. Return the total octets written (not including null terminator) or
-// zero on error.
+// Write all the per-protocol connection counters and the granted read buffer gauge. Return the total octets written
+// (not including null terminator) or zero on error.
 //
 // On successful return (*start) will be advanced to the terminating null byte.
 //
@@ -665,6 +696,12 @@ static size_t _write_conn_counter_metrics(uint8_t **start, size_t available)
         available -= rc;
     }
 
+    size_t rc = _write_metric(start, available, "qdr_granted_read_buffers", "gauge", qd_granted_read_buffers_count());
+    if (rc == 0) {
+        return 0;
+    }
+    available -= rc;
+
     return save - available;
 }
 
@@ -757,11 +794,152 @@ static size_t _write_allocator_metrics(uint8_t **start, size_t available)
     return save - available;
 }
 
-// Write the router process memory use metrics to the output buffer. Return the total octets written (not including null
+// Write the metrics for the Python thread's work queue. Return the total octets written (not including null
 // terminator) or zero on error.
 //
 // On successful return (*start) will be advanced to the terminating null byte.
 //
+static size_t _write_python_metrics(uint8_t **start, size_t available)
+{
+    const size_t save = available;
+    qd_python_work_stats_t stats;
+
+    qd_python_work_stats(&stats);
+
+    size_t rc = _write_metric(start, available, "qdr_python_queue_depth", "gauge", stats.queue_depth);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    rc = _write_metric(start, available, "qdr_python_queue_depth_max", "gauge", stats.max_queue_depth);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    rc = _write_metric(start, available, "qdr_python_calls_total", "counter", stats.calls);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    rc = _write_metric(start, available, "qdr_python_queue_usec_total", "counter", stats.queue_usec);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    rc = _write_metric(start, available, "qdr_python_call_usec_total", "counter", stats.call_usec);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    return save - available;
+}
+
+// Write the busy time metrics of the proactor I/O threads and of the TLS handshake worker pool. Return the total octets
+// written (not including null terminator) or zero on error.
+//
+// On successful return (*start) will be advanced to the terminating null byte.
+//
+static size_t _write_thread_metrics(qd_server_t *server, uint8_t **start, size_t available)
+{
+    const size_t save = available;
+    char name_buffer[MAX_METRIC_NAME_LEN + 1];
+    size_t rc;
+
+    for (int i = 0; i < qd_server_thread_count(server); ++i) {
+        qd_server_thread_stats_t stats;
+        qd_server_thread_stats(server, i, &stats);
+
+        snprintf(name_buffer, sizeof(name_buffer), "qdr_io_thread_%d_batches_total", i);
+        rc = _write_metric(start, available, name_buffer, "counter", stats.batches);
+        if (rc == 0) return 0;
+        available -= rc;
+
+        snprintf(name_buffer, sizeof(name_buffer), "qdr_io_thread_%d_busy_usec_total", i);
+        rc = _write_metric(start, available, name_buffer, "counter", stats.busy_usec);
+        if (rc == 0) return 0;
+        available -= rc;
+    }
+
+    qd_tls_handshake_pool_stats_t tls_stats;
+    qd_tls_handshake_pool_stats(&tls_stats);
+
+    rc = _write_metric(start, available, "qdr_tls_handshake_threads", "gauge", tls_stats.threads);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    rc = _write_metric(start, available, "qdr_tls_handshake_queue_depth", "gauge", tls_stats.queue_depth);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    rc = _write_metric(start, available, "qdr_tls_handshake_offloads_total", "counter", tls_stats.offloads);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    rc = _write_metric(start, available, "qdr_tls_handshake_busy_usec_total", "counter", tls_stats.busy_usec);
+    if (rc == 0) return 0;
+    available -= rc;
+
+    return save - available;
+}
+
+// Count the lock classes registered when lock profiling is enabled (see threading.h)
+//
+static size_t _lock_class_count(void)
+{
+    size_t count = 0;
+    for (sys_lock_class_t *lock_class = sys_lock_class_first(); lock_class; lock_class = sys_lock_class_next(lock_class))
+        count++;
+    return count;
+}
+
+// Write the metrics for at most max_classes lock classes to the output buffer. More classes may have been registered
+// since the output buffer was sized. Return the total octets written (not including null terminator) or zero on error.
+//
+// On successful return (*start) will be advanced to the terminating null byte.
+//
+static size_t _write_lock_metrics(uint8_t **start, size_t available, size_t max_classes)
+{
+    const size_t save = available;
+    char name_buffer[MAX_METRIC_NAME_LEN + 1];
+
+    sys_lock_class_t *lock_class = sys_lock_class_first();
+    for (size_t i = 0; lock_class && i < max_classes; ++i) {
+        sys_lock_stats_t stats;
+        sys_lock_class_stats(lock_class, &stats);
+
+        // "core.action_lock" -> "qdr_lock_core_action_lock", truncated to leave room for the ":<subname>" suffix
+        int ct = snprintf(name_buffer, sizeof(name_buffer), "qdr_lock_%.28s", sys_lock_class_name(lock_class));
+        if (ct < 0 || ct >= sizeof(name_buffer)) {
+            assert(false);
+            return 0;
+        }
+        for (char *ptr = name_buffer; *ptr; ++ptr) {
+            if (!isalnum(*ptr) && *ptr != '_')
+                *ptr = '_';
+        }
+
+        size_t rc = _write_allocator_metric(start, available, name_buffer, "acquired", stats.acquired);
+        if (rc == 0) return 0;
+        available -= rc;
+
+        rc = _write_allocator_metric(start, available, name_buffer, "contended", stats.contended);
+        if (rc == 0) return 0;
+        available -= rc;
+
+        rc = _write_allocator_metric(start, available, name_buffer, "wait_usec", stats.wait_nsec / 1000);
+        if (rc == 0) return 0;
+        available -= rc;
+
+        rc = _write_allocator_metric(start, available, name_buffer, "hold_usec", stats.hold_nsec / 1000);
+        if (rc == 0) return 0;
+        available -= rc;
+
+        lock_class = sys_lock_class_next(lock_class);
+    }
+
+    return save - available;
+}
+
+// Write the router process memory use and memory governor metrics to the output buffer. Return the total octets
+// written (not including null terminator) or zero on error.
+//
+// On successful return (*start) will be advanced to the terminating null byte.
+//
 static size_t _write_memory_metrics(uint8_t **start, size_t available)
 {
     const size_t save = available;
@@ -785,6 +963,28 @@ static size_t _write_memory_metrics(uint8_t **start, size_t available)
         available -= rc;
     }
 
+    qd_memory_governor_stats_t governor;
+    qd_memory_governor_stats(&governor);
+    const struct {
+        const char *name;
+        const char *type;
+        uint64_t    value;
+    } governor_metrics[MEMORY_GOVERNOR_METRIC_COUNT] = {
+        {"qdr_memory_pressure_level", "gauge", governor.level},
+        {"qdr_memory_buffer_ceiling", "gauge", governor.buffer_ceiling},
+        {"qdr_memory_buffers_in_use", "gauge", governor.buffers_in_use},
+        {"qdr_memory_pressure_transitions_total", "counter", governor.transitions},
+        {"qdr_memory_shed_connections_total", "counter", governor.shed},
+    };
+    for (int i = 0; i < MEMORY_GOVERNOR_METRIC_COUNT; ++i) {
+        rc = _write_metric(start, available, governor_metrics[i].name, governor_metrics[i].type,
+                           governor_metrics[i].value);
+        if (rc == 0) {
+            return 0;
+        }
+        available -= rc;
+    }
+
     return save - available;
 }
 
@@ -798,11 +998,17 @@ static size_t _generate_metrics_response(stats_request_state_t *state, uint8_t *
     if (_write_global_metrics(state, start, end - *start) == 0
         || _write_allocator_metrics(start, end - *start) == 0
         || _write_memory_metrics(start, end - *start) == 0
-        || _write_conn_counter_metrics(start, end - *start) == 0) {
+        || _write_conn_counter_metrics(start, end - *start) == 0
+        || _write_python_metrics(start, end - *start) == 0
+        || _write_thread_metrics(state->server->server, start, end - *start) == 0) {
         // error, close the connection
         return 0;
     }
 
+    if (state->lock_classes > 0 && _write_lock_metrics(start, end - *start, state->lock_classes) == 0) {
+        return 0;
+    }
+
     return end - *start;
 }
 
@@ -825,6 +1031,7 @@ static int callback_metrics(struct lws *wsi, enum lws_callback_reasons reason,
     case LWS_CALLBACK_HTTP: {
         // New HTTP request received, setup per-request state with output buffer
         assert(!stats->state);
+        const size_t lock_classes = _lock_class_count();
         // see the comments above regarding output buffer size for metrics:
         size_t buf_size = HTTP_HEADER_LEN
             // router global metrics:
@@ -832,13 +1039,21 @@ static int callback_metrics(struct lws *wsi, enum lws_callback_reasons reason,
             // alloc_pool metrics (+ 1 for qdr_alloc_pool_bytes):
             + (DEQ_SIZE(allocator_metrics) * PER_METRIC_BUF_SIZE * PER_ALLOC_METRIC_COUNT)
             + PER_METRIC_BUF_SIZE
-            // qdr_router_vmsize_bytes and qdr_router_rss_bytes:
-            + (2 * PER_METRIC_BUF_SIZE)
-            // connection counters by protocol:
-            + (QD_PROTOCOL_TOTAL * PER_METRIC_BUF_SIZE)
+            // qdr_router_vmsize_bytes, qdr_router_rss_bytes and the memory governor:
+            + ((2 + MEMORY_GOVERNOR_METRIC_COUNT) * PER_METRIC_BUF_SIZE)
+            // connection counters by protocol and qdr_granted_read_buffers:
+            + ((QD_PROTOCOL_TOTAL + 1) * PER_METRIC_BUF_SIZE)
+            // Python work queue metrics:
+            + (PYTHON_METRIC_COUNT * PER_METRIC_BUF_SIZE)
+            // proactor I/O thread and TLS handshake worker metrics:
+            + (qd_server_thread_count(hs->server) * PER_IO_THREAD_METRIC_COUNT * PER_METRIC_BUF_SIZE)
+            + (TLS_HANDSHAKE_METRIC_COUNT * PER_METRIC_BUF_SIZE)
+            // lock profiling metrics:
+            + (lock_classes * PER_METRIC_BUF_SIZE * PER_LOCK_METRIC_COUNT)
             // 1 terminating null
             + 1;
         stats->state = new_stats_request_state(buf_size);
+        stats->state->lock_classes = lock_classes;
         stats->state->wsi = wsi;
         stats->state->server = hs;
         //request stats from core thread
@@ -23,6 +23,7 @@
 #include "qpid/dispatch/amqp.h"
 #include "qpid/dispatch/ctools.h"
 #include "qpid/dispatch/hash.h"
+#include "qpid/dispatch/static_assert.h"
 #include "buffer_field_api.h"
 
 #include <stdio.h>
@@ -61,11 +62,14 @@ struct qd_iterator_t {
     view_state_t            state;
     unsigned char           prefix;
     unsigned char           prefix_override;
+    bool                    in_storage;         // Located in caller storage, not allocated from the pool
 };
 
 ALLOC_DECLARE(qd_iterator_t);
 ALLOC_DEFINE(qd_iterator_t);
 
+STATIC_ASSERT(sizeof(qd_iterator_t) <= sizeof(qd_iterator_storage_t), Increase_QD_ITERATOR_STORAGE_SIZE);
+
 typedef struct qd_iterator_peer_edge_t {
     DEQ_LINKS(struct qd_iterator_peer_edge_t);
     char *router_id;
@@ -576,13 +580,29 @@ qd_iterator_t *qd_iterator_buffer(qd_buffer_t *buffer, int offset, int length, q
 }
 
 
+qd_iterator_t *qd_iterator_buffer_init(qd_iterator_storage_t *storage, qd_buffer_t *buffer, int offset, int length, qd_iterator_view_t view)
+{
+    assert(storage);
+    qd_iterator_t *iter = (qd_iterator_t *) storage;
+
+    ZERO(iter);
+    iter->in_storage    = true;
+    iter->start_pointer = qd_buffer_field(buffer, qd_buffer_base(buffer) + offset, length);
+
+    qd_iterator_reset_view(iter, view);
+
+    return iter;
+}
+
+
 void qd_iterator_free(qd_iterator_t *iter)
 {
     if (!iter)
         return;
 
     qd_iterator_free_hash_segments(iter);
-    free_qd_iterator_t(iter);
+    if (!iter->in_storage)
+        free_qd_iterator_t(iter);
 }
 
 
@@ -897,11 +917,26 @@ qd_iterator_t *qd_iterator_dup(const qd_iterator_t *iter)
         // drop any references to the hash segments to avoid potential double
         // free
         DEQ_INIT(dup->hash_segments);
+        dup->in_storage = false;
     }
     return dup;
 }
 
 
+qd_iterator_t *qd_iterator_dup_init(qd_iterator_storage_t *storage, const qd_iterator_t *iter)
+{
+    assert(storage);
+    if (!iter)
+        return 0;
+
+    qd_iterator_t *dup = (qd_iterator_t *) storage;
+    *dup = *iter;
+    DEQ_INIT(dup->hash_segments);
+    dup->in_storage = true;
+    return dup;
+}
+
+
 /**
  * Creates and returns a new qd_hash_segment_t and initializes it.
  */
@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "lock_profile.h"
+
+#include "entity_cache.h"
+
+#include "qpid/dispatch/threading.h"
+
+const char *QD_LOCK_CLASS_TYPE = "lockClass";
+
+static sys_lock_class_t *last_published;  // accessed atomically
+
+void qd_lock_profile_publish(void)
+{
+    if (!sys_lock_profiling_enabled())
+        return;
+
+    // Claim each class with a compare-and-swap on last_published so that concurrent callers publish it only once. On
+    // failure last is updated to the class claimed by the other caller and the walk continues from there.
+    sys_lock_class_t *last = __atomic_load_n(&last_published, __ATOMIC_ACQUIRE);
+    sys_lock_class_t *lock_class = last ? sys_lock_class_next(last) : sys_lock_class_first();
+    while (lock_class) {
+        if (__atomic_compare_exchange_n(&last_published, &last, lock_class, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            qd_entity_cache_add(QD_LOCK_CLASS_TYPE, lock_class);
+            last = lock_class;
+        }
+        lock_class = last ? sys_lock_class_next(last) : sys_lock_class_first();
+    }
+}
+
+
+QD_EXPORT qd_error_t qd_entity_refresh_lockClass(qd_entity_t *entity, void *impl)
+{
+    const sys_lock_class_t *lock_class = (const sys_lock_class_t *) impl;
+    sys_lock_stats_t        stats;
+
+    sys_lock_class_stats(lock_class, &stats);
+
+    if (qd_entity_set_string(entity, "lockName", sys_lock_class_name(lock_class)) != 0
+        || qd_entity_set_long(entity, "acquired", stats.acquired) != 0
+        || qd_entity_set_long(entity, "contended", stats.contended) != 0
+        || qd_entity_set_long(entity, "waitUsec", stats.wait_nsec / 1000) != 0
+        || qd_entity_set_long(entity, "holdUsec", stats.hold_nsec / 1000) != 0
+        || qd_entity_set_list(entity, "waitHistogram") != 0)
+        return qd_error_code();
+    for (int i = 0; i < SYS_LOCK_HISTOGRAM_BUCKETS; ++i) {
+        if (qd_entity_set_long(entity, "waitHistogram", stats.wait_histogram[i]) != 0)
+            return qd_error_code();
+    }
+    if (qd_entity_set_list(entity, "holdHistogram") != 0)
+        return qd_error_code();
+    for (int i = 0; i < SYS_LOCK_HISTOGRAM_BUCKETS; ++i) {
+        if (qd_entity_set_long(entity, "holdHistogram", stats.hold_histogram[i]) != 0)
+            return qd_error_code();
+    }
+    return QD_ERROR_NONE;
+}
@@ -0,0 +1,40 @@
+#ifndef LOCK_PROFILE_H
+#define LOCK_PROFILE_H 1
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/** @file
+ *
+ * Management access to the sys_mutex_t contention statistics collected when
+ * lock profiling is enabled (see threading.h).
+ */
+
+#include "entity.h"
+
+/**
+ * Add any lock classes registered since the last call to the entity cache.
+ * Lock classes are created whenever a mutex with a new name is initialized,
+ * including before the entity cache is initialized, so they are published on
+ * demand by the management agent.  Safe to call from any thread.
+ */
+void qd_lock_profile_publish(void);
+
+QD_EXPORT qd_error_t qd_entity_refresh_lockClass(qd_entity_t *entity, void *impl);
+
+#endif
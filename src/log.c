@@ -587,7 +587,7 @@ void qd_log_initialize(void) TA_NO_THREAD_SAFETY_ANALYSIS
     for (level_index_t i = NONE + 1; i < N_LEVELS; ++i)
         aprintf(&begin, end, ", %s", levels[i].name);
 
-    sys_mutex_init(&log_source_lock);
+    sys_mutex_init_named(&log_source_lock, "log.source_lock");
 
     default_log_source                   = qd_log_source(LOG_DEFAULT);
     default_log_source->mask = levels[INFO].mask;
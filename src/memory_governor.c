@@ -0,0 +1,184 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "qpid/dispatch/memory_governor.h"
+
+#include "qpid/dispatch/atomic.h"
+#include "qpid/dispatch/buffer.h"
+#include "qpid/dispatch/ctools.h"
+#include "qpid/dispatch/log.h"
+#include "qpid/dispatch/platform.h"
+#include "qpid/dispatch/timer.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+// Interval between evaluations of the buffer usage. Reading the buffer allocator statistics takes the pool lock, so
+// it is done by a timer rather than by the callers of qd_memory_pressure().
+//
+#define EVALUATION_INTERVAL_MSEC 50
+
+static const char *pressure_names[] = {"normal", "elevated", "high", "critical"};
+
+// Buffers in use at which each level is entered, and below which it is left again. The gap between the two keeps the
+// level from flapping (and logging) while usage hovers around a threshold.
+//
+static uint64_t             enter_threshold[QD_MEMORY_PRESSURE_CRITICAL + 1];
+static uint64_t             exit_threshold[QD_MEMORY_PRESSURE_CRITICAL + 1];
+
+static uint64_t             buffer_ceiling;  // zero until initialized
+static bool                 shedding;
+static qd_timer_t          *evaluation_timer;
+static atomic_uint_fast64_t buffers_in_use;
+static atomic_uint_fast64_t transitions;
+static atomic_uint_fast64_t shed_count;
+static atomic_int           current_level;
+
+
+void qd_memory_governor_initialize(bool enable_shedding)
+{
+    //
+    // Determine the configured buffer memory ceiling.
+    //
+    char     *ceiling_string = getenv("SKUPPER_ROUTER_MEMORY_CEILING");
+    uint64_t  memory_ceiling = (uint64_t) qd_platform_memory_size();
+
+    //
+    // Use 4Gig as a default if the platform fails to return a valid size
+    //
+    if (memory_ceiling == 0) {
+        memory_ceiling = (uint64_t) 4 * (uint64_t) 1024 * (uint64_t) 1024 * (uint64_t) 1024;
+    }
+
+    if (!!ceiling_string) {
+        long long convert = atoll(ceiling_string);
+        if (convert > 0) {
+            memory_ceiling = (uint64_t) convert;
+        }
+    }
+
+    buffer_ceiling = MAX(memory_ceiling / QD_BUFFER_SIZE, 100);
+    shedding       = enable_shedding;
+
+    // enter at 50%, 75% and 85% of the ceiling, leave 5% below that
+    const uint64_t step = buffer_ceiling / 20;
+    enter_threshold[QD_MEMORY_PRESSURE_NORMAL]   = 0;
+    enter_threshold[QD_MEMORY_PRESSURE_ELEVATED] = step * 10;
+    enter_threshold[QD_MEMORY_PRESSURE_HIGH]     = step * 15;
+    enter_threshold[QD_MEMORY_PRESSURE_CRITICAL] = step * 17;
+    for (int level = QD_MEMORY_PRESSURE_NORMAL; level <= QD_MEMORY_PRESSURE_CRITICAL; level++) {
+        exit_threshold[level] = enter_threshold[level] - MIN(enter_threshold[level], step);
+    }
+
+    atomic_store(&buffers_in_use, 0);
+    atomic_store(&transitions, 0);
+    atomic_store(&shed_count, 0);
+    atomic_store(&current_level, QD_MEMORY_PRESSURE_NORMAL);
+
+    const char *mc_unit;
+    double mc_normalized = normalize_memory_size(memory_ceiling, &mc_unit);
+    qd_log(LOG_ROUTER, QD_LOG_INFO, "Router buffer memory ceiling: %.2f %s (%" PRIu64 " buffers)%s", mc_normalized,
+           mc_unit, buffer_ceiling, shedding ? ", shedding new connections under critical pressure" : "");
+}
+
+
+static void evaluate(void)
+{
+    //
+    // Use the "held_by_threads" stats for router buffers as an approximation of how many buffers are in-use.  This
+    // also counts free buffers held in the per-thread free-pools but since we will be dealing with large numbers here
+    // the number of buffers in free-pools will not be significant.
+    //
+    qd_alloc_stats_t stats  = alloc_stats_qd_buffer_t();
+    uint64_t         in_use = stats.held_by_threads;
+
+    const qd_memory_pressure_t old   = (qd_memory_pressure_t) atomic_load_explicit(&current_level, memory_order_relaxed);
+    qd_memory_pressure_t       level = old;
+    while (level < QD_MEMORY_PRESSURE_CRITICAL && in_use >= enter_threshold[level + 1])
+        level++;
+    while (level > QD_MEMORY_PRESSURE_NORMAL && in_use < exit_threshold[level])
+        level--;
+
+    atomic_store_explicit(&buffers_in_use, in_use, memory_order_relaxed);
+    atomic_store_explicit(&current_level, level, memory_order_relaxed);
+    if (old != level) {
+        atomic_fetch_add_explicit(&transitions, 1, memory_order_relaxed);
+        qd_log(LOG_ROUTER, old < level ? QD_LOG_WARNING : QD_LOG_INFO,
+               "Memory pressure %s: %" PRIu64 " of %" PRIu64 " buffers in use", pressure_names[level], in_use,
+               buffer_ceiling);
+    }
+}
+
+
+static void on_evaluation_timer(void *context)
+{
+    evaluate();
+    qd_timer_schedule(evaluation_timer, EVALUATION_INTERVAL_MSEC);
+}
+
+
+void qd_memory_governor_start(struct qd_dispatch_t *qd)
+{
+    if (buffer_ceiling == 0)
+        return;
+    evaluation_timer = qd_timer(qd, on_evaluation_timer, 0);
+    qd_timer_schedule(evaluation_timer, EVALUATION_INTERVAL_MSEC);
+}
+
+
+void qd_memory_governor_stop(void)
+{
+    if (evaluation_timer) {
+        qd_timer_free(evaluation_timer);
+        evaluation_timer = 0;
+    }
+}
+
+
+qd_memory_pressure_t qd_memory_pressure(void)
+{
+    return (qd_memory_pressure_t) atomic_load_explicit(&current_level, memory_order_relaxed);
+}
+
+
+uint64_t qd_memory_governor_scale(uint64_t amount, uint64_t minimum)
+{
+    uint64_t scaled = amount >> qd_memory_pressure();
+    return MAX(scaled, MIN(amount, minimum));
+}
+
+
+bool qd_memory_governor_shed(void)
+{
+    if (!shedding || qd_memory_pressure() != QD_MEMORY_PRESSURE_CRITICAL)
+        return false;
+    atomic_fetch_add_explicit(&shed_count, 1, memory_order_relaxed);
+    return true;
+}
+
+
+void qd_memory_governor_stats(qd_memory_governor_stats_t *stats)
+{
+    stats->level          = qd_memory_pressure();
+    stats->buffer_ceiling = buffer_ceiling;
+    stats->buffers_in_use = atomic_load_explicit(&buffers_in_use, memory_order_relaxed);
+    stats->transitions    = atomic_load_explicit(&transitions, memory_order_relaxed);
+    stats->shed           = atomic_load_explicit(&shed_count, memory_order_relaxed);
+    stats->shedding       = shedding;
+}
@@ -32,6 +32,7 @@
 #include "qpid/dispatch/internal/thread_annotations.h"
 #include "qpid/dispatch/iterator.h"
 #include "qpid/dispatch/log.h"
+#include "qpid/dispatch/memory_governor.h"
 #include "qpid/dispatch/threading.h"
 #include <qpid/dispatch/cutthrough_utils.h>
 #include <qpid/dispatch/amqp_adaptor.h>
@@ -96,6 +97,9 @@ PN_HANDLE(PN_DELIVERY_CTX)
 
 ALLOC_DEFINE_CONFIG_SAFE(qd_message_t, sizeof(qd_message_pvt_t), 0, 0);
 ALLOC_DEFINE(qd_message_content_t);
+ALLOC_DEFINE(qd_message_ra_override_t);
+ALLOC_DEFINE(qd_message_ra_encoding_t);
+ALLOC_DEFINE(qd_message_account_t);
 
 typedef void (*buffer_process_t) (void *context, const unsigned char *base, int length);
 
@@ -1009,13 +1013,15 @@ static qd_field_location_t *qd_message_properties_field(qd_message_t *msg, qd_me
 
 static void qd_message_parse_priority(qd_message_t *in_msg)
 {
-    qd_message_content_t *content  = MSG_CONTENT(in_msg);
-    qd_iterator_t        *iter     = qd_message_field_iterator(in_msg, QD_FIELD_HEADER);
+    qd_message_content_t  *content  = MSG_CONTENT(in_msg);
+    qd_iterator_storage_t  storage;
+    qd_iterator_t         *iter     = qd_message_field_iterator_init(&storage, in_msg, QD_FIELD_HEADER);
 
     SET_ATOMIC_FLAG(&content->priority_parsed);
 
     if (!!iter) {
-        qd_parsed_field_t *field = qd_parse(iter);
+        qd_parse_storage_t  field_storage;
+        qd_parsed_field_t  *field = qd_parse_lazy_init(&field_storage, iter);
         if (qd_parse_ok(field)) {
             if (qd_parse_is_list(field) && qd_parse_sub_count(field) >= 2) {
                 qd_parsed_field_t *priority_field = qd_parse_sub_value(field, 1);
@@ -1111,7 +1117,7 @@ qd_message_t *qd_message(void)
     }
 
     ZERO(msg->content);
-    sys_mutex_init(&msg->content->lock);
+    sys_mutex_init_named(&msg->content->lock, "message.content.lock");
     sys_atomic_init(&msg->content->aborted, 0);
     sys_atomic_init(&msg->content->discard, 0);
     sys_atomic_init(&msg->content->no_body, 0);
@@ -1121,11 +1127,170 @@ qd_message_t *qd_message(void)
     sys_atomic_init(&msg->content->receive_complete, 0);
     sys_atomic_init(&msg->content->ref_count, 1);
     sys_atomic_init(&msg->content->uct_enabled, 0);
+    sys_atomic_init(&msg->content->account_buffers, 0);
+    sys_atomic_init(&msg->content->account_slot_buffers, 0);
     msg->content->parse_depth = QD_DEPTH_NONE;
     return (qd_message_t*) msg;
 }
 
 
+qd_message_account_t *qd_message_account(void)
+{
+    qd_message_account_t *account = new_qd_message_account_t();
+    ZERO(account);
+    sys_atomic_init(&account->ref_count, 1);
+    sys_atomic_init(&account->buffers, 0);
+    sys_atomic_init(&account->slot_buffers, 0);
+    return account;
+}
+
+
+void qd_message_account_decref(qd_message_account_t *account)
+{
+    if (account && sys_atomic_dec(&account->ref_count) == 1) {
+        sys_atomic_destroy(&account->ref_count);
+        sys_atomic_destroy(&account->buffers);
+        sys_atomic_destroy(&account->slot_buffers);
+        free_qd_message_account_t(account);
+    }
+}
+
+
+uint64_t qd_message_account_buffers(const qd_message_account_t *account)
+{
+    return sys_atomic_get((sys_atomic_t *) &account->buffers);
+}
+
+
+uint64_t qd_message_account_slot_buffers(const qd_message_account_t *account)
+{
+    return sys_atomic_get((sys_atomic_t *) &account->slot_buffers);
+}
+
+
+//
+// Charge buffers added to the content (count > 0) or credit buffers released from it (count < 0) to the content's
+// account, if any.  slots: the buffers are in cut-through slots.  The account is set before the message is forwarded
+// and never changes, so it is read without the content lock.
+//
+static inline void content_charge_buffers(qd_message_content_t *content, int count, bool slots)
+{
+    qd_message_account_t *account = content->account;
+    if (!account || count == 0)
+        return;
+
+    if (count > 0) {
+        sys_atomic_add(&content->account_buffers, count);
+        sys_atomic_add(&account->buffers, count);
+        if (slots) {
+            sys_atomic_add(&content->account_slot_buffers, count);
+            sys_atomic_add(&account->slot_buffers, count);
+        }
+    } else {
+        sys_atomic_sub(&content->account_buffers, -count);
+        sys_atomic_sub(&account->buffers, -count);
+        if (slots) {
+            sys_atomic_sub(&content->account_slot_buffers, -count);
+            sys_atomic_sub(&account->slot_buffers, -count);
+        }
+    }
+}
+
+
+void qd_message_set_account(qd_message_t *msg, qd_message_account_t *account)
+{
+    qd_message_content_t *content = MSG_CONTENT(msg);
+
+    if (!account || content->account)
+        return;
+
+    sys_atomic_inc(&account->ref_count);
+
+    LOCK(&content->lock);
+    int slot_buffers = 0;
+    if (IS_ATOMIC_FLAG_SET(&content->uct_enabled)) {
+        for (int i = 0; i < UCT_SLOT_COUNT; i++)
+            slot_buffers += DEQ_SIZE(content->uct_slots[i]);
+    }
+    content->account = account;
+    content_charge_buffers(content, DEQ_SIZE(content->buffers), false);
+    content_charge_buffers(content, slot_buffers, true);
+    UNLOCK(&content->lock);
+}
+
+
+static void ra_override_decref(qd_message_ra_override_t *ra_override)
+{
+    if (ra_override && sys_atomic_dec(&ra_override->ref_count) == 1) {
+        free(ra_override->to_override);
+        free(ra_override->ingress_mesh);
+        sys_atomic_destroy(&ra_override->ref_count);
+        free_qd_message_ra_override_t(ra_override);
+    }
+}
+
+
+static qd_message_ra_override_t *ra_override_new(const char *to_override, const char *ingress_mesh)
+{
+    qd_message_ra_override_t *ra_override = new_qd_message_ra_override_t();
+    ZERO(ra_override);
+    sys_atomic_init(&ra_override->ref_count, 1);
+    if (to_override)
+        ra_override->to_override = qd_strdup(to_override);
+    if (ingress_mesh) {
+        ra_override->ingress_mesh = (char*) malloc(QD_DISCRIMINATOR_BYTES);
+        memcpy(ra_override->ingress_mesh, ingress_mesh, QD_DISCRIMINATOR_BYTES);
+    }
+    return ra_override;
+}
+
+
+//
+// Return the message's override values for modification, first giving the message a private instance if the current
+// one is shared with other copies or with a cached encoding.
+//
+static qd_message_ra_override_t *ra_override_writable(qd_message_pvt_t *msg)
+{
+    qd_message_ra_override_t *ra_override = msg->ra_override;
+
+    if (!ra_override) {
+        msg->ra_override = ra_override_new(0, 0);
+    } else if (sys_atomic_get(&ra_override->ref_count) > 1) {
+        msg->ra_override = ra_override_new(ra_override->to_override, ra_override->ingress_mesh);
+        ra_override_decref(ra_override);
+    }
+    return msg->ra_override;
+}
+
+
+//
+// Share the override values with a new copy of the message.  The ingress mesh is set per outgoing link and is not
+// carried over to copies.
+//
+static qd_message_ra_override_t *ra_override_for_copy(const qd_message_pvt_t *msg)
+{
+    qd_message_ra_override_t *ra_override = msg->ra_override;
+
+    if (!ra_override)
+        return 0;
+    if (ra_override->ingress_mesh)
+        return ra_override->to_override ? ra_override_new(ra_override->to_override, 0) : 0;
+    sys_atomic_inc(&ra_override->ref_count);
+    return ra_override;
+}
+
+
+void _release_router_annotations(qd_message_ra_encoding_t *encoding)
+{
+    if (encoding && sys_atomic_dec(&encoding->ref_count) == 1) {
+        ra_override_decref(encoding->ra_override);
+        qd_buffer_list_free_buffers(&encoding->buffers);
+        sys_atomic_destroy(&encoding->ref_count);
+        free_qd_message_ra_encoding_t(encoding);
+    }
+}
+
+
 void qd_message_free(qd_message_t *in_msg)
 {
     if (!in_msg) return;
@@ -1133,8 +1298,7 @@ void qd_message_free(qd_message_t *in_msg)
     qd_message_pvt_t          *msg        = (qd_message_pvt_t*) in_msg;
     qd_message_q2_unblocker_t  q2_unblock = {0};
 
-    free(msg->ra_to_override);
-    free(msg->ra_ingress_mesh);
+    ra_override_decref(msg->ra_override);
 
     sys_atomic_destroy(&msg->send_complete);
 
@@ -1155,6 +1319,7 @@ void qd_message_free(qd_message_t *in_msg)
             if (qd_buffer_dec_fanout(buf) == 1) {
                 DEQ_REMOVE(content->buffers, buf);
                 qd_buffer_free(buf);
+                content_charge_buffers(content, -1, false);
             }
             buf = next_buf;
         }
@@ -1187,8 +1352,7 @@ void qd_message_free(qd_message_t *in_msg)
             qd_parse_free(content->ra_pf_ingress_mesh);
         if (content->ra_pf_trace)
             qd_parse_free(content->ra_pf_trace);
-        if (content->ra_pf_flags)
-            qd_parse_free(content->ra_pf_flags);
+        _release_router_annotations(content->ra_encoding);
 
         qd_buffer_list_free_buffers(&content->buffers);
 
@@ -1217,6 +1381,16 @@ void qd_message_free(qd_message_t *in_msg)
         }
 
         sys_atomic_destroy(&content->uct_enabled);
+
+        if (content->account) {
+            // credit the buffers still held
+            const uint32_t slot_buffers = sys_atomic_get(&content->account_slot_buffers);
+            sys_atomic_sub(&content->account->slot_buffers, slot_buffers);
+            sys_atomic_sub(&content->account->buffers, sys_atomic_get(&content->account_buffers));
+            qd_message_account_decref(content->account);
+        }
+        sys_atomic_destroy(&content->account_buffers);
+        sys_atomic_destroy(&content->account_slot_buffers);
         free_qd_message_content_t(content);
     }
 
@@ -1224,9 +1398,12 @@ void qd_message_free(qd_message_t *in_msg)
 }
 
 
-qd_message_t *qd_message_copy(qd_message_t *in_msg)
+/**
+ * Allocate a new reference to the content of msg with its own cursor and router annotations. Accounting for the
+ * reference (content ref_count and buffer fanout) is left to the caller.
+ */
+static qd_message_pvt_t *message_new_reference(const qd_message_pvt_t *msg, bool is_fanout)
 {
-    qd_message_pvt_t     *msg     = (qd_message_pvt_t*) in_msg;
     qd_message_content_t *content = msg->content;
     qd_message_pvt_t     *copy    = (qd_message_pvt_t*) new_qd_message_t();
 
@@ -1243,15 +1420,26 @@ qd_message_t *qd_message_copy(qd_message_t *in_msg)
     copy->cursor.cursor = 0;
     sys_atomic_init(&copy->send_complete, 0);
     copy->tag_sent      = false;
-    copy->is_fanout     = false;
+    copy->is_fanout     = is_fanout;
 
     if (!content->ra_disabled) {
-        if (msg->ra_to_override)
-            copy->ra_to_override = qd_strdup(msg->ra_to_override);
-        copy->ra_flags = msg->ra_flags;
+        copy->ra_override = ra_override_for_copy(msg);
+        copy->ra_flags    = msg->ra_flags;
     }
 
-    sys_atomic_inc(&content->ref_count);
+    return copy;
+}
+
+
+qd_message_t *qd_message_copy(qd_message_t *in_msg)
+{
+    qd_message_pvt_t *msg  = (qd_message_pvt_t*) in_msg;
+    qd_message_pvt_t *copy = message_new_reference(msg, false);
+
+    if (!copy)
+        return 0;
+
+    sys_atomic_inc(&msg->content->ref_count);
 
     return (qd_message_t*) copy;
 }
@@ -1290,34 +1478,43 @@ const char *qd_message_parse_router_annotations(qd_message_t *in_msg)
                                                   &content->ra_pf_ingress_mesh,
                                                   &content->ra_pf_to_override,
                                                   &content->ra_pf_trace,
-                                                  &content->ra_pf_flags);
+                                                  &msg->ra_flags);  // per-message so they can be modified
     if (err)
         return(err);
 
-    // copy flags into message so they can be modified
-    msg->ra_flags = qd_parse_as_uint(content->ra_pf_flags);
-    if (!qd_parse_ok(content->ra_pf_flags))
-        return qd_parse_error(content->ra_pf_flags);
-
     return 0;
 }
 
 
 void qd_message_set_to_override_annotation(qd_message_t *in_msg, const char *to_field)
 {
-    qd_message_pvt_t *msg = (qd_message_pvt_t*) in_msg;
-    free(msg->ra_to_override);
-    msg->ra_to_override = to_field ? qd_strdup(to_field) : 0;
+    qd_message_pvt_t *msg     = (qd_message_pvt_t*) in_msg;
+    const char       *current = msg->ra_override ? msg->ra_override->to_override : 0;
+
+    // Setting the value a copy already shares must not break the sharing
+    if (current == to_field || (current && to_field && strcmp(current, to_field) == 0))
+        return;
+
+    qd_message_ra_override_t *ra_override = ra_override_writable(msg);
+    free(ra_override->to_override);
+    ra_override->to_override = to_field ? qd_strdup(to_field) : 0;
 }
 
 
 void qd_message_set_ingress_mesh(qd_message_t *in_msg, const char *mesh_identifier)
 {
-    qd_message_pvt_t *msg = (qd_message_pvt_t*) in_msg;
-    free(msg->ra_ingress_mesh);
+    qd_message_pvt_t *msg     = (qd_message_pvt_t*) in_msg;
+    const char       *current = msg->ra_override ? msg->ra_override->ingress_mesh : 0;
+
+    if (current == mesh_identifier || (current && mesh_identifier && memcmp(current, mesh_identifier, QD_DISCRIMINATOR_BYTES) == 0))
+        return;
+
+    qd_message_ra_override_t *ra_override = ra_override_writable(msg);
+    free(ra_override->ingress_mesh);
+    ra_override->ingress_mesh = 0;
     if (!!mesh_identifier) {
-        msg->ra_ingress_mesh = (char*) malloc(QD_DISCRIMINATOR_BYTES);
-        memcpy(msg->ra_ingress_mesh, mesh_identifier, QD_DISCRIMINATOR_BYTES);
+        ra_override->ingress_mesh = (char*) malloc(QD_DISCRIMINATOR_BYTES);
+        memcpy(ra_override->ingress_mesh, mesh_identifier, QD_DISCRIMINATOR_BYTES);
     }
 }
 
@@ -1409,6 +1606,7 @@ void qd_message_add_fanout(qd_message_t *out_msg)
         assert(content->pending && qd_buffer_size(content->pending) > 0);
         DEQ_INSERT_TAIL(content->buffers, content->pending);
         content->pending = 0;
+        content_charge_buffers(content, 1, false);
         buf = DEQ_HEAD(content->buffers);
     }
     // DISPATCH-1330: since we're incrementing the refcount be sure to set
@@ -1425,6 +1623,53 @@ void qd_message_add_fanout(qd_message_t *out_msg)
 }
 
 
+int qd_message_copy_fanout(qd_message_t *in_msg, qd_message_t **copies, int count)
+{
+    qd_message_pvt_t     *msg     = (qd_message_pvt_t*) in_msg;
+    qd_message_content_t *content = msg->content;
+    int                   made    = 0;
+
+    while (made < count) {
+        qd_message_pvt_t *copy = message_new_reference(msg, true);
+        if (!copy)
+            break;
+        copies[made++] = (qd_message_t*) copy;
+    }
+
+    if (made == 0)
+        return 0;
+    count = made;
+
+    sys_atomic_add(&content->ref_count, count);
+
+    LOCK(&content->lock);
+    content->fanout += count;
+
+    qd_buffer_t *buf = DEQ_HEAD(content->buffers);
+    // DISPATCH-1590: see qd_message_add_fanout()
+    if (!buf) {
+        assert(content->pending && qd_buffer_size(content->pending) > 0);
+        DEQ_INSERT_TAIL(content->buffers, content->pending);
+        content->pending = 0;
+        content_charge_buffers(content, 1, false);
+        buf = DEQ_HEAD(content->buffers);
+    }
+
+    // DISPATCH-1330: see qd_message_add_fanout()
+    for (int i = 0; i < count; ++i)
+        ((qd_message_pvt_t*) copies[i])->cursor.buffer = buf;
+
+    while (buf) {
+        qd_buffer_add_fanout(buf, count);
+        buf = DEQ_NEXT(buf);
+    }
+
+    UNLOCK(&content->lock);
+
+    return count;
+}
+
+
 /**
 * There are two sources of priority information --
 * message and address. Address takes precedence, falling
@@ -1662,6 +1907,7 @@ static void qd_message_receive_cutthrough(qd_message_t *in_msg, pn_delivery_t *d
         ssize_t rc   = link_receive_bufs(link, &content->uct_slots[use_slot], UCT_SLOT_BUF_LIMIT);
         bool data_rx = DEQ_SIZE(content->uct_slots[use_slot]) > 0;
         if (data_rx) {
+            content_charge_buffers(content, DEQ_SIZE(content->uct_slots[use_slot]), true);
             //
             // Data received, advance the producer slot pointer
             //
@@ -1787,6 +2033,7 @@ qd_message_t *qd_message_receive(pn_delivery_t *delivery, ssize_t *octets_receiv
                         qd_buffer_set_fanout(content->pending, content->fanout);
                         DEQ_INSERT_TAIL(content->buffers,
                                         content->pending);
+                        content_charge_buffers(content, 1, false);
                     } else {
                         // pending buffer is empty
                         pending_free = content->pending;
@@ -1813,80 +2060,85 @@ qd_message_t *qd_message_receive(pn_delivery_t *delivery, ssize_t *octets_receiv
         }
 
         //
-        // Handle a missing or full pending buffer
+        // Drain the link's incoming bytes into a batch of completely filled buffers.  pn_link_recv() fills
+        // each buffer to capacity while data is available, so a large transfer frame lands in whole buffers
+        // and the batch is appended to the content under a single lock rather than one lock per buffer.  A
+        // partially filled pending buffer means the incoming bytes are exhausted: the next pn_link_recv()
+        // returns zero or PN_EOS and ends the batch.
         //
-        if (!content->pending) {
-            // Pending buffer is absent: get a new one
-            content->pending = qd_buffer();
-        } else {
-            // Pending buffer exists
-            if (qd_buffer_capacity(content->pending) == 0) {
-                // Pending buffer is full
-                LOCK(&content->lock);
+        qd_buffer_list_t batch        = DEQ_EMPTY;
+        ssize_t          batch_octets = 0;
+        do {
+            if (!content->pending) {
+                content->pending = qd_buffer();
+            } else if (qd_buffer_capacity(content->pending) == 0) {
                 qd_buffer_set_fanout(content->pending, content->fanout);
-                DEQ_INSERT_TAIL(content->buffers, content->pending);
-                content->pending = 0;
-                if (_Q2_holdoff_should_block_LH(content)) {
-                    if (!qd_link_is_q2_limit_unbounded(qdl)) {
-                        content->q2_input_holdoff = true;
-                        UNLOCK(&content->lock);
-                        break;
-                    }
-                }
-                UNLOCK(&content->lock);
+                DEQ_INSERT_TAIL(batch, content->pending);
                 content->pending = qd_buffer();
-            } else {
-                // Pending buffer still has capacity
+            }
+            rc = pn_link_recv(link,
+                              (char*) qd_buffer_cursor(content->pending),
+                              qd_buffer_capacity(content->pending));
+            if (rc > 0) {
+                batch_octets += rc;
+                qd_buffer_insert(content->pending, rc);
+                if (qd_buffer_capacity(content->pending) == 0) {
+                    qd_buffer_set_fanout(content->pending, content->fanout);
+                    DEQ_INSERT_TAIL(batch, content->pending);
+                    content->pending = 0;
+                }
+            }
+        } while (rc > 0 && DEQ_SIZE(batch) < QD_MESSAGE_RX_BATCH);
+
+        *octets_received += batch_octets;
+
+        // Handle maxMessageSize violations
+        if (content->max_message_size && batch_octets > 0) {
+            content->bytes_received += batch_octets;
+            if (content->bytes_received > content->max_message_size) {
+                qd_buffer_list_free_buffers(&batch);
+                qd_connection_t *conn = qd_link_connection(qdl);
+                qd_connection_log_policy_denial(qdl, "DENY AMQP Transfer maxMessageSize exceeded");
+                qd_policy_count_max_size_event(link, conn);
+                SET_ATOMIC_FLAG(&content->discard);
+                SET_ATOMIC_FLAG(&content->oversize);
+                return discard_receive(delivery, link, (qd_message_t*)msg);
             }
         }
 
         //
-        // Try to fill the remaining space in the pending buffer.
+        // When rc is zero we've received all of the data available up to this point, but it does not
+        // constitute the entire message.  Push what we do have (including a partially filled pending buffer)
+        // so the caller can start sending it out; we'll be back later to finish it up.
         //
-        rc = pn_link_recv(link,
-                          (char*) qd_buffer_cursor(content->pending),
-                          qd_buffer_capacity(content->pending));
+        qd_buffer_t *partial = 0;
+        if (rc == 0 && content->pending && qd_buffer_size(content->pending) > 0) {
+            partial = content->pending;
+            content->pending = 0;
+            qd_buffer_set_fanout(partial, content->fanout);
+        }
+
+        bool holdoff = false;
+        if (DEQ_SIZE(batch) > 0 || partial) {
+            LOCK(&content->lock);
+            content_charge_buffers(content, DEQ_SIZE(batch) + (partial ? 1 : 0), false);
+            DEQ_APPEND(content->buffers, batch);
+            if (partial) {
+                DEQ_INSERT_TAIL(content->buffers, partial);
+            }
+            if (rc >= 0 && _Q2_holdoff_should_block_LH(content)) {
+                if (!qd_link_is_q2_limit_unbounded(qdl)) {
+                    content->q2_input_holdoff = true;
+                    holdoff = true;
+                }
+            }
+            UNLOCK(&content->lock);
+        }
 
         if (rc < 0) {
             // error or eos seen. next pass breaks out of loop
             recv_error = true;
-        } else if (rc > 0) {
-            //
-            // We have received a positive number of bytes for the message.
-            // Advance the cursor in the buffer.
-            //
-            *octets_received += rc;
-            qd_buffer_insert(content->pending, rc);
-
-            // Handle maxMessageSize violations
-            if (content->max_message_size) {
-                content->bytes_received += rc;
-                if (content->bytes_received > content->max_message_size)
-                {
-                    qd_connection_t *conn = qd_link_connection(qdl);
-                    qd_connection_log_policy_denial(qdl, "DENY AMQP Transfer maxMessageSize exceeded");
-                    qd_policy_count_max_size_event(link, conn);
-                    SET_ATOMIC_FLAG(&content->discard);
-                    SET_ATOMIC_FLAG(&content->oversize);
-                    return discard_receive(delivery, link, (qd_message_t*)msg);
-                }
-            }
-        } else {
-            //
-            // We received zero bytes, and no PN_EOS.  This means that we've received
-            // all of the data available up to this point, but it does not constitute
-            // the entire message.  We'll be back later to finish it up.
-            // Return the message so that the caller can start sending out whatever we have received so far
-            //
-            // push what we do have for testing/processing
-            if (qd_buffer_size(content->pending) > 0) {
-                LOCK(&content->lock);
-                qd_buffer_set_fanout(content->pending, content->fanout);
-                DEQ_INSERT_TAIL(content->buffers, content->pending);
-                content->pending = 0;
-                UNLOCK(&content->lock);
-                content->pending = qd_buffer();
-            }
+        } else if (rc == 0 || holdoff) {
             break;
         }
     }
@@ -1912,7 +2164,9 @@ static void send_handler(void *context, const unsigned char *start, int length)
 //
 uint32_t _compose_router_annotations(qd_message_pvt_t *msg, unsigned int ra_flags, qd_buffer_list_t *ra_buffers)
 {
-    qd_message_content_t *content = msg->content;
+    qd_message_content_t     *content      = msg->content;
+    const char               *to_override  = msg->ra_override ? msg->ra_override->to_override : 0;
+    const char               *ingress_mesh = msg->ra_override ? msg->ra_override->ingress_mesh : 0;
 
     DEQ_INIT(*ra_buffers);
 
@@ -1923,8 +2177,8 @@ uint32_t _compose_router_annotations(qd_message_pvt_t *msg, unsigned int ra_flag
     qd_compose_insert_uint(ra, msg->ra_flags);
 
     // index 1: to-override. Value local to the message takes precedence.
-    if (msg->ra_to_override) {
-        qd_compose_insert_string(ra, msg->ra_to_override);
+    if (to_override) {
+        qd_compose_insert_string(ra, to_override);
     } else if (content->ra_pf_to_override) {
         qd_buffer_field_t bf = qd_parse_typed_field(content->ra_pf_to_override);
         qd_compose_insert_buffer_field(ra, &bf, 1);
@@ -1959,8 +2213,8 @@ uint32_t _compose_router_annotations(qd_message_pvt_t *msg, unsigned int ra_flag
     }
 
     // index 4: edge-mesh identifier
-    if (!!msg->ra_ingress_mesh) {
-        qd_compose_insert_string_n(ra, msg->ra_ingress_mesh, QD_DISCRIMINATOR_BYTES);
+    if (!!ingress_mesh) {
+        qd_compose_insert_string_n(ra, ingress_mesh, QD_DISCRIMINATOR_BYTES);
     } else if (!!content->ra_pf_ingress_mesh) {
         qd_buffer_field_t bf = qd_parse_typed_field(content->ra_pf_ingress_mesh);
         qd_compose_insert_buffer_field(ra, &bf, 1);
@@ -1976,6 +2230,56 @@ uint32_t _compose_router_annotations(qd_message_pvt_t *msg, unsigned int ra_flag
 }
 
 
+//
+// Get the encoded router annotations section for an outgoing message.  Copies of the same content sent with the same
+// overrides, flags and strip mode (e.g. the copies of a multicast message sent over inter-router links) reuse the
+// encoding cached in the content instead of composing the section again.  A copy with a private override (e.g. one
+// sent to an edge router with its own ingress mesh) cannot share its encoding, so it is composed without touching the
+// cache or the content lock.  The caller must release the returned reference with _release_router_annotations().
+//
+qd_message_ra_encoding_t *_get_router_annotations(qd_message_pvt_t *msg, unsigned int ra_flags)
+{
+    qd_message_content_t     *content = msg->content;
+    qd_message_ra_encoding_t *encoding;
+    const bool                cached  = !msg->ra_override || sys_atomic_get(&msg->ra_override->ref_count) > 1;
+
+    if (cached) {
+        LOCK(&content->lock);
+        encoding = content->ra_encoding;
+        if (encoding
+            && encoding->ra_override == msg->ra_override
+            && encoding->ra_flags == msg->ra_flags
+            && encoding->strip_flags == ra_flags) {
+            sys_atomic_inc(&encoding->ref_count);
+            UNLOCK(&content->lock);
+            return encoding;
+        }
+        UNLOCK(&content->lock);
+    }
+
+    encoding = new_qd_message_ra_encoding_t();
+    ZERO(encoding);
+    sys_atomic_init(&encoding->ref_count, cached ? 2 : 1);  // the caller's reference and the content's
+    encoding->ra_flags    = msg->ra_flags;
+    encoding->strip_flags = ra_flags;
+    encoding->length      = _compose_router_annotations(msg, ra_flags, &encoding->buffers);
+
+    if (cached) {
+        encoding->ra_override = msg->ra_override;
+        if (encoding->ra_override)
+            sys_atomic_inc(&encoding->ra_override->ref_count);
+
+        LOCK(&content->lock);
+        qd_message_ra_encoding_t *old = content->ra_encoding;
+        content->ra_encoding = encoding;
+        UNLOCK(&content->lock);
+
+        _release_router_annotations(old);
+    }
+    return encoding;
+}
+
+
 static void qd_message_send_cut_through(qd_message_pvt_t *msg, qd_message_content_t *content, qd_link_t *link, bool *session_stalled)
 {
     pn_link_t *pnl             = qd_link_pn(link);
@@ -1997,6 +2301,7 @@ static void qd_message_send_cut_through(qd_message_pvt_t *msg, qd_message_conten
                 session_limit = (sent >= session_limit) ? 0 : session_limit - sent;
             }
             qd_buffer_free(buf);
+            content_charge_buffers(content, -1, true);
             buf = DEQ_HEAD(content->uct_slots[use_slot]);
         }
 
@@ -2080,15 +2385,14 @@ ssize_t qd_message_send(qd_message_t *in_msg,
 
             if (ra_flags != QD_MESSAGE_RA_STRIP_ALL) {
                 // prefix the message with new outgoing router annotations section
-                qd_buffer_list_t ra_buffers;
-                uint32_t len = _compose_router_annotations(msg, ra_flags, &ra_buffers);
-                if (len) {
-                    qd_buffer_t *buffer = DEQ_HEAD(ra_buffers);
+                qd_message_ra_encoding_t *encoding = _get_router_annotations(msg, ra_flags);
+                if (encoding->length) {
+                    qd_buffer_t *buffer = DEQ_HEAD(encoding->buffers);
                     assert(buffer);
                     const uint8_t *cursor = qd_buffer_base(buffer);
-                    advance_guarded(&cursor, &buffer, len, send_handler, (void*) pnl);
-                    qd_buffer_list_free_buffers(&ra_buffers);
+                    advance_guarded(&cursor, &buffer, encoding->length, send_handler, (void*) pnl);
                 }
+                _release_router_annotations(encoding);
             }
         }
 
@@ -2157,6 +2461,7 @@ ssize_t qd_message_send(qd_message_t *in_msg,
                         DEQ_REMOVE(content->buffers, buf);
                         qd_buffer_free(buf);
                         ++content->buffers_freed;
+                        content_charge_buffers(content, -1, false);
 
                         // by freeing a buffer there now may be room to restart a
                         // stalled message receiver
@@ -2475,22 +2780,53 @@ qd_iterator_t *qd_message_field_iterator_typed(qd_message_t *msg, qd_message_fie
 }
 
 
-qd_iterator_t *qd_message_field_iterator(qd_message_t *msg, qd_message_field_t field)
+// Locate the value of a message field (less its type header).  Returns false if the field is not present.
+//
+static bool message_field_value(qd_message_t *msg, qd_message_field_t field, qd_buffer_t **buffer, int *offset, int *length)
 {
     qd_field_location_t *loc = qd_message_field_location(msg, field);
 
     if (!loc)
-        return 0;
+        return false;
 
     if (loc->tag == QD_AMQP_NULL)
-        return 0;
+        return false;
 
-    qd_buffer_t   *buffer = loc->buffer;
+    qd_buffer_t   *buf    = loc->buffer;
     unsigned char *cursor = qd_buffer_base(loc->buffer) + loc->offset;
-    if (!advance(&cursor, &buffer, loc->hdr_length))
+    if (!advance(&cursor, &buf, loc->hdr_length))
+        return false;
+
+    *buffer = buf;
+    *offset = cursor - qd_buffer_base(buf);
+    *length = loc->length;
+    return true;
+}
+
+
+qd_iterator_t *qd_message_field_iterator(qd_message_t *msg, qd_message_field_t field)
+{
+    qd_buffer_t *buffer;
+    int          offset;
+    int          length;
+
+    if (!message_field_value(msg, field, &buffer, &offset, &length))
+        return 0;
+
+    return qd_iterator_buffer(buffer, offset, length, ITER_VIEW_ALL);
+}
+
+
+qd_iterator_t *qd_message_field_iterator_init(qd_iterator_storage_t *storage, qd_message_t *msg, qd_message_field_t field)
+{
+    qd_buffer_t *buffer;
+    int          offset;
+    int          length;
+
+    if (!message_field_value(msg, field, &buffer, &offset, &length))
         return 0;
 
-    return qd_iterator_buffer(buffer, cursor - qd_buffer_base(buffer), loc->length, ITER_VIEW_ALL);
+    return qd_iterator_buffer_init(storage, buffer, offset, length, ITER_VIEW_ALL);
 }
 
 
@@ -2767,6 +3103,7 @@ int qd_message_extend(qd_message_t *msg, qd_composed_field_t *field, bool *q2_bl
         buf = DEQ_NEXT(buf);
     }
 
+    content_charge_buffers(content, DEQ_SIZE(*buffers), false);
     DEQ_APPEND(content->buffers, (*buffers));
     count = DEQ_SIZE(content->buffers);
 
@@ -2840,7 +3177,8 @@ bool _Q2_holdoff_should_block_LH(const qd_message_content_t *content) TA_REQ(con
 {
     const size_t buff_ct = DEQ_SIZE(content->buffers);
     assert(buff_ct >= content->protected_buffers);
-    return !content->disable_q2_holdoff && (buff_ct - content->protected_buffers) >= QD_QLIMIT_Q2_UPPER;
+    return !content->disable_q2_holdoff
+           && (buff_ct - content->protected_buffers) >= qd_memory_governor_scale(QD_QLIMIT_Q2_UPPER, QD_QLIMIT_Q2_UPPER_MIN);
 }
 
 
@@ -2848,7 +3186,8 @@ bool _Q2_holdoff_should_unblock_LH(const qd_message_content_t *content) TA_REQ(c
 {
     const size_t buff_ct = DEQ_SIZE(content->buffers);
     assert(buff_ct >= content->protected_buffers);
-    return content->disable_q2_holdoff || (buff_ct - content->protected_buffers) < QD_QLIMIT_Q2_LOWER;
+    return content->disable_q2_holdoff
+           || (buff_ct - content->protected_buffers) < qd_memory_governor_scale(QD_QLIMIT_Q2_LOWER, QD_QLIMIT_Q2_LOWER_MIN);
 }
 
 
@@ -2970,6 +3309,7 @@ void qd_message_produce_buffers(qd_message_t *stream, qd_buffer_list_t *buffers)
     assert(qd_message_can_produce_buffers(stream));
 
     uint32_t useSlot = sys_atomic_get(&content->uct_produce_slot);
+    content_charge_buffers(content, DEQ_SIZE(*buffers), true);
     DEQ_MOVE(*buffers, content->uct_slots[useSlot]);
     sys_atomic_set(&content->uct_produce_slot, (useSlot + 1) % UCT_SLOT_COUNT);
     activate_message_consumer(stream);
@@ -2998,6 +3338,9 @@ int qd_message_consume_buffers(qd_message_t *stream, qd_buffer_list_t *buffers,
         empty = sys_atomic_get(&content->uct_consume_slot) == sys_atomic_get(&content->uct_produce_slot);
     }
 
+    // the consumer owns the buffers now
+    content_charge_buffers(content, -count, true);
+
     if (notify_consumed) {
         activate_message_producer(stream);
     }
@@ -26,6 +26,8 @@
 #include "qpid/dispatch/threading.h"
 
 typedef struct qd_message_pvt_t qd_message_pvt_t;
+typedef struct qd_message_ra_override_t qd_message_ra_override_t;
+typedef struct qd_message_ra_encoding_t qd_message_ra_encoding_t;
 
 /** @file
  * Message representation.
@@ -115,10 +117,10 @@ typedef struct {
     qd_parsed_field_t   *ra_pf_ingress;                  // ingress router id
     qd_parsed_field_t   *ra_pf_to_override;              // optional dest address override
     qd_parsed_field_t   *ra_pf_trace;                    // the fields from the trace list
-    qd_parsed_field_t   *ra_pf_flags;                    // misc control flags
     qd_parsed_field_t   *ra_pf_ingress_mesh;             // mesh_id of ingress edge router
     bool                 ra_disabled;                    // true: link routing - no router annotations involved.
     bool                 ra_parsed;
+    qd_message_ra_encoding_t *ra_encoding;               // Most recently encoded outgoing RA section (lock)
 
     uint64_t             max_message_size;               // Configured max; 0 if no max to enforce
     uint64_t             bytes_received;                 // Bytes returned by pn_link_recv()
@@ -145,8 +147,46 @@ typedef struct {
     sys_atomic_t             uct_consume_slot;
     qd_message_activation_t  uct_producer_activation;
     qd_message_activation_t  uct_consumer_activation;
+
+    qd_message_account_t    *account;                   // Charged for the buffers held by this content, may be null
+    sys_atomic_t             account_buffers;           // Buffers currently charged to account
+    sys_atomic_t             account_slot_buffers;      //  of which in cut-through slots
 } qd_message_content_t;
 
+//
+// Buffers held by the message contents charged to an owner such as a connection.  The owner and every charged content
+// hold a reference.
+//
+struct qd_message_account_t {
+    sys_atomic_t  ref_count;
+    sys_atomic_t  buffers;
+    sys_atomic_t  slot_buffers;
+};
+
+//
+// Outgoing router annotation values that replace those received in the message content.  Copies of a message share
+// one instance by reference until a copy sets a different value, at which point that copy gets its own instance
+// (copy-on-write).  An instance is never modified while it is shared.
+//
+struct qd_message_ra_override_t {
+    sys_atomic_t  ref_count;
+    char         *to_override;     // new outgoing value for to-override annotation
+    char         *ingress_mesh;    // new outgoing value for ingress_mesh annotation
+};
+
+//
+// An encoded outgoing router annotations section.  The section depends only on the content, the overrides, the flags
+// and the strip mode, so copies sent with identical values share a single encoding cached in the content.
+//
+struct qd_message_ra_encoding_t {
+    sys_atomic_t              ref_count;
+    qd_message_ra_override_t *ra_override;   // cache key, holds a reference so it cannot be recycled (null if not cached)
+    uint32_t                  ra_flags;
+    unsigned int              strip_flags;
+    uint32_t                  length;
+    qd_buffer_list_t          buffers;
+};
+
 struct qd_message_pvt_t {
     struct {
         qd_buffer_t *buffer;
@@ -154,8 +194,7 @@ struct qd_message_pvt_t {
     }                              cursor;          // Pointer to current location of outgoing byte stream.
     qd_message_content_t          *content;         // Singleton content shared by reference between
                                                     //  incoming and all outgoing copies
-    char                          *ra_to_override;  // new outgoing value for to-override annotation
-    char                          *ra_ingress_mesh; // new outgoing value for ingress_mesh annotation
+    qd_message_ra_override_t      *ra_override;     // new outgoing annotation values, shared copy-on-write
     uint32_t                       ra_flags;        // new outgoing value for flag annotation
     bool                           strip_annotations_in;
     bool                           ra_sent;         // false == router annotation section not yet sent
@@ -167,6 +206,9 @@ struct qd_message_pvt_t {
 
 ALLOC_DECLARE_SAFE(qd_message_t);
 ALLOC_DECLARE(qd_message_content_t);
+ALLOC_DECLARE(qd_message_ra_override_t);
+ALLOC_DECLARE(qd_message_ra_encoding_t);
+ALLOC_DECLARE(qd_message_account_t);
 
 #define MSG_CONTENT(m)     (((qd_message_pvt_t*) m)->content)
 #define MSG_FLAG_STREAMING       0x01u
@@ -185,6 +227,8 @@ bool _Q2_holdoff_should_block_LH(const qd_message_content_t *content) TA_REQ(con
 bool _Q2_holdoff_should_unblock_LH(const qd_message_content_t *content) TA_REQ(content->lock);
 
 uint32_t _compose_router_annotations(qd_message_pvt_t *msg, unsigned int ra_flags, qd_buffer_list_t *ra_buffers);
+qd_message_ra_encoding_t *_get_router_annotations(qd_message_pvt_t *msg, unsigned int ra_flags);
+void _release_router_annotations(qd_message_ra_encoding_t *encoding);
 
 
 ///@}
@@ -22,12 +22,15 @@
 #include "qpid/dispatch/alloc.h"
 #include "qpid/dispatch/amqp.h"
 #include "qpid/dispatch/ctools.h"
+#include "qpid/dispatch/static_assert.h"
 
 #include "buffer_field_api.h"
 
 #include <assert.h>
 #include <inttypes.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 DEQ_DECLARE(qd_parsed_field_t, qd_parsed_field_list_t);
 
@@ -40,6 +43,10 @@ typedef struct qd_amqp_field_t {
 } qd_amqp_field_t;
 
 
+typedef struct qd_parse_arena_t qd_parse_arena_t;
+
+static inline char *parse_amqp_field(qd_buffer_field_t *bfield, qd_amqp_field_t *value);
+
 struct qd_parsed_field_t {
     DEQ_LINKS(qd_parsed_field_t);
     const qd_parsed_field_t *parent;
@@ -49,14 +56,122 @@ struct qd_parsed_field_t {
     const char              *parse_error;
     qd_buffer_field_t        full_field;  // contains encoded AMQP type header and value
     qd_amqp_field_t          amqp;        // decoded header and raw value
+    qd_parse_arena_t        *arena;       // qd_parse_lazy() only: arena holding this tree
+    bool                     expanded;    // qd_parse_lazy() only: children have been materialized
 };
 
 ALLOC_DECLARE(qd_parsed_field_t);
 ALLOC_DEFINE(qd_parsed_field_t);
 
 
+//
+// Arena for the nodes of a tree created by qd_parse_lazy(). The arena is a chain of blocks, the first of which also
+// holds the root of the tree. Nodes are never freed individually: the whole chain is released by qd_parse_free() on
+// the root.
+//
+// Blocks normally come from the pool and hold QD_PARSE_ARENA_FIELDS nodes. A tree that is retained (the trace of the
+// router annotations) starts with a heap block sized for its root and direct children, and a tree parsed with
+// qd_parse_lazy_init() starts with the caller's storage. Either is followed by pool blocks if it turns out too small.
+//
+#define QD_PARSE_ARENA_FIELDS 16
+
+typedef enum {
+    QD_PARSE_ARENA_POOL,
+    QD_PARSE_ARENA_HEAP,
+    QD_PARSE_ARENA_STORAGE,
+} qd_parse_arena_source_t;
+
+struct qd_parse_arena_t {
+    qd_parse_arena_t  *next;      // next block in the chain
+    qd_parse_arena_t  *tail;      // first block only: the block new nodes are carved from
+    uint32_t           used;
+    uint16_t           capacity;  // number of nodes in fields
+    uint8_t            source;    // qd_parse_arena_source_t
+    qd_parsed_field_t  fields[QD_PARSE_ARENA_FIELDS];
+};
+
+ALLOC_DECLARE(qd_parse_arena_t);
+ALLOC_DEFINE(qd_parse_arena_t);
+
+STATIC_ASSERT(offsetof(qd_parse_arena_t, fields) + QD_PARSE_STORAGE_FIELDS * sizeof(qd_parsed_field_t) <= sizeof(qd_parse_storage_t),
+              Increase_QD_PARSE_STORAGE_SIZE);
+
+
+static void init_arena_block(qd_parse_arena_t *block, uint16_t capacity, qd_parse_arena_source_t source)
+{
+    block->next     = 0;
+    block->tail     = 0;
+    block->used     = 0;
+    block->capacity = capacity;
+    block->source   = source;
+}
+
+
+// Allocate a block for capacity nodes. Blocks smaller than a pool block are allocated from the heap.
+//
+static qd_parse_arena_t *new_arena_block(uint32_t capacity)
+{
+    qd_parse_arena_t *block;
+    if (capacity < QD_PARSE_ARENA_FIELDS) {
+        block = qd_malloc(offsetof(qd_parse_arena_t, fields) + capacity * sizeof(qd_parsed_field_t));
+        init_arena_block(block, capacity, QD_PARSE_ARENA_HEAP);
+    } else {
+        block = new_qd_parse_arena_t();
+        init_arena_block(block, QD_PARSE_ARENA_FIELDS, QD_PARSE_ARENA_POOL);
+    }
+    return block;
+}
+
+
+static qd_parsed_field_t *arena_new_field(qd_parse_arena_t *arena)
+{
+    qd_parse_arena_t *block = arena->tail;
+    if (block->used == block->capacity) {
+        block = new_arena_block(QD_PARSE_ARENA_FIELDS);
+        arena->tail->next = block;
+        arena->tail       = block;
+    }
+
+    qd_parsed_field_t *field = &block->fields[block->used++];
+    ZERO(field);
+    DEQ_ITEM_INIT(field);
+    DEQ_INIT(field->children);
+    field->arena = arena;
+    return field;
+}
+
+
+// Materialize the children of a field created by qd_parse_lazy(). The encoding has already been validated so no
+// parse errors are expected here.
+//
+static void expand_children(qd_parsed_field_t *field)
+{
+    if (!field->arena || field->expanded)
+        return;
+
+    field->expanded = true;
+    if (field->parse_error)
+        return;
+
+    qd_buffer_field_t children = field->amqp.value;
+    for (uint32_t idx = 0; idx < field->amqp.count; idx++) {
+        qd_parsed_field_t *child = arena_new_field(field->arena);
+        child->parent     = field;
+        child->full_field = children;
+        child->parse_error = parse_amqp_field(&children, &child->amqp);
+        DEQ_INSERT_TAIL(field->children, child);
+        if (child->parse_error) {
+            field->parse_error = child->parse_error;
+            break;
+        }
+        child->full_field.remaining -= children.remaining;
+    }
+}
+
+
 qd_parsed_field_t* qd_field_first_child(qd_parsed_field_t *field)
 {
+    expand_children(field);
     return DEQ_HEAD(field->children);
 }
 
@@ -226,12 +341,135 @@ qd_parsed_field_t *qd_parse(const qd_iterator_t *iter)
 }
 
 
+// Walk the encoded data held in *bfield without building a tree. Returns 0 if the value and everything it contains
+// is well formed, else the same error qd_parse_internal() would report for it. On return bfield has been advanced
+// past the encoded value.
+//
+static const char *validate_amqp_field(qd_buffer_field_t *bfield, qd_amqp_field_t *value)
+{
+    const char *error = parse_amqp_field(bfield, value);
+    if (!error) {
+        qd_buffer_field_t children = value->value;
+        qd_amqp_field_t   child;
+        for (uint32_t idx = 0; idx < value->count && !error; idx++) {
+            error = validate_amqp_field(&children, &child);
+        }
+    }
+    return error;
+}
+
+
+// Arena-backed equivalent of qd_parse_internal() for the root of a tree. The first block of the arena is the caller's
+// storage if given, else a block sized for the root and its direct children if fit is set, else a pool block. On
+// return bfield has been advanced past the encoded AMQP data.
+//
+static qd_parsed_field_t *qd_parse_lazy_internal(qd_buffer_field_t *bfield, qd_parse_storage_t *storage, bool fit)
+{
+    qd_buffer_field_t full_field = *bfield;
+    qd_amqp_field_t   amqp;
+    const char       *parse_error = parse_amqp_field(bfield, &amqp);
+
+    qd_parse_arena_t *arena;
+    if (storage) {
+        arena = (qd_parse_arena_t *) storage;
+        init_arena_block(arena, QD_PARSE_STORAGE_FIELDS, QD_PARSE_ARENA_STORAGE);
+    } else {
+        arena = new_arena_block(fit && !parse_error ? (uint64_t) amqp.count + 1 : QD_PARSE_ARENA_FIELDS);
+    }
+    arena->tail = arena;
+
+    qd_parsed_field_t *field = arena_new_field(arena);
+    field->full_field  = full_field;
+    field->amqp        = amqp;
+    field->parse_error = parse_error;
+    if (!field->parse_error) {
+        field->full_field.remaining -= bfield->remaining;
+
+        // check the contained values without building nodes for them
+        qd_buffer_field_t children = field->amqp.value;
+        qd_amqp_field_t   child;
+        for (uint32_t idx = 0; idx < field->amqp.count && !field->parse_error; idx++) {
+            field->parse_error = validate_amqp_field(&children, &child);
+        }
+    }
+
+    return field;
+}
+
+
+qd_parsed_field_t *qd_parse_lazy(const qd_iterator_t *iter)
+{
+    if (!iter)
+        return 0;
+
+    qd_buffer_field_t bfield = qd_iterator_get_view_cursor(iter);
+    return qd_parse_lazy_internal(&bfield, 0, false);
+}
+
+
+qd_parsed_field_t *qd_parse_lazy_init(qd_parse_storage_t *storage, const qd_iterator_t *iter)
+{
+    assert(storage);
+    if (!iter)
+        return 0;
+
+    qd_buffer_field_t bfield = qd_iterator_get_view_cursor(iter);
+    return qd_parse_lazy_internal(&bfield, storage, false);
+}
+
+
+static void free_arena_block(qd_parse_arena_t *block)
+{
+    switch ((qd_parse_arena_source_t) block->source) {
+    case QD_PARSE_ARENA_POOL:
+        free_qd_parse_arena_t(block);
+        break;
+    case QD_PARSE_ARENA_HEAP:
+        free(block);
+        break;
+    case QD_PARSE_ARENA_STORAGE:
+        break;
+    }
+}
+
+
+static void qd_parse_free_arena(qd_parse_arena_t *arena)
+{
+    qd_parse_arena_t *block = arena;
+    while (block) {
+        for (uint32_t idx = 0; idx < block->used; idx++) {
+            qd_parsed_field_t *field = &block->fields[idx];
+            if (field->raw_iter)
+                qd_iterator_free(field->raw_iter);
+            if (field->typed_iter)
+                qd_iterator_free(field->typed_iter);
+        }
+        block = block->next;
+    }
+
+    // the root lives in the first block, release it last
+    block = arena->next;
+    while (block) {
+        qd_parse_arena_t *next = block->next;
+        free_arena_block(block);
+        block = next;
+    }
+    free_arena_block(arena);
+}
+
+
 void qd_parse_free(qd_parsed_field_t *field)
 {
     if (!field)
         return;
 
     assert(field->parent == 0);
+    if (field->arena) {
+        assert(field == &field->arena->fields[0]);
+        qd_parse_free_arena(field->arena);
+        return;
+    }
+
     if (field->raw_iter)
         qd_iterator_free(field->raw_iter);
 
@@ -278,6 +516,11 @@ static qd_parsed_field_t *qd_parse_dup_internal(const qd_parsed_field_t *field,
 
 qd_parsed_field_t *qd_parse_dup(const qd_parsed_field_t *field)
 {
+    if (field && field->arena) {
+        // lazily expanded tree: build a regular one from the same base data
+        qd_buffer_field_t bfield = field->full_field;
+        return qd_parse_internal(&bfield, 0);
+    }
     return field ? qd_parse_dup_internal(field, 0) : 0;
 }
 
@@ -598,6 +841,7 @@ bool qd_parse_as_bool(qd_parsed_field_t *parsed_field)
 
 uint32_t qd_parse_sub_count(qd_parsed_field_t *field)
 {
+    expand_children(field);
     uint32_t count = DEQ_SIZE(field->children);
 
     if (field->amqp.tag == QD_AMQP_MAP8 || field->amqp.tag == QD_AMQP_MAP32)
@@ -612,6 +856,7 @@ qd_parsed_field_t *qd_parse_sub_key(qd_parsed_field_t *field, uint32_t idx)
     if (field->amqp.tag != QD_AMQP_MAP8 && field->amqp.tag != QD_AMQP_MAP32)
         return 0;
 
+    expand_children(field);
     idx = idx << 1;
     qd_parsed_field_t *key = DEQ_HEAD(field->children);
     while (idx && key) {
@@ -628,6 +873,7 @@ qd_parsed_field_t *qd_parse_sub_value(qd_parsed_field_t *field, uint32_t idx)
     if (field->amqp.tag == QD_AMQP_MAP8 || field->amqp.tag == QD_AMQP_MAP32)
         idx = (idx << 1) + 1;
 
+    expand_children(field);
     qd_parsed_field_t *key = DEQ_HEAD(field->children);
     while (idx && key) {
         idx--;
@@ -666,6 +912,7 @@ int qd_parse_is_list(qd_parsed_field_t *field)
 
 int qd_parse_is_scalar(qd_parsed_field_t *field)
 {
+    expand_children(field);
     return DEQ_SIZE(field->children) == 0;
 }
 
@@ -710,7 +957,7 @@ const char *qd_parse_router_annotations(
     qd_parsed_field_t **ra_ingress_mesh,
     qd_parsed_field_t **ra_to_override,
     qd_parsed_field_t **ra_trace,
-    qd_parsed_field_t **ra_flags)
+    uint32_t           *ra_flags)
 {
     *ra_ingress      = 0;
     *ra_ingress_mesh = 0;
@@ -739,10 +986,14 @@ const char *qd_parse_router_annotations(
 
     qd_buffer_field_t ra_fields = ra_list.value;
 
-    // index 0: flags
-    (*ra_flags) = qd_parse_internal(&ra_fields, 0);
-    if (!qd_parse_ok((*ra_flags)))
-        return (*ra_flags)->parse_error;
+    // index 0: flags. Only the value is needed so the field is parsed into stack storage.
+    qd_parse_storage_t flags_storage;
+    qd_parsed_field_t *flags = qd_parse_lazy_internal(&ra_fields, &flags_storage, false);
+    *ra_flags = qd_parse_as_uint(flags);
+    error     = qd_parse_error(flags);
+    qd_parse_free(flags);
+    if (error)
+        return error;
 
     // index 1: to-override (optional)
     (*ra_to_override) = qd_parse_internal(&ra_fields, 0);
@@ -766,14 +1017,16 @@ const char *qd_parse_router_annotations(
     } else if (!qd_parse_is_string(*ra_ingress))
         return "Invalid router ingress annotation: wrong type";
 
-    // index 3: trace list
-    (*ra_trace) = qd_parse_internal(&ra_fields, 0);
+    // index 3: trace list. It is kept with the message content, so it is parsed into a single block sized for the
+    // list and its entries. The check below expands all of its (scalar) entries, so the tree is not modified after it
+    // is shared by the message content.
+    (*ra_trace) = qd_parse_lazy_internal(&ra_fields, 0, true);
     if (!qd_parse_ok((*ra_trace)))
         return (*ra_trace)->parse_error;
     if (!qd_parse_is_list((*ra_trace)))
         return "Invalid router trace annotation: not a list";
     bool all_str = true;
-    for (qd_parsed_field_t *node = DEQ_HEAD((*ra_trace)->children);
+    for (qd_parsed_field_t *node = qd_field_first_child(*ra_trace);
          node && all_str;
          node = DEQ_NEXT(node)) {
         all_str = qd_parse_is_string(node);
@@ -827,6 +827,60 @@ bool qd_parse_tree_walk(qd_parse_tree_t *tree, qd_parse_tree_visit_t *callback,
 }
 
 
+typedef struct {
+    qd_parse_tree_type_t type;
+    int                  prefix_tokens;
+} prefix_tokens_t;
+
+// qd_parse_tree_walk callback for qd_parse_tree_prefix_tokens
+static bool prefix_tokens_visit(void *handle, const char *pattern, void *payload)
+{
+    prefix_tokens_t *prefix = (prefix_tokens_t *) handle;
+    token_iterator_t t;
+    int literals = 0;
+
+    token_iterator_init(&t, prefix->type, pattern);
+    while (!token_iterator_done(&t)) {
+        if (token_iterator_is_match_glob(&t)) {
+            token_iterator_next(&t);
+            if (!token_iterator_done(&t)) {
+                prefix->prefix_tokens = -1;
+                return false;
+            }
+        } else if (token_iterator_is_match_1(&t)) {
+            prefix->prefix_tokens = -1;
+            return false;
+        } else {
+            literals++;
+            token_iterator_next(&t);
+        }
+    }
+
+    if (literals > prefix->prefix_tokens)
+        prefix->prefix_tokens = literals;
+    return true;
+}
+
+
+int qd_parse_tree_prefix_tokens(qd_parse_tree_t *tree)
+{
+    prefix_tokens_t prefix = {.type = tree->type, .prefix_tokens = 0};
+    parse_tree_walk(tree->root, prefix_tokens_visit, &prefix);
+    return prefix.prefix_tokens;
+}
+
+
+const char *qd_parse_tree_skip_tokens(const qd_parse_tree_t *tree, const char *value, int count)
+{
+    token_iterator_t t;
+
+    token_iterator_init(&t, tree->type, value);
+    for (int i = 0; i < count && !token_iterator_done(&t); i++)
+        token_iterator_next(&t);
+    return token_iterator_done(&t) ? 0 : t.token.begin;
+}
+
+
 bool qd_parse_tree_validate_pattern(const qd_parse_tree_t *tree,
                                     const qd_iterator_t *pattern)
 {
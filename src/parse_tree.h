@@ -119,6 +119,20 @@ void qd_parse_tree_search(qd_parse_tree_t *tree, const qd_iterator_t *value,
 // visit each terminal node on the tree, returns last value returned by callback
 bool qd_parse_tree_walk(qd_parse_tree_t *tree, qd_parse_tree_visit_t *callback, void *handle);
 
+// prefix matching support: if no pattern in the tree has a wildcard other
+// than a trailing "match zero or more", all values that share their first N
+// tokens match the same pattern, where N is the largest number of literal
+// tokens in any pattern.
+//
+// returns N, or -1 if some pattern has a wildcard elsewhere
+int qd_parse_tree_prefix_tokens(qd_parse_tree_t *tree);
+
+// returns a pointer to the first token of value following its first count
+// tokens, or NULL if value has no more than count tokens.  The value is
+// tokenized exactly as the tree tokenizes it for matching, including empty
+// tokens ("a..b") and leading or trailing separators.
+const char *qd_parse_tree_skip_tokens(const qd_parse_tree_t *tree, const char *value, int count);
+
 //
 // parse tree functions using string interface
 //
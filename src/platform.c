@@ -26,6 +26,7 @@
 #include <inttypes.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <time.h>
 #if QD_HAVE_GETRLIMIT
 #include <sys/resource.h>
 #endif
@@ -197,3 +198,10 @@ uint64_t qd_router_rss_memory_usage(void)
     // VmRSS is in kB
     return _parse_proc_memory_metric("VmRSS: %" SCNu64) * 1024;
 }
+
+uint64_t qd_platform_monotonic_usec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
@@ -33,13 +33,170 @@
 #include "qpid/dispatch/internal/thread_annotations.h"
 
 #include <assert.h>
+#include <errno.h>
 #include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//
+// Lock contention profiling. The lock classes are never freed: they are referenced from static storage at each
+// sys_mutex_init_named() call site.
+//
+struct sys_lock_class_t {
+    sys_lock_class_t     *next;
+    const char           *name;  // string literal passed to sys_mutex_init_named(), the registry key
+    atomic_uint_fast64_t  acquired;
+    atomic_uint_fast64_t  contended;
+    atomic_uint_fast64_t  wait_nsec;
+    atomic_uint_fast64_t  hold_nsec;
+    atomic_uint_fast64_t  wait_histogram[SYS_LOCK_HISTOGRAM_BUCKETS];
+    atomic_uint_fast64_t  hold_histogram[SYS_LOCK_HISTOGRAM_BUCKETS];
+};
+
+static pthread_mutex_t   lock_classes_lock = PTHREAD_MUTEX_INITIALIZER;  // not a sys_mutex_t: avoid profiling itself
+static sys_lock_class_t *lock_classes_head;
+static sys_lock_class_t *lock_classes_tail;
+
+#ifdef QD_LOCK_PROFILING
+static pthread_once_t    lock_profiling_once = PTHREAD_ONCE_INIT;
+static bool              lock_profiling;
+static sys_lock_class_t *other_lock_class;  // for sys_mutex_init()
+
+static void lock_profiling_init(void)
+{
+    lock_profiling = getenv("SKUPPER_ROUTER_LOCK_PROFILING") != 0;
+}
+
+static inline uint64_t lock_clock_nsec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static inline int lock_histogram_bucket(uint64_t nsec)
+{
+    int bucket = 0;
+    for (uint64_t limit = 1000; bucket < SYS_LOCK_HISTOGRAM_BUCKETS - 1 && nsec >= limit; limit *= 10)
+        bucket++;
+    return bucket;
+}
+
+static sys_lock_class_t *lock_class_LH(const char *name)
+{
+    for (sys_lock_class_t *lock_class = lock_classes_head; lock_class; lock_class = lock_class->next) {
+        if (strcmp(lock_class->name, name) == 0)
+            return lock_class;
+    }
+
+    sys_lock_class_t *lock_class = calloc(1, sizeof(sys_lock_class_t));
+    if (!lock_class)
+        return 0;
+    lock_class->name = name;
+
+    if (lock_classes_tail)
+        lock_classes_tail->next = lock_class;
+    else
+        lock_classes_head = lock_class;
+    lock_classes_tail = lock_class;
+    return lock_class;
+}
+#endif
+
+bool sys_lock_profiling_enabled(void)
+{
+#ifdef QD_LOCK_PROFILING
+    pthread_once(&lock_profiling_once, lock_profiling_init);
+    return lock_profiling;
+#else
+    return false;
+#endif
+}
+
+sys_lock_class_t *sys_lock_class_first(void)
+{
+    pthread_mutex_lock(&lock_classes_lock);
+    sys_lock_class_t *lock_class = lock_classes_head;
+    pthread_mutex_unlock(&lock_classes_lock);
+    return lock_class;
+}
+
+sys_lock_class_t *sys_lock_class_next(const sys_lock_class_t *lock_class)
+{
+    pthread_mutex_lock(&lock_classes_lock);
+    sys_lock_class_t *next = lock_class->next;
+    pthread_mutex_unlock(&lock_classes_lock);
+    return next;
+}
+
+const char *sys_lock_class_name(const sys_lock_class_t *lock_class)
+{
+    return lock_class->name;
+}
+
+void sys_lock_class_stats(const sys_lock_class_t *lock_class, sys_lock_stats_t *stats)
+{
+    sys_lock_class_t *lc = (sys_lock_class_t *) lock_class;  // cast away const for the atomic loads
+
+    stats->acquired  = atomic_load_explicit(&lc->acquired, memory_order_relaxed);
+    stats->contended = atomic_load_explicit(&lc->contended, memory_order_relaxed);
+    stats->wait_nsec = atomic_load_explicit(&lc->wait_nsec, memory_order_relaxed);
+    stats->hold_nsec = atomic_load_explicit(&lc->hold_nsec, memory_order_relaxed);
+    for (int i = 0; i < SYS_LOCK_HISTOGRAM_BUCKETS; ++i) {
+        stats->wait_histogram[i] = atomic_load_explicit(&lc->wait_histogram[i], memory_order_relaxed);
+        stats->hold_histogram[i] = atomic_load_explicit(&lc->hold_histogram[i], memory_order_relaxed);
+    }
+}
+
+#ifdef QD_LOCK_PROFILING
+// Account for the time the mutex was held by the caller, who is about to release it
+//
+static inline void lock_profile_release(sys_mutex_t *mutex)
+{
+    if (mutex->acquired_nsec) {
+        uint64_t held = lock_clock_nsec() - mutex->acquired_nsec;
+        mutex->acquired_nsec = 0;
+        atomic_fetch_add_explicit(&mutex->lock_class->hold_nsec, held, memory_order_relaxed);
+        atomic_fetch_add_explicit(&mutex->lock_class->hold_histogram[lock_histogram_bucket(held)], 1, memory_order_relaxed);
+    }
+}
+
+
+void sys_mutex_init_class(sys_mutex_t *mutex, sys_lock_class_t **site_class, const char *name)
+{
+    int result = pthread_mutex_init(&(mutex->mutex), 0);
+    (void) result; assert(result == 0);
+    mutex->lock_class    = 0;
+    mutex->acquired_nsec = 0;
+
+    if (sys_lock_profiling_enabled()) {
+        sys_lock_class_t *lock_class = __atomic_load_n(site_class, __ATOMIC_ACQUIRE);
+        if (!lock_class) {
+            pthread_mutex_lock(&lock_classes_lock);
+            lock_class = lock_class_LH(name);
+            pthread_mutex_unlock(&lock_classes_lock);
+            __atomic_store_n(site_class, lock_class, __ATOMIC_RELEASE);
+        }
+        mutex->lock_class = lock_class;
+    }
+}
+
+
+void sys_mutex_init(sys_mutex_t *mutex)
+{
+    sys_mutex_init_class(mutex, &other_lock_class, "other");
+}
+
+#else
 
 void sys_mutex_init(sys_mutex_t *mutex)
 {
     int result = pthread_mutex_init(&(mutex->mutex), 0);
     (void) result; assert(result == 0);
 }
+#endif
 
 
 void sys_mutex_free(sys_mutex_t *mutex)
@@ -51,13 +208,42 @@ void sys_mutex_free(sys_mutex_t *mutex)
 
 void sys_mutex_lock(sys_mutex_t *mutex) TA_ACQ(*mutex) TA_NO_THREAD_SAFETY_ANALYSIS
 {
+#ifndef QD_LOCK_PROFILING
     int result = pthread_mutex_lock(&(mutex->mutex));
     (void) result; assert(result == 0);
+#else
+    if (!mutex->lock_class) {
+        int result = pthread_mutex_lock(&(mutex->mutex));
+        (void) result; assert(result == 0);
+        return;
+    }
+
+    sys_lock_class_t *lock_class = mutex->lock_class;
+    int result = pthread_mutex_trylock(&(mutex->mutex));
+    if (result == EBUSY) {
+        uint64_t start = lock_clock_nsec();
+        result = pthread_mutex_lock(&(mutex->mutex));
+        (void) result; assert(result == 0);
+        mutex->acquired_nsec = lock_clock_nsec();
+        uint64_t waited = mutex->acquired_nsec - start;
+        atomic_fetch_add_explicit(&lock_class->contended, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&lock_class->wait_nsec, waited, memory_order_relaxed);
+        atomic_fetch_add_explicit(&lock_class->wait_histogram[lock_histogram_bucket(waited)], 1, memory_order_relaxed);
+    } else {
+        (void) result; assert(result == 0);
+        mutex->acquired_nsec = lock_clock_nsec();
+    }
+    atomic_fetch_add_explicit(&lock_class->acquired, 1, memory_order_relaxed);
+#endif
 }
 
 
 void sys_mutex_unlock(sys_mutex_t *mutex) TA_REL(*mutex) TA_NO_THREAD_SAFETY_ANALYSIS
 {
+#ifdef QD_LOCK_PROFILING
+    if (mutex->lock_class)
+        lock_profile_release(mutex);
+#endif
     int result = pthread_mutex_unlock(&(mutex->mutex));
     (void) result; assert(result == 0);
 }
@@ -79,8 +265,17 @@ void sys_cond_free(sys_cond_t *cond)
 
 void sys_cond_wait(sys_cond_t *cond, sys_mutex_t *held_mutex) TA_REQ(*held_mutex)
 {
+    // the mutex is not held while waiting for the condition
+#ifdef QD_LOCK_PROFILING
+    if (held_mutex->lock_class)
+        lock_profile_release(held_mutex);
+#endif
     int result = pthread_cond_wait(&(cond->cond), &(held_mutex->mutex));
     (void) result; assert(result == 0);
+#ifdef QD_LOCK_PROFILING
+    if (held_mutex->lock_class)
+        held_mutex->acquired_nsec = lock_clock_nsec();
+#endif
 }
 
 
@@ -140,7 +335,9 @@ static const char thread_names[SYS_THREAD_ROLE_COUNT][SYS_THREAD_NAME_MAX + 1] =
     "core_thread",   // SYS_THREAD_CORE
     "wrkr_",         // SYS_THREAD_PROACTOR (multiple)
     "vflow_thread",  // SYS_THREAD_VFLOW
-    "lws_thread"     // SYS_THREAD_LWS_HTTP
+    "lws_thread",    // SYS_THREAD_LWS_HTTP
+    "python_thread", // SYS_THREAD_PYTHON
+    "tls_hs_thread"  // SYS_THREAD_TLS_HANDSHAKE (multiple)
 };
 
 static sys_atomic_t proactor_thread_count = 0;
@@ -381,13 +578,15 @@ char *test_threading_roles_names(void *context)
 
     // check non-proactor thread roles and names
 
-    sys_thread_role_t roles[3] = {
+    sys_thread_role_t roles[5] = {
         SYS_THREAD_CORE,
         SYS_THREAD_VFLOW,
         SYS_THREAD_LWS_HTTP,
+        SYS_THREAD_PYTHON,
+        SYS_THREAD_TLS_HANDSHAKE,
     };
 
-    for (int i = 0; i < 3; i++) {
+    for (int i = 0; i < 5; i++) {
         sys_mutex_lock(&lock);
 
         sys_thread_t *t = sys_thread(roles[i], test_thread, &lock);
@@ -26,7 +26,9 @@
 #include "qpid/dispatch/amqp.h"
 #include "qpid/dispatch/error.h"
 #include "qpid/dispatch/log.h"
+#include "qpid/dispatch/platform.h"
 #include "qpid/dispatch/router.h"
+#include "qpid/dispatch/threading.h"
 
 #include <proton/disposition.h>
 
@@ -45,6 +47,7 @@ static PyObject        *message_type = 0;
 static PyObject        *dispatch_python_pkgdir = 0;
 
 static void qd_python_setup(void);
+static void python_work_start(void);
 
 
 void qd_python_initialize(qd_dispatch_t *qd, const char *python_pkgdir)
@@ -59,10 +62,12 @@ void qd_python_initialize(qd_dispatch_t *qd, const char *python_pkgdir)
         dispatch_python_pkgdir = PyUnicode_FromString(python_pkgdir);
     qd_python_setup();
     PyEval_SaveThread(); // drop the Python GIL; we will reacquire it in other threads as needed
+    python_work_start();
 }
 
 void qd_python_finalize(void)
 {
+    qd_python_stop_work();
     (void) qd_python_lock();
 
     Py_DECREF(message_type);
@@ -87,6 +92,178 @@ void qd_python_check_lock(void)
 }
 
 
+//===============================================================================
+// Python Work Thread
+//===============================================================================
+
+// Maximum number of work items run before the Python thread releases the GIL to let other threads use it
+#define PYTHON_WORK_BATCH 16
+
+ALLOC_DECLARE(qd_python_work_t);
+ALLOC_DEFINE(qd_python_work_t);
+DEQ_DECLARE(qd_python_work_t, qd_python_work_list_t);
+
+static struct {
+    sys_mutex_t             lock;
+    sys_cond_t              cond;
+    sys_thread_t           *thread;
+    qd_python_work_list_t   queue;
+    qd_python_work_stats_t  stats;
+    bool                    running;
+} python_work;
+
+
+static void *python_work_thread(void *arg)
+{
+    sys_mutex_lock(&python_work.lock);
+    while (python_work.running) {
+        if (DEQ_IS_EMPTY(python_work.queue)) {
+            sys_cond_wait(&python_work.cond, &python_work.lock);
+            continue;
+        }
+        sys_mutex_unlock(&python_work.lock);
+
+        //
+        // Work is removed from the queue only while holding the GIL so that qd_python_cancel_work() (which is called
+        // with the GIL held) cannot race with running it.
+        //
+        qd_python_lock_state_t lock_state = qd_python_lock();
+        sys_mutex_lock(&python_work.lock);
+        qd_python_work_t *work = DEQ_HEAD(python_work.queue);
+        for (int batch = 0; work && batch < PYTHON_WORK_BATCH; ++batch) {
+            DEQ_REMOVE_HEAD(python_work.queue);
+            sys_mutex_unlock(&python_work.lock);
+
+            uint64_t start = qd_platform_monotonic_usec();
+            uint64_t queued = start - work->posted_usec;
+            work->handler(work, false);
+            free_qd_python_work_t(work);
+            uint64_t elapsed = qd_platform_monotonic_usec() - start;
+
+            sys_mutex_lock(&python_work.lock);
+            python_work.stats.calls++;
+            python_work.stats.queue_usec += queued;
+            python_work.stats.call_usec  += elapsed;
+            work = DEQ_HEAD(python_work.queue);
+        }
+        sys_mutex_unlock(&python_work.lock);
+        qd_python_unlock(lock_state);
+        sys_mutex_lock(&python_work.lock);
+    }
+    sys_mutex_unlock(&python_work.lock);
+    return 0;
+}
+
+
+static void python_work_start(void)
+{
+    sys_mutex_init(&python_work.lock);
+    sys_cond_init(&python_work.cond);
+    DEQ_INIT(python_work.queue);
+    ZERO(&python_work.stats);
+    python_work.running = true;
+    python_work.thread  = sys_thread(SYS_THREAD_PYTHON, python_work_thread, 0);
+}
+
+
+void qd_python_stop_work(void)
+{
+    if (!python_work.thread)
+        return;
+
+    sys_mutex_lock(&python_work.lock);
+    python_work.running = false;
+    sys_cond_signal(&python_work.cond);
+    sys_mutex_unlock(&python_work.lock);
+
+    sys_thread_join(python_work.thread);
+    sys_thread_free(python_work.thread);
+    python_work.thread = 0;
+
+    qd_python_work_list_t queue;
+    sys_mutex_lock(&python_work.lock);
+    DEQ_MOVE(python_work.queue, queue);
+    sys_mutex_unlock(&python_work.lock);
+
+    qd_python_work_t *work = DEQ_HEAD(queue);
+    while (work) {
+        DEQ_REMOVE_HEAD(queue);
+        work->handler(work, true);
+        free_qd_python_work_t(work);
+        work = DEQ_HEAD(queue);
+    }
+}
+
+
+qd_python_work_t *qd_python_work(qd_python_work_handler_t handler)
+{
+    qd_python_work_t *work = new_qd_python_work_t();
+    ZERO(work);
+    work->handler = handler;
+    return work;
+}
+
+
+void qd_python_post_work(qd_python_work_t *work)
+{
+    bool notify;
+
+    work->posted_usec = qd_platform_monotonic_usec();
+
+    sys_mutex_lock(&python_work.lock);
+    if (!python_work.running) {
+        sys_mutex_unlock(&python_work.lock);
+        work->handler(work, true);
+        free_qd_python_work_t(work);
+        return;
+    }
+    DEQ_ITEM_INIT(work);
+    DEQ_INSERT_TAIL(python_work.queue, work);
+    python_work.stats.max_queue_depth = MAX(python_work.stats.max_queue_depth, DEQ_SIZE(python_work.queue));
+    notify = DEQ_SIZE(python_work.queue) == 1;
+    sys_mutex_unlock(&python_work.lock);
+
+    if (notify)
+        sys_cond_signal(&python_work.cond);
+}
+
+
+void qd_python_cancel_work(void *context)
+{
+    qd_python_work_list_t cancelled = DEQ_EMPTY;
+
+    assert(PyGILState_Check());
+    sys_mutex_lock(&python_work.lock);
+    qd_python_work_t *work = DEQ_HEAD(python_work.queue);
+    while (work) {
+        qd_python_work_t *next = DEQ_NEXT(work);
+        if (work->context == context) {
+            DEQ_REMOVE(python_work.queue, work);
+            DEQ_INSERT_TAIL(cancelled, work);
+        }
+        work = next;
+    }
+    sys_mutex_unlock(&python_work.lock);
+
+    work = DEQ_HEAD(cancelled);
+    while (work) {
+        DEQ_REMOVE_HEAD(cancelled);
+        work->handler(work, true);
+        free_qd_python_work_t(work);
+        work = DEQ_HEAD(cancelled);
+    }
+}
+
+
+void qd_python_work_stats(qd_python_work_stats_t *stats)
+{
+    sys_mutex_lock(&python_work.lock);
+    *stats = python_work.stats;
+    stats->queue_depth = DEQ_SIZE(python_work.queue);
+    sys_mutex_unlock(&python_work.lock);
+}
+
+
 //===============================================================================
 // Data Conversion Functions
 //===============================================================================
@@ -626,27 +803,21 @@ static qd_error_t iter_to_py_attr(qd_iterator_t *iter,
     return qd_error_code();
 }
 
-static uint64_t qd_io_rx_handler(void *context, qd_message_t *msg, int link_id, int inter_router_cost,
-                                 uint64_t ignore, const qd_policy_spec_t *policy_spec, qdr_error_t **error)
+static void qd_io_rx_work(qd_python_work_t *work, bool discard)
 {
-    IoAdapter *self = (IoAdapter*) context;
-    *error = 0;
+    IoAdapter    *self = (IoAdapter*) work->context;
+    qd_message_t *msg  = work->msg;
 
-    //
-    // Parse the message through the body and exit if the message is not well formed.
-    //
-    if (qd_message_check_depth(msg, QD_DEPTH_BODY) != QD_MESSAGE_DEPTH_OK) {
-        *error = qdr_error(QD_AMQP_COND_DECODE_ERROR, "Parse error in message content");
-        return PN_REJECTED;
+    if (discard) {
+        qd_message_free(msg);
+        return;
     }
 
-    // This is called from non-python threads so we need to acquire the GIL to use python APIS.
-    qd_python_lock_state_t lock_state = qd_python_lock();
     PyObject *py_msg = PyObject_CallFunction(message_type, NULL);
     if (!py_msg) {
         qd_error_py();
-        qd_python_unlock(lock_state);
-        return PN_ACCEPTED;
+        qd_message_free(msg);
+        return;
     }
     iter_to_py_attr(qd_message_field_iterator(msg, QD_FIELD_TO), py_iter_copy, py_msg, "address");
     iter_to_py_attr(qd_message_field_iterator(msg, QD_FIELD_REPLY_TO), py_iter_copy, py_msg, "reply_to");
@@ -655,12 +826,36 @@ static uint64_t qd_io_rx_handler(void *context, qd_message_t *msg, int link_id,
     iter_to_py_attr(qd_message_field_iterator(msg, QD_FIELD_APPLICATION_PROPERTIES), py_iter_parse, py_msg, "properties");
     iter_to_py_attr(qd_message_field_iterator(msg, QD_FIELD_BODY), py_iter_parse, py_msg, "body");
 
-    PyObject *value = PyObject_CallFunction(self->handler, "Oil", py_msg, link_id, inter_router_cost);
+    PyObject *value = PyObject_CallFunction(self->handler, "Oil", py_msg, work->maskbit, work->inter_router_cost);
 
     Py_DECREF(py_msg);
     Py_XDECREF(value);
     qd_error_py();
-    qd_python_unlock(lock_state);
+    qd_message_free(msg);
+}
+
+
+static uint64_t qd_io_rx_handler(void *context, qd_message_t *msg, int link_id, int inter_router_cost,
+                                 uint64_t ignore, const qd_policy_spec_t *policy_spec, qdr_error_t **error)
+{
+    IoAdapter *self = (IoAdapter*) context;
+    *error = 0;
+
+    //
+    // Parse the message through the body and exit if the message is not well formed.
+    //
+    if (qd_message_check_depth(msg, QD_DEPTH_BODY) != QD_MESSAGE_DEPTH_OK) {
+        *error = qdr_error(QD_AMQP_COND_DECODE_ERROR, "Parse error in message content");
+        return PN_REJECTED;
+    }
+
+    // This is called from non-python threads: hand the message to the Python thread rather than wait for the GIL.
+    qd_python_work_t *work  = qd_python_work(qd_io_rx_work);
+    work->context           = self;
+    work->msg               = qd_message_copy(msg);
+    work->maskbit           = link_id;
+    work->inter_router_cost = inter_router_cost;
+    qd_python_post_work(work);
     return PN_ACCEPTED;
 }
 
@@ -721,6 +916,7 @@ static int IoAdapter_clear(IoAdapter* self)
 static void IoAdapter_dealloc(IoAdapter* self)
 {
     qdr_core_unsubscribe(self->sub);
+    qd_python_cancel_work(self);
     PyObject_GC_UnTrack(self);
     IoAdapter_clear(self);
     Py_TYPE(self)->tp_free((PyObject*)self);
@@ -20,8 +20,10 @@
  */
 #include <Python.h>
 
+#include "qpid/dispatch/ctools.h"
 #include "qpid/dispatch/message.h"
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #if PY_MAJOR_VERSION <= 2
@@ -41,6 +43,40 @@
 // buffer.
 char *py_obj_2_c_string(PyObject *py_obj);
 
+//
+// Python work: calls into Python that do not need a result are queued and run, in order, on the dedicated Python
+// thread so that the posting thread never waits for the GIL.
+//
+typedef struct qd_python_work_t qd_python_work_t;
+
+// Runs on the Python thread with the GIL held. When discard is true the GIL is not held: only free the resources
+// referenced by the work item.
+typedef void (*qd_python_work_handler_t)(qd_python_work_t *work, bool discard);
+
+struct qd_python_work_t {
+    DEQ_LINKS(qd_python_work_t);
+    qd_python_work_handler_t  handler;
+    void                     *context;
+    qd_message_t             *msg;
+    int                       maskbit;
+    int                       inter_router_cost;
+    uint64_t                  mobile_seq;
+    uint64_t                  posted_usec;
+};
+
+typedef struct qd_python_work_stats_t {
+    uint64_t queue_depth;      // work items waiting to run
+    uint64_t max_queue_depth;  // high water mark of queue_depth
+    uint64_t calls;            // work items run
+    uint64_t queue_usec;       // total time work items waited to run
+    uint64_t call_usec;        // total time spent running work items
+} qd_python_work_stats_t;
+
+qd_python_work_t *qd_python_work(qd_python_work_handler_t handler);
+void qd_python_post_work(qd_python_work_t *work);
+void qd_python_cancel_work(void *context);  // discard all queued work for context, call with the GIL held
+void qd_python_work_stats(qd_python_work_stats_t *stats);
+
 void qd_json_msgs_init(PyObject **msgs);
 void qd_json_msgs_done(PyObject *msgs);
 void qd_json_msgs_append(PyObject *msgs, qd_message_t *msg);
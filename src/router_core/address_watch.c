@@ -20,12 +20,32 @@
 #include "router_core_private.h"
 #include "qpid/dispatch/amqp.h"
 
+//
+// The update notification state of a watch.  It is shared by reference with the general-work item that delivers the
+// notification, so it outlives the watch if the watch is cancelled while a notification is queued.  At most one
+// notification is queued per watch: address changes while one is queued only refresh the counts it will deliver.
+//
+typedef struct qdr_address_watch_notify_t {
+    sys_mutex_t                 lock;
+    sys_atomic_t                ref_count;
+    qdr_address_watch_update_t  on_update;
+    void                       *context;
+    bool                        pending;            // A notification is queued (lock)
+    uint32_t                    local_consumers;    // Latest counts (lock)
+    uint32_t                    in_proc_consumers;
+    uint32_t                    remote_consumers;
+    uint32_t                    local_producers;
+} qdr_address_watch_notify_t;
+
+ALLOC_DECLARE(qdr_address_watch_notify_t);
+ALLOC_DEFINE(qdr_address_watch_notify_t);
+
 struct qdr_address_watch_t {
     DEQ_LINKS(struct qdr_address_watch_t);
     DEQ_LINKS_N(PER_ADDRESS, struct qdr_address_watch_t);
     qdr_watch_handle_t          watch_handle;
     qdr_address_t              *addr;
-    qdr_address_watch_update_t  on_update;
+    qdr_address_watch_notify_t *notify;
     qdr_address_watch_cancel_t  on_cancel;
     void                       *context;
 };
@@ -38,6 +58,7 @@ static void qdr_watch_cancel_invoker(qdr_core_t *core, qdr_general_work_t *work,
 static void qdr_core_watch_address_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_core_unwatch_address_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_address_watch_free_CT(qdr_core_t *core, qdr_address_watch_t *watch);
+static void qdr_address_watch_notify_decref(qdr_address_watch_notify_t *notify);
 
 //==================================================================================
 // Core Interface Functions
@@ -85,14 +106,25 @@ void qdr_trigger_address_watch_CT(qdr_core_t *core, qdr_address_t *addr)
     qdr_address_watch_t *watch = DEQ_HEAD(addr->watches);
 
     while (!!watch) {
-        qdr_general_work_t *work = qdr_general_work(qdr_watch_invoker);
-        work->watch_update_handler = watch->on_update;
-        work->context              = watch->context;
-        work->local_consumers      = DEQ_SIZE(addr->rlinks);
-        work->in_proc_consumers    = DEQ_SIZE(addr->subscriptions);
-        work->remote_consumers     = qd_bitmask_cardinality(addr->rnodes);
-        work->local_producers      = DEQ_SIZE(addr->inlinks);
-        qdr_post_general_work_CT(core, work);
+        qdr_address_watch_notify_t *notify = watch->notify;
+
+        sys_mutex_lock(&notify->lock);
+        notify->local_consumers   = DEQ_SIZE(addr->rlinks);
+        notify->in_proc_consumers = DEQ_SIZE(addr->subscriptions);
+        notify->remote_consumers  = qd_bitmask_cardinality(addr->rnodes);
+        notify->local_producers   = DEQ_SIZE(addr->inlinks) + DEQ_SIZE(addr->mux_inlinks);
+        bool post = !notify->pending;
+        notify->pending = true;
+        sys_mutex_unlock(&notify->lock);
+
+        if (post) {
+            qdr_general_work_t *work = qdr_general_work(qdr_watch_invoker);
+            sys_atomic_inc(&notify->ref_count);
+            work->context = notify;
+            qdr_post_general_work_CT(core, work);
+        } else {
+            core->addr_watch_notifications_coalesced++;
+        }
         watch = DEQ_NEXT_N(PER_ADDRESS, watch);
     }
 }
@@ -120,15 +152,42 @@ static void qdr_address_watch_free_CT(qdr_core_t *core, qdr_address_watch_t *wat
 
     watch->addr->ref_count--;
     qdr_check_addr_CT(core, watch->addr);
+    qdr_address_watch_notify_decref(watch->notify);
     free_qdr_address_watch_t(watch);
 }
 
 
+static void qdr_address_watch_notify_decref(qdr_address_watch_notify_t *notify)
+{
+    if (sys_atomic_dec(&notify->ref_count) == 1) {
+        sys_mutex_free(&notify->lock);
+        sys_atomic_destroy(&notify->ref_count);
+        free_qdr_address_watch_notify_t(notify);
+    }
+}
+
+
 static void qdr_watch_invoker(qdr_core_t *core, qdr_general_work_t *work, bool discard)
 {
-    if (!discard)
-        work->watch_update_handler(work->context,
-                                   work->local_consumers, work->in_proc_consumers, work->remote_consumers, work->local_producers);
+    qdr_address_watch_notify_t *notify = (qdr_address_watch_notify_t*) work->context;
+
+    //
+    // Clear the pending flag before taking the counts so a change made after this point posts a new notification.
+    //
+    sys_mutex_lock(&notify->lock);
+    notify->pending = false;
+    uint32_t local_consumers   = notify->local_consumers;
+    uint32_t in_proc_consumers = notify->in_proc_consumers;
+    uint32_t remote_consumers  = notify->remote_consumers;
+    uint32_t local_producers   = notify->local_producers;
+    sys_mutex_unlock(&notify->lock);
+
+    if (!discard) {
+        notify->on_update(notify->context, local_consumers, in_proc_consumers, remote_consumers, local_producers);
+        atomic_fetch_add_explicit(&core->addr_watch_notifications, 1, memory_order_relaxed);
+    }
+
+    qdr_address_watch_notify_decref(notify);
 }
 
 
@@ -169,9 +228,15 @@ static void qdr_core_watch_address_CT(qdr_core_t *core, qdr_action_t *action, bo
             ZERO(watch);
             watch->watch_handle = action->args.io.value32_1;
             watch->addr         = addr;
-            watch->on_update    = action->args.io.watch_handler;
             watch->on_cancel    = action->args.io.cancel_handler;
             watch->context      = action->args.io.context;
+
+            watch->notify = new_qdr_address_watch_notify_t();
+            ZERO(watch->notify);
+            sys_mutex_init(&watch->notify->lock);
+            sys_atomic_init(&watch->notify->ref_count, 1);
+            watch->notify->on_update = action->args.io.watch_handler;
+            watch->notify->context   = action->args.io.context;
             DEQ_INSERT_TAIL(core->addr_watches, watch);
 
             DEQ_INSERT_TAIL_N(PER_ADDRESS, addr->watches, watch);
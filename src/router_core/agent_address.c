@@ -42,6 +42,7 @@
 #define QDR_ADDRESS_PRIORITY                           18
 #define QDR_ADDRESS_DELIVERIES_REDIRECTED              19
 #define QDR_ADDRESS_WATCH                              20
+#define QDR_ADDRESS_LATENCY_HISTOGRAM                  21
 
 const char *qdr_address_columns[] =
     {"name",
@@ -65,6 +66,7 @@ const char *qdr_address_columns[] =
      "priority",
      "deliveriesRedirectedToFallback",
      "watch",
+     "deliveryLatencyHistogram",
      0};
 
 
@@ -179,6 +181,13 @@ static void qdr_insert_address_columns_CT(qdr_core_t          *core,
         qd_compose_insert_bool(body, DEQ_SIZE(addr->watches) > 0);
         break;
 
+    case QDR_ADDRESS_LATENCY_HISTOGRAM:
+        qd_compose_start_list(body);
+        for (int i = 0; i < QDR_DELIVERY_LATENCY_BUCKETS; i++)
+            qd_compose_insert_ulong(body, addr->latency_histogram[i]);
+        qd_compose_end_list(body);
+        break;
+
     default:
         qd_compose_insert_null(body);
         break;
@@ -456,6 +456,7 @@ void qdra_config_address_create_CT(qdr_core_t         *core,
         pattern = 0;
 
         DEQ_INSERT_TAIL(core->addr_config, addr);
+        core->addr_config_generation++;
         if (name) {
             qd_iterator_view_t iter_view = qd_iterator_get_view(name);
             qd_iterator_reset_view(name, ITER_VIEW_ADDRESS_HASH);
@@ -18,6 +18,7 @@
  */
 
 #include "agent_connection.h"
+#include "delivery.h"
 
 #include "qpid/dispatch/ctools.h"
 
@@ -49,6 +50,13 @@
 #define QDR_CONNECTION_LAST_DLV_SECONDS      22
 #define QDR_CONNECTION_ENABLE_PROTOCOL_TRACE 23
 #define QDR_CONNECTION_MESH_ID               24
+#define QDR_CONNECTION_DELIVERIES_IN         25
+#define QDR_CONNECTION_DELIVERIES_OUT        26
+#define QDR_CONNECTION_MESSAGE_BUFFERS       27
+#define QDR_CONNECTION_CUT_THROUGH_BUFFERS   28
+#define QDR_CONNECTION_RAW_BUFFERS           29
+#define QDR_CONNECTION_UNSETTLED_DELIVERIES  30
+#define QDR_CONNECTION_MEMORY_BYTES          31
 
 
 const char * const QDR_CONNECTION_DIR_IN  = "in";
@@ -96,6 +104,13 @@ const char *qdr_connection_columns[] =
      "lastDlvSeconds",
      "enableProtocolTrace",
      "meshId",
+     "deliveriesIn",
+     "deliveriesOut",
+     "messageBuffers",
+     "cutThroughBuffers",
+     "rawBuffers",
+     "unsettledDeliveries",
+     "memoryBytes",
      0};
 
 const char *CONNECTION_TYPE = "io.skupper.router.connection";
@@ -123,7 +138,30 @@ static void qd_get_next_pn_data(pn_data_t **data, const char **d, int *d1)
     }
 
 
-static void qdr_connection_insert_column_CT(qdr_core_t *core, qdr_connection_t *conn, int col, qd_composed_field_t *body, bool as_map)
+//
+// Memory held on behalf of a connection.  Message buffers are charged to the connection that received the message
+// (see qd_message_set_account()) for as long as they are held anywhere in the router, including buffers in cut-through
+// slots.  All values are maintained as counters where buffers and deliveries are added and released.
+//
+typedef struct qdr_connection_memory_t {
+    uint64_t message_buffers;
+    uint64_t cut_through_buffers;
+    uint64_t raw_buffers;
+    uint64_t unsettled_deliveries;
+} qdr_connection_memory_t;
+
+
+static void qdr_connection_memory_CT(qdr_connection_t *conn, qdr_connection_memory_t *mem)
+{
+    mem->message_buffers      = qd_message_account_buffers(conn->buffer_account);
+    mem->cut_through_buffers  = qd_message_account_slot_buffers(conn->buffer_account);
+    mem->raw_buffers          = sys_atomic_get(&conn->raw_buffers);
+    mem->unsettled_deliveries = sys_atomic_get(&conn->unsettled_deliveries);
+}
+
+
+static void qdr_connection_insert_column_CT(qdr_core_t *core, qdr_connection_t *conn, const qdr_connection_memory_t *mem,
+                                            int col, qd_composed_field_t *body, bool as_map)
 {
     char id_str[100];
     const char *text = 0;
@@ -235,7 +273,8 @@ static void qdr_connection_insert_column_CT(qdr_core_t *core, qdr_connection_t *
                 qd_compose_insert_bool(body, true);
             }
             else if (core->router_mode  == QD_ROUTER_MODE_EDGE){
-                if (core->active_edge_connection == conn)
+                // In active-active mode every open edge connection carries traffic
+                if (core->active_edge_connection == conn || core->edge_uplinks_active_active)
                     qd_compose_insert_bool(body, true);
                 else
                     qd_compose_insert_bool(body, false);
@@ -313,6 +352,34 @@ static void qdr_connection_insert_column_CT(qdr_core_t *core, qdr_connection_t *
             qd_compose_insert_null(body);
         }
         break;
+
+    case QDR_CONNECTION_DELIVERIES_IN:
+        qd_compose_insert_ulong(body, conn->deliveries_in);
+        break;
+
+    case QDR_CONNECTION_DELIVERIES_OUT:
+        qd_compose_insert_ulong(body, atomic_load_explicit(&conn->deliveries_out, memory_order_relaxed));
+        break;
+
+    case QDR_CONNECTION_MESSAGE_BUFFERS:
+        qd_compose_insert_ulong(body, mem->message_buffers);
+        break;
+
+    case QDR_CONNECTION_CUT_THROUGH_BUFFERS:
+        qd_compose_insert_ulong(body, mem->cut_through_buffers);
+        break;
+
+    case QDR_CONNECTION_RAW_BUFFERS:
+        qd_compose_insert_ulong(body, mem->raw_buffers);
+        break;
+
+    case QDR_CONNECTION_UNSETTLED_DELIVERIES:
+        qd_compose_insert_ulong(body, mem->unsettled_deliveries);
+        break;
+
+    case QDR_CONNECTION_MEMORY_BYTES:
+        qd_compose_insert_ulong(body, (mem->message_buffers + mem->raw_buffers) * QD_BUFFER_SIZE);
+        break;
     }
 
     sys_mutex_unlock(&conn->connection_info->connection_info_lock);
@@ -326,9 +393,11 @@ static void qdr_agent_write_connection_CT(qdr_core_t *core, qdr_query_t *query,
     qd_compose_start_list(body);
 
     if (conn) {
+        qdr_connection_memory_t mem;
+        qdr_connection_memory_CT(conn, &mem);
         int i = 0;
         while (query->columns[i] >= 0) {
-            qdr_connection_insert_column_CT(core, conn, query->columns[i], body, false);
+            qdr_connection_insert_column_CT(core, conn, &mem, query->columns[i], body, false);
             i++;
         }
     }
@@ -429,11 +498,14 @@ static void qdr_manage_write_connection_map_CT(qdr_core_t          *core,
                                                qd_composed_field_t *body,
                                                const char          *qdr_connection_columns[])
 {
+    qdr_connection_memory_t mem;
+    qdr_connection_memory_CT(conn, &mem);
+
     qd_compose_start_map(body);
 
     for(int i = 0; i < QDR_CONNECTION_COLUMN_COUNT; i++) {
         qd_compose_insert_string(body, qdr_connection_columns[i]);
-        qdr_connection_insert_column_CT(core, conn, i, body, false);
+        qdr_connection_insert_column_CT(core, conn, &mem, i, body, false);
     }
 
     qd_compose_end_map(body);
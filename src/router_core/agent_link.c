@@ -50,6 +50,8 @@
 #define QDR_LINK_SETTLE_RATE              25
 #define QDR_LINK_CREDIT_AVAILABLE         26
 #define QDR_LINK_ZERO_CREDIT_SECONDS      27
+#define QDR_LINK_QUEUE_DELAY_HISTOGRAM    28
+#define QDR_LINK_LATENCY_HISTOGRAM        29
 
 const char *qdr_link_columns[] =
     {"name",
@@ -80,6 +82,8 @@ const char *qdr_link_columns[] =
      "settleRate",
      "creditAvailable",
      "zeroCreditSeconds",
+     "queueDelayHistogram",
+     "deliveryLatencyHistogram",
      0};
 
 static const char *qd_link_type_name(qd_link_type_t lt)
@@ -272,6 +276,23 @@ static void qdr_agent_write_column_CT(qdr_core_t *core, qd_composed_field_t *bod
             qd_compose_insert_uint(body, qdr_core_uptime_ticks(core) - link->zero_credit_time);
         break;
 
+    case QDR_LINK_QUEUE_DELAY_HISTOGRAM:
+        if (link->link_direction == QD_OUTGOING) {
+            qd_compose_start_list(body);
+            for (int i = 0; i < QDR_LINK_QDELAY_BUCKETS; i++)
+                qd_compose_insert_ulong(body, link->queue_delay_histogram[i]);
+            qd_compose_end_list(body);
+        } else
+            qd_compose_insert_null(body);
+        break;
+
+    case QDR_LINK_LATENCY_HISTOGRAM:
+        qd_compose_start_list(body);
+        for (int i = 0; i < QDR_DELIVERY_LATENCY_BUCKETS; i++)
+            qd_compose_insert_ulong(body, link->latency_histogram[i]);
+        qd_compose_end_list(body);
+        break;
+
     default:
         qd_compose_insert_null(body);
         break;
@@ -55,6 +55,21 @@
 #define QDR_ROUTER_RSS_USAGE                           26
 #define QDR_ROUTER_CONNECTION_COUNTERS                 27
 #define QDR_ROUTER_VERSION                             28
+#define QDR_ROUTER_ADDR_CONFIG_CACHE_HITS              29
+#define QDR_ROUTER_ADDR_CONFIG_CACHE_MISSES            30
+#define QDR_ROUTER_CONTROL_ACTION_QUEUE_DEPTH          31
+#define QDR_ROUTER_DATA_ACTION_QUEUE_DEPTH             32
+#define QDR_ROUTER_CONTROL_ACTIONS                     33
+#define QDR_ROUTER_DATA_ACTIONS                        34
+#define QDR_ROUTER_CONTROL_ACTION_WAIT_USEC            35
+#define QDR_ROUTER_DATA_ACTION_WAIT_USEC               36
+#define QDR_ROUTER_CONTROL_ACTION_MAX_WAIT_USEC        37
+#define QDR_ROUTER_DATA_ACTION_MAX_WAIT_USEC           38
+#define QDR_ROUTER_ADDR_WATCH_NOTIFICATIONS            39
+#define QDR_ROUTER_ADDR_WATCH_NOTIFICATIONS_COALESCED  40
+#define QDR_ROUTER_DATA_ACTION_WAIT_SAMPLES            41
+#define QDR_ROUTER_EDGE_ADDR_TRACKING_MESSAGES         42
+#define QDR_ROUTER_EDGE_ADDR_TRACKING_UPDATES          43
 
 const char *qdr_router_columns[] =
     {"identity",
@@ -86,6 +101,21 @@ const char *qdr_router_columns[] =
      "residentMemoryUsage",
      "connectionCounters",
      "version",
+     "addressConfigCacheHits",
+     "addressConfigCacheMisses",
+     "controlActionQueueDepth",
+     "dataActionQueueDepth",
+     "controlActions",
+     "dataActions",
+     "controlActionWaitUsec",
+     "dataActionWaitUsec",
+     "controlActionMaxWaitUsec",
+     "dataActionMaxWaitUsec",
+     "addressWatchNotifications",
+     "addressWatchNotificationsCoalesced",
+     "dataActionWaitSamples",
+     "edgeAddressTrackingMessages",
+     "edgeAddressTrackingUpdates",
      0};
 
 static void qdr_agent_write_column_CT(qd_composed_field_t *body, int col, qdr_core_t *core)
@@ -194,6 +224,71 @@ static void qdr_agent_write_column_CT(qd_composed_field_t *body, int col, qdr_co
         qd_compose_insert_uint(body, core->links_blocked);
         break;
 
+    case QDR_ROUTER_ADDR_CONFIG_CACHE_HITS:
+        qd_compose_insert_ulong(body, core->addr_config_cache_hits);
+        break;
+
+    case QDR_ROUTER_ADDR_CONFIG_CACHE_MISSES:
+        qd_compose_insert_ulong(body, core->addr_config_cache_misses);
+        break;
+
+    case QDR_ROUTER_CONTROL_ACTION_QUEUE_DEPTH: {
+        sys_mutex_lock(&core->action_lock);
+        const size_t depth = DEQ_SIZE(core->action_list_control);
+        sys_mutex_unlock(&core->action_lock);
+        qd_compose_insert_ulong(body, depth + DEQ_SIZE(core->action_batch_control));
+    } break;
+
+    case QDR_ROUTER_DATA_ACTION_QUEUE_DEPTH: {
+        sys_mutex_lock(&core->action_lock);
+        const size_t depth = DEQ_SIZE(core->action_list);
+        sys_mutex_unlock(&core->action_lock);
+        qd_compose_insert_ulong(body, depth + DEQ_SIZE(core->action_batch));
+    } break;
+
+    case QDR_ROUTER_CONTROL_ACTIONS:
+        qd_compose_insert_ulong(body, core->control_action_stats.actions);
+        break;
+
+    case QDR_ROUTER_DATA_ACTIONS:
+        qd_compose_insert_ulong(body, core->data_action_stats.actions);
+        break;
+
+    case QDR_ROUTER_CONTROL_ACTION_WAIT_USEC:
+        qd_compose_insert_ulong(body, core->control_action_stats.wait_usec);
+        break;
+
+    case QDR_ROUTER_DATA_ACTION_WAIT_USEC:
+        qd_compose_insert_ulong(body, core->data_action_stats.wait_usec);
+        break;
+
+    case QDR_ROUTER_CONTROL_ACTION_MAX_WAIT_USEC:
+        qd_compose_insert_ulong(body, core->control_action_stats.max_wait_usec);
+        break;
+
+    case QDR_ROUTER_DATA_ACTION_MAX_WAIT_USEC:
+        qd_compose_insert_ulong(body, core->data_action_stats.max_wait_usec);
+        break;
+
+    case QDR_ROUTER_ADDR_WATCH_NOTIFICATIONS:
+        qd_compose_insert_ulong(body, atomic_load_explicit(&core->addr_watch_notifications, memory_order_relaxed));
+        break;
+
+    case QDR_ROUTER_ADDR_WATCH_NOTIFICATIONS_COALESCED:
+        qd_compose_insert_ulong(body, core->addr_watch_notifications_coalesced);
+        break;
+
+    case QDR_ROUTER_DATA_ACTION_WAIT_SAMPLES:
+        qd_compose_insert_ulong(body, core->data_action_stats.waits);
+        break;
+
+    case QDR_ROUTER_EDGE_ADDR_TRACKING_MESSAGES:
+        qd_compose_insert_ulong(body, core->edge_addr_tracking_messages);
+        break;
+
+    case QDR_ROUTER_EDGE_ADDR_TRACKING_UPDATES:
+        qd_compose_insert_ulong(body, core->edge_addr_tracking_updates);
+        break;
 
     case QDR_ROUTER_UPTIME_SECONDS:
         qd_compose_insert_uint(body, qdr_core_uptime_ticks(core));
@@ -35,6 +35,7 @@ static void qdr_connection_opened_CT(qdr_core_t *core, qdr_action_t *action, boo
 static void qdr_connection_notify_closed_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_link_inbound_first_attach_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_link_inbound_second_attach_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
+static void qdr_link_move_delivery_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_link_inbound_detach_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_link_notify_closed_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_link_processing_complete_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
@@ -44,6 +45,7 @@ static void qdr_connection_set_tracing_CT(qdr_core_t *core, qdr_action_t *action
 
 ALLOC_DEFINE_SAFE(qdr_connection_t);
 ALLOC_DEFINE(qdr_connection_work_t);
+ALLOC_DEFINE(qdr_addr_config_cache_entry_t);
 
 //==================================================================================
 // Internal Functions
@@ -116,7 +118,11 @@ qdr_connection_t *qdr_connection_opened(qdr_core_t                   *core,
     DEQ_INIT(conn->work_list);
     DEQ_INIT(conn->streaming_link_pool);
     conn->connection_info->role = conn->role;
-    sys_mutex_init(&conn->work_lock);
+    sys_mutex_init_named(&conn->work_lock, "core.connection.work_lock");
+    sys_atomic_init(&conn->raw_buffers, 0);
+    sys_atomic_init(&conn->unsettled_deliveries, 0);
+    conn->buffer_account = qd_message_account();
+    atomic_init(&conn->deliveries_out, 0);
     conn->conn_uptime = qdr_core_uptime_ticks(core);
 
     if (context_binder) {
@@ -129,7 +135,7 @@ qdr_connection_t *qdr_connection_opened(qdr_core_t                   *core,
     if (qd_log_enabled(LOG_PROTOCOL, QD_LOG_DEBUG)) {
         action->args.connection.enable_protocol_trace = true;
     }
-    qdr_action_enqueue(core, action);
+    qdr_action_fence_enqueue(core, action);
 
     char   props_str[1000];
     size_t props_len = 1000;
@@ -163,7 +169,7 @@ void qdr_connection_notify_closed(qdr_connection_t *conn)
 {
     qdr_action_t *action = qdr_action(qdr_connection_notify_closed_CT, "connection_notify_closed");
     set_safe_ptr_qdr_connection_t(conn, &action->args.connection.conn);
-    qdr_action_enqueue(conn->core, action);
+    qdr_action_fence_enqueue(conn->core, action);
 }
 
 bool qdr_connection_route_container(qdr_connection_t *conn)
@@ -288,6 +294,15 @@ void *qdr_connection_get_context(const qdr_connection_t *conn)
     return conn ? conn->user_context : NULL;
 }
 
+
+void qdr_connection_raw_buffers_held(qdr_connection_t *conn, int delta)
+{
+    if (delta > 0)
+        sys_atomic_add(&conn->raw_buffers, (uint32_t) delta);
+    else if (delta < 0)
+        sys_atomic_sub(&conn->raw_buffers, (uint32_t) -delta);
+}
+
 void qdr_record_link_credit(qdr_core_t *core, qdr_link_t *link)
 {
     //
@@ -359,7 +374,95 @@ void qdr_core_close_connection(qdr_connection_t *conn)
 {
     qdr_action_t *action = qdr_action(qdr_core_close_connection_CT, "qdr_core_close_connection");
     set_safe_ptr_qdr_connection_t(conn, &action->args.connection.conn);
-    qdr_action_enqueue(conn->core, action);
+    qdr_action_fence_enqueue(conn->core, action);
+}
+
+
+//
+// Run the link's pending work in order: flow, drain, detach, and deliveries up to the link's scheduling deficit.
+// The deficit is first credited with 'quantum' octets (a quantum of zero lifts the limit).  Returns true if the
+// link used up its deficit with deliveries still waiting and must be visited again in the next round.
+//
+static bool qdr_connection_process_link_work(qdr_core_t *core, qdr_connection_t *conn, qdr_link_t *link,
+                                             int64_t quantum, int *event_count)
+{
+    qdr_link_work_t *link_work;
+    bool             detach_sent = false;
+    bool             yielded     = false;
+
+    link->drr_deficit = quantum > 0 ? link->drr_deficit + quantum : INT64_MAX;
+    if (link->drr_deficit <= 0) {
+        // The previous round's deliveries overdrew the deficit: sit this round out
+        return true;
+    }
+
+    //
+    // The work lock must be used to protect accesses to the link's work_list and
+    // link_work->processing.
+    //
+    sys_mutex_lock(&conn->work_lock);
+    link_work = DEQ_HEAD(link->work_list);
+    if (link_work) {
+        // link_work ref transferred to local link_work
+        DEQ_REMOVE_HEAD(link->work_list);
+        link_work->processing = true;
+    }
+    sys_mutex_unlock(&conn->work_lock);
+
+    while (link_work) {
+        switch (link_work->work_type) {
+        case QDR_LINK_WORK_DELIVERY :
+            {
+                int count = conn->protocol_adaptor->push_handler(conn->protocol_adaptor->user_context, link, link_work->value);
+                assert(count <= link_work->value);
+                link_work->value -= count;
+                yielded = link_work->value > 0 && count > 0 && link->drr_deficit <= 0;
+                break;
+            }
+
+        case QDR_LINK_WORK_FLOW :
+            if (link_work->value > 0)
+                conn->protocol_adaptor->flow_handler(conn->protocol_adaptor->user_context, link, link_work->value);
+            if      (link_work->drain_action == QDR_LINK_WORK_DRAIN_ACTION_SET)
+                conn->protocol_adaptor->drain_handler(conn->protocol_adaptor->user_context, link, true);
+            else if (link_work->drain_action == QDR_LINK_WORK_DRAIN_ACTION_CLEAR)
+                conn->protocol_adaptor->drain_handler(conn->protocol_adaptor->user_context, link, false);
+            else if (link_work->drain_action == QDR_LINK_WORK_DRAIN_ACTION_DRAINED)
+                conn->protocol_adaptor->drained_handler(conn->protocol_adaptor->user_context, link);
+            break;
+
+        case QDR_LINK_WORK_FIRST_DETACH :
+        case QDR_LINK_WORK_SECOND_DETACH :
+            conn->protocol_adaptor->detach_handler(conn->protocol_adaptor->user_context, link, link_work->error,
+                                                   link_work->work_type == QDR_LINK_WORK_FIRST_DETACH);
+            detach_sent = true;
+            break;
+        }
+
+        sys_mutex_lock(&conn->work_lock);
+        if (link_work->work_type == QDR_LINK_WORK_DELIVERY && link_work->value > 0) {
+            // link_work ref transferred from link_work to work_list
+            DEQ_INSERT_HEAD(link->work_list, link_work);
+            link_work->processing = false;
+            link_work = 0; // Halt work processing
+        } else {
+            qdr_link_work_release(link_work);
+            link_work = DEQ_HEAD(link->work_list);
+            if (link_work) {
+                // link_work ref transferred to local link_work
+                DEQ_REMOVE_HEAD(link->work_list);
+                link_work->processing = true;
+            }
+        }
+        sys_mutex_unlock(&conn->work_lock);
+        (*event_count)++;
+    }
+
+    if (!yielded && !detach_sent) {
+        qdr_record_link_credit(core, link);
+    }
+
+    return yielded;
 }
 
 
@@ -374,7 +477,6 @@ int qdr_connection_process(qdr_connection_t *conn)
 
     qdr_link_ref_t *ref;
     qdr_link_t     *link;
-    bool            detach_sent;
 
     sys_mutex_lock(&conn->work_lock);
 
@@ -431,26 +533,17 @@ int qdr_connection_process(qdr_connection_t *conn)
         work = DEQ_HEAD(work_list);
     }
 
-    // Process the links_with_work array from highest to lowest priority.
+    // Process the links_with_work array from highest to lowest priority.  The links of one priority are
+    // served deficit-round-robin: every round grants each link the priority's quantum of octets and a
+    // link yields to the others once its sent deliveries have consumed its deficit.  This keeps one
+    // high-volume link from monopolizing the connection's turn.
     for (int priority = QDR_MAX_PRIORITY; priority >= 0; -- priority) {
-        ref = DEQ_HEAD(links_with_work[priority]);
-        while (ref) {
-            qdr_link_work_t *link_work;
-            detach_sent = false;
-            link = ref->link;
+        const int64_t quantum = core->link_quantum[priority];
 
-            //
-            // The work lock must be used to protect accesses to the link's work_list and
-            // link_work->processing.
-            //
-            sys_mutex_lock(&conn->work_lock);
-            link_work = DEQ_HEAD(link->work_list);
-            if (link_work) {
-                // link_work ref transferred to local link_work
-                DEQ_REMOVE_HEAD(link->work_list);
-                link_work->processing = true;
-            }
-            sys_mutex_unlock(&conn->work_lock);
+        for (ref = DEQ_HEAD(links_with_work[priority]); ref; ref = DEQ_NEXT(ref)) {
+            link = ref->link;
+            link->drr_deficit = 0;
+            link->drr_done    = false;
 
             //
             // Handle disposition/settlement updates
@@ -468,60 +561,20 @@ int qdr_connection_process(qdr_connection_t *conn)
                 dref = DEQ_HEAD(updated_deliveries);
                 event_count++;
             }
+        }
 
-            while (link_work) {
-                switch (link_work->work_type) {
-                case QDR_LINK_WORK_DELIVERY :
-                    {
-                        int count = conn->protocol_adaptor->push_handler(conn->protocol_adaptor->user_context, link, link_work->value);
-                        assert(count <= link_work->value);
-                        link_work->value -= count;
-                        break;
-                    }
-
-                case QDR_LINK_WORK_FLOW :
-                    if (link_work->value > 0)
-                        conn->protocol_adaptor->flow_handler(conn->protocol_adaptor->user_context, link, link_work->value);
-                    if      (link_work->drain_action == QDR_LINK_WORK_DRAIN_ACTION_SET)
-                        conn->protocol_adaptor->drain_handler(conn->protocol_adaptor->user_context, link, true);
-                    else if (link_work->drain_action == QDR_LINK_WORK_DRAIN_ACTION_CLEAR)
-                        conn->protocol_adaptor->drain_handler(conn->protocol_adaptor->user_context, link, false);
-                    else if (link_work->drain_action == QDR_LINK_WORK_DRAIN_ACTION_DRAINED)
-                        conn->protocol_adaptor->drained_handler(conn->protocol_adaptor->user_context, link);
-                    break;
-
-                case QDR_LINK_WORK_FIRST_DETACH :
-                case QDR_LINK_WORK_SECOND_DETACH :
-                    conn->protocol_adaptor->detach_handler(conn->protocol_adaptor->user_context, link, link_work->error,
-                                                           link_work->work_type == QDR_LINK_WORK_FIRST_DETACH);
-                    detach_sent = true;
-                    break;
-                }
-
-                sys_mutex_lock(&conn->work_lock);
-                if (link_work->work_type == QDR_LINK_WORK_DELIVERY && link_work->value > 0) {
-                    // link_work ref transferred from link_work to work_list
-                    DEQ_INSERT_HEAD(link->work_list, link_work);
-                    link_work->processing = false;
-                    link_work = 0; // Halt work processing
-                } else {
-                    qdr_link_work_release(link_work);
-                    link_work = DEQ_HEAD(link->work_list);
-                    if (link_work) {
-                        // link_work ref transferred to local link_work
-                        DEQ_REMOVE_HEAD(link->work_list);
-                        link_work->processing = true;
-                    }
-                }
-                sys_mutex_unlock(&conn->work_lock);
-                event_count++;
-            }
-
-            if (!detach_sent) {
-                qdr_record_link_credit(core, link);
+        bool pending = true;
+        while (pending) {
+            pending = false;
+            for (ref = DEQ_HEAD(links_with_work[priority]); ref; ref = DEQ_NEXT(ref)) {
+                link = ref->link;
+                if (link->drr_done)
+                    continue;
+                if (qdr_connection_process_link_work(core, conn, link, quantum, &event_count))
+                    pending = true;
+                else
+                    link->drr_done = true;
             }
-
-            ref = DEQ_NEXT(ref);
         }
     }
 
@@ -631,6 +684,12 @@ void qdr_link_stalled_outbound(qdr_link_t *link)
 }
 
 
+void qdr_link_charge_octets(qdr_link_t *link, uint64_t octets)
+{
+    link->drr_deficit -= (int64_t) octets;
+}
+
+
 void qdr_link_set_user_streaming(qdr_link_t *link)
 {
     link->user_streaming = true;
@@ -740,12 +799,25 @@ qdr_link_t *qdr_link_first_attach(qdr_connection_t *conn,
     action->args.connection.initial_delivery = initial_delivery;
     if (!!initial_delivery)
         qdr_delivery_incref(initial_delivery, "qdr_link_first_attach - protect delivery in action list");
-    qdr_action_enqueue(conn->core, action);
+    qdr_action_fence_enqueue(conn->core, action);
 
     return link;
 }
 
 
+void qdr_link_move_delivery(qdr_link_t *link, qdr_delivery_t *delivery)
+{
+    qdr_action_t *action = qdr_action(qdr_link_move_delivery_CT, "link_move_delivery");
+
+    tsan_reset_delivery_ids(delivery, link->conn->identity, link->identity);
+
+    set_safe_ptr_qdr_link_t(link, &action->args.connection.link);
+    action->args.connection.initial_delivery = delivery;
+    qdr_delivery_incref(delivery, "qdr_link_move_delivery - protect delivery in action list");
+    qdr_action_enqueue(link->core, action);
+}
+
+
 void qdr_link_second_attach(qdr_link_t *link, qdr_terminus_t *source, qdr_terminus_t *target)
 {
     qdr_action_t *action = qdr_action(qdr_link_inbound_second_attach_CT, "link_second_attach");
@@ -756,7 +828,7 @@ void qdr_link_second_attach(qdr_link_t *link, qdr_terminus_t *source, qdr_termin
     // ownership of source/target passed to core, core must free them when done
     action->args.connection.source = source;
     action->args.connection.target = target;
-    qdr_action_enqueue(link->core, action);
+    qdr_action_fence_enqueue(link->core, action);
 }
 
 
@@ -767,7 +839,7 @@ void qdr_link_detach_received(qdr_link_t *link, qdr_error_t *error)
     set_safe_ptr_qdr_connection_t(link->conn, &action->args.connection.conn);
     set_safe_ptr_qdr_link_t(link, &action->args.connection.link);
     action->args.connection.error  = error;
-    qdr_action_enqueue(link->core, action);
+    qdr_action_fence_enqueue(link->core, action);
 }
 
 
@@ -777,7 +849,7 @@ void qdr_link_notify_closed(qdr_link_t *link, bool forced)
 
     set_safe_ptr_qdr_link_t(link, &action->args.connection.link);
     action->args.connection.forced_close = forced;
-    qdr_action_enqueue(link->core, action);
+    qdr_action_fence_enqueue(link->core, action);
 }
 
 
@@ -873,6 +945,7 @@ void qdr_link_cleanup_deliveries_CT(qdr_core_t *core, qdr_connection_t *conn, qd
         d = DEQ_NEXT(d);
     }
 
+    sys_atomic_sub(&conn->unsettled_deliveries, DEQ_SIZE(link->unsettled));
     DEQ_MOVE(link->unsettled, unsettled);
     d = DEQ_HEAD(unsettled);
     while (d) {
@@ -1126,6 +1199,11 @@ static void qdr_link_cleanup_CT(qdr_core_t *core, qdr_connection_t *conn, qdr_li
                          link,  QDR_LINK_LIST_CLASS_ADDRESS);
     }
 
+    //
+    // Links closed without a detach still carry their multiplexed address bindings
+    //
+    qdr_core_unbind_address_mux_links_CT(core, link);
+
     if (link->in_streaming_pool) {
         DEQ_REMOVE_N(STREAMING_POOL, conn->streaming_link_pool, link);
         link->in_streaming_pool = false;
@@ -1331,13 +1409,146 @@ void qdr_link_outbound_second_attach_CT(qdr_core_t *core, qdr_link_t *link, qdr_
 }
 
 
+void qdr_addr_config_cache_init(qdr_addr_config_cache_t *cache)
+{
+    cache->hash       = qd_hash(10, 32, 0);
+    cache->generation = 0;
+    cache->key_tokens = 0;  // no patterns configured: every address has the same (null) configuration
+    DEQ_INIT(cache->entries);
+}
+
+
+static void qdr_addr_config_cache_remove_head(qdr_addr_config_cache_t *cache)
+{
+    qdr_addr_config_cache_entry_t *entry = DEQ_HEAD(cache->entries);
+    DEQ_REMOVE_HEAD(cache->entries);
+    qd_hash_remove_by_handle(cache->hash, entry->hash_handle);
+    qd_hash_handle_free(entry->hash_handle);
+    free_qdr_addr_config_cache_entry_t(entry);
+}
+
+
+void qdr_addr_config_cache_free(qdr_addr_config_cache_t *cache)
+{
+    while (DEQ_HEAD(cache->entries))
+        qdr_addr_config_cache_remove_head(cache);
+    qd_hash_free(cache->hash);
+    cache->hash = 0;
+}
+
+
+/**
+ * Discard all entries if the address configuration changed since they were cached.
+ */
+static void qdr_addr_config_cache_refresh_CT(qdr_core_t *core, qdr_addr_config_cache_t *cache)
+{
+    if (cache->generation == core->addr_config_generation)
+        return;
+
+    while (DEQ_HEAD(cache->entries))
+        qdr_addr_config_cache_remove_head(cache);
+    cache->generation = core->addr_config_generation;
+    cache->key_tokens = qd_parse_tree_prefix_tokens(core->addr_parse_tree);
+}
+
+
+/**
+ * Write the cache key of address to key: the address itself, or its first cache->key_tokens tokens followed by '#'
+ * if more tokens follow. The address is tokenized by the parse tree itself so the key cannot disagree with matching.
+ * key must hold QDR_ADDR_CONFIG_KEY_MAX + 2 octets and address must be no longer than QDR_ADDR_CONFIG_KEY_MAX.
+ */
+static void qdr_addr_config_cache_key(const qdr_core_t *core, const qdr_addr_config_cache_t *cache,
+                                      const char *address, char *key)
+{
+    const char *end = 0;
+
+    if (cache->key_tokens >= 0)
+        end = qd_parse_tree_skip_tokens(core->addr_parse_tree, address, cache->key_tokens);  // first token not in key
+
+    if (end) {
+        size_t len = end - address;
+        memcpy(key, address, len);
+        key[len]     = '#';
+        key[len + 1] = '\0';
+    } else {
+        strcpy(key, address);
+    }
+}
+
+
+/**
+ * Look up the address configuration for key in the cache. Returns false on a miss.
+ */
+static bool qdr_addr_config_cache_lookup_CT(qdr_core_t *core, qdr_addr_config_cache_t *cache, const char *key,
+                                            qdr_address_config_t **addr_config)
+{
+    qdr_addr_config_cache_entry_t *entry = 0;
+    qd_hash_retrieve_str(cache->hash, (const unsigned char *) key, (void **) &entry);
+    if (!entry) {
+        core->addr_config_cache_misses++;
+        return false;
+    }
+
+    core->addr_config_cache_hits++;
+    *addr_config = entry->config;
+    return true;
+}
+
+
+static void qdr_addr_config_cache_insert_CT(qdr_addr_config_cache_t *cache, const char *key,
+                                            qdr_address_config_t *addr_config)
+{
+    if (DEQ_SIZE(cache->entries) >= QDR_ADDR_CONFIG_CACHE_SIZE)
+        qdr_addr_config_cache_remove_head(cache);
+
+    qdr_addr_config_cache_entry_t *entry = new_qdr_addr_config_cache_entry_t();
+    ZERO(entry);
+    entry->config = addr_config;
+    if (qd_hash_insert_str(cache->hash, (const unsigned char *) key, entry, &entry->hash_handle) != QD_ERROR_NONE) {
+        free_qdr_addr_config_cache_entry_t(entry);
+        return;
+    }
+    DEQ_INSERT_TAIL(cache->entries, entry);
+}
+
+
+/**
+ * Match address against the address configuration, going through cache.
+ */
+static qdr_address_config_t *qdr_addr_config_match_CT(qdr_core_t *core, qdr_addr_config_cache_t *cache,
+                                                      const char *address)
+{
+    qdr_address_config_t *addr = 0;
+
+    if (strlen(address) > QDR_ADDR_CONFIG_KEY_MAX) {
+        qd_parse_tree_retrieve_match_str(core->addr_parse_tree, address, (void **) &addr);
+        return addr;
+    }
+
+    char key[QDR_ADDR_CONFIG_KEY_MAX + 2];
+    qdr_addr_config_cache_refresh_CT(core, cache);
+    qdr_addr_config_cache_key(core, cache, address, key);
+    if (!qdr_addr_config_cache_lookup_CT(core, cache, key, &addr)) {
+        qd_parse_tree_retrieve_match_str(core->addr_parse_tree, address, (void **) &addr);
+        qdr_addr_config_cache_insert_CT(cache, key, addr);
+    }
+    return addr;
+}
+
+
 qdr_address_config_t *qdr_config_for_address_CT(qdr_core_t *core, qdr_connection_t *conn, qd_iterator_t *iter)
 {
     qdr_address_config_t *addr = 0;
     qd_iterator_view_t old_view = qd_iterator_get_view(iter);
 
     qd_iterator_reset_view(iter, ITER_VIEW_ADDRESS_NO_HOST);
-    qd_parse_tree_retrieve_match(core->addr_parse_tree, iter, (void **) &addr);
+    if (qd_iterator_length(iter) > QDR_ADDR_CONFIG_KEY_MAX) {
+        qd_parse_tree_retrieve_match(core->addr_parse_tree, iter, (void **) &addr);
+    } else {
+        char address[QDR_ADDR_CONFIG_KEY_MAX + 1];
+        qd_iterator_strncpy(iter, address, sizeof(address));
+        addr = qdr_addr_config_match_CT(core, &core->addr_config_cache, address);
+    }
     qd_iterator_annotate_prefix(iter, '\0');
     qd_iterator_reset_view(iter, old_view);
 
@@ -1360,7 +1571,6 @@ qd_address_treatment_t qdr_treatment_for_address_hash_with_default_CT(qdr_core_t
     char *copy    = storage;
     bool  on_heap = false;
     int   length  = qd_iterator_length(iter);
-    qd_address_treatment_t trt = default_treatment;
     qdr_address_config_t *addr = 0;
 
     if (length > HASH_STORAGE_SIZE) {
@@ -1372,20 +1582,18 @@ qd_address_treatment_t qdr_treatment_for_address_hash_with_default_CT(qdr_core_t
 
     if (copy[0] == QD_ITER_HASH_PREFIX_MOBILE) {
         //
-        // Handle the mobile address case
+        // Handle the mobile address case.  Only mobile addresses are configurable so other hashes are not cached.
         //
-        qd_iterator_t *config_iter = qd_iterator_string(&copy[1], ITER_VIEW_ADDRESS_NO_HOST);
-        qd_parse_tree_retrieve_match(core->addr_parse_tree, config_iter, (void **) &addr);
-        if (addr)
-            trt = addr->treatment;
-        qd_iterator_free(config_iter);
+        addr = qdr_addr_config_match_CT(core, &core->addr_treatment_cache, &copy[1]);
     }
 
     if (on_heap)
         free(copy);
 
+    qd_iterator_reset(iter);
+
     *addr_config = addr;
-    return trt;
+    return addr ? addr->treatment : default_treatment;
 }
 
 
@@ -1406,6 +1614,7 @@ void qdr_check_addr_CT(qdr_core_t *core, qdr_address_t *addr)
     if (DEQ_SIZE(addr->subscriptions) == 0
         && DEQ_SIZE(addr->rlinks) == 0
         && DEQ_SIZE(addr->inlinks) == 0
+        && DEQ_SIZE(addr->mux_inlinks) == 0
         && qd_bitmask_cardinality(addr->rnodes) == 0
         && addr->ref_count == 0
         && addr->tracked_deliveries == 0
@@ -1706,6 +1915,9 @@ static void qdr_connection_opened_CT(qdr_core_t *core, qdr_action_t *action, boo
 void qdr_connection_free(qdr_connection_t *conn)
 {
     sys_mutex_free(&conn->work_lock);
+    sys_atomic_destroy(&conn->raw_buffers);
+    sys_atomic_destroy(&conn->unsettled_deliveries);
+    qd_message_account_decref(conn->buffer_account);
     qdr_error_free(conn->error);
     qdr_connection_info_free(conn->connection_info);
     free_qdr_connection_t(conn);
@@ -1964,6 +2176,7 @@ static void qdr_link_process_initial_delivery_CT(qdr_core_t *core, qdr_link_t *l
 
         case QDR_DELIVERY_IN_UNSETTLED:
             DEQ_REMOVE(old_link->unsettled, dlv);
+            sys_atomic_dec(&old_link->conn->unsettled_deliveries);
             dlv->where = QDR_DELIVERY_NOWHERE;
             assert(sys_atomic_get(&dlv->ref_count) > 1);
             qdr_delivery_decref_CT(core, dlv, "qdr_link_process_initial_delivery_CT - remove from unsettled list");
@@ -1994,6 +2207,18 @@ static void qdr_link_process_initial_delivery_CT(qdr_core_t *core, qdr_link_t *l
 }
 
 
+static void qdr_link_move_delivery_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
+{
+    qdr_link_t     *link = safe_deref_qdr_link_t(action->args.connection.link);
+    qdr_delivery_t *dlv  = action->args.connection.initial_delivery;
+
+    if (!discard && !!link && !(link->state & (QDR_LINK_STATE_DETACH_RECVD | QDR_LINK_STATE_DETACH_SENT))) {
+        qdr_link_process_initial_delivery_CT(core, link, dlv);
+    }
+    qdr_delivery_decref(core, dlv, "qdr_link_move_delivery_CT - dropping action reference");
+}
+
+
 static void qdr_link_inbound_first_attach_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
 {
     qdr_connection_t      *conn = safe_deref_qdr_connection_t(action->args.connection.conn);
@@ -2176,6 +2401,7 @@ static void qdr_link_inbound_first_attach_CT(qdr_core_t *core, qdr_action_t *act
         case QD_LINK_EDGE_DOWNLINK:
             qdr_attach_link_downlink_CT(core, conn, link, source);
             qdr_link_outbound_second_attach_CT(core, link, source, target);
+            qdrc_event_link_raise(core, QDRC_EVENT_LINK_OUT_ATTACHED, link);
             break;
         }
     }
@@ -2368,6 +2594,7 @@ static void qdr_link_process_detach(qdr_core_t *core, qdr_link_t *link, qdr_erro
             if (addr) {
                 qdr_core_unbind_address_link_CT(core, addr, link);
             }
+            qdr_core_unbind_address_mux_links_CT(core, link);
             break;
 
         case QD_LINK_CONTROL:
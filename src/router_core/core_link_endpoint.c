@@ -92,6 +92,12 @@ qdr_connection_t *qdrc_endpoint_get_connection_CT(qdrc_endpoint_t *ep)
 }
 
 
+qdr_link_t *qdrc_endpoint_get_link_CT(qdrc_endpoint_t *ep)
+{
+    return !!ep ? ep->link : 0;
+}
+
+
 void qdrc_endpoint_second_attach_CT(qdr_core_t *core, qdrc_endpoint_t *ep, qdr_terminus_t *source, qdr_terminus_t *target)
 {
     qdr_link_outbound_second_attach_CT(core, ep->link, source, target);
@@ -144,7 +150,7 @@ qdr_delivery_t *qdrc_endpoint_delivery_CT(qdr_core_t *core, qdrc_endpoint_t *end
     dlv->delivery_id = next_delivery_id();
     dlv->link_id     = endpoint->link->identity;
     dlv->conn_id     = endpoint->link->conn_id;
-    sys_mutex_init(&dlv->dispo_lock);
+    sys_mutex_init_named(&dlv->dispo_lock, "core.delivery.dispo_lock");
     qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG, DLV_FMT " Delivery created qdrc_endpoint_delivery_CT",
            DLV_ARGS(dlv));
     return dlv;
@@ -185,12 +185,14 @@ qdrc_endpoint_t *qdrc_endpoint_create_link_CT(qdr_core_t           *core,
  *
  *  - The link's direction of delivery flow
  *  - The link's connection
+ *  - The link itself
  *
  * @param endpoint Pointer to an endpoint object
  * @return The requested information (or 0 if not present)
  */
 qd_direction_t    qdrc_endpoint_get_direction_CT(const qdrc_endpoint_t *endpoint);
 qdr_connection_t *qdrc_endpoint_get_connection_CT(qdrc_endpoint_t *endpoint);
+qdr_link_t       *qdrc_endpoint_get_link_CT(qdrc_endpoint_t *endpoint);
 
 /**
  * Respond to a link attach to the core-endpoint. Typically called by the on_first_attach callback.
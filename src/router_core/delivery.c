@@ -328,6 +328,7 @@ bool qdr_delivery_settled_CT(qdr_core_t *core, qdr_delivery_t *dlv) TA_NO_THREAD
 
     if (dlv->where == QDR_DELIVERY_IN_UNSETTLED) {
         DEQ_REMOVE(link->unsettled, dlv);
+        sys_atomic_dec(&conn->unsettled_deliveries);
         dlv->where = QDR_DELIVERY_NOWHERE;
         moved = true;
     }
@@ -356,6 +357,18 @@ bool qdr_delivery_settled_CT(qdr_core_t *core, qdr_delivery_t *dlv) TA_NO_THREAD
     return moved;
 }
 
+// Map a delivery latency onto its QDR_DELIVERY_LATENCY_BUCKETS histogram bucket
+//
+static int qdr_delivery_latency_bucket(uint64_t latency_usec)
+{
+    static const uint64_t bounds_usec[QDR_DELIVERY_LATENCY_BUCKETS - 1] =
+        {100, 200, 500, 1000, 2000, 5000, 10000, 100000, 1000000};
+    int bucket = 0;
+    while (bucket < QDR_DELIVERY_LATENCY_BUCKETS - 1 && latency_usec >= bounds_usec[bucket])
+        bucket++;
+    return bucket;
+}
+
 void qdr_delivery_increment_counters_CT(qdr_core_t *core, qdr_delivery_t *delivery)
 {
     qdr_link_t *link = qdr_delivery_link(delivery);
@@ -414,6 +427,19 @@ void qdr_delivery_increment_counters_CT(qdr_core_t *core, qdr_delivery_t *delive
                 if (link->link_direction ==  QD_INCOMING)
                     core->deliveries_delayed_1sec++;
             }
+
+            if (delivery->ingress_usec) {
+                const uint64_t now     = qdr_core_batch_usec(core);
+                const uint64_t latency = now > delivery->ingress_usec ? now - delivery->ingress_usec : 0;
+                const int      bucket  = qdr_delivery_latency_bucket(latency);
+                link->latency_histogram[bucket]++;
+                if (link->link_direction == QD_INCOMING) {
+                    if (link->link_type == QD_LINK_ENDPOINT)
+                        core->delivery_latency_histogram[bucket]++;
+                } else if (link->owning_addr) {
+                    link->owning_addr->latency_histogram[bucket]++;
+                }
+            }
         }
 
         //
@@ -806,6 +832,7 @@ static void qdr_delivery_anycast_reforward_CT(qdr_core_t *core, qdr_delivery_t *
     if (!!in_link) {
         if (peer->where == QDR_DELIVERY_IN_UNSETTLED) {
             DEQ_REMOVE(in_link->unsettled, peer);
+            sys_atomic_dec(&in_link->conn->unsettled_deliveries);
             qdr_delivery_decref_CT(core, peer, "qdr_delivery_anycast_reforward_CT - removed from unsettled");
             peer->where = QDR_DELIVERY_NOWHERE;
         } else if (peer->where == QDR_DELIVERY_IN_SETTLED) {
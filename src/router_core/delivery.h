@@ -51,6 +51,8 @@ struct qdr_delivery_t {
     qd_delivery_state_t    *remote_state;        ///< outcome-specific data read from remote endpoint
     qd_delivery_state_t    *local_state;         ///< outcome-specific data to send to remote endpoint
     uint32_t                ingress_time;
+    uint64_t                ingress_usec;        ///< Monotonic clock when the delivery was created by the I/O thread
+    uint64_t                enqueue_usec;        ///< When placed on the outgoing link's undelivered list, 0 once sent
     qdr_delivery_where_t    where;
     uint8_t                 tag[QDR_DELIVERY_TAG_MAX];
     int                     tag_length;
@@ -22,21 +22,21 @@
 #include "delivery.h"
 #include "router_core_private.h"
 
+#include "qpid/dispatch/platform.h"
+
 #include <inttypes.h>
 #include <strings.h>
 
 // #define LOG_FORWARD_BALANCED 1
 
-typedef struct qdr_forward_deliver_info_t {
-    DEQ_LINKS(struct qdr_forward_deliver_info_t);
+// Multicast fanouts up to this size are staged on the stack
+#define QDR_FORWARD_MULTICAST_STACK_TARGETS 64
+
+// An outgoing link selected by a multicast fanout and the delivery created for it
+typedef struct qdr_forward_target_t {
     qdr_link_t     *out_link;
     qdr_delivery_t *out_dlv;
-} qdr_forward_deliver_info_t;
-
-ALLOC_DECLARE(qdr_forward_deliver_info_t);
-DEQ_DECLARE(qdr_forward_deliver_info_t, qdr_forward_deliver_info_list_t);
-
-ALLOC_DEFINE(qdr_forward_deliver_info_t);
+} qdr_forward_target_t;
 
 
 // get the control link for a given inter-router connection
@@ -164,7 +164,12 @@ static void qdr_forward_find_closest_remotes_CT(qdr_core_t *core, qdr_address_t
 }
 
 
-qdr_delivery_t *qdr_forward_new_delivery_CT(qdr_core_t *core, qdr_delivery_t *in_dlv, qdr_link_t *out_link, qd_message_t *msg)
+//
+// Create the outgoing delivery for out_link. out_msg is a new fanout reference to the message (see
+// qd_message_add_fanout()) that is owned by the delivery.
+//
+static qdr_delivery_t *qdr_forward_init_delivery_CT(qdr_core_t *core, qdr_delivery_t *in_dlv, qdr_link_t *out_link,
+                                                    qd_message_t *out_msg, bool receive_complete)
 {
     qdr_delivery_t *out_dlv = new_qdr_delivery_t();
     if (out_link->conn)
@@ -172,17 +177,18 @@ qdr_delivery_t *qdr_forward_new_delivery_CT(qdr_core_t *core, qdr_delivery_t *in
 
     ZERO(out_dlv);
     set_safe_ptr_qdr_link_t(out_link, &out_dlv->link_sp);
-    out_dlv->msg        = qd_message_copy(msg);
+    out_dlv->msg        = out_msg;
     out_dlv->delivery_id = next_delivery_id();
     out_dlv->link_id     = out_link->identity;
     out_dlv->conn_id     = out_link->conn_id;
-    sys_mutex_init(&out_dlv->dispo_lock);
+    sys_mutex_init_named(&out_dlv->dispo_lock, "core.delivery.dispo_lock");
     qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG, DLV_FMT " Delivery created qdr_forward_new_delivery_CT",
            DLV_ARGS(out_dlv));
 
     if (in_dlv) {
         out_dlv->settled       = in_dlv->settled;
         out_dlv->ingress_time  = in_dlv->ingress_time;
+        out_dlv->ingress_usec  = in_dlv->ingress_usec;
         out_dlv->ingress_index = in_dlv->ingress_index;
         if (in_dlv->remote_disposition) {
             // propagate disposition state from remote to peer
@@ -191,6 +197,7 @@ qdr_delivery_t *qdr_forward_new_delivery_CT(qdr_core_t *core, qdr_delivery_t *in
     } else {
         out_dlv->settled       = true;
         out_dlv->ingress_time  = qdr_core_uptime_ticks(core);
+        out_dlv->ingress_usec  = qdr_core_batch_usec(core);
         out_dlv->ingress_index = -1;
     }
 
@@ -200,22 +207,30 @@ qdr_delivery_t *qdr_forward_new_delivery_CT(qdr_core_t *core, qdr_delivery_t *in
     memcpy(out_dlv->tag, &tag, sizeof(tag));
     out_dlv->tag_length = sizeof(tag);
 
-    //
-    // Add one to the message fanout. This will later be used in the qd_message_send function that sends out messages.
-    //
-    qd_message_add_fanout(out_dlv->msg);
-
     //
     // Create peer linkage if the outgoing delivery is unsettled. This peer linkage is necessary to deal with dispositions that show up in the future.
     // Also create peer linkage if the message is not yet been completely received. This linkage will help us stream large pre-settled multicast messages.
     //
-    if (!out_dlv->settled || !qd_message_receive_complete(msg))
+    if (!out_dlv->settled || !receive_complete)
         qdr_delivery_link_peers_CT(in_dlv, out_dlv);
 
     return out_dlv;
 }
 
 
+qdr_delivery_t *qdr_forward_new_delivery_CT(qdr_core_t *core, qdr_delivery_t *in_dlv, qdr_link_t *out_link, qd_message_t *msg)
+{
+    qd_message_t *out_msg = qd_message_copy(msg);
+
+    //
+    // Add one to the message fanout. This will later be used in the qd_message_send function that sends out messages.
+    //
+    qd_message_add_fanout(out_msg);
+
+    return qdr_forward_init_delivery_CT(core, in_dlv, out_link, out_msg, qd_message_receive_complete(msg));
+}
+
+
 //
 // Drop all pre-settled deliveries pending on the link's
 // undelivered list.
@@ -270,7 +285,7 @@ static void qdr_forward_drop_presettled_CT_LH(qdr_core_t *core, qdr_link_t *link
 }
 
 
-void qdr_forward_deliver_CT(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery_t *out_dlv)
+static inline void qdr_forward_set_ingress_mesh_CT(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery_t *out_dlv)
 {
     //
     // If we are an edge router and the outgoing link is an edge connection to the interior,
@@ -282,9 +297,16 @@ void qdr_forward_deliver_CT(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery
         && core->edge_mesh_identifier[0] != '\0') {
         qd_message_set_ingress_mesh(out_dlv->msg, core->edge_mesh_identifier);
     }
+}
 
-    sys_mutex_lock(&out_link->conn->work_lock);
 
+//
+// Put out_dlv on the undelivered list of out_link and schedule the link work to send it. The caller must activate the
+// connection after releasing the lock.
+//
+static void qdr_forward_enqueue_CT_LH(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery_t *out_dlv, uint64_t now_usec)
+    TA_REQ(out_link->conn->work_lock)
+{
     //
     // If the delivery is pre-settled and the outbound link is at or above capacity,
     // discard all pre-settled deliveries on the undelivered list prior to enqueuing
@@ -294,7 +316,8 @@ void qdr_forward_deliver_CT(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery
         qdr_forward_drop_presettled_CT_LH(core, out_link);
 
     DEQ_INSERT_TAIL(out_link->undelivered, out_dlv);
-    out_dlv->where = QDR_DELIVERY_IN_UNDELIVERED;
+    out_dlv->where        = QDR_DELIVERY_IN_UNDELIVERED;
+    out_dlv->enqueue_usec = now_usec;
 
     // This incref is for putting the delivery in the undelivered list
     qdr_delivery_incref(out_dlv, "qdr_forward_deliver_CT - add to undelivered list");
@@ -315,6 +338,15 @@ void qdr_forward_deliver_CT(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery
     qdr_add_link_ref(&out_link->conn->links_with_work[out_link->priority], out_link, QDR_LINK_LIST_CLASS_WORK);
 
     out_dlv->link_work = qdr_link_work_getref(work);
+}
+
+
+void qdr_forward_deliver_CT(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery_t *out_dlv)
+{
+    qdr_forward_set_ingress_mesh_CT(core, out_link, out_dlv);
+
+    sys_mutex_lock(&out_link->conn->work_lock);
+    qdr_forward_enqueue_CT_LH(core, out_link, out_dlv, qd_platform_monotonic_usec());
     sys_mutex_unlock(&out_link->conn->work_lock);
 
     //
@@ -324,6 +356,44 @@ void qdr_forward_deliver_CT(qdr_core_t *core, qdr_link_t *out_link, qdr_delivery
 }
 
 
+static int qdr_forward_target_by_conn(const void *a, const void *b)
+{
+    const qdr_connection_t *conn_a = ((const qdr_forward_target_t *) a)->out_link->conn;
+    const qdr_connection_t *conn_b = ((const qdr_forward_target_t *) b)->out_link->conn;
+    return conn_a < conn_b ? -1 : conn_a > conn_b ? 1 : 0;
+}
+
+
+//
+// Deliver a multicast fanout. Targets are grouped by outgoing connection so that each connection's work lock is taken
+// and the connection activated once, however many of its links receive a copy.
+//
+static void qdr_forward_deliver_targets_CT(qdr_core_t *core, qdr_forward_target_t *targets, int count)
+{
+    if (count > 1)
+        qsort(targets, count, sizeof(qdr_forward_target_t), qdr_forward_target_by_conn);
+
+    const uint64_t now_usec = qd_platform_monotonic_usec();
+    int i = 0;
+    while (i < count) {
+        qdr_connection_t *conn = targets[i].out_link->conn;
+
+        for (int j = i; j < count && targets[j].out_link->conn == conn; ++j)
+            qdr_forward_set_ingress_mesh_CT(core, targets[j].out_link, targets[j].out_dlv);
+
+        sys_mutex_lock(&conn->work_lock);
+        for (; i < count && targets[i].out_link->conn == conn; ++i)
+            qdr_forward_enqueue_CT_LH(core, targets[i].out_link, targets[i].out_dlv, now_usec);
+        sys_mutex_unlock(&conn->work_lock);
+
+        //
+        // Activate the outgoing connection for later processing.
+        //
+        qdr_connection_activate_CT(core, conn);
+    }
+}
+
+
 static void qdr_settle_subscription_delivery_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
 {
     qdr_delivery_t *in_delivery = action->args.delivery.delivery;
@@ -544,8 +614,16 @@ int qdr_forward_multicast_CT(qdr_core_t      *core,
     qd_bitmask_t *link_exclusion       = !!in_delivery ? in_delivery->link_exclusion : 0;
     bool          receive_complete     = qd_message_receive_complete(msg);
 
-    qdr_forward_deliver_info_list_t deliver_info_list;
-    DEQ_INIT(deliver_info_list);
+    //
+    // The outgoing links are gathered first so that the message references for all of them can be made in one batch.
+    // There is at most one target per local receiver link and one per next-hop router.
+    //
+    qdr_forward_target_t  stack_targets[QDR_FORWARD_MULTICAST_STACK_TARGETS];
+    qdr_forward_target_t *targets      = stack_targets;
+    int                   target_count = 0;
+    const int max_targets = DEQ_SIZE(addr->rlinks) + qd_bitmask_cardinality(addr->rnodes);
+    if (max_targets > QDR_FORWARD_MULTICAST_STACK_TARGETS)
+        targets = (qdr_forward_target_t *) qd_malloc(max_targets * sizeof(qdr_forward_target_t));
 
     //
     // Forward to local subscribers
@@ -565,14 +643,7 @@ int qdr_forward_multicast_CT(qdr_core_t      *core,
                 }
 
                 if (out_link) {
-                    qdr_delivery_t *out_delivery = qdr_forward_new_delivery_CT(core, in_delivery, out_link, msg);
-
-                    // Store the out_link and out_delivery so we can forward the delivery later on
-                    qdr_forward_deliver_info_t *deliver_info = new_qdr_forward_deliver_info_t();
-                    ZERO(deliver_info);
-                    deliver_info->out_dlv = out_delivery;
-                    deliver_info->out_link = out_link;
-                    DEQ_INSERT_TAIL(deliver_info_list, deliver_info);
+                    targets[target_count++].out_link = out_link;
 
                     fanout++;
                     if (out_link->link_type != QD_LINK_CONTROL && out_link->link_type != QD_LINK_ROUTER) {
@@ -655,14 +726,7 @@ int qdr_forward_multicast_CT(qdr_core_t      *core,
             }
 
             if (dest_link) {
-                qdr_delivery_t *out_delivery = qdr_forward_new_delivery_CT(core, in_delivery, dest_link, msg);
-
-                // Store the out_link and out_delivery so we can forward the delivery later on
-                qdr_forward_deliver_info_t *deliver_info = new_qdr_forward_deliver_info_t();
-                ZERO(deliver_info);
-                deliver_info->out_dlv = out_delivery;
-                deliver_info->out_link = dest_link;
-                DEQ_INSERT_TAIL(deliver_info_list, deliver_info);
+                targets[target_count++].out_link = dest_link;
 
                 fanout++;
                 addr->deliveries_transit++;
@@ -674,6 +738,27 @@ int qdr_forward_multicast_CT(qdr_core_t      *core,
         qd_bitmask_free(conn_set);
     }
 
+    if (target_count > 0) {
+        assert(target_count <= max_targets);
+
+        //
+        // Make the fanout references to the message for all targets at once, then create the outgoing deliveries.
+        //
+        qd_message_t  *stack_msgs[QDR_FORWARD_MULTICAST_STACK_TARGETS];
+        qd_message_t **out_msgs = target_count > QDR_FORWARD_MULTICAST_STACK_TARGETS
+            ? (qd_message_t **) qd_malloc(target_count * sizeof(qd_message_t *))
+            : stack_msgs;
+        target_count = qd_message_copy_fanout(msg, out_msgs, target_count);
+
+        for (int i = 0; i < target_count; ++i) {
+            targets[i].out_dlv = qdr_forward_init_delivery_CT(core, in_delivery, targets[i].out_link, out_msgs[i],
+                                                              receive_complete);
+        }
+
+        if (out_msgs != stack_msgs)
+            free(out_msgs);
+    }
+
     if (!exclude_inprocess) {
         //
         // Forward to in-process subscribers
@@ -687,13 +772,10 @@ int qdr_forward_multicast_CT(qdr_core_t      *core,
         }
     }
 
-    qdr_forward_deliver_info_t *deliver_info = DEQ_HEAD(deliver_info_list);
-    while (deliver_info) {
-        qdr_forward_deliver_CT(core, deliver_info->out_link, deliver_info->out_dlv);
-        DEQ_REMOVE_HEAD(deliver_info_list);
-        free_qdr_forward_deliver_info_t(deliver_info);
-        deliver_info = DEQ_HEAD(deliver_info_list);
-    }
+    qdr_forward_deliver_targets_CT(core, targets, target_count);
+
+    if (targets != stack_targets)
+        free(targets);
 
     return fanout;
 }
@@ -22,35 +22,174 @@
 
 #include "qpid/dispatch/amqp.h"
 #include "qpid/dispatch/ctools.h"
+#include "qpid/dispatch/parse.h"
 
 #include <stdio.h>
 
+//
+// Reachability updates are not sent as they happen.  The edge inlinks whose state changed are collected per edge peer
+// and sent together by an action queued behind the work that produced them, so a burst of address changes (e.g. a
+// site coming up) yields one message per edge peer instead of one per address per edge peer.  Peers that do not
+// advertise QD_CAPABILITY_EDGE_ADDRESS_BATCH still receive one address per message.
+//
+#define QDRC_ADDR_TRACKING_BATCH_MAX 256
+#define QDRC_ADDR_INTEREST_CREDIT    32
+
+//
+// An edge in multiplexed proxy mode (router edgeAddressProxy) does not attach a link per mobile address.  It sends
+// its address interest over a link to QD_TERMINUS_EDGE_ADDRESS_INTEREST instead.  The body of each message is a list
+// of address/consumer/producer triples.  Consumer interest binds the edge's downlink to the address as a multiplexed
+// binding, producer interest makes the edge peer receive reachability updates for the address over its tracking
+// link exactly as it would for an attached edge inlink.  Producer interest also binds the interest link to the
+// address so that the edge's producers are counted (e.g. by address watches) as attached edge inlinks would be.
+// An interest with neither flag set is withdrawn.
+//
 typedef struct qdr_addr_tracking_module_context_t     qdr_addr_tracking_module_context_t;
 typedef struct qdr_addr_endpoint_state_t              qdr_addr_endpoint_state_t;
+typedef struct qdr_addr_interest_state_t              qdr_addr_interest_state_t;
 
 struct qdr_addr_endpoint_state_t {
     DEQ_LINKS(qdr_addr_endpoint_state_t);
     qdrc_endpoint_t                    *endpoint;
     qdr_connection_t                   *conn;    // The connection associated with the endpoint.
     qdr_addr_tracking_module_context_t *mc;
+    qdr_link_ref_list_t                 pending_links; // Inlinks with a reachability update not yet sent
+    qdr_edge_interest_list_t            pending_interests; // Producer interests with a reachability update not yet sent
     int                                ref_count;
     bool                               closed; // Is the endpoint that this state belong to closed?
+    bool                               batch;  // The edge peer accepts many addresses per message
 };
 
 DEQ_DECLARE(qdr_addr_endpoint_state_t, qdr_addr_endpoint_state_list_t);
 ALLOC_DECLARE(qdr_addr_endpoint_state_t);
 ALLOC_DEFINE(qdr_addr_endpoint_state_t);
 
+struct qdr_addr_interest_state_t {
+    DEQ_LINKS(qdr_addr_interest_state_t);
+    qdrc_endpoint_t                    *endpoint;
+    qdr_connection_t                   *conn;
+    qdr_addr_tracking_module_context_t *mc;
+    qdr_edge_interest_list_t            interests;
+    qdr_link_t_sp                       downlink_sp; // The edge downlink that carries deliveries for consumer interests
+    qdr_addr_endpoint_state_t          *tracking;    // [ref] Tracking endpoint that carries reachability updates
+};
+
+DEQ_DECLARE(qdr_addr_interest_state_t, qdr_addr_interest_state_list_t);
+ALLOC_DECLARE(qdr_addr_interest_state_t);
+ALLOC_DEFINE(qdr_addr_interest_state_t);
+
+struct qdr_edge_interest_t {
+    DEQ_LINKS(qdr_edge_interest_t);              // Linkage in the interest state's list
+    DEQ_LINKS_N(ADDR, qdr_edge_interest_t);      // Linkage in addr->edge_interests
+    DEQ_LINKS_N(PENDING, qdr_edge_interest_t);   // Linkage in the tracking endpoint's pending_interests
+    qdr_addr_interest_state_t *state;
+    qdr_address_t             *addr;             // [ref] Held by addr->ref_count
+    qdr_mux_binding_t_sp       binding_sp;       // Binding of the downlink while the edge has consumers
+    qdr_mux_binding_t_sp       producer_binding_sp; // Binding of the interest link while the edge has producers
+    bool                       consumer;         // Bound (or to be bound once the downlink attaches) to the downlink
+    bool                       producer;
+    bool                       reachable;        // The last reachability state sent for a producer interest
+    bool                       pending;
+};
+
+ALLOC_DECLARE(qdr_edge_interest_t);
+ALLOC_DEFINE(qdr_edge_interest_t);
+
 struct  qdr_addr_tracking_module_context_t {
     qdr_core_t                     *core;
     qdr_addr_endpoint_state_list_t  endpoint_state_list;
+    qdr_addr_interest_state_list_t  interest_state_list;
     qdrc_event_subscription_t      *event_sub;
     qdrc_endpoint_desc_t           addr_tracking_endpoint;
+    qdrc_endpoint_desc_t           addr_interest_endpoint;
+    bool                            flush_scheduled;
 };
 
 
-static qd_message_t *qdcm_edge_create_address_dlv(qdr_core_t *core, qdr_address_t   *addr, bool insert_addr)
+static void qdrc_clear_pending_updates(qdr_addr_endpoint_state_t *endpoint_state)
+{
+    qdr_link_ref_t *ref = DEQ_HEAD(endpoint_state->pending_links);
+    while (ref) {
+        qdr_del_link_ref(&endpoint_state->pending_links, ref->link, QDR_LINK_LIST_CLASS_EDGE_ADDR);
+        ref = DEQ_HEAD(endpoint_state->pending_links);
+    }
+
+    qdr_edge_interest_t *interest = DEQ_HEAD(endpoint_state->pending_interests);
+    while (interest) {
+        DEQ_REMOVE_HEAD_N(PENDING, endpoint_state->pending_interests);
+        interest->pending = false;
+        interest = DEQ_HEAD(endpoint_state->pending_interests);
+    }
+}
+
+
+//
+// Drop a reference to an endpoint state.  The state is freed once its endpoint is closed and it is no longer
+// referenced.
+//
+static void qdrc_release_endpoint_state(qdr_addr_endpoint_state_t *endpoint_state)
+{
+    endpoint_state->ref_count--;
+    if (endpoint_state->ref_count == 0 && endpoint_state->closed) {
+        qdr_addr_tracking_module_context_t *mc = endpoint_state->mc;
+        if (mc) {
+            DEQ_REMOVE(mc->endpoint_state_list, endpoint_state);
+        }
+        endpoint_state->conn = 0;
+        endpoint_state->endpoint = 0;
+        free_qdr_addr_endpoint_state_t(endpoint_state);
+    }
+}
+
+
+//
+// Compose an update message from the head of the endpoint's pending list, removing the links it covers.  The body is
+// a list of address/reachable pairs.
+//
+static qd_message_t *qdcm_edge_create_address_dlv(qdr_core_t *core, qdr_addr_endpoint_state_t *endpoint_state)
 {
+    int max_count = endpoint_state->batch ? QDRC_ADDR_TRACKING_BATCH_MAX : 1;
+    int count     = 0;
+
+    qd_composed_field_t *body = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
+
+    qd_compose_start_list(body);
+
+    qdr_link_ref_t *ref = DEQ_HEAD(endpoint_state->pending_links);
+    while (ref && count < max_count) {
+        qdr_link_t    *link = ref->link;
+        qdr_address_t *addr = link->owning_addr;
+        if (addr) {
+            const char *addr_str = (const char*) qd_hash_key_by_handle(addr->hash_handle);
+            qd_compose_insert_string(body, addr_str);
+            qd_compose_insert_bool(body, link->edge_reachable);
+            count++;
+        }
+        qdr_del_link_ref(&endpoint_state->pending_links, link, QDR_LINK_LIST_CLASS_EDGE_ADDR);
+        ref = DEQ_HEAD(endpoint_state->pending_links);
+    }
+
+    qdr_edge_interest_t *interest = DEQ_HEAD(endpoint_state->pending_interests);
+    while (interest && count < max_count) {
+        const char *addr_str = (const char*) qd_hash_key_by_handle(interest->addr->hash_handle);
+        qd_compose_insert_string(body, addr_str);
+        qd_compose_insert_bool(body, interest->reachable);
+        count++;
+        DEQ_REMOVE_HEAD_N(PENDING, endpoint_state->pending_interests);
+        interest->pending = false;
+        interest = DEQ_HEAD(endpoint_state->pending_interests);
+    }
+
+    qd_compose_end_list(body);
+
+    if (count == 0) {
+        qd_compose_free(body);
+        return 0;
+    }
+
+    core->edge_addr_tracking_messages++;
+    core->edge_addr_tracking_updates += count;
+
     qd_message_t *msg = qd_message();
 
     //
@@ -61,16 +200,6 @@ static qd_message_t *qdcm_edge_create_address_dlv(qdr_core_t *core, qdr_address_
     qd_compose_insert_bool(fld, 0);     // durable
     qd_compose_end_list(fld);
 
-    qd_composed_field_t *body = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
-
-    qd_compose_start_list(body);
-
-    const char *addr_str = (const char*) qd_hash_key_by_handle(addr->hash_handle);
-
-    qd_compose_insert_string(body, addr_str);
-    qd_compose_insert_bool(body, insert_addr);
-    qd_compose_end_list(body);
-
     // Finally, compose and return the message so it can be sent out.
     qd_message_compose_3(msg, fld, body, true);
 
@@ -80,11 +209,15 @@ static qd_message_t *qdcm_edge_create_address_dlv(qdr_core_t *core, qdr_address_
     return msg;
 }
 
+//
+// Find the open tracking endpoint of a connection.  A closed endpoint may linger in the list until its last reference
+// is released, possibly alongside the tracking link that replaced it.
+//
 static qdr_addr_endpoint_state_t *qdrc_get_endpoint_state_for_connection(qdr_addr_endpoint_state_list_t  endpoint_state_list, qdr_connection_t *conn)
 {
     qdr_addr_endpoint_state_t *endpoint_state = DEQ_HEAD(endpoint_state_list);
     while(endpoint_state) {
-        if (endpoint_state->conn == conn) {
+        if (endpoint_state->conn == conn && !endpoint_state->closed) {
             return endpoint_state;
         }
         endpoint_state = DEQ_NEXT(endpoint_state);
@@ -93,6 +226,12 @@ static qdr_addr_endpoint_state_t *qdrc_get_endpoint_state_for_connection(qdr_add
 }
 
 
+static qdr_addr_interest_state_t *qdrc_get_interest_state_for_connection(qdr_addr_tracking_module_context_t *mc,
+                                                                         qdr_connection_t                   *conn);
+static void qdrc_interest_set_tracking(qdr_addr_interest_state_t *state, qdr_addr_endpoint_state_t *tracking);
+static void qdrc_interest_bind_downlink(qdr_addr_interest_state_t *state, qdr_link_t *downlink);
+
+
 static void qdrc_address_endpoint_first_attach(void              *bind_context,
                                                qdrc_endpoint_t   *endpoint,
                                                void             **link_context,
@@ -113,9 +252,15 @@ static void qdrc_address_endpoint_first_attach(void              *bind_context,
         endpoint_state->endpoint  = endpoint;
         endpoint_state->mc        = bc;
         endpoint_state->conn      = qdrc_endpoint_get_connection_CT(endpoint);
+        endpoint_state->batch     = qdr_terminus_has_capability(remote_source, QD_CAPABILITY_EDGE_ADDRESS_BATCH);
+        DEQ_INIT(endpoint_state->pending_links);
         DEQ_INSERT_TAIL(bc->endpoint_state_list, endpoint_state);
         *link_context = endpoint_state;
         qdrc_endpoint_second_attach_CT(bc->core, endpoint, remote_source, remote_target);
+
+        qdr_addr_interest_state_t *interest_state = qdrc_get_interest_state_for_connection(bc, endpoint_state->conn);
+        if (interest_state && (!interest_state->tracking || interest_state->tracking->closed))
+            qdrc_interest_set_tracking(interest_state, endpoint_state);
     }
     else {
         //
@@ -149,6 +294,7 @@ static void qdrc_address_endpoint_cleanup(void *link_context)
         qdr_addr_tracking_module_context_t *mc = endpoint_state->mc;
         assert (endpoint_state->conn);
         endpoint_state->closed = true;
+        qdrc_clear_pending_updates(endpoint_state);
         if (endpoint_state->ref_count == 0) {
 
             //
@@ -216,18 +362,79 @@ static bool qdrc_can_send_address(qdr_address_t *addr, qdr_connection_t *in_conn
 }
 
 
-static void qdrc_send_message(qdr_core_t *core, qdr_address_t *addr, qdrc_endpoint_t *endpoint, bool insert_addr)
+static void qdrc_flush_updates_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
 {
-    if (!addr)
+    if (discard)
         return;
 
-    if (!endpoint)
+    qdr_addr_tracking_module_context_t *mc = (qdr_addr_tracking_module_context_t*) action->args.general.context_1;
+    mc->flush_scheduled = false;
+
+    qdr_addr_endpoint_state_t *endpoint_state = DEQ_HEAD(mc->endpoint_state_list);
+    while (endpoint_state) {
+        while ((!DEQ_IS_EMPTY(endpoint_state->pending_links) || !DEQ_IS_EMPTY(endpoint_state->pending_interests))
+               && !!endpoint_state->endpoint && !endpoint_state->closed) {
+            qd_message_t *msg = qdcm_edge_create_address_dlv(core, endpoint_state);
+            if (msg) {
+                qdr_delivery_t *dlv = qdrc_endpoint_delivery_CT(core, endpoint_state->endpoint, msg);
+                qdrc_endpoint_send_CT(core, endpoint_state->endpoint, dlv, false);
+            }
+        }
+        endpoint_state = DEQ_NEXT(endpoint_state);
+    }
+}
+
+
+//
+// Record that the reachability of the link's address changed for the link's edge peer.  The link's edge_reachable
+// flag holds the state to be sent; a link changing again before the update is sent is sent only once.
+//
+static void qdrc_schedule_flush(qdr_core_t *core, qdr_addr_tracking_module_context_t *mc)
+{
+    if (!mc->flush_scheduled) {
+        mc->flush_scheduled = true;
+        qdr_action_t *action = qdr_action(qdrc_flush_updates_CT, "edge_addr_tracking_flush");
+        action->args.general.context_1 = mc;
+        qdr_action_enqueue(core, action);
+    }
+}
+
+
+static void qdrc_send_message(qdr_core_t *core, qdr_link_t *link, qdr_addr_endpoint_state_t *endpoint_state)
+{
+    qdr_add_link_ref(&endpoint_state->pending_links, link, QDR_LINK_LIST_CLASS_EDGE_ADDR);
+    qdrc_schedule_flush(core, endpoint_state->mc);
+}
+
+
+//
+// Recompute the reachability of a producer interest and queue an update to the edge peer if it changed.
+//
+static void qdrc_check_interest(qdr_core_t *core, qdr_edge_interest_t *interest)
+{
+    qdr_addr_endpoint_state_t *tracking = interest->state->tracking;
+    if (!interest->producer || !tracking || !tracking->endpoint || tracking->closed)
         return;
 
-    qd_message_t *msg = qdcm_edge_create_address_dlv(core, addr, insert_addr);
-    qdr_delivery_t *dlv = qdrc_endpoint_delivery_CT(core, endpoint, msg);
+    bool reachable = qdrc_can_send_address(interest->addr, interest->state->conn);
+    if (reachable != interest->reachable) {
+        interest->reachable = reachable;
+        if (!interest->pending) {
+            interest->pending = true;
+            DEQ_INSERT_TAIL_N(PENDING, tracking->pending_interests, interest);
+        }
+        qdrc_schedule_flush(core, tracking->mc);
+    }
+}
+
 
-    qdrc_endpoint_send_CT(core, endpoint, dlv, false);
+static void qdrc_check_edge_interests(qdr_core_t *core, qdr_address_t *addr)
+{
+    qdr_edge_interest_t *interest = DEQ_HEAD(addr->edge_interests);
+    while (interest) {
+        qdrc_check_interest(core, interest);
+        interest = DEQ_NEXT_N(ADDR, interest);
+    }
 }
 
 
@@ -243,19 +450,21 @@ static void qdrc_update_edge_peers(qdr_core_t *core, qdr_address_t *addr, bool r
             if (!!endpoint && !endpoint_state->closed) {
                 if (reachable) {
                     if (!link->edge_reachable && qdrc_can_send_address(addr, endpoint_state->conn)) {
-                        qdrc_send_message(core, addr, endpoint, true);
                         link->edge_reachable = true;
+                        qdrc_send_message(core, link, endpoint_state);
                     }
                 } else {
                     if (link->edge_reachable && !qdrc_can_send_address(addr, endpoint_state->conn)) {
-                        qdrc_send_message(core, addr, endpoint, false);
                         link->edge_reachable = false;
+                        qdrc_send_message(core, link, endpoint_state);
                     }
                 }
             }
         }
         inlink = DEQ_NEXT(inlink);
     }
+
+    qdrc_check_edge_interests(core, addr);
 }
 
 
@@ -275,19 +484,21 @@ static void qdrc_check_edge_peers(qdr_core_t *core, qdr_address_t *addr)
             if (!!endpoint && !endpoint_state->closed) {
                 if (!link->edge_reachable) {
                     if (qdrc_can_send_address(addr, endpoint_state->conn)) {
-                        qdrc_send_message(core, addr, endpoint, true);
                         link->edge_reachable = true;
+                        qdrc_send_message(core, link, endpoint_state);
                     }
                 } else {
                     if (!qdrc_can_send_address(addr, endpoint_state->conn)) {
-                        qdrc_send_message(core, addr, endpoint, false);
                         link->edge_reachable = false;
+                        qdrc_send_message(core, link, endpoint_state);
                     }
                 }
             }
         }
         inlink = DEQ_NEXT(inlink);
     }
+
+    qdrc_check_edge_interests(core, addr);
 }
 
 
@@ -356,9 +567,9 @@ static void on_link_event(void *context, qdrc_event_t event, qdr_link_t *link)
                     assert(link->edge_context == 0);
                     link->edge_context = endpoint_state;
                     endpoint_state->ref_count++;
-                    if (qdrc_can_send_address(addr, link->conn)) {
-                        qdrc_send_message(mc->core, addr, endpoint_state->endpoint, true);
+                    if (qdrc_can_send_address(addr, link->conn) && !endpoint_state->closed) {
                         link->edge_reachable = true;
+                        qdrc_send_message(mc->core, link, endpoint_state);
                     }
                 }
             }
@@ -369,20 +580,20 @@ static void on_link_event(void *context, qdrc_event_t event, qdr_link_t *link)
         {
             if (link->edge_context) {
                 qdr_addr_endpoint_state_t *endpoint_state = (qdr_addr_endpoint_state_t*) link->edge_context;
-                endpoint_state->ref_count--;
+                qdr_del_link_ref(&endpoint_state->pending_links, link, QDR_LINK_LIST_CLASS_EDGE_ADDR);
                 link->edge_context = 0;
-                //
-                // The endpoint has been closed and no other links are referencing this endpoint. Time to free it.
-                //
-                if (endpoint_state->ref_count == 0 && endpoint_state->closed) {
-                    qdr_addr_tracking_module_context_t *mc = endpoint_state->mc;
-                    if (mc) {
-                        DEQ_REMOVE(mc->endpoint_state_list, endpoint_state);
-                    }
-                    endpoint_state->conn = 0;
-                    endpoint_state->endpoint = 0;
-                    free_qdr_addr_endpoint_state_t(endpoint_state);
-                }
+                qdrc_release_endpoint_state(endpoint_state);
+            }
+            break;
+        }
+
+        case QDRC_EVENT_LINK_OUT_ATTACHED :
+        {
+            qdr_addr_tracking_module_context_t *mc = (qdr_addr_tracking_module_context_t*) context;
+            if (link->link_type == QD_LINK_EDGE_DOWNLINK) {
+                qdr_addr_interest_state_t *interest_state = qdrc_get_interest_state_for_connection(mc, link->conn);
+                if (interest_state)
+                    qdrc_interest_bind_downlink(interest_state, link);
             }
             break;
         }
@@ -393,6 +604,324 @@ static void on_link_event(void *context, qdrc_event_t event, qdr_link_t *link)
 }
 
 
+static qdr_addr_interest_state_t *qdrc_get_interest_state_for_connection(qdr_addr_tracking_module_context_t *mc,
+                                                                         qdr_connection_t                   *conn)
+{
+    qdr_addr_interest_state_t *state = DEQ_HEAD(mc->interest_state_list);
+    while (state && state->conn != conn)
+        state = DEQ_NEXT(state);
+    return state;
+}
+
+
+//
+// Reachability updates for producer interests are sent over the tracking link of the same edge connection.  Updates
+// that could not be sent before the tracking link attached are queued now.  When the edge re-attaches its tracking
+// link the closed endpoint is replaced and the reachable interests are announced again on the new one.
+//
+static void qdrc_interest_set_tracking(qdr_addr_interest_state_t *state, qdr_addr_endpoint_state_t *tracking)
+{
+    qdr_addr_endpoint_state_t *old_tracking = state->tracking;
+
+    state->tracking = tracking;
+    tracking->ref_count++;
+
+    qdr_edge_interest_t *interest = DEQ_HEAD(state->interests);
+    while (interest) {
+        assert(!interest->pending);  // cleared when the old endpoint closed
+        interest->reachable = false;
+        qdrc_check_interest(state->mc->core, interest);
+        interest = DEQ_NEXT(interest);
+    }
+
+    if (old_tracking)
+        qdrc_release_endpoint_state(old_tracking);
+}
+
+
+//
+// Bind the edge's downlink to every address the edge has consumers for.  Consumer interest that arrived before the
+// downlink attached, or that outlived a previous downlink, is bound here.
+//
+static void qdrc_interest_bind_downlink(qdr_addr_interest_state_t *state, qdr_link_t *downlink)
+{
+    qdr_core_t *core = state->mc->core;
+
+    set_safe_ptr_qdr_link_t(downlink, &state->downlink_sp);
+
+    qdr_edge_interest_t *interest = DEQ_HEAD(state->interests);
+    while (interest) {
+        if (interest->consumer && !safe_deref_qdr_mux_binding_t(interest->binding_sp)) {
+            qdr_mux_binding_t *binding = qdr_core_bind_address_mux_link_CT(core, interest->addr, downlink);
+            set_safe_ptr_qdr_mux_binding_t(binding, &interest->binding_sp);
+        }
+        interest = DEQ_NEXT(interest);
+    }
+}
+
+
+static qdr_link_t *qdrc_interest_downlink(qdr_addr_interest_state_t *state)
+{
+    qdr_link_t *downlink = safe_deref_qdr_link_t(state->downlink_sp);
+    if (!downlink) {
+        qdr_link_ref_t *ref = DEQ_HEAD(state->conn->links);
+        while (ref && !downlink) {
+            if (ref->link->link_type == QD_LINK_EDGE_DOWNLINK && ref->link->link_direction == QD_OUTGOING)
+                downlink = ref->link;
+            ref = DEQ_NEXT(ref);
+        }
+        if (downlink)
+            set_safe_ptr_qdr_link_t(downlink, &state->downlink_sp);
+    }
+    return downlink;
+}
+
+
+//
+// Free an interest record.  The address is released only while the core is running; at shutdown the addresses have
+// already been freed.
+//
+static void qdrc_free_interest(qdr_core_t *core, qdr_edge_interest_t *interest, bool release_addr)
+{
+    qdr_addr_interest_state_t *state = interest->state;
+    qdr_address_t             *addr  = interest->addr;
+
+    DEQ_REMOVE(state->interests, interest);
+    if (interest->pending) {
+        DEQ_REMOVE_N(PENDING, state->tracking->pending_interests, interest);
+        interest->pending = false;
+    }
+
+    if (release_addr) {
+        DEQ_REMOVE_N(ADDR, addr->edge_interests, interest);
+        qdr_mux_binding_t *binding = safe_deref_qdr_mux_binding_t(interest->binding_sp);
+        if (binding)
+            qdr_core_unbind_address_mux_link_CT(core, binding);
+        binding = safe_deref_qdr_mux_binding_t(interest->producer_binding_sp);
+        if (binding)
+            qdr_core_unbind_address_mux_link_CT(core, binding);
+        addr->ref_count--;
+        qdr_check_addr_CT(core, addr);
+    }
+
+    free_qdr_edge_interest_t(interest);
+}
+
+
+static void qdrc_apply_interest(qdr_addr_interest_state_t *state, qd_iterator_t *key_iter, bool consumer, bool producer)
+{
+    qdr_core_t          *core     = state->mc->core;
+    qdr_address_t       *addr     = 0;
+    qdr_edge_interest_t *interest = 0;
+
+    qd_iterator_reset_view(key_iter, ITER_VIEW_ALL);
+    qd_hash_retrieve(core->addr_hash, key_iter, (void**) &addr);
+    if (addr) {
+        if (!qdr_address_is_mobile_CT(addr))
+            return;
+        interest = DEQ_HEAD(addr->edge_interests);
+        while (interest && interest->state != state)
+            interest = DEQ_NEXT_N(ADDR, interest);
+    }
+
+    if (!interest) {
+        if (!consumer && !producer)
+            return;
+
+        if (!addr) {
+            if (qd_iterator_octet(key_iter) != QD_ITER_HASH_PREFIX_MOBILE)
+                return;
+            qd_iterator_reset(key_iter);
+
+            qdr_address_config_t   *addr_config;
+            qd_address_treatment_t  treatment = qdr_treatment_for_address_hash_CT(core, key_iter, &addr_config);
+            addr = qdr_address_CT(core, treatment, addr_config);
+            if (!addr)
+                return;
+            qd_hash_insert(core->addr_hash, key_iter, addr, &addr->hash_handle);
+            DEQ_ITEM_INIT(addr);
+            DEQ_INSERT_TAIL(core->addrs, addr);
+        }
+
+        interest = new_qdr_edge_interest_t();
+        ZERO(interest);
+        DEQ_ITEM_INIT(interest);
+        DEQ_ITEM_INIT_N(ADDR, interest);
+        DEQ_ITEM_INIT_N(PENDING, interest);
+        interest->state = state;
+        interest->addr  = addr;
+        addr->ref_count++;
+        DEQ_INSERT_TAIL(state->interests, interest);
+        DEQ_INSERT_TAIL_N(ADDR, addr->edge_interests, interest);
+    }
+
+    if (!consumer && !producer) {
+        qdrc_free_interest(core, interest, true);
+        return;
+    }
+
+    //
+    // Consumer interest is remembered even while the edge has no downlink; it is bound when the downlink attaches.
+    //
+    interest->consumer = consumer;
+    qdr_mux_binding_t *binding = safe_deref_qdr_mux_binding_t(interest->binding_sp);
+    if (consumer && !binding) {
+        qdr_link_t *downlink = qdrc_interest_downlink(state);
+        if (downlink) {
+            binding = qdr_core_bind_address_mux_link_CT(core, addr, downlink);
+            set_safe_ptr_qdr_mux_binding_t(binding, &interest->binding_sp);
+        }
+    } else if (!consumer && binding) {
+        qd_nullify_safe_ptr(&interest->binding_sp);
+        qdr_core_unbind_address_mux_link_CT(core, binding);
+    }
+
+    //
+    // Producer interest is bound to the interest link, which lasts as long as the interest itself.
+    //
+    interest->producer = producer;
+    binding = safe_deref_qdr_mux_binding_t(interest->producer_binding_sp);
+    if (producer && !binding) {
+        binding = qdr_core_bind_address_mux_link_CT(core, addr, qdrc_endpoint_get_link_CT(state->endpoint));
+        set_safe_ptr_qdr_mux_binding_t(binding, &interest->producer_binding_sp);
+    } else if (!producer && binding) {
+        qd_nullify_safe_ptr(&interest->producer_binding_sp);
+        qdr_core_unbind_address_mux_link_CT(core, binding);
+    }
+
+    if (producer) {
+        qdrc_check_interest(core, interest);
+    } else if (interest->pending) {
+        DEQ_REMOVE_N(PENDING, state->tracking->pending_interests, interest);
+        interest->pending   = false;
+        interest->reachable = false;
+    } else {
+        interest->reachable = false;
+    }
+}
+
+
+static void qdrc_interest_endpoint_first_attach(void             *bind_context,
+                                                qdrc_endpoint_t  *endpoint,
+                                                void            **link_context,
+                                                qdr_terminus_t   *remote_source,
+                                                qdr_terminus_t   *remote_target)
+{
+    qdr_addr_tracking_module_context_t *mc   = (qdr_addr_tracking_module_context_t*) bind_context;
+    qdr_connection_t                   *conn = qdrc_endpoint_get_connection_CT(endpoint);
+
+    //
+    // Address interest is only accepted from an edge router sending over its edge connection.
+    //
+    if (conn->role == QDR_ROLE_EDGE_CONNECTION && qdrc_endpoint_get_direction_CT(endpoint) == QD_INCOMING) {
+        qdr_addr_interest_state_t *state = new_qdr_addr_interest_state_t();
+        ZERO(state);
+        DEQ_ITEM_INIT(state);
+        state->endpoint = endpoint;
+        state->conn     = conn;
+        state->mc       = mc;
+        DEQ_INSERT_TAIL(mc->interest_state_list, state);
+        *link_context = state;
+
+        qdr_addr_endpoint_state_t *tracking = qdrc_get_endpoint_state_for_connection(mc->endpoint_state_list, conn);
+        if (tracking && !tracking->closed)
+            qdrc_interest_set_tracking(state, tracking);
+
+        //
+        // The capability in the returned target tells the edge that its interest will be honored.
+        //
+        if (remote_target)
+            qdr_terminus_add_capability(remote_target, QD_CAPABILITY_EDGE_ADDRESS_INTEREST);
+        qdrc_endpoint_second_attach_CT(mc->core, endpoint, remote_source, remote_target);
+        qdrc_endpoint_flow_CT(mc->core, endpoint, QDRC_ADDR_INTEREST_CREDIT, false);
+    } else {
+        qdr_error_t *error;
+        if (conn->role != QDR_ROLE_EDGE_CONNECTION)
+            error = qdr_error("qd:connection-role", "Connection does not support address interest");
+        else
+            error = qdr_error(QD_AMQP_COND_NOT_IMPLEMENTED, "Outgoing messages not allowed");
+        *link_context = 0;
+        qdrc_endpoint_detach_CT(mc->core, endpoint, error);
+        qdr_terminus_free(remote_source);
+        qdr_terminus_free(remote_target);
+    }
+}
+
+
+static void qdrc_interest_endpoint_transfer(void           *link_context,
+                                            qdr_delivery_t *dlv,
+                                            qd_message_t   *msg)
+{
+    qdr_addr_interest_state_t *state = (qdr_addr_interest_state_t*) link_context;
+    qdr_core_t                *core  = state->mc->core;
+    uint64_t                   dispo = PN_ACCEPTED;
+
+    if (qd_message_check_depth(msg, QD_DEPTH_BODY) == QD_MESSAGE_DEPTH_OK) {
+        qd_iterator_t     *iter  = qd_message_field_iterator(msg, QD_FIELD_BODY);
+        qd_parsed_field_t *body  = qd_parse_lazy(iter);
+        uint32_t           count = !!body && qd_parse_is_list(body) ? qd_parse_sub_count(body) : 0;
+        for (uint32_t idx = 0; idx + 2 < count; idx += 3) {
+            qd_parsed_field_t *key_field      = qd_parse_sub_value(body, idx);
+            qd_parsed_field_t *consumer_field = qd_parse_sub_value(body, idx + 1);
+            qd_parsed_field_t *producer_field = qd_parse_sub_value(body, idx + 2);
+
+            if (qd_parse_is_scalar(key_field) && qd_parse_is_scalar(consumer_field) && qd_parse_is_scalar(producer_field)) {
+                qdrc_apply_interest(state, qd_parse_raw(key_field),
+                                    qd_parse_as_bool(consumer_field), qd_parse_as_bool(producer_field));
+            }
+        }
+
+        qd_parse_free(body);
+        qd_iterator_free(iter);
+    } else {
+        qd_log(LOG_ROUTER_CORE, QD_LOG_ERROR,
+               "Edge Address Tracking: received an invalid address interest message, rejecting");
+        dispo = PN_REJECTED;
+    }
+
+    qdrc_endpoint_settle_CT(core, dlv, dispo);
+    qdrc_endpoint_flow_CT(core, state->endpoint, 1, false);
+}
+
+
+static void qdrc_interest_endpoint_on_first_detach(void *link_context, qdr_error_t *error)
+{
+    qdr_addr_interest_state_t *state = (qdr_addr_interest_state_t*) link_context;
+    qdrc_endpoint_detach_CT(state->mc->core, state->endpoint, 0);
+    qdr_error_free(error);
+}
+
+
+static void qdrc_free_interest_state(qdr_addr_interest_state_t *state, bool release_addrs)
+{
+    qdr_addr_tracking_module_context_t *mc = state->mc;
+
+    qdr_edge_interest_t *interest = DEQ_HEAD(state->interests);
+    while (interest) {
+        qdrc_free_interest(mc->core, interest, release_addrs);
+        interest = DEQ_HEAD(state->interests);
+    }
+
+    if (state->tracking)
+        qdrc_release_endpoint_state(state->tracking);
+
+    DEQ_REMOVE(mc->interest_state_list, state);
+    free_qdr_addr_interest_state_t(state);
+}
+
+
+static void qdrc_interest_endpoint_cleanup(void *link_context)
+{
+    qdr_addr_interest_state_t *state = (qdr_addr_interest_state_t*) link_context;
+    if (state) {
+        //
+        // The edge's interest ends with the link.  At shutdown the addresses have already been freed by the core.
+        //
+        qdrc_free_interest_state(state, state->mc->core->running);
+    }
+}
+
+
 static bool qdrc_edge_address_tracking_enable_CT(qdr_core_t *core)
 {
     return core->router_mode == QD_ROUTER_MODE_INTERIOR;
@@ -415,6 +944,16 @@ static void qdrc_edge_address_tracking_init_CT(qdr_core_t *core, void **module_c
     context->addr_tracking_endpoint.on_cleanup  = qdrc_address_endpoint_cleanup;
     qdrc_endpoint_bind_mobile_address_CT(core, QD_TERMINUS_EDGE_ADDRESS_TRACKING, &context->addr_tracking_endpoint, context);
 
+    //
+    // Bind to the static address QD_TERMINUS_EDGE_ADDRESS_INTEREST
+    //
+    context->addr_interest_endpoint.label            = "qdrc_edge_address_interest";
+    context->addr_interest_endpoint.on_first_attach  = qdrc_interest_endpoint_first_attach;
+    context->addr_interest_endpoint.on_transfer      = qdrc_interest_endpoint_transfer;
+    context->addr_interest_endpoint.on_first_detach  = qdrc_interest_endpoint_on_first_detach;
+    context->addr_interest_endpoint.on_cleanup       = qdrc_interest_endpoint_cleanup;
+    qdrc_endpoint_bind_mobile_address_CT(core, QD_TERMINUS_EDGE_ADDRESS_INTEREST, &context->addr_interest_endpoint, context);
+
     //
     // Subscribe to address and link events.
     //
@@ -426,7 +965,8 @@ static void qdrc_edge_address_tracking_init_CT(qdr_core_t *core, void **module_c
             | QDRC_EVENT_ADDR_LOCAL_CHANGED
             | QDRC_EVENT_ADDR_REMOTE_CHANGED
             | QDRC_EVENT_LINK_EDGE_DATA_ATTACHED
-            | QDRC_EVENT_LINK_EDGE_DATA_DETACHED,
+            | QDRC_EVENT_LINK_EDGE_DATA_DETACHED
+            | QDRC_EVENT_LINK_OUT_ATTACHED,
             0,
             on_link_event,
             on_addr_event,
@@ -439,10 +979,18 @@ static void qdrc_edge_address_tracking_final_CT(void *module_context)
 {
     qdr_addr_tracking_module_context_t *mc = ( qdr_addr_tracking_module_context_t*) module_context;
 
+    // Interest states release their references to the endpoint states, the addresses are already gone.
+    qdr_addr_interest_state_t *interest_state = DEQ_HEAD(mc->interest_state_list);
+    while (interest_state) {
+        qdrc_free_interest_state(interest_state, false);
+        interest_state = DEQ_HEAD(mc->interest_state_list);
+    }
+
     // If there are any endpoint states still hanging around, clean it up.
     qdr_addr_endpoint_state_t *endpoint_state = DEQ_HEAD(mc->endpoint_state_list);
     while (endpoint_state) {
         DEQ_REMOVE_HEAD(mc->endpoint_state_list);
+        qdrc_clear_pending_updates(endpoint_state);
         free_qdr_addr_endpoint_state_t(endpoint_state);
         endpoint_state = DEQ_HEAD(mc->endpoint_state_list);
     }
@@ -24,12 +24,14 @@
 #include "router_core_private.h"
 
 #include "qpid/dispatch/amqp.h"
+#include "qpid/dispatch/hash.h"
 #include "qpid/dispatch/iterator.h"
 #include "qpid/dispatch/message.h"
 #include "qpid/dispatch/parse.h"
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 //
 // This is the Address Proxy component of the Edge Router module.
@@ -62,17 +64,66 @@
 //    7) For addresses that have at least one local non-proxy destination, maintain inbound links
 //       on each open inter-edge connection.
 //
+//  Related to active-active uplinks (router edgeUplinkMode):
+//
+//    8) Every open edge connection is an uplink with its own anonymous sender, edge-downlink and
+//       address-tracking link.  The per-address proxy links of items 3 and 4 are placed on the
+//       uplink chosen by rendezvous hashing of the address, so that adding or losing an uplink
+//       only moves the addresses that hash to that uplink.  In active-standby mode the only uplink
+//       is the active edge connection.
+//
+//  Related to multiplexed proxying (router edgeAddressProxy):
+//
+//    9) Instead of the per-address links of items 3 and 4, each uplink has one outgoing link to
+//       QD_TERMINUS_EDGE_ADDRESS_INTEREST over which changes in local consumer/producer interest are
+//       sent in batches.  Deliveries for local consumers arrive over the edge-downlink and local
+//       producers send over the anonymous sender, which is bound to an address as a multiplexed
+//       binding while the interior reports destinations for it.  The number of links on an uplink
+//       is therefore independent of the number of addresses.  An uplink to an interior router that
+//       does not return QD_CAPABILITY_EDGE_ADDRESS_INTEREST is proxied per address.
+//
 
 #define INITIAL_CREDIT 32
 
+//
+// Interest announcements are batched per uplink.  A batch is also sent once its address keys reach
+// INTEREST_BATCH_OCTETS so that an announcement fits in a single transfer frame.
+//
+#define INTEREST_BATCH_MAX    256
+#define INTEREST_BATCH_OCTETS 8192
+
+#define INTEREST_CONSUMER 0x01
+#define INTEREST_PRODUCER 0x02
+
+typedef struct qcm_edge_uplink_t qcm_edge_uplink_t;
+
+struct qcm_edge_uplink_t {
+    DEQ_LINKS(qcm_edge_uplink_t);
+    qcm_edge_addr_proxy_t *ap;
+    qdr_connection_t      *conn;               ///< Zero once the uplink is lost
+    qdrc_endpoint_t       *tracking_endpoint;
+    qdrc_endpoint_t       *interest_endpoint;  ///< Address interest link (multiplexed proxying only)
+    qdr_link_t_sp          anonymous_sp;       ///< The uplink's anonymous sender
+    qd_composed_field_t   *interest_batch;     ///< Interest announcements not yet sent
+    int                    interest_batch_count;
+    size_t                 interest_batch_octets;
+    uint32_t               seed;               ///< Rendezvous hash seed, derived from the interior's container-id
+    bool                   interest_active;    ///< The interior accepted the address interest link
+    bool                   per_address;        ///< Multiplexed proxying is not available, proxy per address
+};
+
+DEQ_DECLARE(qcm_edge_uplink_t, qcm_edge_uplink_list_t);
+
 struct qcm_edge_addr_proxy_t {
     qdr_core_t                *core;
     qdrc_event_subscription_t *event_sub;
-    bool                       edge_conn_established;
     qdr_address_t             *edge_conn_addr;
     qdr_connection_t          *edge_conn;
-    qdrc_endpoint_t           *tracking_endpoint;
+    qcm_edge_uplink_list_t     uplinks;
     qdrc_endpoint_desc_t       endpoint_descriptor;
+    qdrc_endpoint_desc_t       interest_descriptor;
+    qdr_address_list_t         interest_pending;   ///< Addresses with an interest change to announce
+    bool                       interest_flush_scheduled;
 };
 
 
@@ -95,13 +146,80 @@ static qdr_terminus_t *qdr_terminus_normal(const char *addr)
 }
 
 
+static qcm_edge_uplink_t *find_uplink(qcm_edge_addr_proxy_t *ap, const qdr_connection_t *conn)
+{
+    qcm_edge_uplink_t *uplink = DEQ_HEAD(ap->uplinks);
+    while (!!uplink && uplink->conn != conn)
+        uplink = DEQ_NEXT(uplink);
+    return uplink;
+}
+
+
+static uint32_t uplink_weight(const qcm_edge_uplink_t *uplink, const char *key)
+{
+    uint32_t hash = HASH_INIT ^ uplink->seed;
+    while (*key)
+        hash = HASH_COMPUTE(hash, *key++);
+
+    //
+    // Finalize (murmur3 fmix32) so that addresses with a common prefix spread evenly
+    //
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+
+/**
+ * Choose the uplink that will carry the proxy links for the address with the given hash key.
+ * Returns zero if there is no established uplink.
+ */
+static qcm_edge_uplink_t *select_uplink(qcm_edge_addr_proxy_t *ap, const char *key)
+{
+    qcm_edge_uplink_t *uplink = DEQ_HEAD(ap->uplinks);
+    if (DEQ_SIZE(ap->uplinks) < 2)
+        return uplink;
+
+    qcm_edge_uplink_t *best        = 0;
+    uint32_t           best_weight = 0;
+    while (!!uplink) {
+        uint32_t weight = uplink_weight(uplink, key);
+        if (!best || weight > best_weight) {
+            best        = uplink;
+            best_weight = weight;
+        }
+        uplink = DEQ_NEXT(uplink);
+    }
+    return best;
+}
+
+
+static void del_inlink(qcm_edge_addr_proxy_t *ap, qdr_address_t *addr);
+static void del_outlink(qcm_edge_addr_proxy_t *ap, qdr_address_t *addr);
+
+
 static void add_inlink(qcm_edge_addr_proxy_t *ap, const char *key, qdr_address_t *addr)
 {
+    qcm_edge_uplink_t *uplink = select_uplink(ap, key);
+    if (!uplink)
+        return;
+
     qdr_link_t *edge_inlink = safe_deref_qdr_link_t(addr->edge_inlink_sp);
+    if (!!edge_inlink && edge_inlink->conn != uplink->conn) {
+        //
+        // The set of uplinks has changed and this address now hashes to a different uplink.
+        //
+        del_inlink(ap, addr);
+        edge_inlink = 0;
+    }
+
     if (edge_inlink == 0) {
         qdr_terminus_t *term = qdr_terminus_normal(key + 1);
 
-        qdr_link_t *link = qdr_create_link_CT(ap->core, ap->edge_conn, QD_LINK_ENDPOINT, QD_INCOMING,
+        qdr_link_t *link = qdr_create_link_CT(ap->core, uplink->conn, QD_LINK_ENDPOINT, QD_INCOMING,
                                               term, qdr_terminus_normal(0), QD_SSN_ENDPOINT,
                                               QDR_DEFAULT_PRIORITY);
         link->proxy = true;
@@ -124,7 +242,16 @@ static void del_inlink(qcm_edge_addr_proxy_t *ap, qdr_address_t *addr)
 
 static void add_outlink(qcm_edge_addr_proxy_t *ap, const char *key, qdr_address_t *addr)
 {
+    qcm_edge_uplink_t *uplink = select_uplink(ap, key);
+    if (!uplink)
+        return;
+
     qdr_link_t *edge_outlink = safe_deref_qdr_link_t(addr->edge_outlink_sp);
+    if (!!edge_outlink && edge_outlink->conn != uplink->conn) {
+        del_outlink(ap, addr);
+        edge_outlink = 0;
+    }
+
     if (edge_outlink == 0 && DEQ_SIZE(addr->subscriptions) == 0) {
         //
         // Note that this link must not be bound to the address at this time.  That will
@@ -133,7 +260,7 @@ static void add_outlink(qcm_edge_addr_proxy_t *ap, const char *key, qdr_address_
         //
         qdr_terminus_t *term = qdr_terminus_normal(key + 1);
 
-        qdr_link_t *link = qdr_create_link_CT(ap->core, ap->edge_conn, QD_LINK_ENDPOINT, QD_OUTGOING,
+        qdr_link_t *link = qdr_create_link_CT(ap->core, uplink->conn, QD_LINK_ENDPOINT, QD_OUTGOING,
                                               qdr_terminus_normal(0), term, QD_SSN_ENDPOINT,
                                               QDR_DEFAULT_PRIORITY);
         link->proxy = true;
@@ -254,6 +381,333 @@ static void on_link_event(void *context, qdrc_event_t event, qdr_link_t *link)
 }
 
 
+/**
+ * Ensure that the proxy links for a mobile address are in place on the uplink selected for it.
+ */
+static void proxy_addr_on_uplink(qcm_edge_addr_proxy_t *ap, qdr_address_t *addr)
+{
+    const char *key = (const char*) qd_hash_key_by_handle(addr->hash_handle);
+    if (*key != QD_ITER_HASH_PREFIX_MOBILE)
+        return;
+
+    //
+    // If the address has more than zero attached destinations, create an
+    // incoming link from the interior to signal the presence of local consumers.
+    // The proxy links (those on the uplinks, the multiplexed bindings of the
+    // uplinks' anonymous senders and the inter-edge proxies) are not local
+    // consumers, however many of them there are.
+    //
+    if (DEQ_SIZE(addr->rlinks) - addr->proxy_rlink_count > 0 || (DEQ_SIZE(addr->subscriptions) > 0 && addr->propagate_local))
+        add_inlink(ap, key, addr);
+
+    //
+    // If the address has more than zero attached sources, create an outgoing link
+    // to the interior to signal the presence of local producers.
+    //
+    if (DEQ_SIZE(addr->inlinks) - addr->proxy_inlink_count > 0 || DEQ_SIZE(addr->watches) > 0)
+        add_outlink(ap, key, addr);
+}
+
+
+static qcm_edge_uplink_t *find_uplink_by_id(qcm_edge_addr_proxy_t *ap, uint64_t conn_id)
+{
+    qcm_edge_uplink_t *uplink = DEQ_HEAD(ap->uplinks);
+    while (!!uplink && uplink->conn->identity != conn_id)
+        uplink = DEQ_NEXT(uplink);
+    return uplink;
+}
+
+
+static uint8_t interest_flags(const qdr_address_t *addr)
+{
+    uint8_t flags = 0;
+
+    if (DEQ_SIZE(addr->rlinks) - addr->proxy_rlink_count > 0 || (DEQ_SIZE(addr->subscriptions) > 0 && addr->propagate_local))
+        flags |= INTEREST_CONSUMER;
+
+    if ((DEQ_SIZE(addr->inlinks) - addr->proxy_inlink_count > 0 || DEQ_SIZE(addr->watches) > 0)
+        && DEQ_SIZE(addr->subscriptions) == 0)
+        flags |= INTEREST_PRODUCER;
+
+    return flags;
+}
+
+
+static void send_interest_batch(qcm_edge_addr_proxy_t *ap, qcm_edge_uplink_t *uplink)
+{
+    qd_composed_field_t *body = uplink->interest_batch;
+    if (!body)
+        return;
+
+    uplink->interest_batch        = 0;
+    uplink->interest_batch_count  = 0;
+    uplink->interest_batch_octets = 0;
+    qd_compose_end_list(body);
+
+    if (uplink->interest_endpoint) {
+        qd_composed_field_t *fld = qd_compose(QD_PERFORMATIVE_HEADER, 0);
+        qd_compose_start_list(fld);
+        qd_compose_insert_bool(fld, 0);     // durable
+        qd_compose_end_list(fld);
+
+        qd_message_t *msg = qd_message();
+        qd_message_compose_3(msg, fld, body, true);
+        qd_compose_free(fld);
+
+        qdr_delivery_t *dlv = qdrc_endpoint_delivery_CT(ap->core, uplink->interest_endpoint, msg);
+        qdrc_endpoint_send_CT(ap->core, uplink->interest_endpoint, dlv, false);
+    }
+
+    qd_compose_free(body);
+}
+
+
+/**
+ * Add an address/consumer/producer triple to the uplink's next interest announcement.  Interest with
+ * neither flag set withdraws the address.
+ */
+static void add_interest(qcm_edge_addr_proxy_t *ap, qcm_edge_uplink_t *uplink, const char *key, uint8_t flags)
+{
+    if (!uplink->interest_batch) {
+        uplink->interest_batch = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
+        qd_compose_start_list(uplink->interest_batch);
+    }
+
+    qd_compose_insert_string(uplink->interest_batch, key);
+    qd_compose_insert_bool(uplink->interest_batch, !!(flags & INTEREST_CONSUMER));
+    qd_compose_insert_bool(uplink->interest_batch, !!(flags & INTEREST_PRODUCER));
+    uplink->interest_batch_count++;
+    uplink->interest_batch_octets += strlen(key);
+
+    if (uplink->interest_batch_count == INTEREST_BATCH_MAX || uplink->interest_batch_octets >= INTEREST_BATCH_OCTETS)
+        send_interest_batch(ap, uplink);
+}
+
+
+static void del_producer_binding(qcm_edge_addr_proxy_t *ap, qdr_address_t *addr)
+{
+    qdr_mux_binding_t *binding = safe_deref_qdr_mux_binding_t(addr->edge_mux_binding_sp);
+    if (binding) {
+        qd_nullify_safe_ptr(&addr->edge_mux_binding_sp);
+        qdr_core_unbind_address_mux_link_CT(ap->core, binding);
+    }
+}
+
+
+/**
+ * Bring the interest announced for a mobile address in line with its local consumers and producers.
+ */
+static void update_interest(qcm_edge_addr_proxy_t *ap, qdr_address_t *addr)
+{
+    const char *key = (const char*) qd_hash_key_by_handle(addr->hash_handle);
+    if (!key || *key != QD_ITER_HASH_PREFIX_MOBILE)
+        return;
+
+    //
+    // An address that hashes to an uplink whose interest link is not attached yet is announced once it is.
+    //
+    qcm_edge_uplink_t *uplink = select_uplink(ap, key);
+    if (!!uplink && !uplink->interest_active && !uplink->per_address)
+        return;
+
+    uint8_t            flags     = !!uplink ? interest_flags(addr) : 0;
+    qcm_edge_uplink_t *announced = !!addr->edge_interest ? find_uplink_by_id(ap, addr->edge_interest_conn_id) : 0;
+
+    if (!announced) {
+        //
+        // The uplink the interest was announced on is gone and the interior discarded the interest with it.
+        //
+        addr->edge_interest         = 0;
+        addr->edge_interest_conn_id = 0;
+    } else if (announced != uplink || uplink->per_address) {
+        //
+        // The set of uplinks has changed and this address now hashes to a different uplink.
+        //
+        add_interest(ap, announced, key, 0);
+        addr->edge_interest         = 0;
+        addr->edge_interest_conn_id = 0;
+    }
+
+    if (!!uplink && uplink->per_address) {
+        if (flags & INTEREST_CONSUMER)
+            add_inlink(ap, key, addr);
+        else
+            del_inlink(ap, addr);
+        if (flags & INTEREST_PRODUCER)
+            add_outlink(ap, key, addr);
+        else
+            del_outlink(ap, addr);
+    } else {
+        del_inlink(ap, addr);
+        del_outlink(ap, addr);
+        if (!!uplink && flags != addr->edge_interest) {
+            add_interest(ap, uplink, key, flags);
+            addr->edge_interest         = flags;
+            addr->edge_interest_conn_id = flags ? uplink->conn->identity : 0;
+        }
+    }
+
+    //
+    // The anonymous sender stays bound only while it belongs to the uplink carrying the producer interest.
+    //
+    qdr_mux_binding_t *binding = safe_deref_qdr_mux_binding_t(addr->edge_mux_binding_sp);
+    if (!!binding && (!(addr->edge_interest & INTEREST_PRODUCER)
+                      || binding->ref->link->conn->identity != addr->edge_interest_conn_id)) {
+        del_producer_binding(ap, addr);
+    }
+}
+
+
+static void flush_interest_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
+{
+    if (discard)
+        return;
+
+    qcm_edge_addr_proxy_t *ap = (qcm_edge_addr_proxy_t*) action->args.general.context_1;
+    ap->interest_flush_scheduled = false;
+
+    qdr_address_t *addr = DEQ_HEAD(ap->interest_pending);
+    while (addr) {
+        DEQ_REMOVE_HEAD_N(EDGE_INTEREST, ap->interest_pending);
+        addr->edge_interest_pending = false;
+        update_interest(ap, addr);
+        addr->ref_count--;
+        qdr_check_addr_CT(core, addr);
+        addr = DEQ_HEAD(ap->interest_pending);
+    }
+
+    qcm_edge_uplink_t *uplink = DEQ_HEAD(ap->uplinks);
+    while (uplink) {
+        send_interest_batch(ap, uplink);
+        uplink = DEQ_NEXT(uplink);
+    }
+}
+
+
+/**
+ * Queue a mobile address for the next interest announcement.  Announcements are made by an action queued behind the
+ * work that changed the address, so a burst of changes is announced in a few messages.
+ */
+static void mark_interest_pending(qcm_edge_addr_proxy_t *ap, qdr_address_t *addr)
+{
+    if (addr->edge_interest_pending)
+        return;
+
+    addr->edge_interest_pending = true;
+    addr->ref_count++;
+    DEQ_INSERT_TAIL_N(EDGE_INTEREST, ap->interest_pending, addr);
+
+    if (!ap->interest_flush_scheduled) {
+        ap->interest_flush_scheduled = true;
+        qdr_action_t *action = qdr_action(flush_interest_CT, "edge_addr_proxy_interest_flush");
+        action->args.general.context_1 = ap;
+        qdr_action_enqueue(ap->core, action);
+    }
+}
+
+
+static void proxy_all_addrs_on_uplinks(qcm_edge_addr_proxy_t *ap)
+{
+    qdr_address_t *addr = DEQ_HEAD(ap->core->addrs);
+    while (addr) {
+        if (!ap->core->edge_proxy_multiplexed)
+            proxy_addr_on_uplink(ap, addr);
+        else if (qdr_address_is_mobile_CT(addr))
+            mark_interest_pending(ap, addr);
+        addr = DEQ_NEXT(addr);
+    }
+}
+
+
+static void uplink_up(qcm_edge_addr_proxy_t *ap, qdr_connection_t *conn)
+{
+    qcm_edge_uplink_t *uplink = NEW(qcm_edge_uplink_t);
+    ZERO(uplink);
+    DEQ_ITEM_INIT(uplink);
+    uplink->ap   = ap;
+    uplink->conn = conn;
+
+    const char *container = conn->connection_info ? conn->connection_info->container : 0;
+    uplink->seed = HASH_INIT;
+    while (container && *container)
+        uplink->seed = HASH_COMPUTE(uplink->seed, *container++);
+
+    DEQ_INSERT_TAIL(ap->uplinks, uplink);
+
+    //
+    // Attach an anonymous sending link to the interior router.
+    //
+    qdr_link_t *out_link = qdr_create_link_CT(ap->core, conn,
+                                              QD_LINK_ENDPOINT, QD_OUTGOING,
+                                              qdr_terminus(0), qdr_terminus(0),
+                                              QD_SSN_ENDPOINT,
+                                              QDR_DEFAULT_PRIORITY);
+    out_link->proxy = true;
+    set_safe_ptr_qdr_link_t(out_link, &uplink->anonymous_sp);
+
+    //
+    // Associate the anonymous sender with the edge connection address.  This will cause
+    // all deliveries destined off-edge to be sent to the interior via the edge connection.
+    // When there is more than one uplink, the closest forwarder rotates deliveries across them.
+    //
+    qdr_core_bind_address_link_CT(ap->core, ap->edge_conn_addr, out_link);
+
+    //
+    // Attach a receiving link for edge summary.  This will cause all deliveries
+    // destined for this router to be delivered via the edge connection.
+    //
+    qdr_link_t *elink = qdr_create_link_CT(ap->core, conn,
+                                           QD_LINK_ENDPOINT, QD_INCOMING,
+                                           qdr_terminus_edge_downlink(ap->core->router_id),
+                                           qdr_terminus_edge_downlink(0),
+                                           QD_SSN_ENDPOINT, QDR_DEFAULT_PRIORITY);
+    elink->proxy = true;
+
+    //
+    // Attach a receiving link for edge address tracking updates.  The capability tells the interior that this edge
+    // accepts updates for several addresses in one message.
+    //
+    qdr_terminus_t *tracking_source = qdr_terminus_normal(QD_TERMINUS_EDGE_ADDRESS_TRACKING);
+    qdr_terminus_add_capability(tracking_source, QD_CAPABILITY_EDGE_ADDRESS_BATCH);
+    uplink->tracking_endpoint =
+        qdrc_endpoint_create_link_CT(ap->core, conn, QD_INCOMING,
+                                     tracking_source,
+                                     qdr_terminus(0), &ap->endpoint_descriptor, uplink);
+
+    //
+    // In multiplexed mode, attach the sending link for address interest.  The interior's address interest
+    // handler expects the edge-downlink and tracking links to be in place already.
+    //
+    if (ap->core->edge_proxy_multiplexed) {
+        uplink->interest_endpoint =
+            qdrc_endpoint_create_link_CT(ap->core, conn, QD_OUTGOING,
+                                         qdr_terminus(0),
+                                         qdr_terminus_normal(QD_TERMINUS_EDGE_ADDRESS_INTEREST),
+                                         &ap->interest_descriptor, uplink);
+    }
+}
+
+
+static void uplink_down(qcm_edge_addr_proxy_t *ap, qdr_connection_t *conn)
+{
+    qcm_edge_uplink_t *uplink = find_uplink(ap, conn);
+    if (!uplink)
+        return;
+
+    DEQ_REMOVE(ap->uplinks, uplink);
+    uplink->conn = 0;
+    qd_compose_free(uplink->interest_batch);
+    uplink->interest_batch = 0;
+
+    //
+    // The uplink record is the link context of the tracking and interest endpoints.  If an endpoint has not
+    // been cleaned up yet, its cleanup handler will free the record.
+    //
+    if (!uplink->tracking_endpoint && !uplink->interest_endpoint)
+        free(uplink);
+}
+
+
 static void on_conn_event(void *context, qdrc_event_t event, qdr_connection_t *conn)
 {
     qcm_edge_addr_proxy_t *ap = (qcm_edge_addr_proxy_t*) context;
@@ -262,103 +716,44 @@ static void on_conn_event(void *context, qdrc_event_t event, qdr_connection_t *c
     case QDRC_EVENT_CONN_OPENED :
         if (conn->role == QDR_ROLE_INTER_EDGE) {
             on_inter_edge_connection_opened(ap, conn);
+        } else if (conn->role == QDR_ROLE_EDGE_CONNECTION && ap->core->edge_uplinks_active_active) {
+            //
+            // Additional uplink in active-active mode.  The first uplink was set up by
+            // QDRC_EVENT_CONN_EDGE_ESTABLISHED.
+            //
+            if (!find_uplink(ap, conn)) {
+                uplink_up(ap, conn);
+                proxy_all_addrs_on_uplinks(ap);
+            }
         }
         break;
 
-    case QDRC_EVENT_CONN_EDGE_ESTABLISHED : {
-        //
-        // Flag the edge connection as being established.
-        //
-        ap->edge_conn_established = true;
-        ap->edge_conn             = conn;
-
-        //
-        // Attach an anonymous sending link to the interior router.
-        //
-        qdr_link_t *out_link = qdr_create_link_CT(ap->core, conn,
-                                                  QD_LINK_ENDPOINT, QD_OUTGOING,
-                                                  qdr_terminus(0), qdr_terminus(0),
-                                                  QD_SSN_ENDPOINT,
-                                                  QDR_DEFAULT_PRIORITY);
-        out_link->proxy = true;
-
-        //
-        // Associate the anonymous sender with the edge connection address.  This will cause
-        // all deliveries destined off-edge to be sent to the interior via the edge connection.
-        //
-        qdr_core_bind_address_link_CT(ap->core, ap->edge_conn_addr, out_link);
-
-        //
-        // Attach a receiving link for edge summary.  This will cause all deliveries
-        // destined for this router to be delivered via the edge connection.
-        //
-        qdr_link_t *elink = qdr_create_link_CT(ap->core, conn,
-                                               QD_LINK_ENDPOINT, QD_INCOMING,
-                                               qdr_terminus_edge_downlink(ap->core->router_id),
-                                               qdr_terminus_edge_downlink(0),
-                                               QD_SSN_ENDPOINT, QDR_DEFAULT_PRIORITY);
-        elink->proxy = true;
+    case QDRC_EVENT_CONN_CLOSED :
+        if (conn->role == QDR_ROLE_EDGE_CONNECTION && ap->core->edge_uplinks_active_active && find_uplink(ap, conn)) {
+            //
+            // Re-home the addresses that were proxied over the lost uplink.
+            //
+            uplink_down(ap, conn);
+            proxy_all_addrs_on_uplinks(ap);
+        }
+        break;
 
-        //
-        // Attach a receiving link for edge address tracking updates.
-        //
-        ap->tracking_endpoint =
-            qdrc_endpoint_create_link_CT(ap->core, conn, QD_INCOMING,
-                                         qdr_terminus_normal(QD_TERMINUS_EDGE_ADDRESS_TRACKING),
-                                         qdr_terminus(0), &ap->endpoint_descriptor, ap);
+    case QDRC_EVENT_CONN_EDGE_ESTABLISHED : {
+        ap->edge_conn = conn;
+        if (!find_uplink(ap, conn)) {
+            uplink_up(ap, conn);
+        }
 
         //
         // Process eligible local destinations
         //
-        qdr_address_t *addr = DEQ_HEAD(ap->core->addrs);
-        while (addr) {
-            const char *key = (const char*) qd_hash_key_by_handle(addr->hash_handle);
-            if (*key == QD_ITER_HASH_PREFIX_MOBILE) {
-                //
-                // If the address has more than zero attached destinations, create an
-                // incoming link from the interior to signal the presence of local consumers.
-                //
-                if (DEQ_SIZE(addr->rlinks) > 0 || (DEQ_SIZE(addr->subscriptions) > 0 && addr->propagate_local)) {
-                    if (DEQ_SIZE(addr->rlinks) == 1) { // TODO - fix this logic
-                        //
-                        // If there's only one link and it's on the edge connection, ignore the address.
-                        //
-                        qdr_link_ref_t *ref = DEQ_HEAD(addr->rlinks);
-                        if (ref->link->conn != ap->edge_conn)
-                            add_inlink(ap, key, addr);
-                    } else
-                        add_inlink(ap, key, addr);
-                }
-
-                //
-                // If the address has more than zero attached sources, create an outgoing link
-                // to the interior to signal the presence of local producers.
-                //
-                bool add = false;
-                if (DEQ_SIZE(addr->inlinks) > 0 || DEQ_SIZE(addr->watches) > 0) {
-                    if (DEQ_SIZE(addr->inlinks) == 1 && DEQ_SIZE(addr->watches) == 0) {
-                        //
-                        // If there's only one link and it's on the edge connection, ignore the address.
-                        //
-                        qdr_link_ref_t *ref = DEQ_HEAD(addr->inlinks);
-                        if (ref->link->conn != ap->edge_conn)
-                            add = true;
-                    } else
-                        add = true;
-
-                    if (add) {
-                        add_outlink(ap, key, addr);
-                    }
-                }
-            }
-            addr = DEQ_NEXT(addr);
-        }
+        proxy_all_addrs_on_uplinks(ap);
         break;
     }
 
     case QDRC_EVENT_CONN_EDGE_LOST :
-        ap->edge_conn_established = false;
-        ap->edge_conn             = 0;
+        ap->edge_conn = 0;
+        uplink_down(ap, conn);
         break;
 
     default:
@@ -401,8 +796,13 @@ static void on_addr_event(void *context, qdrc_event_t event, qdr_address_t *addr
     //
     // If we don't have an established edge connection, there is no further work to be done.
     //
-    if (!ap->edge_conn_established)
+    if (DEQ_IS_EMPTY(ap->uplinks))
+        return;
+
+    if (ap->core->edge_proxy_multiplexed) {
+        mark_interest_pending(ap, addr);
         return;
+    }
 
     const char *key = (const char*) qd_hash_key_by_handle(addr->hash_handle);
 
@@ -449,20 +849,43 @@ static void on_second_attach(void           *link_context,
                              qdr_terminus_t *remote_source,
                              qdr_terminus_t *remote_target)
 {
-    qcm_edge_addr_proxy_t *ap = (qcm_edge_addr_proxy_t*) link_context;
+    qcm_edge_uplink_t     *uplink = (qcm_edge_uplink_t*) link_context;
+    qcm_edge_addr_proxy_t *ap     = uplink->ap;
 
-    qdrc_endpoint_flow_CT(ap->core, ap->tracking_endpoint, INITIAL_CREDIT, false);
+    qdrc_endpoint_flow_CT(ap->core, uplink->tracking_endpoint, INITIAL_CREDIT, false);
 
     qdr_terminus_free(remote_source);
     qdr_terminus_free(remote_target);
 }
 
 
+/**
+ * In multiplexed mode the uplink's anonymous sender is bound to a producer address while the interior reports
+ * destinations for it.
+ */
+static void update_producer_binding(qcm_edge_addr_proxy_t *ap, qcm_edge_uplink_t *uplink, qdr_address_t *addr, bool dest)
+{
+    qdr_mux_binding_t *binding   = safe_deref_qdr_mux_binding_t(addr->edge_mux_binding_sp);
+    qdr_link_t        *anonymous = safe_deref_qdr_link_t(uplink->anonymous_sp);
+
+    if (dest) {
+        if (!binding && !!anonymous && (addr->edge_interest & INTEREST_PRODUCER)
+            && addr->edge_interest_conn_id == uplink->conn->identity) {
+            binding = qdr_core_bind_address_mux_link_CT(ap->core, addr, anonymous);
+            set_safe_ptr_qdr_mux_binding_t(binding, &addr->edge_mux_binding_sp);
+        }
+    } else if (!!binding && binding->ref->link == anonymous) {
+        del_producer_binding(ap, addr);
+    }
+}
+
+
 static void on_transfer(void           *link_context,
                         qdr_delivery_t *dlv,
                         qd_message_t   *msg)
 {
-    qcm_edge_addr_proxy_t *ap = (qcm_edge_addr_proxy_t*) link_context;
+    qcm_edge_uplink_t     *uplink = (qcm_edge_uplink_t*) link_context;
+    qcm_edge_addr_proxy_t *ap     = uplink->ap;
     uint64_t dispo = PN_ACCEPTED;
 
     //
@@ -470,14 +893,15 @@ static void on_transfer(void           *link_context,
     //
     if (qd_message_check_depth(msg, QD_DEPTH_BODY) == QD_MESSAGE_DEPTH_OK) {
         //
-        // Get the message body.  It must be a list with two elements.  The first is an address
-        // and the second is a boolean indicating whether that address has upstream destinations.
+        // Get the message body.  It must be a list of address/boolean pairs.  In each pair the first element is an
+        // address and the second is a boolean indicating whether that address has upstream destinations.
         //
-        qd_iterator_t     *iter = qd_message_field_iterator(msg, QD_FIELD_BODY);
-        qd_parsed_field_t *body = qd_parse(iter);
-        if (!!body && qd_parse_is_list(body) && qd_parse_sub_count(body) == 2) {
-            qd_parsed_field_t *addr_field = qd_parse_sub_value(body, 0);
-            qd_parsed_field_t *dest_field = qd_parse_sub_value(body, 1);
+        qd_iterator_t     *iter  = qd_message_field_iterator(msg, QD_FIELD_BODY);
+        qd_parsed_field_t *body  = qd_parse_lazy(iter);
+        uint32_t           count = !!body && qd_parse_is_list(body) ? qd_parse_sub_count(body) : 0;
+        for (uint32_t idx = 0; idx + 1 < count; idx += 2) {
+            qd_parsed_field_t *addr_field = qd_parse_sub_value(body, idx);
+            qd_parsed_field_t *dest_field = qd_parse_sub_value(body, idx + 1);
 
             if (qd_parse_is_scalar(addr_field) && qd_parse_is_scalar(dest_field)) {
                 qd_iterator_t *addr_iter = qd_parse_raw(addr_field);
@@ -486,9 +910,14 @@ static void on_transfer(void           *link_context,
 
                 qd_iterator_reset_view(addr_iter, ITER_VIEW_ALL);
                 qd_hash_retrieve(ap->core->addr_hash, addr_iter, (void**) &addr);
-                if (addr) {
+                if (addr && ap->core->edge_proxy_multiplexed && !uplink->per_address) {
+                    update_producer_binding(ap, uplink, addr, dest);
+                } else if (addr) {
+                    //
+                    // Only the outlink attached over this uplink is affected by its tracking updates.
+                    //
                     qdr_link_t *link = safe_deref_qdr_link_t(addr->edge_outlink_sp);
-                    if (link) {
+                    if (link && link->conn == uplink->conn) {
                         if (dest) {
                             if (link->owning_addr == 0) {
                                 qdr_core_bind_address_link_CT(ap->core, addr, link);
@@ -516,7 +945,7 @@ static void on_transfer(void           *link_context,
     //
     // Replenish the credit for this delivery
     //
-    qdrc_endpoint_flow_CT(ap->core, ap->tracking_endpoint, 1, false);
+    qdrc_endpoint_flow_CT(ap->core, uplink->tracking_endpoint, 1, false);
 }
 
 qdr_address_t *qcm_edge_conn_addr(void *link_context)
@@ -530,9 +959,73 @@ qdr_address_t *qcm_edge_conn_addr(void *link_context)
 
 static void on_cleanup(void *link_context)
 {
-    qcm_edge_addr_proxy_t *ap = (qcm_edge_addr_proxy_t*) link_context;
+    qcm_edge_uplink_t *uplink = (qcm_edge_uplink_t*) link_context;
+
+    uplink->tracking_endpoint = 0;
+    if (!uplink->conn && !uplink->interest_endpoint) {
+        // uplink_down() has already removed this record
+        free(uplink);
+    }
+}
 
-    ap->tracking_endpoint = 0;
+
+static void on_interest_second_attach(void           *link_context,
+                                      qdr_terminus_t *remote_source,
+                                      qdr_terminus_t *remote_target)
+{
+    qcm_edge_uplink_t     *uplink = (qcm_edge_uplink_t*) link_context;
+    qcm_edge_addr_proxy_t *ap     = uplink->ap;
+
+    if (!!remote_target && qdr_terminus_has_capability(remote_target, QD_CAPABILITY_EDGE_ADDRESS_INTEREST)) {
+        uplink->interest_active = true;
+    } else {
+        qd_log(LOG_ROUTER_CORE, QD_LOG_WARNING,
+               "Edge Address Proxy: interior router on connection [C%" PRIu64 "] does not support multiplexed address proxying, proxying per address",
+               uplink->conn ? uplink->conn->identity : 0);
+        uplink->per_address = true;
+        qdrc_endpoint_detach_CT(ap->core, uplink->interest_endpoint, 0);
+    }
+
+    qdr_terminus_free(remote_source);
+    qdr_terminus_free(remote_target);
+
+    if (!!uplink->conn)
+        proxy_all_addrs_on_uplinks(ap);
+}
+
+
+static void on_interest_first_detach(void *link_context, qdr_error_t *error)
+{
+    qcm_edge_uplink_t     *uplink = (qcm_edge_uplink_t*) link_context;
+    qcm_edge_addr_proxy_t *ap     = uplink->ap;
+    bool                   live   = !!uplink->conn;
+
+    //
+    // The interior refused or dropped the interest link on a live uplink.  Proxy per address on it instead.
+    //
+    if (live) {
+        uplink->interest_active = false;
+        uplink->per_address     = true;
+    }
+
+    qdrc_endpoint_detach_CT(ap->core, uplink->interest_endpoint, 0);
+    qdr_error_free(error);
+
+    if (live)
+        proxy_all_addrs_on_uplinks(ap);
+}
+
+
+static void on_interest_cleanup(void *link_context)
+{
+    qcm_edge_uplink_t *uplink = (qcm_edge_uplink_t*) link_context;
+
+    uplink->interest_endpoint = 0;
+    uplink->interest_active   = false;
+    if (!uplink->conn && !uplink->tracking_endpoint) {
+        // uplink_down() has already removed this record
+        free(uplink);
+    }
 }
 
 
@@ -548,6 +1041,11 @@ qcm_edge_addr_proxy_t *qcm_edge_addr_proxy(qdr_core_t *core)
     ap->endpoint_descriptor.on_transfer      = on_transfer;
     ap->endpoint_descriptor.on_cleanup       = on_cleanup;
 
+    ap->interest_descriptor.label            = "Edge Address Proxy - interest";
+    ap->interest_descriptor.on_second_attach = on_interest_second_attach;
+    ap->interest_descriptor.on_first_detach  = on_interest_first_detach;
+    ap->interest_descriptor.on_cleanup       = on_interest_cleanup;
+
     //
     // Establish the edge connection address to represent destinations reachable via the edge connection
     //
@@ -560,6 +1058,7 @@ qcm_edge_addr_proxy_t *qcm_edge_addr_proxy(qdr_core_t *core)
                                             QDRC_EVENT_CONN_EDGE_ESTABLISHED
                                             | QDRC_EVENT_CONN_EDGE_LOST
                                             | QDRC_EVENT_CONN_OPENED
+                                            | QDRC_EVENT_CONN_CLOSED
                                             | QDRC_EVENT_ADDR_ADDED_LOCAL_DEST
                                             | QDRC_EVENT_ADDR_REMOVED_LOCAL_DEST
                                             | QDRC_EVENT_ADDR_BECAME_SOURCE
@@ -585,6 +1084,18 @@ qcm_edge_addr_proxy_t *qcm_edge_addr_proxy(qdr_core_t *core)
 void qcm_edge_addr_proxy_final(qcm_edge_addr_proxy_t *ap)
 {
     qdrc_event_unsubscribe_CT(ap->core, ap->event_sub);
+
+    //
+    // Addresses still in ap->interest_pending have already been freed by the core.
+    //
+    qcm_edge_uplink_t *uplink = DEQ_HEAD(ap->uplinks);
+    while (uplink) {
+        DEQ_REMOVE_HEAD(ap->uplinks);
+        qd_compose_free(uplink->interest_batch);
+        free(uplink);
+        uplink = DEQ_HEAD(ap->uplinks);
+    }
+
     free(ap);
 }
 
@@ -32,13 +32,19 @@
 // edge connections to Interior routers and choosing one to be the active
 // edge connection.  An edge router may maintain multiple "edge-connection"
 // connections to different Interior routers.  Only one of those connections
-// will be designated as active and carry edge traffic.  This component
-// identifies the active edge connection and generates outbound core events
-// to notify other interested parties:
+// will be designated as active.  This component identifies the active edge
+// connection and generates outbound core events to notify other interested
+// parties:
 //
 //     QDRC_EVENT_CONN_EDGE_ESTABLISHED
 //     QDRC_EVENT_CONN_EDGE_LOST
 //
+// All open edge connections (uplinks) are tracked in core->edge_uplinks.  In
+// the default active-standby mode only the active edge connection carries edge
+// traffic.  In active-active mode (router edgeUplinkMode) the Address Proxy
+// distributes traffic across all of the uplinks; the active connection is then
+// only the one used for the single-uplink control functions (mesh discovery).
+//
 
 struct qcm_edge_conn_mgr_t {
     qdr_core_t                *core;
@@ -137,12 +143,19 @@ static void on_conn_event(void *context, qdrc_event_t event, qdr_connection_t *c
 
     switch (event) {
     case QDRC_EVENT_CONN_OPENED :
-        if (cm->active_edge_connection == 0 && conn->role == QDR_ROLE_EDGE_CONNECTION) {
+        if (conn->role == QDR_ROLE_EDGE_CONNECTION) {
+            qdr_add_connection_ref(&cm->core->edge_uplinks, conn);
+            if (cm->active_edge_connection == 0) {
                 qd_log(LOG_ROUTER_CORE, QD_LOG_INFO,
                        "Edge connection (id=%" PRIu64 ") to interior established", conn->identity);
                 cm->active_edge_connection       = conn;
                 cm->core->active_edge_connection = conn;
                 qdrc_event_conn_raise(cm->core, QDRC_EVENT_CONN_EDGE_ESTABLISHED, conn);
+            } else if (cm->core->edge_uplinks_active_active) {
+                qd_log(LOG_ROUTER_CORE, QD_LOG_INFO,
+                       "Edge connection (id=%" PRIu64 ") to interior established, %zu uplinks active",
+                       conn->identity, DEQ_SIZE(cm->core->edge_uplinks));
+            }
         }
 
         if (conn->role == QDR_ROLE_INTER_EDGE) {
@@ -155,11 +168,14 @@ static void on_conn_event(void *context, qdrc_event_t event, qdr_connection_t *c
         break;
 
     case QDRC_EVENT_CONN_CLOSED :
+        if (conn->role == QDR_ROLE_EDGE_CONNECTION) {
+            qdr_del_connection_ref(&cm->core->edge_uplinks, conn);
+        }
+
         if (cm->active_edge_connection == conn) {
             qdrc_event_conn_raise(cm->core, QDRC_EVENT_CONN_EDGE_LOST, conn);
-            qdr_connection_t *alternate = DEQ_HEAD(cm->core->open_connections);
-            while (alternate && (alternate == conn || alternate->role != QDR_ROLE_EDGE_CONNECTION))
-                alternate = DEQ_NEXT(alternate);
+            qdr_connection_ref_t *alt_ref   = DEQ_HEAD(cm->core->edge_uplinks);
+            qdr_connection_t     *alternate = alt_ref ? alt_ref->conn : 0;
             if (alternate) {
                 qd_log(LOG_ROUTER_CORE, QD_LOG_INFO,
                        "Edge connection (id=%" PRIu64 ") to interior lost, activating alternate id=%" PRIu64 "",
@@ -172,7 +188,12 @@ static void on_conn_event(void *context, qdrc_event_t event, qdr_connection_t *c
                        "Edge connection (id=%" PRIu64 ") to interior lost, no alternate connection available",
                        conn->identity);
                 cm->active_edge_connection = 0;
+                cm->core->active_edge_connection = 0;
             }
+        } else if (conn->role == QDR_ROLE_EDGE_CONNECTION && cm->core->edge_uplinks_active_active) {
+            qd_log(LOG_ROUTER_CORE, QD_LOG_INFO,
+                   "Edge connection (id=%" PRIu64 ") to interior lost, %zu uplinks active",
+                   conn->identity, DEQ_SIZE(cm->core->edge_uplinks));
         }
 
         //
@@ -212,6 +233,13 @@ qcm_edge_conn_mgr_t *qcm_edge_conn_mgr(qdr_core_t *core)
 void qcm_edge_conn_mgr_final(qcm_edge_conn_mgr_t *cm)
 {
     qdrc_event_unsubscribe_CT(cm->core, cm->event_sub);
+
+    qdr_connection_ref_t *ref = DEQ_HEAD(cm->core->edge_uplinks);
+    while (ref) {
+        qdr_del_connection_ref(&cm->core->edge_uplinks, ref->conn);
+        ref = DEQ_HEAD(cm->core->edge_uplinks);
+    }
+
     free(cm);
 }
 
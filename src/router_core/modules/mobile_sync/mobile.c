@@ -202,7 +202,7 @@ static void qcm_mobile_sync_compose_addr_descriptor(const qdr_address_t *addr, q
     qd_compose_insert_string(field, hash_key);
     if (include_attributes) {
         qd_compose_insert_int(field, addr->treatment);
-        qd_compose_insert_int(field, DEQ_SIZE(addr->inlinks));
+        qd_compose_insert_int(field, DEQ_SIZE(addr->inlinks) + DEQ_SIZE(addr->mux_inlinks));
         if (addr->local_sole_destination_mesh) {
             qd_compose_insert_null(field); // out-link capacity
             qd_compose_insert_string_n(field, addr->destination_mesh_id, QD_DISCRIMINATOR_BYTES);
@@ -779,8 +779,8 @@ static uint64_t qcm_mobile_sync_on_message_CT(void                    *context,
     qdrm_mobile_sync_t *msync      = (qdrm_mobile_sync_t*) context;
     qd_iterator_t      *ap_iter    = qd_message_field_iterator(msg, QD_FIELD_APPLICATION_PROPERTIES);
     qd_iterator_t      *body_iter  = qd_message_field_iterator(msg, QD_FIELD_BODY);
-    qd_parsed_field_t  *ap_field   = qd_parse(ap_iter);
-    qd_parsed_field_t  *body_field = qd_parse(body_iter);
+    qd_parsed_field_t  *ap_field   = qd_parse_lazy(ap_iter);
+    qd_parsed_field_t  *body_field = qd_parse_lazy(body_iter);
 
     if (!!ap_field && qd_parse_is_map(ap_field)) {
         qd_parsed_field_t *opcode_field = qd_parse_value_by_key(ap_field, OPCODE);
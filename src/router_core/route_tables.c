@@ -37,12 +37,19 @@ static void qdr_unsubscribe_CT         (qdr_core_t *core, qdr_action_t *action,
 // Interface Functions
 //==================================================================================
 
+//
+// The route table updates below come from the routing protocol and are queued as control actions so that convergence
+// is not held up behind data-plane work. They refer to connections and links (e.g. the inter-router control links by
+// mask bit) so they never overtake the lifecycle actions queued with qdr_action_fence_enqueue(). They may overtake
+// deliveries and the other data actions, none of which the route table handlers read.
+//
+
 void qdr_core_add_router(qdr_core_t *core, const char *address, int router_maskbit)
 {
     qdr_action_t *action = qdr_action(qdr_add_router_CT, "add_router");
     action->args.route_table.router_maskbit = router_maskbit;
     action->args.route_table.address        = qdr_field(address);
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -50,7 +57,7 @@ void qdr_core_del_router(qdr_core_t *core, int router_maskbit)
 {
     qdr_action_t *action = qdr_action(qdr_del_router_CT, "del_router");
     action->args.route_table.router_maskbit = router_maskbit;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -59,7 +66,7 @@ void qdr_core_set_link(qdr_core_t *core, int router_maskbit, int link_maskbit)
     qdr_action_t *action = qdr_action(qdr_set_link_CT, "set_link");
     action->args.route_table.router_maskbit = router_maskbit;
     action->args.route_table.link_maskbit   = link_maskbit;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -67,7 +74,7 @@ void qdr_core_remove_link(qdr_core_t *core, int router_maskbit)
 {
     qdr_action_t *action = qdr_action(qdr_remove_link_CT, "remove_link");
     action->args.route_table.router_maskbit = router_maskbit;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -76,7 +83,7 @@ void qdr_core_set_next_hop(qdr_core_t *core, int router_maskbit, int nh_router_m
     qdr_action_t *action = qdr_action(qdr_set_next_hop_CT, "set_next_hop");
     action->args.route_table.router_maskbit    = router_maskbit;
     action->args.route_table.nh_router_maskbit = nh_router_maskbit;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -84,7 +91,7 @@ void qdr_core_remove_next_hop(qdr_core_t *core, int router_maskbit)
 {
     qdr_action_t *action = qdr_action(qdr_remove_next_hop_CT, "remove_next_hop");
     action->args.route_table.router_maskbit = router_maskbit;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -93,7 +100,7 @@ void qdr_core_set_cost(qdr_core_t *core, int router_maskbit, int cost)
     qdr_action_t *action = qdr_action(qdr_set_cost_CT, "set_cost");
     action->args.route_table.router_maskbit = router_maskbit;
     action->args.route_table.cost           = cost;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -102,7 +109,7 @@ void qdr_core_set_valid_origins(qdr_core_t *core, int router_maskbit, qd_bitmask
     qdr_action_t *action = qdr_action(qdr_set_valid_origins_CT, "set_valid_origins");
     action->args.route_table.router_maskbit = router_maskbit;
     action->args.route_table.router_set     = routers;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -110,7 +117,7 @@ void qdr_core_flush_destinations(qdr_core_t *core, int router_maskbit)
 {
     qdr_action_t *action = qdr_action(qdr_flush_destinations_CT, "flush_destinations");
     action->args.route_table.router_maskbit = router_maskbit;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -118,7 +125,7 @@ void qdr_core_mobile_seq_advanced(qdr_core_t *core, int router_maskbit)
 {
     qdr_action_t *action = qdr_action(qdr_mobile_seq_advanced_CT, "mobile_seq_advanced");
     action->args.route_table.router_maskbit = router_maskbit;
-    qdr_action_enqueue(core, action);
+    qdr_action_control_enqueue(core, action);
 }
 
 
@@ -224,6 +231,8 @@ void qdr_route_table_setup_CT(qdr_core_t *core)
     core->conn_id_hash = qd_hash(6, 4, 0);
     core->cost_epoch   = 1;
     core->addr_parse_tree = qd_parse_tree_new(QD_PARSE_TREE_ADDRESS);
+    qdr_addr_config_cache_init(&core->addr_config_cache);
+    qdr_addr_config_cache_init(&core->addr_treatment_cache);
 
     if (core->router_mode == QD_ROUTER_MODE_INTERIOR) {
         core->hello_addr      = qdr_add_local_address_CT(core, 'L', "qdhello",     QD_TREATMENT_MULTICAST_FLOOD);
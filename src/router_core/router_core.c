@@ -23,6 +23,7 @@
 #include "router_core_private.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <strings.h>
 
 ALLOC_DECLARE(qdr_link_work_t);
@@ -38,6 +39,7 @@ ALLOC_DEFINE(qdr_delivery_cleanup_t);
 ALLOC_DEFINE(qdr_general_work_t);
 ALLOC_DEFINE(qdr_link_work_t);
 ALLOC_DEFINE_SAFE(qdr_connection_ref_t);
+ALLOC_DEFINE_SAFE(qdr_mux_binding_t);
 ALLOC_DEFINE(qdr_connection_info_t);
 ALLOC_DEFINE(qdr_subscription_ref_t);
 
@@ -72,6 +74,37 @@ static void qdr_core_setup_init(qdr_core_t *core)
     qdr_adaptors_init(core);
 }
 
+//
+// Set the per-priority link scheduling quanta from the router's linkSchedulingQuanta attribute: a comma-separated
+// list of octet counts for priorities 0, 1, ...  The last value given applies to the remaining priorities.
+//
+static void qdr_core_set_link_quanta(qdr_core_t *core, const char *config)
+{
+    int64_t quantum = QDR_LINK_DEFAULT_QUANTUM;
+    const char *cursor = config;
+
+    for (int priority = 0; priority < QDR_N_PRIORITIES; priority++) {
+        if (cursor && *cursor) {
+            char *end;
+            long long value = strtoll(cursor, &end, 10);
+            while (*end == ' ')
+                end++;
+            if (end == cursor || value < 0 || (*end != ',' && *end != '\0')) {
+                qd_log(LOG_ROUTER_CORE, QD_LOG_WARNING,
+                       "Invalid linkSchedulingQuanta '%s', using %d octets for all priorities", config,
+                       QDR_LINK_DEFAULT_QUANTUM);
+                for (int i = 0; i < QDR_N_PRIORITIES; i++)
+                    core->link_quantum[i] = QDR_LINK_DEFAULT_QUANTUM;
+                return;
+            }
+            quantum = value;
+            cursor  = *end == ',' ? end + 1 : end;
+        }
+        core->link_quantum[priority] = quantum;
+    }
+}
+
+
 qdr_core_t *qdr_core(qd_dispatch_t *qd, qd_router_mode_t mode, const char *area, const char *id, const char *van_id)
 {
     qdr_core_t *core = NEW(qdr_core_t);
@@ -83,7 +116,12 @@ qdr_core_t *qdr_core(qd_dispatch_t *qd, qd_router_mode_t mode, const char *area,
     core->router_id           = id;
     core->van_id              = van_id;
     core->worker_thread_count = qd->thread_count;
+    core->edge_uplinks_active_active = qd->edge_uplink_active_active;
+    core->edge_proxy_multiplexed     = qd->edge_address_proxy_multiplexed;
+    qdr_core_set_link_quanta(core, qd->link_scheduling_quanta);
     sys_atomic_init(&core->uptime_ticks, 0);
+    atomic_init(&core->addr_watch_notifications, 0);
+    core->batch_usec = qd_platform_monotonic_usec();
 
     //
     // Set up the logging sources for the router core. The core
@@ -98,12 +136,16 @@ qdr_core_t *qdr_core(qd_dispatch_t *qd, qd_router_mode_t mode, const char *area,
     // Set up the threading support
     //
     sys_cond_init(&core->action_cond);
-    sys_mutex_init(&core->action_lock);
+    sys_mutex_init_named(&core->action_lock, "core.action_lock");
     core->running     = true;
     DEQ_INIT(core->action_list);
+    DEQ_INIT(core->action_list_control);
     DEQ_INIT(core->action_list_background);
+    DEQ_INIT(core->action_batch);
+    DEQ_INIT(core->action_batch_control);
+    sys_atomic_init(&core->action_fences, 0);
 
-    sys_mutex_init(&core->work_lock);
+    sys_mutex_init_named(&core->work_lock, "core.work_lock");
     DEQ_INIT(core->work_list);
     core->work_timer = qd_timer(core->qd, qdr_general_handler, core);
 
@@ -111,7 +153,7 @@ qdr_core_t *qdr_core(qd_dispatch_t *qd, qd_router_mode_t mode, const char *area,
     // Set up the unique identifier generator
     //
     core->next_identifier = 1;
-    sys_mutex_init(&core->id_lock);
+    sys_mutex_init_named(&core->id_lock, "core.id_lock");
 
     //
     // Initialize the management agent
@@ -196,6 +238,8 @@ void qdr_core_free(qdr_core_t *core)
     qd_hash_free(core->addr_lr_al_hash);
 
     qd_parse_tree_free(core->addr_parse_tree);
+    qdr_addr_config_cache_free(&core->addr_config_cache);
+    qdr_addr_config_cache_free(&core->addr_treatment_cache);
 
     qdr_node_t *rnode = 0;
     while ( (rnode = DEQ_HEAD(core->routers)) ) {
@@ -315,8 +359,10 @@ void qdr_core_free(qdr_core_t *core)
     // held by the action
 
     qdr_action_list_t  action_list;
-    while (!DEQ_IS_EMPTY(core->action_list) || !DEQ_IS_EMPTY(core->action_list_background)) {
-        DEQ_MOVE(core->action_list, action_list);
+    while (!DEQ_IS_EMPTY(core->action_list) || !DEQ_IS_EMPTY(core->action_list_control)
+           || !DEQ_IS_EMPTY(core->action_list_background)) {
+        DEQ_MOVE(core->action_list_control, action_list);
+        DEQ_APPEND(action_list, core->action_list);
         DEQ_APPEND(action_list, core->action_list_background);
         qdr_action_t *action = DEQ_HEAD(action_list);
         while (action) {
@@ -348,7 +394,10 @@ void qdr_core_free(qdr_core_t *core)
 
     assert(DEQ_IS_EMPTY(core->work_list));
     assert(DEQ_IS_EMPTY(core->action_list));
+    assert(DEQ_IS_EMPTY(core->action_list_control));
     assert(DEQ_IS_EMPTY(core->action_list_background));
+    assert(DEQ_IS_EMPTY(core->action_batch));
+    assert(DEQ_IS_EMPTY(core->action_batch_control));
     assert(DEQ_IS_EMPTY(core->streaming_connections));
 
     if (core->routers_by_mask_bit)         free(core->routers_by_mask_bit);
@@ -366,6 +415,7 @@ void qdr_core_free(qdr_core_t *core)
     sys_thread_free(core->thread);
     sys_cond_free(&core->action_cond);
     sys_mutex_free(&core->action_lock);
+    sys_atomic_destroy(&core->action_fences);
     sys_mutex_free(&core->work_lock);
     sys_mutex_free(&core->id_lock);
     qd_timer_free(core->work_timer);
@@ -501,6 +551,10 @@ qdr_action_t *qdr_action(qdr_action_handler_t action_handler, const char *label)
 void qdr_action_enqueue(qdr_core_t *core, qdr_action_t *action)
 {
     sys_mutex_lock(&core->action_lock);
+    // The queueing delay of data actions is sampled: only the action that starts the list is stamped. It waits longest
+    // of the actions the core thread takes with it, and the clock is read once per core pass instead of per action.
+    if (DEQ_IS_EMPTY(core->action_list))
+        action->enqueue_usec = qd_platform_monotonic_usec();
     DEQ_INSERT_TAIL(core->action_list, action);
     const bool need_wake = core->sleeping;
     sys_mutex_unlock(&core->action_lock);
@@ -509,6 +563,52 @@ void qdr_action_enqueue(qdr_core_t *core, qdr_action_t *action)
 }
 
 
+/**
+ * Queue a data action that control actions must not overtake. This is used for the connection and link lifecycle
+ * actions that set up the state the route table updates refer to (e.g. the inter-router control links that
+ * qdr_set_link_CT looks up by mask bit). While a fence is pending, control actions are queued behind it on the
+ * action_list in FIFO order.
+ */
+void qdr_action_fence_enqueue(qdr_core_t *core, qdr_action_t *action)
+{
+    action->fence = true;
+    sys_mutex_lock(&core->action_lock);
+    sys_atomic_inc(&core->action_fences);
+    if (DEQ_IS_EMPTY(core->action_list))
+        action->enqueue_usec = qd_platform_monotonic_usec();
+    DEQ_INSERT_TAIL(core->action_list, action);
+    const bool need_wake = core->sleeping;
+    sys_mutex_unlock(&core->action_lock);
+    if (need_wake)
+        sys_cond_signal(&core->action_cond);
+}
+
+
+/**
+ * Queue a routing control-plane action. Control actions run in order among themselves but ahead of the data actions
+ * queued by qdr_action_enqueue() so that route changes are not delayed behind a flood of delivery work. They never
+ * overtake a fence action queued by qdr_action_fence_enqueue(): while one is pending the control action becomes a
+ * fence itself and is queued on the action_list, which keeps it in order with both the fence and the control actions
+ * queued after it.
+ */
+void qdr_action_control_enqueue(qdr_core_t *core, qdr_action_t *action)
+{
+    action->enqueue_usec = qd_platform_monotonic_usec();
+    sys_mutex_lock(&core->action_lock);
+    if (sys_atomic_get(&core->action_fences) > 0) {
+        action->fence = true;
+        sys_atomic_inc(&core->action_fences);
+        DEQ_INSERT_TAIL(core->action_list, action);
+    } else {
+        DEQ_INSERT_TAIL(core->action_list_control, action);
+    }
+    const bool need_wake = core->sleeping;
+    sys_mutex_unlock(&core->action_lock);
+    if (need_wake)
+        sys_cond_signal(&core->action_cond);
+}
+
+
 void qdr_action_background_enqueue(qdr_core_t *core, qdr_action_t *action)
 {
     sys_mutex_lock(&core->action_lock);
@@ -676,12 +776,21 @@ void qdr_core_remove_address(qdr_core_t *core, qdr_address_t *addr)
     // Free resources associated with this address
 
     DEQ_APPEND(addr->rlinks, addr->inlinks);
+    DEQ_APPEND(addr->rlinks, addr->mux_inlinks);
     qdr_link_ref_t *lref = DEQ_HEAD(addr->rlinks);
     while (lref) {
         qdr_link_t *link = lref->link;
-        assert(link->owning_addr == addr);
-        link->owning_addr = 0;
-        qdr_del_link_ref(&addr->rlinks, link, QDR_LINK_LIST_CLASS_ADDRESS);
+        if (lref->mux_binding) {
+            qdr_mux_binding_t *binding = lref->mux_binding;
+            DEQ_REMOVE(addr->rlinks, lref);
+            DEQ_REMOVE(link->mux_bindings, binding);
+            free_qdr_link_ref_t(lref);
+            free_qdr_mux_binding_t(binding);
+        } else {
+            assert(link->owning_addr == addr);
+            link->owning_addr = 0;
+            qdr_del_link_ref(&addr->rlinks, link, QDR_LINK_LIST_CLASS_ADDRESS);
+        }
         lref = DEQ_HEAD(addr->rlinks);
     }
 
@@ -767,6 +876,99 @@ void qdr_core_edge_mesh_id_changed_CT(qdr_core_t *core, qdr_connection_t *conn)
 }
 
 
+/**
+ * A destination link has been added to addr->rlinks.  Update the address state that depends on its local
+ * destinations and raise the related events.
+ */
+static void qdr_addr_rlink_added_CT(qdr_core_t *core, qdr_address_t *addr, qdr_link_t *link)
+{
+    if (DEQ_SIZE(addr->rlinks) == 1) {
+        //
+        // If this is the only local destination for this address and the connection goes to an edge mesh,
+        // this address has a local-sole-destination-mesh.
+        //
+        if (link->conn->edge_mesh_id[0] != '\0') {
+            addr->local_sole_destination_mesh = true;
+            memcpy(addr->destination_mesh_id, link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES);
+            qdr_process_addr_attributes_CT(core, addr);
+            qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
+        }
+
+        //
+        // This is the first outgoing link for this address, start the flow of incoming deliveries.
+        //
+        qdr_addr_start_inlinks_CT(core, addr);
+    } else {
+        //
+        // This is an additional local destination for the address.  If this destination does not go
+        // to the same edge mesh as all the existing destinations, clear the local-sole-destination-mesh
+        // state.
+        //
+        if (addr->local_sole_destination_mesh && memcmp(addr->destination_mesh_id, link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES) != 0) {
+            addr->local_sole_destination_mesh = false;
+            addr->destination_mesh_id[0] = '\0';
+            qdr_process_addr_attributes_CT(core, addr);
+            qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
+        }
+    }
+
+    if (!link->proxy && DEQ_SIZE(addr->rlinks) - addr->proxy_rlink_count <= QDRC_LOCAL_DEST_THRESHOLD) {
+        qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_ADDED_LOCAL_DEST, addr);
+    }
+}
+
+
+/**
+ * A destination link has been removed from addr->rlinks.  Update the address state that depends on its local
+ * destinations and raise the related events.
+ */
+static void qdr_addr_rlink_removed_CT(qdr_core_t *core, qdr_address_t *addr, qdr_link_t *link)
+{
+    if (!addr->local_sole_destination_mesh) {
+        //
+        // If this address previously did not have a local-sole-destination-mesh, it may now have one.
+        // We need to check the remaining destinations to see if they all go to the same edge mesh.
+        //
+        if (DEQ_SIZE(addr->rlinks) > 0) {
+            qdr_link_ref_t *ref       = DEQ_HEAD(addr->rlinks);
+            bool            same_mesh = ref->link->conn->edge_mesh_id[0] != '\0';
+
+            if (same_mesh) {
+                memcpy(addr->destination_mesh_id, ref->link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES);
+                while (!!ref && same_mesh) {
+                    if (memcmp(addr->destination_mesh_id, ref->link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES) != 0) {
+                        same_mesh = false;
+                        addr->destination_mesh_id[0] = '\0';
+                    }
+                    ref = DEQ_NEXT(ref);
+                }
+
+                if (same_mesh) {
+                    addr->local_sole_destination_mesh = true;
+                    qdr_process_addr_attributes_CT(core, addr);
+                    qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
+                }
+            }
+        }
+    } else {
+        //
+        // If this address previously had a local-sole-destination-mesh and the last destination was just
+        // removed, the flag must be cleared.
+        //
+        if (DEQ_SIZE(addr->rlinks) == 0) {
+            addr->local_sole_destination_mesh = false;
+            addr->destination_mesh_id[0] = '\0';
+            qdr_process_addr_attributes_CT(core, addr);
+            qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
+        }
+    }
+
+    if (!link->proxy && DEQ_SIZE(addr->rlinks) - addr->proxy_rlink_count <= QDRC_LOCAL_DEST_THRESHOLD) {
+        qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_REMOVED_LOCAL_DEST, addr);
+    }
+}
+
+
 void qdr_core_bind_address_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_link_t *link)
 {
     assert(core->router_mode == QD_ROUTER_MODE_EDGE || !link->proxy);
@@ -786,40 +988,7 @@ void qdr_core_bind_address_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_li
     if (link->link_direction == QD_OUTGOING) {
         qdr_add_link_ref(&addr->rlinks, link, QDR_LINK_LIST_CLASS_ADDRESS);
         addr->proxy_rlink_count += link->proxy ? 1 : 0;
-
-        if (DEQ_SIZE(addr->rlinks) == 1) {
-            //
-            // If this is the only local destination for this address and the connection goes to an edge mesh,
-            // this address has a local-sole-destination-mesh.
-            //
-            if (link->conn->edge_mesh_id[0] != '\0') {
-                addr->local_sole_destination_mesh = true;
-                memcpy(addr->destination_mesh_id, link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES);
-                qdr_process_addr_attributes_CT(core, addr);
-                qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
-            }
-
-            //
-            // This is the first outgoing link for this address, start the flow of incoming deliveries.
-            //
-            qdr_addr_start_inlinks_CT(core, addr);
-        } else {
-            //
-            // This is an additional local destination for the address.  If this destination does not go
-            // to the same edge mesh as all the existing destinations, clear the local-sole-destination-mesh
-            // state.
-            //
-            if (addr->local_sole_destination_mesh && memcmp(addr->destination_mesh_id, link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES) != 0) {
-                addr->local_sole_destination_mesh = false;
-                addr->destination_mesh_id[0] = '\0';
-                qdr_process_addr_attributes_CT(core, addr);
-                qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
-            }
-        }
-
-        if (!link->proxy && DEQ_SIZE(addr->rlinks) - addr->proxy_rlink_count <= QDRC_LOCAL_DEST_THRESHOLD) {
-            qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_ADDED_LOCAL_DEST, addr);
-        }
+        qdr_addr_rlink_added_CT(core, addr, link);
     } else {  // link->link_direction == QD_INCOMING
         qdr_add_link_ref(&addr->inlinks, link, QDR_LINK_LIST_CLASS_ADDRESS);
         addr->proxy_inlink_count += link->proxy ? 1 : 0;
@@ -849,49 +1018,7 @@ void qdr_core_unbind_address_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_
         bool removed = qdr_del_link_ref(&addr->rlinks, link, QDR_LINK_LIST_CLASS_ADDRESS);
         if (removed) {
             addr->proxy_rlink_count -= link->proxy ? 1 : 0;
-
-            if (!addr->local_sole_destination_mesh) {
-                //
-                // If this address previously did not have a local-sole-destination-mesh, it may now have one.
-                // We need to check the remaining destinations to see if they all go to the same edge mesh.
-                //
-                if (DEQ_SIZE(addr->rlinks) > 0) {
-                    qdr_link_ref_t *ref       = DEQ_HEAD(addr->rlinks);
-                    bool            same_mesh = ref->link->conn->edge_mesh_id[0] != '\0';
-
-                    if (same_mesh) {
-                        memcpy(addr->destination_mesh_id, ref->link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES);
-                        while (!!ref && same_mesh) {
-                            if (memcmp(addr->destination_mesh_id, ref->link->conn->edge_mesh_id, QD_DISCRIMINATOR_BYTES) != 0) {
-                                same_mesh = false;
-                                addr->destination_mesh_id[0] = '\0';
-                            }
-                            ref = DEQ_NEXT(ref);
-                        }
-
-                        if (same_mesh) {
-                            addr->local_sole_destination_mesh = true;
-                            qdr_process_addr_attributes_CT(core, addr);
-                            qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
-                        }
-                    }
-                }
-            } else {
-                //
-                // If this address previously had a local-sole-destination-mesh and the last destination was just
-                // removed, the flag must be cleared.
-                //
-                if (DEQ_SIZE(addr->rlinks) == 0) {
-                    addr->local_sole_destination_mesh = false;
-                    addr->destination_mesh_id[0] = '\0';
-                    qdr_process_addr_attributes_CT(core, addr);
-                    qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_LOCAL_CHANGED, addr);
-                }
-            }
-
-            if (!link->proxy && DEQ_SIZE(addr->rlinks) - addr->proxy_rlink_count <= QDRC_LOCAL_DEST_THRESHOLD) {
-                qdrc_event_addr_raise(core, QDRC_EVENT_ADDR_REMOVED_LOCAL_DEST, addr);
-            }
+            qdr_addr_rlink_removed_CT(core, addr, link);
         }
     } else {  // link->link_direction == QD_INCOMING
         bool removed = qdr_del_link_ref(&addr->inlinks, link, QDR_LINK_LIST_CLASS_ADDRESS);
@@ -907,6 +1034,69 @@ void qdr_core_unbind_address_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_
 }
 
 
+qdr_mux_binding_t *qdr_core_bind_address_mux_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_link_t *link)
+{
+    qdr_mux_binding_t *binding = new_qdr_mux_binding_t();
+    ZERO(binding);
+    DEQ_ITEM_INIT(binding);
+    binding->addr = addr;
+
+    //
+    // The reference is not recorded in link->ref[] since the link may be referenced from many addresses.
+    //
+    qdr_link_ref_t *ref = new_qdr_link_ref_t();
+    DEQ_ITEM_INIT(ref);
+    ref->link        = link;
+    ref->mux_binding = binding;
+    binding->ref     = ref;
+
+    DEQ_INSERT_TAIL(link->mux_bindings, binding);
+    if (link->link_direction == QD_OUTGOING) {
+        DEQ_INSERT_TAIL(addr->rlinks, ref);
+        addr->proxy_rlink_count += link->proxy ? 1 : 0;
+        qdr_addr_rlink_added_CT(core, addr, link);
+    } else {
+        DEQ_INSERT_TAIL(addr->mux_inlinks, ref);
+    }
+    qdr_trigger_address_watch_CT(core, addr);
+    return binding;
+}
+
+
+void qdr_core_unbind_address_mux_link_CT(qdr_core_t *core, qdr_mux_binding_t *binding)
+{
+    qdr_address_t *addr = binding->addr;
+    qdr_link_t    *link = binding->ref->link;
+
+    DEQ_REMOVE(link->mux_bindings, binding);
+    if (link->link_direction == QD_OUTGOING) {
+        DEQ_REMOVE(addr->rlinks, binding->ref);
+    } else {
+        DEQ_REMOVE(addr->mux_inlinks, binding->ref);
+    }
+    free_qdr_link_ref_t(binding->ref);
+    free_qdr_mux_binding_t(binding);
+
+    if (link->link_direction == QD_OUTGOING) {
+        addr->proxy_rlink_count -= link->proxy ? 1 : 0;
+        qdr_addr_rlink_removed_CT(core, addr, link);
+    }
+    qdr_trigger_address_watch_CT(core, addr);
+}
+
+
+void qdr_core_unbind_address_mux_links_CT(qdr_core_t *core, qdr_link_t *link)
+{
+    qdr_mux_binding_t *binding = DEQ_HEAD(link->mux_bindings);
+    while (binding) {
+        qdr_address_t *addr = binding->addr;
+        qdr_core_unbind_address_mux_link_CT(core, binding);
+        qdr_check_addr_CT(core, addr);
+        binding = DEQ_HEAD(link->mux_bindings);
+    }
+}
+
+
 void qdr_core_remove_address_config(qdr_core_t *core, qdr_address_config_t *addr)
 {
     qd_iterator_t *pattern = qd_iterator_string(addr->pattern, ITER_VIEW_ALL);
@@ -919,6 +1109,7 @@ void qdr_core_remove_address_config(qdr_core_t *core, qdr_address_config_t *addr
     }
     DEQ_REMOVE(core->addr_config, addr);
     qd_parse_tree_remove_pattern(core->addr_parse_tree, pattern);
+    core->addr_config_generation++;
     addr->ref_count--;
 
     if (addr->ref_count == 0)
@@ -934,7 +1125,8 @@ void qdr_add_link_ref(qdr_link_ref_list_t *ref_list, qdr_link_t *link, int cls)
 
     qdr_link_ref_t *ref = new_qdr_link_ref_t();
     DEQ_ITEM_INIT(ref);
-    ref->link = link;
+    ref->link        = link;
+    ref->mux_binding = 0;
     link->ref[cls] = ref;
     DEQ_INSERT_TAIL(*ref_list, ref);
 }
@@ -1112,6 +1304,8 @@ static void qdr_global_stats_request_CT(qdr_core_t *core, qdr_action_t *action,
             stats->deliveries_delayed_10sec = core->deliveries_delayed_10sec;
             stats->deliveries_stuck = core->deliveries_stuck;
             stats->links_blocked = core->links_blocked;
+            for (int i = 0; i < QDR_DELIVERY_LATENCY_BUCKETS; i++)
+                stats->delivery_latency_histogram[i] = core->delivery_latency_histogram[i];
         }
         qdr_general_work_t *work = qdr_general_work(qdr_post_global_stats_response);
         work->stats_handler = action->args.stats_request.handler;
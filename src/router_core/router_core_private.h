@@ -44,6 +44,8 @@ typedef struct qdr_connection_ref_t  qdr_connection_ref_t;
 typedef struct qdr_edge_t            qdr_edge_t;
 typedef struct qdr_agent_t           qdr_agent_t;
 typedef struct qdr_edge_peer_t       qdr_edge_peer_t;
+typedef struct qdr_mux_binding_t     qdr_mux_binding_t;
+typedef struct qdr_edge_interest_t   qdr_edge_interest_t;
 
 ALLOC_DECLARE(qdr_address_t);
 ALLOC_DECLARE(qdr_address_config_t);
@@ -53,6 +55,7 @@ ALLOC_DECLARE(qdr_link_ref_t);
 ALLOC_DECLARE(qdr_auto_link_t);
 ALLOC_DECLARE(qdr_conn_identifier_t);
 ALLOC_DECLARE_SAFE(qdr_connection_ref_t);
+ALLOC_DECLARE_SAFE(qdr_mux_binding_t);
 
 ALLOC_DECLARE_SAFE(qdr_connection_t);
 ALLOC_DECLARE_SAFE(qdr_link_t);
@@ -100,6 +103,8 @@ struct qdr_action_t {
     DEQ_LINKS(qdr_action_t);
     qdr_action_handler_t  action_handler;
     const char           *label;
+    uint64_t              enqueue_usec;  // monotonic clock when queued, 0 for data actions that are not sampled
+    bool                  fence;         // control actions may not overtake this action, see qdr_action_fence_enqueue()
     union {
         //
         // Arguments for router control-plane actions
@@ -199,6 +204,20 @@ struct qdr_action_t {
 ALLOC_DECLARE(qdr_action_t);
 DEQ_DECLARE(qdr_action_t, qdr_action_list_t);
 
+//
+// The core thread runs at most this many control actions before giving a batch of data actions a turn, and at most
+// this many data actions before checking for control actions again.
+//
+#define QDR_CONTROL_ACTION_BURST 64
+#define QDR_DATA_ACTION_BATCH    1024
+
+typedef struct qdr_action_stats_t {
+    uint64_t actions;        // actions run
+    uint64_t waits;          // actions run whose queueing delay was measured
+    uint64_t wait_usec;      // total time the measured actions waited in the queue
+    uint64_t max_wait_usec;  // longest time a measured action waited in the queue
+} qdr_action_stats_t;
+
 //
 //
 //
@@ -240,15 +259,10 @@ struct qdr_general_work_t {
     void                        *on_message_context;
     uint64_t                     in_conn_id;
     uint64_t                     mobile_seq;
-    uint32_t                     local_consumers;
-    uint32_t                     in_proc_consumers;
-    uint32_t                     remote_consumers;
-    uint32_t                     local_producers;
     const qd_policy_spec_t      *policy_spec;
     qdr_delivery_t              *delivery;
     qdr_delivery_cleanup_list_t  delivery_cleanup_list;
     qdr_global_stats_handler_t   stats_handler;
-    qdr_address_watch_update_t   watch_update_handler;
     qdr_address_watch_cancel_t   watch_cancel_handler;
     void                        *context;
 };
@@ -419,7 +433,8 @@ void qdr_del_delivery_ref(qdr_delivery_ref_list_t *list, qdr_delivery_ref_t *ref
 #define QDR_LINK_LIST_CLASS_WORK       1
 #define QDR_LINK_LIST_CLASS_CONNECTION 2
 #define QDR_LINK_LIST_CLASS_LOCAL      3
-#define QDR_LINK_LIST_CLASSES          4
+#define QDR_LINK_LIST_CLASS_EDGE_ADDR  4
+#define QDR_LINK_LIST_CLASSES          5
 
 typedef enum {
     QDR_LINK_OPER_UP,
@@ -446,6 +461,33 @@ typedef enum {
 
 #define QDR_LINK_RATE_DEPTH 5
 
+//
+// Queueing-delay histogram buckets: time from a delivery being placed on an outgoing link's undelivered
+// list until the I/O thread starts sending it.  Upper bounds: 100us, 1ms, 10ms, 100ms, 1s, unbounded.
+//
+#define QDR_LINK_QDELAY_BUCKETS 6
+
+//
+// Default octet quantum granted to each link per deficit-round-robin round in qdr_connection_process.
+//
+#define QDR_LINK_DEFAULT_QUANTUM 65536
+
+//
+// A multiplexed binding makes an outgoing link one of the local destinations of an address without the address
+// becoming the link's owning_addr, so one link can be a destination for many addresses.  It is used when an edge
+// announces address interest instead of attaching a link per address (router edgeAddressProxy).  An incoming link
+// bound this way stands for the edge's producers of the address: it is counted as a producer but, unlike the
+// addr->inlinks, it is never started or drained on behalf of the address.
+//
+struct qdr_mux_binding_t {
+    DEQ_LINKS(qdr_mux_binding_t);   ///< Linkage in the link's mux_bindings list
+    qdr_address_t  *addr;
+    qdr_link_ref_t *ref;            ///< The reference to the link in addr->rlinks or addr->mux_inlinks
+};
+
+DEQ_DECLARE(qdr_mux_binding_t, qdr_mux_binding_list_t);
+DEQ_DECLARE(qdr_edge_interest_t, qdr_edge_interest_list_t);
+
 struct qdr_link_t {
     DEQ_LINKS(qdr_link_t);
     qdr_core_t              *core;
@@ -464,6 +506,7 @@ struct qdr_link_t {
     qdr_address_t           *owning_addr;        ///< [ref] Address record that owns this link
     qdrc_endpoint_t         *core_endpoint;      ///< [ref] Set if this link terminates on an in-core endpoint
     qdr_link_ref_t          *ref[QDR_LINK_LIST_CLASSES];  ///< Pointers to containing reference objects
+    qdr_mux_binding_list_t   mux_bindings;       ///< Multiplexed address bindings
     qdr_auto_link_t         *auto_link;          ///< [ref] Auto_link that owns this link
     qdr_delivery_list_t      undelivered;        ///< Deliveries to be forwarded or sent
     qdr_delivery_list_t      unsettled;          ///< Unsettled deliveries
@@ -509,6 +552,10 @@ struct qdr_link_t {
     uint64_t  deliveries_stuck;
     uint64_t  settled_deliveries[QDR_LINK_RATE_DEPTH];
     uint64_t *ingress_histogram;
+    uint64_t  queue_delay_histogram[QDR_LINK_QDELAY_BUCKETS];
+    uint64_t  latency_histogram[QDR_DELIVERY_LATENCY_BUCKETS];
+    int64_t   drr_deficit;  ///< Octets the link may still send in the current scheduling round (I/O thread only)
+    bool      drr_done;     ///< No more work to schedule for this link in the current qdr_connection_process
     uint8_t   priority;
     uint8_t   rate_cursor;
     uint32_t  core_ticks;
@@ -520,7 +567,8 @@ DEQ_DECLARE(qdr_link_t, qdr_link_list_t);
 
 struct qdr_link_ref_t {
     DEQ_LINKS(qdr_link_ref_t);
-    qdr_link_t *link;
+    qdr_link_t        *link;
+    qdr_mux_binding_t *mux_binding;  ///< Set if this reference is owned by a multiplexed binding
 };
 
 DEQ_DECLARE(qdr_link_ref_t, qdr_link_ref_list_t);
@@ -546,6 +594,7 @@ struct qdr_address_t {
     qdr_subscription_list_t    subscriptions; ///< In-process message subscribers
     qdr_link_ref_list_t        rlinks;        ///< Locally-Connected Consumers
     qdr_link_ref_list_t        inlinks;       ///< Locally-Connected Producers
+    qdr_link_ref_list_t        mux_inlinks;   ///< Producers on multiplexed edges, see qdr_mux_binding_t
     qd_bitmask_t              *rnodes;        ///< Bitmask of remote routers with connected consumers
     qd_hash_handle_t          *hash_handle;   ///< Linkage back to the hash table entry
     qdrc_endpoint_desc_t      *core_endpoint; ///< [ref] Set if this address is bound to an in-core endpoint
@@ -592,6 +641,16 @@ struct qdr_address_t {
     char *add_prefix;
     char *del_prefix;
 
+    //
+    // State for multiplexed mobile-address proxying (router edgeAddressProxy)
+    //
+    qdr_edge_interest_list_t edge_interests;        ///< Interest announced by edge peers (on interior router)
+    DEQ_LINKS_N(EDGE_INTEREST, qdr_address_t);      ///< Linkage in the list of pending announcements (on edge router)
+    qdr_mux_binding_t_sp     edge_mux_binding_sp;   ///< [ref] Binding of an uplink's anonymous sender (on edge router)
+    uint64_t                 edge_interest_conn_id; ///< Uplink connection the interest was announced on (on edge router)
+    uint8_t                  edge_interest;         ///< Interest flags announced to the interior (on edge router)
+    bool                     edge_interest_pending; ///< The address is in the list of pending announcements (on edge router)
+
     /**@name Statistics */
     ///@{
     uint64_t deliveries_ingress;
@@ -602,6 +661,7 @@ struct qdr_address_t {
     uint64_t deliveries_egress_route_container;
     uint64_t deliveries_ingress_route_container;
     uint64_t deliveries_redirected;
+    uint64_t latency_histogram[QDR_DELIVERY_LATENCY_BUCKETS];  ///< Settled deliveries sent to this address's consumers
 
     ///@}
 
@@ -618,6 +678,19 @@ void qdr_core_edge_mesh_id_changed_CT(qdr_core_t *core, qdr_connection_t *conn);
 void qdr_core_bind_address_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_link_t *link);
 void qdr_core_unbind_address_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_link_t *link);
 
+/**
+ * Make an outgoing link a local destination of an address through a multiplexed binding.  Unlike
+ * qdr_core_bind_address_link_CT this does not set the link's owning_addr, so a link may be bound to any number of
+ * addresses this way.  The binding is removed when the link detaches.
+ */
+qdr_mux_binding_t *qdr_core_bind_address_mux_link_CT(qdr_core_t *core, qdr_address_t *addr, qdr_link_t *link);
+void qdr_core_unbind_address_mux_link_CT(qdr_core_t *core, qdr_mux_binding_t *binding);
+
+/**
+ * Remove all of the multiplexed bindings of a link and release the addresses that are no longer in use.
+ */
+void qdr_core_unbind_address_mux_links_CT(qdr_core_t *core, qdr_link_t *link);
+
 struct qdr_address_config_t {
     DEQ_LINKS(qdr_address_config_t);
     char                   *name;
@@ -632,6 +705,41 @@ struct qdr_address_config_t {
 
 DEQ_DECLARE(qdr_address_config_t, qdr_address_config_list_t);
 void qdr_core_remove_address_config(qdr_core_t *core, qdr_address_config_t *addr);
+
+//
+// Address configuration lookup cache
+//
+// Remembers the result of matching an address against core->addr_parse_tree, including the absence of a match. All
+// entries are discarded when the address configuration changes (core->addr_config_generation). The oldest entry is
+// evicted once the cache holds QDR_ADDR_CONFIG_CACHE_SIZE entries.
+//
+// Entries are keyed by the part of the address the configured patterns can distinguish: when every pattern is a
+// literal prefix (tokens optionally followed by a trailing '#') the match only depends on the first key_tokens tokens
+// of the address and whether more follow, so all addresses sharing those tokens share one entry.  Otherwise
+// (key_tokens < 0) the full address is the key.  Addresses longer than QDR_ADDR_CONFIG_KEY_MAX bypass the cache.
+//
+#define QDR_ADDR_CONFIG_CACHE_SIZE 1024
+#define QDR_ADDR_CONFIG_KEY_MAX    255
+
+typedef struct qdr_addr_config_cache_entry_t qdr_addr_config_cache_entry_t;
+struct qdr_addr_config_cache_entry_t {
+    DEQ_LINKS(qdr_addr_config_cache_entry_t);
+    qd_hash_handle_t     *hash_handle;
+    qdr_address_config_t *config;  ///< null if no address configuration matches
+};
+
+ALLOC_DECLARE(qdr_addr_config_cache_entry_t);
+DEQ_DECLARE(qdr_addr_config_cache_entry_t, qdr_addr_config_cache_entry_list_t);
+
+typedef struct qdr_addr_config_cache_t {
+    qd_hash_t                          *hash;
+    qdr_addr_config_cache_entry_list_t  entries;     ///< oldest first
+    uint64_t                            generation;  ///< core->addr_config_generation the entries are valid for
+    int                                 key_tokens;  ///< address tokens in a key, < 0 to key on the full address
+} qdr_addr_config_cache_t;
+
+void qdr_addr_config_cache_init(qdr_addr_config_cache_t *cache);
+void qdr_addr_config_cache_free(qdr_addr_config_cache_t *cache);
 bool qdr_is_addr_treatment_multicast(qdr_address_t *addr);
 const char *get_address_treatment_string(qd_address_treatment_t  treatment);
 
@@ -706,6 +814,11 @@ struct qdr_connection_t {
     qdr_connection_t           *group_cursor;          ///< Pointer to the next group member to use for traffic allocation
     qdr_edge_peer_t            *edge_peer;             ///< Edge routers only - Mesh-peer that this connection links to
     char                        edge_mesh_id[QD_DISCRIMINATOR_BYTES]; ///< Interior, edge-role only - Identity of the connected mesh
+    uint64_t                    deliveries_in;         ///< Deliveries received on this connection's links
+    atomic_uint_fast64_t        deliveries_out;        ///< Deliveries sent on this connection's links (counted on the I/O thread)
+    sys_atomic_t                raw_buffers;           ///< Raw I/O buffers held by the adaptor, see qdr_connection_raw_buffers_held()
+    sys_atomic_t                unsettled_deliveries;  ///< Deliveries on the unsettled lists of this connection's links
+    qd_message_account_t       *buffer_account;        ///< Charged for the buffers of the messages received on this connection
 };
 
 void qdr_core_delete_auto_link (qdr_core_t *core,  qdr_auto_link_t *al);
@@ -814,7 +927,13 @@ struct qdr_core_t {
     sys_thread_t      *thread;
 
     qdr_action_list_t  action_list_background;  /// Actions processed only when the action_list is empty
+    qdr_action_list_t  action_list_control;     /// Routing control-plane actions, processed ahead of the action_list
     qdr_action_list_t  action_list;
+    qdr_action_list_t  action_batch_control;    /// Control actions taken by the core thread and not yet run
+    qdr_action_list_t  action_batch;            /// Data actions taken by the core thread and not yet run
+    sys_atomic_t       action_fences;           /// Fence actions queued on the action_list and not yet run
+    qdr_action_stats_t control_action_stats;
+    qdr_action_stats_t data_action_stats;
     sys_cond_t         action_cond;
     sys_mutex_t        action_lock;
     bool               running;
@@ -827,10 +946,15 @@ struct qdr_core_t {
     qdr_general_work_list_t  work_list;
     qd_timer_t              *work_timer;
     sys_atomic_t             uptime_ticks;
+    uint64_t                 batch_usec;  ///< Monotonic clock read once per core thread action batch
 
     qdr_protocol_adaptor_list_t  protocol_adaptors;
     qdr_connection_list_t        open_connections;
     qdr_connection_t            *active_edge_connection;
+    qdr_connection_ref_list_t    edge_uplinks;             ///< All open edge connections to interior routers (edge only)
+    bool                         edge_uplinks_active_active; ///< If true, all edge uplinks carry traffic
+    bool                         edge_proxy_multiplexed;     ///< If true, mobile-address interest is announced over one control link per uplink
+    int64_t                      link_quantum[QDR_N_PRIORITIES]; ///< Octets per link per scheduling round, 0: unlimited
     qdr_connection_list_t        connections_to_activate;
     qdr_link_list_t              open_links;
     qdr_connection_ref_list_t    streaming_connections;
@@ -873,7 +997,16 @@ struct qdr_core_t {
     qdr_address_list_t         addrs;
     qd_hash_t                 *addr_hash;
     qdr_address_watch_list_t   addr_watches;
+    atomic_uint_fast64_t       addr_watch_notifications;            ///< watch notifications delivered (counted by the invoker)
+    uint64_t                   addr_watch_notifications_coalesced;  ///< address changes folded into a pending notification
+    uint64_t                   edge_addr_tracking_messages;         ///< address-tracking messages sent to edge peers
+    uint64_t                   edge_addr_tracking_updates;          ///< address reachability updates in those messages
     qd_parse_tree_t           *addr_parse_tree;
+    uint64_t                   addr_config_generation;  ///< incremented whenever addr_parse_tree changes
+    qdr_addr_config_cache_t    addr_config_cache;       ///< keyed by address prefix (qdr_config_for_address_CT)
+    qdr_addr_config_cache_t    addr_treatment_cache;    ///< keyed by mobile address (qdr_treatment_for_address_hash_CT)
+    uint64_t                   addr_config_cache_hits;
+    uint64_t                   addr_config_cache_misses;
     qdr_address_t             *hello_addr;
     qdr_address_t             *router_addr_L;
     qdr_address_t             *routerma_addr_L;
@@ -914,6 +1047,7 @@ struct qdr_core_t {
     uint64_t deliveries_delayed_1sec;
     uint64_t deliveries_delayed_10sec;
     uint64_t deliveries_stuck;
+    uint64_t delivery_latency_histogram[QDR_DELIVERY_LATENCY_BUCKETS];
     uint64_t deliveries_redirected;
     uint32_t links_blocked;
 
@@ -947,6 +1081,8 @@ void qdr_agent_free(qdr_agent_t *agent);
 void  qdr_forwarder_setup_CT(qdr_core_t *core);
 qdr_action_t *qdr_action(qdr_action_handler_t action_handler, const char *label);
 void qdr_action_enqueue(qdr_core_t *core, qdr_action_t *action);
+void qdr_action_fence_enqueue(qdr_core_t *core, qdr_action_t *action);
+void qdr_action_control_enqueue(qdr_core_t *core, qdr_action_t *action);
 void qdr_action_background_enqueue(qdr_core_t *core, qdr_action_t *action);
 void qdr_link_issue_credit_CT(qdr_core_t *core, qdr_link_t *link, int credit, bool drain);
 void qdr_drain_inbound_undelivered_CT(qdr_core_t *core, qdr_link_t *link, qdr_address_t *addr);
@@ -1080,4 +1216,13 @@ static inline uint32_t qdr_core_uptime_ticks(qdr_core_t *core)
     return sys_atomic_get(&core->uptime_ticks);
 }
 
+/**
+ * Monotonic time in microseconds at the start of the core thread's current action batch. Deliveries settled in the
+ * same batch share one clock read.
+ */
+static inline uint64_t qdr_core_batch_usec(qdr_core_t *core)
+{
+    return core->batch_usec;
+}
+
 #endif
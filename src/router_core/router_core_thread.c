@@ -20,6 +20,7 @@
 #include "module.h"
 #include "router_core_private.h"
 
+#include "qpid/dispatch/platform.h"
 #include "qpid/dispatch/protocol_adaptor.h"
 
 /**
@@ -187,10 +188,38 @@ void qdr_adaptors_finalize(qdr_core_t *core)
 }
 
 
+/**
+ * Run up to limit actions from the head of the list (all of them once the core is stopping) and account for the time
+ * the stamped ones waited in the queue.
+ */
+static void qdr_run_actions_CT(qdr_core_t *core, qdr_action_list_t *actions, qdr_action_stats_t *stats, int limit)
+{
+    const uint64_t now    = core->batch_usec;
+    qdr_action_t  *action = DEQ_HEAD(*actions);
+    while (action && (limit-- > 0 || !core->running)) {
+        DEQ_REMOVE_HEAD(*actions);
+        stats->actions++;
+        if (action->enqueue_usec) {
+            const uint64_t wait_usec = now > action->enqueue_usec ? now - action->enqueue_usec : 0;
+            stats->waits++;
+            stats->wait_usec    += wait_usec;
+            stats->max_wait_usec = MAX(stats->max_wait_usec, wait_usec);
+        }
+        if (action->label)
+            qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG, "Core action '%s'%s", action->label,
+                   core->running ? "" : " (discard)");
+        action->action_handler(core, action, !core->running);
+        if (action->fence)
+            sys_atomic_dec(&core->action_fences);
+        free_qdr_action_t(action);
+        action = DEQ_HEAD(*actions);
+    }
+}
+
+
 void *router_core_thread(void *arg)
 {
     qdr_core_t        *core = (qdr_core_t*) arg;
-    qdr_action_list_t  action_list = DEQ_EMPTY;
     qdr_action_t      *bg_action = 0;
 
     qd_log(LOG_ROUTER_CORE, QD_LOG_INFO, "Router Core thread running. %s/%s", core->router_area,
@@ -202,10 +231,15 @@ void *router_core_thread(void *arg)
         sys_mutex_lock(&core->action_lock);
 
         for (;;) {
-            if (!DEQ_IS_EMPTY(core->action_list)) {
-                DEQ_MOVE(core->action_list, action_list);
+            //
+            // Control actions are collected on every pass so that they wait behind at most one batch of data actions.
+            // Data actions are taken a whole list at a time but run in batches of QDR_DATA_ACTION_BATCH.
+            //
+            DEQ_APPEND(core->action_batch_control, core->action_list_control);
+            if (DEQ_IS_EMPTY(core->action_batch))
+                DEQ_MOVE(core->action_list, core->action_batch);
+            if (!DEQ_IS_EMPTY(core->action_batch_control) || !DEQ_IS_EMPTY(core->action_batch))
                 break;
-            }
 
             // no pending actions so process one background action if present
             //
@@ -228,6 +262,8 @@ void *router_core_thread(void *arg)
 
         sys_mutex_unlock(&core->action_lock);
 
+        core->batch_usec = qd_platform_monotonic_usec();
+
         // bg_action is set only when there are no other actions pending
         //
         if (bg_action) {
@@ -241,18 +277,10 @@ void *router_core_thread(void *arg)
         }
 
         //
-        // Process and free all of the action items in the list
+        // Process a burst of control actions followed by a batch of data actions
         //
-        qdr_action_t *action = DEQ_HEAD(action_list);
-        while (action) {
-            DEQ_REMOVE_HEAD(action_list);
-            if (action->label)
-                qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG, "Core action '%s'%s", action->label,
-                       core->running ? "" : " (discard)");
-            action->action_handler(core, action, !core->running);
-            free_qdr_action_t(action);
-            action = DEQ_HEAD(action_list);
-        }
+        qdr_run_actions_CT(core, &core->action_batch_control, &core->control_action_stats, QDR_CONTROL_ACTION_BURST);
+        qdr_run_actions_CT(core, &core->action_batch, &core->data_action_stats, QDR_DATA_ACTION_BATCH);
 
         //
         // Activate all connections that were flagged for activation during the above processing
@@ -269,6 +297,12 @@ void *router_core_thread(void *arg)
         }
     }
 
+    //
+    // Discard the actions taken but not run before the core stopped
+    //
+    qdr_run_actions_CT(core, &core->action_batch_control, &core->control_action_stats, 0);
+    qdr_run_actions_CT(core, &core->action_batch, &core->data_action_stats, 0);
+
     qd_log(LOG_ROUTER_CORE, QD_LOG_INFO, "Router Core thread exited");
     return 0;
 }
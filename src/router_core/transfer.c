@@ -21,6 +21,7 @@
 #include "router_core_private.h"
 
 #include "qpid/dispatch/amqp.h"
+#include "qpid/dispatch/platform.h"
 
 #include <inttypes.h>
 
@@ -29,6 +30,7 @@
 //==================================================================================
 
 static void qdr_link_flow_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
+static void qdr_link_set_capacity_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 static void qdr_send_to_CT(qdr_core_t *core, qdr_action_t *action, bool discard);
 
 
@@ -54,10 +56,12 @@ qdr_delivery_t *qdr_link_deliver(qdr_link_t *link, qd_message_t *msg, qd_iterato
     dlv->ingress_index      = ingress_index;
     dlv->remote_disposition = remote_disposition;
     dlv->remote_state       = remote_state;
+    dlv->ingress_usec       = qd_platform_monotonic_usec();
     dlv->delivery_id        = next_delivery_id();
     dlv->link_id            = link->identity;
     dlv->conn_id            = link->conn_id;
-    sys_mutex_init(&dlv->dispo_lock);
+    sys_mutex_init_named(&dlv->dispo_lock, "core.delivery.dispo_lock");
+    qd_message_set_account(msg, link->conn->buffer_account);
     qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG, DLV_FMT " Delivery created qdr_link_deliver", DLV_ARGS(dlv));
 
     qdr_delivery_incref(dlv, "qdr_link_deliver - newly created delivery, add to action list");
@@ -90,10 +94,12 @@ qdr_delivery_t *qdr_link_deliver_to(qdr_link_t *link, qd_message_t *msg,
     dlv->ingress_index      = ingress_index;
     dlv->remote_disposition = remote_disposition;
     dlv->remote_state       = remote_state;
+    dlv->ingress_usec       = qd_platform_monotonic_usec();
     dlv->delivery_id        = next_delivery_id();
     dlv->link_id            = link->identity;
     dlv->conn_id            = link->conn_id;
-    sys_mutex_init(&dlv->dispo_lock);
+    sys_mutex_init_named(&dlv->dispo_lock, "core.delivery.dispo_lock");
+    qd_message_set_account(msg, link->conn->buffer_account);
     qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG, DLV_FMT " Delivery created qdr_link_deliver_to", DLV_ARGS(dlv));
 
     qdr_delivery_incref(dlv, "qdr_link_deliver_to - newly created delivery, add to action list");
@@ -120,10 +126,12 @@ qdr_delivery_t *qdr_link_deliver_to_core(qdr_link_t *link, qd_message_t *msg, bo
     dlv->presettled         = settled;
     dlv->remote_disposition = remote_disposition;
     dlv->remote_state       = remote_state;
+    dlv->ingress_usec       = qd_platform_monotonic_usec();
     dlv->delivery_id        = next_delivery_id();
     dlv->link_id            = link->identity;
     dlv->conn_id            = link->conn_id;
-    sys_mutex_init(&dlv->dispo_lock);
+    sys_mutex_init_named(&dlv->dispo_lock, "core.delivery.dispo_lock");
+    qd_message_set_account(msg, link->conn->buffer_account);
 
     qd_message_disable_router_annotations(msg);  // deliveries to the core do not use router annotations
 
@@ -140,7 +148,31 @@ qdr_delivery_t *qdr_link_deliver_to_core(qdr_link_t *link, qd_message_t *msg, bo
 }
 
 
-// send up to credit pending outgoing deliveries
+// Account for the time a delivery waited on the undelivered list before the I/O thread started sending it.  The
+// clock is read at most once per batch: *now is zero until the first delivery of the batch needs it.
+//
+static void qdr_link_record_queue_delay(qdr_link_t *link, qdr_delivery_t *dlv, uint64_t *now)
+{
+    if (dlv->enqueue_usec == 0)
+        return;
+
+    if (*now == 0)
+        *now = qd_platform_monotonic_usec();
+    uint64_t delay  = *now > dlv->enqueue_usec ? *now - dlv->enqueue_usec : 0;
+    int      bucket = 0;
+    for (uint64_t bound = 100; bucket < QDR_LINK_QDELAY_BUCKETS - 1 && delay >= bound; bound *= 10)
+        bucket++;
+    link->queue_delay_histogram[bucket]++;
+    dlv->enqueue_usec = 0;
+}
+
+
+//
+// Send the link's undelivered deliveries, at most 'credit' of them.  Sending stops early once the completed
+// deliveries have used up the link's scheduling deficit (link->drr_deficit), which the caller,
+// qdr_connection_process, replenishes every round.  The deliver handler charges the deficit with the octets it
+// writes (qdr_link_charge_octets); only the AMQP adaptor does, see protocol_adaptor.h.
+//
 int qdr_link_process_deliveries(qdr_core_t *core, qdr_link_t *link, int credit)
 {
     qdr_connection_t *conn = link->conn;
@@ -149,15 +181,17 @@ int qdr_link_process_deliveries(qdr_core_t *core, qdr_link_t *link, int credit)
     bool              settled = false;
     bool              send_complete = false;
     int               num_deliveries_completed = 0;
+    uint64_t          now = 0;
 
     if (link->link_direction == QD_OUTGOING) {
 
-        while (credit > 0) {
+        while (credit > 0 && link->drr_deficit > 0) {
             sys_mutex_lock(&conn->work_lock);
             dlv = DEQ_HEAD(link->undelivered);
             if (dlv) {
                 qdr_delivery_incref(dlv, "qdr_link_process_deliveries - holding the undelivered delivery locally");
                 uint64_t new_disp    = 0;
+                qdr_link_record_queue_delay(link, dlv, &now);
 
                 // DISPATCH-1302 race hack fix: There is a race between the CORE thread
                 // and the outbound (this) thread over settlement. It occurs when the CORE
@@ -187,6 +221,7 @@ int qdr_link_process_deliveries(qdr_core_t *core, qdr_link_t *link, int credit)
                     credit--;
                     link->credit_to_core--;
                     link->total_deliveries++;
+                    atomic_fetch_add_explicit(&conn->deliveries_out, 1, memory_order_relaxed);
 
                     if (new_disp != QD_DELIVERY_MOVED_TO_NEW_LINK) {
                         //
@@ -212,6 +247,7 @@ int qdr_link_process_deliveries(qdr_core_t *core, qdr_link_t *link, int credit)
                             qdr_delivery_decref(core, dlv, "qdr_link_process_deliveries - remove from undelivered list");
                         } else {
                             DEQ_INSERT_TAIL(link->unsettled, dlv);
+                            sys_atomic_inc(&link->conn->unsettled_deliveries);
                             dlv->where = QDR_DELIVERY_IN_UNSETTLED;
                             qd_log(
                                 LOG_ROUTER_CORE, QD_LOG_DEBUG,
@@ -321,6 +357,7 @@ void qdr_link_complete_sent_message(qdr_core_t *core, qdr_link_t *link)
 
         if (!dlv->settled && !qdr_delivery_oversize(dlv) && !qdr_delivery_is_aborted(dlv)) {
             DEQ_INSERT_TAIL(link->unsettled, dlv);
+            sys_atomic_inc(&link->conn->unsettled_deliveries);
             dlv->where = QDR_DELIVERY_IN_UNSETTLED;
             qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG,
                    DLV_FMT " Delivery transfer:  qdr_link_complete_sent_message: undelivered-list -> unsettled-list",
@@ -371,6 +408,18 @@ void qdr_link_flow(qdr_core_t *core, qdr_link_t *link, int credit, bool drain_mo
     qdr_record_link_credit(core, link);
 }
 
+
+void qdr_link_set_capacity(qdr_core_t *core, qdr_link_t *link, int capacity)
+{
+    qdr_action_t *action = qdr_action(qdr_link_set_capacity_CT, "link_set_capacity");
+
+    assert(capacity > 0);
+    set_safe_ptr_qdr_link_t(link, &action->args.connection.link);
+    action->args.connection.credit = capacity;
+    qdr_action_enqueue(core, action);
+}
+
+
 void qdr_link_set_drained(qdr_core_t *core, qdr_link_t *link)
 {
     if (link) {
@@ -409,6 +458,17 @@ void qdr_send_to2(qdr_core_t *core, qd_message_t *msg, const char *addr, bool ex
 //==================================================================================
 
 
+static void qdr_link_set_capacity_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
+{
+    qdr_link_t *link = safe_deref_qdr_link_t(action->args.connection.link);
+
+    if (discard || !link)
+        return;
+
+    link->capacity = action->args.connection.credit;
+}
+
+
 static void qdr_link_flow_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
 {
     qdr_link_t *link = safe_deref_qdr_link_t(action->args.connection.link);
@@ -677,6 +737,7 @@ static void qdr_link_forward_CT(qdr_core_t *core, qdr_link_t *link, qdr_delivery
             // Again, don't bother decrementing then incrementing the ref_count
             //
             DEQ_INSERT_TAIL(link->unsettled, dlv);
+            sys_atomic_inc(&link->conn->unsettled_deliveries);
             dlv->where = QDR_DELIVERY_IN_UNSETTLED;
             qd_log(LOG_ROUTER_CORE, QD_LOG_DEBUG,
                    DLV_FMT " Delivery transfer:  qdr_link_forward_CT: action-list -> unsettled-list", DLV_ARGS(dlv));
@@ -712,6 +773,8 @@ void qdr_link_deliver_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
         link->reforwards++;
     } else {
         link->total_deliveries++;
+        if (link->conn)
+            link->conn->deliveries_in++;
         if (link->link_type == QD_LINK_ENDPOINT)
             core->deliveries_ingress++;
     }
@@ -793,6 +856,7 @@ void qdr_link_deliver_CT(qdr_core_t *core, qdr_action_t *action, bool discard)
                             temp_rlink = new_qdr_link_ref_t();
                             DEQ_ITEM_INIT(temp_rlink);
                             temp_rlink->link = sender_rlink->link;
+                            temp_rlink->mux_binding = 0;
                             DEQ_INSERT_TAIL(addr->rlinks, temp_rlink);
                         }
                     }
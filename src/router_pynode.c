@@ -25,6 +25,7 @@
 #include "router_private.h"
 
 #include "qpid/dispatch.h"
+#include "qpid/dispatch/atomic.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -315,60 +316,89 @@ static PyTypeObject RouterAdapterType = {
 };
 
 
+//
+// The route table callbacks are invoked by the core's general work handler on an I/O thread.  The Python calls are
+// queued to the Python thread rather than having the I/O thread wait for the GIL.
+//
+static void qd_router_set_mobile_seq_work(qd_python_work_t *work, bool discard)
+{
+    if (discard || !pySetMobileSeq)
+        return;
+
+    PyObject *pArgs = PyTuple_New(2);
+    PyTuple_SetItem(pArgs, 0, PyLong_FromLong((long) work->maskbit));
+    PyTuple_SetItem(pArgs, 1, PyLong_FromLong((long) work->mobile_seq));
+    PyObject *pValue = PyObject_CallObject(pySetMobileSeq, pArgs);
+    qd_error_py();
+    Py_DECREF(pArgs);
+    Py_XDECREF(pValue);
+}
+
+
 static void qd_router_set_mobile_seq(void *context, int router_mask_bit, uint64_t mobile_seq)
 {
     qd_router_t *router = (qd_router_t*) context;
-    PyObject    *pArgs;
-    PyObject    *pValue;
 
     if (pySetMobileSeq && router->router_mode == QD_ROUTER_MODE_INTERIOR) {
-        qd_python_lock_state_t lock_state = qd_python_lock();
-        pArgs = PyTuple_New(2);
-        PyTuple_SetItem(pArgs, 0, PyLong_FromLong((long) router_mask_bit));
-        PyTuple_SetItem(pArgs, 1, PyLong_FromLong((long) mobile_seq));
-        pValue = PyObject_CallObject(pySetMobileSeq, pArgs);
-        qd_error_py();
-        Py_DECREF(pArgs);
-        Py_XDECREF(pValue);
-        qd_python_unlock(lock_state);
+        qd_python_work_t *work = qd_python_work(qd_router_set_mobile_seq_work);
+        work->context    = router;
+        work->maskbit    = router_mask_bit;
+        work->mobile_seq = mobile_seq;
+        qd_python_post_work(work);
     }
 }
 
 
+static void qd_router_set_my_mobile_seq_work(qd_python_work_t *work, bool discard)
+{
+    if (discard || !pySetMyMobileSeq)
+        return;
+
+    PyObject *pArgs = PyTuple_New(1);
+    PyTuple_SetItem(pArgs, 0, PyLong_FromLong((long) work->mobile_seq));
+    PyObject *pValue = PyObject_CallObject(pySetMyMobileSeq, pArgs);
+    qd_error_py();
+    Py_DECREF(pArgs);
+    Py_XDECREF(pValue);
+}
+
+
 static void qd_router_set_my_mobile_seq(void *context, uint64_t mobile_seq)
 {
     qd_router_t *router = (qd_router_t*) context;
-    PyObject    *pArgs;
-    PyObject    *pValue;
 
     if (pySetMobileSeq && router->router_mode == QD_ROUTER_MODE_INTERIOR) {
-        qd_python_lock_state_t lock_state = qd_python_lock();
-        pArgs = PyTuple_New(1);
-        PyTuple_SetItem(pArgs, 0, PyLong_FromLong((long) mobile_seq));
-        pValue = PyObject_CallObject(pySetMyMobileSeq, pArgs);
-        qd_error_py();
-        Py_DECREF(pArgs);
-        Py_XDECREF(pValue);
-        qd_python_unlock(lock_state);
+        qd_python_work_t *work = qd_python_work(qd_router_set_my_mobile_seq_work);
+        work->context    = router;
+        work->mobile_seq = mobile_seq;
+        qd_python_post_work(work);
     }
 }
 
 
+static void qd_router_link_lost_work(qd_python_work_t *work, bool discard)
+{
+    if (discard || !pyLinkLost)
+        return;
+
+    PyObject *pArgs = PyTuple_New(1);
+    PyTuple_SetItem(pArgs, 0, PyLong_FromLong((long) work->maskbit));
+    PyObject *pValue = PyObject_CallObject(pyLinkLost, pArgs);
+    qd_error_py();
+    Py_DECREF(pArgs);
+    Py_XDECREF(pValue);
+}
+
+
 static void qd_router_link_lost(void *context, int link_mask_bit)
 {
     qd_router_t *router = (qd_router_t*) context;
-    PyObject    *pArgs;
-    PyObject    *pValue;
 
     if (pyLinkLost && router->router_mode == QD_ROUTER_MODE_INTERIOR) {
-        qd_python_lock_state_t lock_state = qd_python_lock();
-        pArgs = PyTuple_New(1);
-        PyTuple_SetItem(pArgs, 0, PyLong_FromLong((long) link_mask_bit));
-        pValue = PyObject_CallObject(pyLinkLost, pArgs);
-        qd_error_py();
-        Py_DECREF(pArgs);
-        Py_XDECREF(pValue);
-        qd_python_unlock(lock_state);
+        qd_python_work_t *work = qd_python_work(qd_router_link_lost_work);
+        work->context = router;
+        work->maskbit = link_mask_bit;
+        qd_python_post_work(work);
     }
 }
 
@@ -465,23 +495,35 @@ void qd_router_python_free(qd_router_t *router) {
 }
 
 
+static sys_atomic_t tick_pending;
+
+static void qd_pyrouter_tick_work(qd_python_work_t *work, bool discard)
+{
+    CLEAR_ATOMIC_FLAG(&tick_pending);
+    if (discard || !pyTick)
+        return;
+
+    PyObject *pArgs  = PyTuple_New(0);
+    PyObject *pValue = PyObject_CallObject(pyTick, pArgs);
+    Py_DECREF(pArgs);
+    Py_XDECREF(pValue);
+    qd_error_py();
+}
+
+
 qd_error_t qd_pyrouter_tick(qd_router_t *router)
 {
     qd_error_clear();
-    qd_error_t err = QD_ERROR_NONE;
-
-    PyObject *pArgs;
-    PyObject *pValue;
-
-    if (pyTick && router->router_mode == QD_ROUTER_MODE_INTERIOR) {
-        qd_python_lock_state_t lock_state = qd_python_lock();
-        pArgs  = PyTuple_New(0);
-        pValue = PyObject_CallObject(pyTick, pArgs);
-        Py_DECREF(pArgs);
-        Py_XDECREF(pValue);
-        err = qd_error_py();
-        qd_python_unlock(lock_state);
+
+    //
+    // Run on the Python thread.  If the previous tick has not run yet the Python thread is backed up: do not queue
+    // another.
+    //
+    if (pyTick && router->router_mode == QD_ROUTER_MODE_INTERIOR && !SET_ATOMIC_FLAG(&tick_pending)) {
+        qd_python_work_t *work = qd_python_work(qd_pyrouter_tick_work);
+        work->context = router;
+        qd_python_post_work(work);
     }
-    return err;
+    return QD_ERROR_NONE;
 }
 
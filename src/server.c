@@ -38,6 +38,7 @@
 #include "qpid/dispatch/ctools.h"
 #include "qpid/dispatch/failoverlist.h"
 #include "qpid/dispatch/log.h"
+#include "qpid/dispatch/memory_governor.h"
 #include "qpid/dispatch/platform.h"
 #include "qpid/dispatch/proton_utils.h"
 #include "qpid/dispatch/threading.h"
@@ -54,9 +55,17 @@
 #include <stdio.h>
 #include <string.h>
 
+// Per proactor thread busy time. Each entry is written only by its thread.
+typedef struct proactor_thread_stats_t {
+    atomic_uint_fast64_t batches;
+    atomic_uint_fast64_t busy_usec;
+} proactor_thread_stats_t;
+
 struct qd_server_t {
     qd_dispatch_t            *qd;
     const int                 thread_count; /* Immutable */
+    proactor_thread_stats_t  *thread_stats; /* thread_count entries */
+    sys_atomic_t              next_thread_index;
     const char               *container_name;
     const char               *sasl_config_path;
     const char               *sasl_config_name;
@@ -141,9 +150,12 @@ static void *proactor_thread(void *arg)
     ASSERT_THREAD_IS(SYS_THREAD_PROACTOR);
 
     qd_server_t      *qd_server = (qd_server_t*)arg;
+    const int         index     = sys_atomic_inc(&qd_server->next_thread_index) % qd_server->thread_count;
+    proactor_thread_stats_t *stats = &qd_server->thread_stats[index];
     bool running = true;
     while (running) {
         pn_event_batch_t            *events            = pn_proactor_wait(qd_server->proactor);
+        const uint64_t               batch_start       = qd_platform_monotonic_usec();
         sys_thread_proactor_mode_t   proactor_mode     = SYS_THREAD_PROACTOR_MODE_OTHER;
         void                        *proactor_context  = 0;
         bool                        (*event_handler)(qd_server_t *, pn_event_t *, void *);
@@ -176,6 +188,9 @@ static void *proactor_thread(void *arg)
 
         (void) event_handler(qd_server, 0, proactor_context);
         pn_proactor_done(qd_server->proactor, events);
+
+        atomic_fetch_add_explicit(&stats->batches, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&stats->busy_usec, qd_platform_monotonic_usec() - batch_start, memory_order_relaxed);
     }
     return NULL;
 }
@@ -196,9 +211,11 @@ qd_server_t *qd_server(qd_dispatch_t *qd, int thread_count, const char *containe
     qd_server->sasl_config_name = sasl_config_name;
     qd_server->proactor         = pn_proactor();
     qd_server->start_context    = 0;
+    qd_server->thread_stats     = (proactor_thread_stats_t *) qd_calloc(thread_count, sizeof(proactor_thread_stats_t));
+    sys_atomic_init(&qd_server->next_thread_index, 0);
 
-    sys_mutex_init(&qd_server->lock);
-    sys_mutex_init(&qd_server->conn_activation_lock);
+    sys_mutex_init_named(&qd_server->lock, "server.lock");
+    sys_mutex_init_named(&qd_server->conn_activation_lock, "server.conn_activation_lock");
     sys_cond_init(&qd_server->cond);
 
     qd_timer_initialize();
@@ -235,6 +252,8 @@ void qd_server_free(qd_server_t *qd_server)
     sys_mutex_free(&qd_server->lock);
     sys_mutex_free(&qd_server->conn_activation_lock);
     sys_cond_free(&qd_server->cond);
+    sys_atomic_destroy(&qd_server->next_thread_index);
+    free(qd_server->thread_stats);
     free(qd_server);
 }
 
@@ -265,6 +284,7 @@ void qd_server_run(qd_dispatch_t *qd)
 #endif
 
     qd_alloc_start_monitor(qd);  // enable periodic alloc pool usage loggin
+    qd_memory_governor_start(qd);
 
     const int n = qd_server->thread_count;
     sys_thread_t **threads = (sys_thread_t **)qd_calloc(n, sizeof(sys_thread_t*));
@@ -279,6 +299,7 @@ void qd_server_run(qd_dispatch_t *qd)
     free(threads);
 
     qd_alloc_stop_monitor();
+    qd_memory_governor_stop();
 
     qd_log(LOG_ROUTER, QD_LOG_INFO, "Shut Down");
 }
@@ -296,6 +317,18 @@ void qd_server_timeout(qd_server_t *server, qd_duration_t duration) {
 
 qd_dispatch_t* qd_server_dispatch(qd_server_t *server) { return server->qd; }
 
+int qd_server_thread_count(const qd_server_t *server)
+{
+    return server->thread_count;
+}
+
+void qd_server_thread_stats(const qd_server_t *server, int index, qd_server_thread_stats_t *stats)
+{
+    assert(index >= 0 && index < server->thread_count);
+    stats->batches   = atomic_load_explicit(&server->thread_stats[index].batches, memory_order_relaxed);
+    stats->busy_usec = atomic_load_explicit(&server->thread_stats[index].busy_usec, memory_order_relaxed);
+}
+
 uint64_t qd_server_allocate_connection_id(qd_server_t *server)
 {
     uint64_t id;
@@ -44,4 +44,23 @@ void qd_server_timeout(qd_server_t *server, qd_duration_t delay);
  */
 void qd_server_trace_all_connections(bool enable_tracing);
 
+/**
+ * Busy time of a proactor I/O thread: the time spent handling proactor event batches as opposed to waiting for them.
+ */
+typedef struct qd_server_thread_stats_t {
+    uint64_t batches;    // event batches handled
+    uint64_t busy_usec;  // total time spent handling event batches
+} qd_server_thread_stats_t;
+
+/**
+ * Get the number of proactor I/O threads (workerThreads)
+ */
+int qd_server_thread_count(const qd_server_t *server);
+
+/**
+ * Get a snapshot of the busy time counters of the proactor I/O thread at index (0 .. qd_server_thread_count() - 1).
+ * Thread safe.
+ */
+void qd_server_thread_stats(const qd_server_t *server, int index, qd_server_thread_stats_t *stats);
+
 #endif
@@ -283,7 +283,7 @@ void qd_timer_cancel(qd_timer_t *timer)
 
 void qd_timer_initialize(void)
 {
-    sys_mutex_init(&lock);
+    sys_mutex_init_named(&lock, "timer.lock");
     DEQ_INIT(scheduled_timers);
     time_base = 0;
 }
@@ -26,6 +26,7 @@
 #include "qpid/dispatch/atomic.h"
 #include "qpid/dispatch/threading.h"
 #include "qpid/dispatch/log.h"
+#include "qpid/dispatch/timer.h"
 
 typedef struct qd_tls_context_t qd_tls_context_t;
 typedef struct qd_proton_config_t qd_proton_config_t;
@@ -56,7 +57,9 @@ struct qd_proton_config_t {
  * Context for a single per-connection TLS data stream
  */
 struct qd_tls_session_t {
+    DEQ_LINKS(qd_tls_session_t);           // for the handshake worker queue
     qd_proton_config_t   *proton_tls_cfg;  // TLS Proton configuration used by session
+    qd_tls_config_t      *tls_config;      // parent configuration (referenced) for handshake accounting
 
     // only one of the following Proton session pointers will be set based on whether this session is for a raw
     // connection or an AMQP connection
@@ -76,11 +79,25 @@ struct qd_tls_session_t {
     bool                   raw_read_drained; // raw conn read closed and all buffer read
     bool                   input_drained;    // no more decrypted output, raw conn read closed
     bool                   output_flushed;   // encrypt done, raw conn write closed
+    bool                   handshake_done;   // accounted for in the parent config's handshake stats
+    bool                   input_closed;     // cached pn_tls_is_input_closed(): readable while offloaded
+
+    // handshake offload state (see tls_handshake.c). offloaded is set by the I/O thread and cleared by the worker once
+    // it is done with pn_raw. offload_free is protected by the handshake pool lock, the remainder are only accessed by
+    // the I/O thread once offloaded is cleared
+    pn_raw_connection_t   *offload_raw_conn;  // woken when the offloaded handshake step completes
+    sys_atomic_t           offloaded;         // pn_raw is owned by a handshake worker thread
+    bool                   offload_free;      // qd_tls_session_free() called while offloaded
+    bool                   offload_done;      // offload_error holds the result of the offloaded pn_tls_process()
+    int                    offload_error;
 
     uint64_t encrypted_output_bytes;
     uint64_t encrypted_input_bytes;
+    uint64_t handshake_start_usec;
 };
 
+DEQ_DECLARE(qd_tls_session_t, qd_tls_session_list_t);
+
 /**
  * Context for a TLS configuration object.
  *
@@ -98,10 +115,12 @@ struct qd_tls_config_t {
     qd_tls_type_t       p_type;
     sys_atomic_t        ref_count;
     long                version;         // lock must be held
+    qd_tls_handshake_stats_t handshake_stats;  // lock must be held
 
     bool                authenticate_peer;
     bool                verify_hostname;
     bool                is_listener;
+    bool                owner_released;  // the listener/connector has dropped its reference, lock must be held
 };
 
 DEQ_DECLARE(qd_tls_config_t, qd_tls_config_list_t);
@@ -118,6 +137,7 @@ struct qd_tls_context_t {
     char                 *ssl_profile_name;
     qd_ssl2_profile_t     profile;
     qd_tls_config_list_t  tls_configs;
+    qd_timer_t           *rotation_timer;  // reloads listener configs every profile.session_cache_rotation seconds
 };
 
 DEQ_DECLARE(qd_tls_context_t, qd_tls_context_list_t);
@@ -132,5 +152,11 @@ pn_ssl_domain_t *tls_private_allocate_amqp_config(const char *ssl_profile_name,
                                                   bool is_listener, bool verify_hostname, bool authenticate_peer);
 qd_proton_config_t *qd_proton_config(pn_tls_config_t *tls_cfg, pn_ssl_domain_t *ssl_cfg);
 void qd_proton_config_decref(qd_proton_config_t *p_cfg);
+void tls_private_handshake_done(qd_tls_session_t *session, bool resumed);
+void tls_private_handshake_pool_initialize(void);
+void tls_private_handshake_pool_finalize(void);
+bool tls_private_handshake_offload(qd_tls_session_t *session, pn_raw_connection_t *raw_conn);
+bool tls_private_handshake_offloaded(const qd_tls_session_t *session);
+bool tls_private_handshake_defer_free(qd_tls_session_t *session);
 #endif
 
@@ -24,6 +24,7 @@
 #include "qpid/dispatch/error.h"
 #include "qpid/dispatch/threading.h"
 #include "qpid/dispatch/buffer.h"
+#include "qpid/dispatch/platform.h"
 #include "entity.h"
 
 #include <proton/tls.h>
@@ -66,6 +67,8 @@ static void _tls_context_free(qd_tls_context_t *ctxt);
 static qd_error_t _update_tls_config(qd_tls_config_t *tls_config, const qd_ssl2_profile_t *profile);
 static qd_error_t _validate_config(const qd_ssl2_profile_t *profile, const char *profile_name, bool is_listener,
                                    bool authenticate_peer);
+static void _schedule_session_cache_rotation(qd_dispatch_t *qd, qd_tls_context_t *tls_context);
+static void _tls_config_decref(qd_tls_config_t *tls_config);
 
 // TODO: these should be moved somewhere public as they are called from multiple places
 extern void qd_server_config_process_password(char **actual_val, char *pw, bool *is_file, bool allow_literal_prefix);
@@ -83,6 +86,7 @@ extern void qd_set_password_from_file(const char *password_file, char **password
 void qd_tls_initialize(void)
 {
     DEQ_INIT(context_list);
+    tls_private_handshake_pool_initialize();
 }
 
 
@@ -95,6 +99,7 @@ void qd_tls_finalize(void)
         ctxt = DEQ_HEAD(context_list);
     }
     tls_private_release_display_name_service();
+    tls_private_handshake_pool_finalize();
 }
 
 
@@ -126,6 +131,7 @@ QD_EXPORT void *qd_tls_configure_ssl_profile(qd_dispatch_t *qd, qd_entity_t *ent
     }
 
     DEQ_INSERT_TAIL(context_list, tls_context);
+    _schedule_session_cache_rotation(qd, tls_context);
     qd_log(LOG_AGENT, QD_LOG_INFO, "Created sslProfile %s", tls_context->ssl_profile_name);
     return tls_context;
 }
@@ -181,6 +187,7 @@ QD_EXPORT void *qd_tls_update_ssl_profile(qd_dispatch_t *qd, qd_entity_t *entity
 
     _cleanup_tls_profile(&tls_context->profile);
     tls_context->profile = new_profile;
+    _schedule_session_cache_rotation(qd, tls_context);
     qd_log(LOG_AGENT, QD_LOG_INFO, "Updated sslProfile %s ", tls_context->ssl_profile_name);
     return impl;
 }
@@ -295,7 +302,21 @@ qd_tls_config_t *qd_tls_config(const char *ssl_profile_name,
 }
 
 
+// Called by the owning listener or connector only. Sessions and the parent tls_context release their references via
+// _tls_config_decref() so that the configuration is known to be unused once its owner is gone.
+//
 void qd_tls_config_decref(qd_tls_config_t *tls_config)
+{
+    if (tls_config) {
+        sys_mutex_lock(&tls_config->lock);
+        tls_config->owner_released = true;
+        sys_mutex_unlock(&tls_config->lock);
+        _tls_config_decref(tls_config);
+    }
+}
+
+
+static void _tls_config_decref(qd_tls_config_t *tls_config)
 {
     if (tls_config) {
         uint32_t rc = sys_atomic_dec(&tls_config->ref_count);
@@ -314,6 +335,60 @@ void qd_tls_config_decref(qd_tls_config_t *tls_config)
 }
 
 
+void qd_tls_config_get_handshake_stats(qd_tls_config_t *tls_config, qd_tls_handshake_stats_t *stats)
+{
+    sys_mutex_lock(&tls_config->lock);
+    *stats = tls_config->handshake_stats;
+    sys_mutex_unlock(&tls_config->lock);
+}
+
+
+qd_error_t qd_tls_config_refresh_handshake_stats(qd_tls_config_t *tls_config, qd_entity_t *entity)
+{
+    qd_tls_handshake_stats_t stats = {0};
+
+    if (tls_config) {
+        qd_tls_config_get_handshake_stats(tls_config, &stats);
+    }
+
+    if (qd_entity_set_long(entity, "tlsHandshakesFull", stats.full) != 0
+        || qd_entity_set_long(entity, "tlsHandshakesResumed", stats.resumed) != 0
+        || qd_entity_set_list(entity, "tlsHandshakeHistogram") != 0)
+        return qd_error_code();
+    for (int i = 0; i < QD_TLS_HANDSHAKE_HISTOGRAM_BUCKETS; ++i) {
+        if (qd_entity_set_long(entity, "tlsHandshakeHistogram", stats.histogram[i]) != 0)
+            return qd_error_code();
+    }
+    return QD_ERROR_NONE;
+}
+
+
+/**
+ * Account for a completed handshake in the parent configuration of the session. Called from the I/O thread that owns
+ * the session.
+ */
+void tls_private_handshake_done(qd_tls_session_t *tls_session, bool resumed)
+{
+    if (tls_session->handshake_done)
+        return;
+    tls_session->handshake_done = true;
+
+    const uint64_t usec   = qd_platform_monotonic_usec() - tls_session->handshake_start_usec;
+    int            bucket = 0;
+    for (uint64_t limit = 1000; bucket < QD_TLS_HANDSHAKE_HISTOGRAM_BUCKETS - 1 && usec >= limit; limit *= 10)
+        bucket++;
+
+    qd_tls_config_t *tls_config = tls_session->tls_config;
+    sys_mutex_lock(&tls_config->lock);
+    if (resumed)
+        tls_config->handshake_stats.resumed++;
+    else
+        tls_config->handshake_stats.full++;
+    tls_config->handshake_stats.histogram[bucket]++;
+    sys_mutex_unlock(&tls_config->lock);
+}
+
+
 qd_tls_session_t *qd_tls_session_raw(qd_tls_config_t *tls_config, const char *peer_hostname,
                                      const char **alpn_protocols, size_t alpn_protocol_count,
                                      void *context, qd_tls_session_on_secure_cb_t *on_secure)
@@ -324,6 +399,7 @@ qd_tls_session_t *qd_tls_session_raw(qd_tls_config_t *tls_config, const char *pe
 
     qd_tls_session_t *tls_session = new_qd_tls_session_t();
     ZERO(tls_session);
+    sys_atomic_init(&tls_session->offloaded, 0);
 
     tls_session->user_context = context;
     tls_session->on_secure_cb = on_secure;
@@ -343,6 +419,9 @@ qd_tls_session_t *qd_tls_session_raw(qd_tls_config_t *tls_config, const char *pe
     sys_mutex_unlock(&tls_config->lock);
 
     tls_session->proton_tls_cfg = p_cfg;
+    sys_atomic_inc(&tls_config->ref_count);  // released by qd_tls_session_free()
+    tls_session->tls_config = tls_config;
+    tls_session->handshake_start_usec = qd_platform_monotonic_usec();
 
     // Must hold the proton config lock during the session initialization. Initialization is not thread safe since the
     // proton config is modified during this process.
@@ -413,7 +492,8 @@ error:
 }
 
 
-qd_tls_session_t *qd_tls_session_amqp(qd_tls_config_t *tls_config, pn_transport_t *tport, bool allow_unencrypted)
+qd_tls_session_t *qd_tls_session_amqp(qd_tls_config_t *tls_config, pn_transport_t *tport, bool allow_unencrypted,
+                                      const char *session_id)
 {
     assert(tls_config->p_type == QD_TLS_TYPE_PROTON_AMQP);
 
@@ -421,6 +501,7 @@ qd_tls_session_t *qd_tls_session_amqp(qd_tls_config_t *tls_config, pn_transport_
 
     qd_tls_session_t *tls_session = new_qd_tls_session_t();
     ZERO(tls_session);
+    sys_atomic_init(&tls_session->offloaded, 0);
 
     tls_session->ssl_profile_name = qd_strdup(tls_config->ssl_profile_name);
 
@@ -438,6 +519,9 @@ qd_tls_session_t *qd_tls_session_amqp(qd_tls_config_t *tls_config, pn_transport_
     sys_mutex_unlock(&tls_config->lock);
 
     tls_session->proton_tls_cfg = p_cfg;
+    sys_atomic_inc(&tls_config->ref_count);  // released by qd_tls_session_free()
+    tls_session->tls_config = tls_config;
+    tls_session->handshake_start_usec = qd_platform_monotonic_usec();
 
     // Must hold the proton config lock during the session initialization. Initialization is not thread safe since the
     // proton config is modified during this process.
@@ -452,7 +536,16 @@ qd_tls_session_t *qd_tls_session_amqp(qd_tls_config_t *tls_config, pn_transport_
         goto error;
     }
 
-    int rc = pn_ssl_init(tls_session->pn_amqp, p_cfg->pn_amqp, 0);
+    // In client mode Proton caches the negotiated TLS session by session_id and offers it for resumption when the next
+    // session with the same id connects. Qualify the id with the sslProfile so credentials are never mixed.
+    char *resume_id = 0;
+    if (session_id && !tls_config->is_listener) {
+        size_t len = strlen(tls_session->ssl_profile_name) + strlen(session_id) + 2;
+        resume_id  = qd_malloc(len);
+        snprintf(resume_id, len, "%s/%s", tls_session->ssl_profile_name, session_id);
+    }
+    int rc = pn_ssl_init(tls_session->pn_amqp, p_cfg->pn_amqp, resume_id);
+    free(resume_id);
     if (rc) {
         sys_mutex_unlock(&p_cfg->lock);
         qd_error(QD_ERROR_RUNTIME, "Failed to initialize AMQP TLS session (%d)", rc);
@@ -479,6 +572,9 @@ void qd_tls_session_free(qd_tls_session_t *tls_session)
     pn_raw_buffer_t buf_desc;
 
     if (tls_session) {
+        if (tls_private_handshake_defer_free(tls_session))
+            return;  // the handshake worker thread will free it
+
         if (tls_session->pn_raw) {
             pn_tls_stop(tls_session->pn_raw);
 
@@ -509,6 +605,7 @@ void qd_tls_session_free(qd_tls_session_t *tls_session)
         sys_mutex_unlock(&tls_session->proton_tls_cfg->lock);
 
         qd_proton_config_decref(tls_session->proton_tls_cfg);
+        _tls_config_decref(tls_session->tls_config);
         free(tls_session->ssl_profile_name);
         free(tls_session->uid_format);
         free_qd_tls_session_t(tls_session);
@@ -523,6 +620,8 @@ char *qd_tls_session_get_alpn_protocol(const qd_tls_session_t *tls_session)
     size_t      protocol_name_length;
 
     assert(tls_session->pn_raw);
+    if (tls_private_handshake_offloaded(tls_session))
+        return 0;  // handshake in progress on a worker thread
     if (pn_tls_get_alpn_protocol(tls_session->pn_raw, &protocol_name, &protocol_name_length)) {
         protocol = (char *) qd_calloc(protocol_name_length + 1, sizeof(char));
         memmove(protocol, protocol_name, protocol_name_length);
@@ -539,6 +638,8 @@ char *qd_tls_session_get_protocol_version(const qd_tls_session_t *tls_session)
 
     if (tls_session->pn_raw) {
         const char *protocol_version;
+        if (tls_private_handshake_offloaded(tls_session))
+            return 0;  // handshake in progress on a worker thread
         if (pn_tls_get_protocol_version(tls_session->pn_raw, &protocol_version, &version_len)) {
             version = (char *) qd_calloc(version_len + 1, sizeof(char));
             memmove(version, protocol_version, version_len);
@@ -562,6 +663,8 @@ char *qd_tls_session_get_protocol_ciphers(const qd_tls_session_t *tls_session)
 
     if (tls_session->pn_raw) {
         const char *protocol_ciphers;
+        if (tls_private_handshake_offloaded(tls_session))
+            return 0;  // handshake in progress on a worker thread
         if (pn_tls_get_cipher(tls_session->pn_raw, &protocol_ciphers, &ciphers_len)) {
             ciphers = (char *) qd_calloc(ciphers_len + 1, sizeof(char));
             memmove(ciphers, protocol_ciphers, ciphers_len);
@@ -582,6 +685,8 @@ char *qd_tls_session_get_protocol_ciphers(const qd_tls_session_t *tls_session)
 int qd_tls_session_get_ssf(const qd_tls_session_t *tls_session)
 {
     if (tls_session->pn_raw) {
+        if (tls_private_handshake_offloaded(tls_session))
+            return 0;  // handshake in progress on a worker thread
         return pn_tls_get_ssf(tls_session->pn_raw);
     } else {
         return pn_ssl_get_ssf(tls_session->pn_amqp);
@@ -609,6 +714,7 @@ qd_ssl2_profile_t *qd_tls_read_ssl_profile(const char *ssl_profile_name, qd_ssl2
     profile->trusted_certificate_db = CHECKED_STRDUP(tls_context->profile.trusted_certificate_db);
     profile->version                = tls_context->profile.version;
     profile->oldest_valid_version   = tls_context->profile.oldest_valid_version;
+    profile->session_cache_rotation = tls_context->profile.session_cache_rotation;
 
     return profile;
 }
@@ -661,6 +767,8 @@ static qd_error_t _read_tls_profile(qd_entity_t *entity, qd_ssl2_profile_t *prof
     if (qd_error_code()) goto error;
     profile->oldest_valid_version       = qd_entity_opt_long(entity, "oldestValidVersion", 0);
     if (qd_error_code()) goto error;
+    profile->session_cache_rotation     = qd_entity_opt_long(entity, "sessionCacheRotationSeconds", 0);
+    if (qd_error_code()) goto error;
 
     if (profile->uid_format) {
         if (!tls_private_validate_uid_format(profile->uid_format)) {
@@ -704,6 +812,10 @@ static qd_error_t _read_tls_profile(qd_entity_t *entity, qd_ssl2_profile_t *prof
         qd_error(QD_ERROR_CONFIG, "version must be >= oldestValidVersion (sslProfile '%s')", name);
         goto error;
     }
+    if (profile->session_cache_rotation < 0) {
+        qd_error(QD_ERROR_CONFIG, "Negative sessionCacheRotationSeconds is invalid (sslProfile '%s')", name);
+        goto error;
+    }
 
     free(name);
     return QD_ERROR_NONE;
@@ -801,6 +913,53 @@ static qd_error_t _update_tls_config(qd_tls_config_t *tls_config, const qd_ssl2_
 }
 
 
+/**
+ * Timer callback: reload the listener configurations of an sslProfile. The new Proton configuration starts with an
+ * empty server-side session cache and fresh session ticket keys, so sessions established before the rotation can no
+ * longer be resumed.
+ */
+static void _on_session_cache_rotation(void *context)
+{
+    ASSERT_MGMT_THREAD;  // timer callbacks are serialized with management updates
+
+    qd_tls_context_t *tls_context = (qd_tls_context_t *) context;
+    qd_tls_config_t  *tls_config  = DEQ_HEAD(tls_context->tls_configs);
+    while (tls_config) {
+        // Skip the configs of deleted listeners. Sessions may still hold references to them so the reference count
+        // does not tell.
+        sys_mutex_lock(&tls_config->lock);
+        const bool live = tls_config->is_listener && !tls_config->owner_released;
+        sys_mutex_unlock(&tls_config->lock);
+        if (live) {
+            if (_update_tls_config(tls_config, &tls_context->profile) != QD_ERROR_NONE) {
+                qd_log(LOG_AGENT, QD_LOG_ERROR, "Failed to rotate the TLS session cache of sslProfile '%s': %s",
+                       tls_context->ssl_profile_name, qd_error_message());
+            }
+        }
+        tls_config = DEQ_NEXT(tls_config);
+    }
+
+    qd_log(LOG_AGENT, QD_LOG_DEBUG, "Rotated the TLS session cache of sslProfile %s", tls_context->ssl_profile_name);
+    qd_timer_schedule(tls_context->rotation_timer, tls_context->profile.session_cache_rotation * 1000);
+}
+
+
+/** Start, restart or cancel the session cache rotation timer of the TLS context per its sslProfile
+ */
+static void _schedule_session_cache_rotation(qd_dispatch_t *qd, qd_tls_context_t *tls_context)
+{
+    if (tls_context->profile.session_cache_rotation > 0) {
+        if (!tls_context->rotation_timer) {
+            tls_context->rotation_timer = qd_timer(qd, _on_session_cache_rotation, tls_context);
+        }
+        qd_timer_schedule(tls_context->rotation_timer, tls_context->profile.session_cache_rotation * 1000);
+    } else if (tls_context->rotation_timer) {
+        qd_timer_free(tls_context->rotation_timer);
+        tls_context->rotation_timer = 0;
+    }
+}
+
+
 /** Find the TLS context associated with the given sslProfile name
  */
 static qd_tls_context_t *_find_tls_context(const char *profile_name)
@@ -822,10 +981,11 @@ static qd_tls_context_t *_find_tls_context(const char *profile_name)
 static void _tls_context_free(qd_tls_context_t *ctxt)
 {
     if (ctxt) {
+        qd_timer_free(ctxt->rotation_timer);
         qd_tls_config_t *tls_config = DEQ_HEAD(ctxt->tls_configs);
         while (tls_config) {
             DEQ_REMOVE_HEAD(ctxt->tls_configs);
-            qd_tls_config_decref(tls_config);
+            _tls_config_decref(tls_config);
             tls_config = DEQ_HEAD(ctxt->tls_configs);
         }
         free(ctxt->ssl_profile_name);
@@ -240,6 +240,15 @@ char *qd_tls_session_get_user_id(qd_tls_session_t *session)
 }
 
 
+void qd_tls_session_amqp_handshake_done(qd_tls_session_t *session)
+{
+    // only valid for Proton AMQP TLS sessions
+    assert(session->pn_amqp);
+
+    tls_private_handshake_done(session, pn_ssl_resume_status(session->pn_amqp) == PN_SSL_RESUME_REUSED);
+}
+
+
 /**
  * Allocate a Proton AMQP TLS configuration.
  *
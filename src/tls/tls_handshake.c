@@ -0,0 +1,205 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "qpid/dispatch/tls_common.h"
+#include "private.h"
+
+#include "qpid/dispatch/platform.h"
+
+#include <proton/raw_connection.h>
+#include <proton/tls.h>
+
+/*
+ * Handshake worker pool
+ *
+ * The expensive part of a TLS handshake (key exchange, certificate signing and verification) happens in the
+ * pn_tls_process() call that consumes the handshake records sent by the peer. When the pool is running
+ * qd_tls_session_do_io() hands that call to a worker thread and returns immediately, freeing the proactor thread to
+ * service other connections. While offloaded the worker thread owns the session's pn_tls_t: neither the I/O thread
+ * nor the qd_tls_session_* accessors touch it until the worker clears the session's atomic offloaded flag and wakes
+ * the raw connection. Testing the flag takes no lock.
+ */
+
+
+static struct {
+    sys_mutex_t                    lock;
+    sys_cond_t                     cond;
+    sys_thread_t                 **threads;
+    int                            thread_count;  // only modified by the main thread when the proactor is not running
+    qd_tls_session_list_t          queue;
+    qd_tls_handshake_pool_stats_t  stats;
+    bool                           running;
+} handshake_pool;
+
+
+static void *handshake_worker_thread(void *arg)
+{
+    sys_mutex_lock(&handshake_pool.lock);
+    while (true) {
+        qd_tls_session_t *session = DEQ_HEAD(handshake_pool.queue);
+        if (!session) {
+            // drain the queue before exiting so no raw connection is left waiting for its wake
+            if (!handshake_pool.running)
+                break;
+            sys_cond_wait(&handshake_pool.cond, &handshake_pool.lock);
+            continue;
+        }
+        DEQ_REMOVE_HEAD(handshake_pool.queue);
+        sys_mutex_unlock(&handshake_pool.lock);
+
+        uint64_t start   = qd_platform_monotonic_usec();
+        int      err     = pn_tls_process(session->pn_raw);
+        uint64_t elapsed = qd_platform_monotonic_usec() - start;
+
+        sys_mutex_lock(&handshake_pool.lock);
+        handshake_pool.stats.offloads++;
+        handshake_pool.stats.busy_usec += elapsed;
+        session->offload_error = err;
+        session->offload_done  = true;
+        CLEAR_ATOMIC_FLAG(&session->offloaded);  // releases pn_raw to the I/O thread
+        if (session->offload_free) {
+            // the owner released the session (and possibly its raw connection) while the worker held it
+            sys_mutex_unlock(&handshake_pool.lock);
+            qd_tls_session_free(session);
+            sys_mutex_lock(&handshake_pool.lock);
+        } else {
+            // Wake while holding the lock: tls_private_handshake_defer_free() cannot return until this is done, so the
+            // raw connection cannot have been released yet.
+            pn_raw_connection_wake(session->offload_raw_conn);
+        }
+    }
+    sys_mutex_unlock(&handshake_pool.lock);
+    return 0;
+}
+
+
+void tls_private_handshake_pool_initialize(void)
+{
+    sys_mutex_init_named(&handshake_pool.lock, "tls.handshake_pool.lock");
+    sys_cond_init(&handshake_pool.cond);
+    DEQ_INIT(handshake_pool.queue);
+    ZERO(&handshake_pool.stats);
+    handshake_pool.threads      = 0;
+    handshake_pool.thread_count = 0;
+    handshake_pool.running      = false;
+}
+
+
+void tls_private_handshake_pool_finalize(void)
+{
+    qd_tls_handshake_pool_stop();
+    sys_cond_free(&handshake_pool.cond);
+    sys_mutex_free(&handshake_pool.lock);
+}
+
+
+void qd_tls_handshake_pool_start(int thread_count)
+{
+    assert(!handshake_pool.threads);
+    if (thread_count <= 0)
+        return;
+
+    handshake_pool.running      = true;
+    handshake_pool.thread_count = thread_count;
+    handshake_pool.threads      = (sys_thread_t **) qd_calloc(thread_count, sizeof(sys_thread_t *));
+    for (int i = 0; i < thread_count; ++i) {
+        handshake_pool.threads[i] = sys_thread(SYS_THREAD_TLS_HANDSHAKE, handshake_worker_thread, 0);
+    }
+    qd_log(LOG_SERVER, QD_LOG_INFO, "Running TLS handshakes on %d worker threads", thread_count);
+}
+
+
+void qd_tls_handshake_pool_stop(void)
+{
+    if (!handshake_pool.threads)
+        return;
+
+    sys_mutex_lock(&handshake_pool.lock);
+    handshake_pool.running = false;
+    sys_cond_signal_all(&handshake_pool.cond);
+    sys_mutex_unlock(&handshake_pool.lock);
+
+    for (int i = 0; i < handshake_pool.thread_count; ++i) {
+        sys_thread_join(handshake_pool.threads[i]);
+        sys_thread_free(handshake_pool.threads[i]);
+    }
+    free(handshake_pool.threads);
+    handshake_pool.threads      = 0;
+    handshake_pool.thread_count = 0;
+}
+
+
+void qd_tls_handshake_pool_stats(qd_tls_handshake_pool_stats_t *stats)
+{
+    sys_mutex_lock(&handshake_pool.lock);
+    *stats             = handshake_pool.stats;
+    stats->queue_depth = DEQ_SIZE(handshake_pool.queue);
+    stats->threads     = handshake_pool.thread_count;
+    sys_mutex_unlock(&handshake_pool.lock);
+}
+
+
+/**
+ * Queue the pending handshake step of session for a worker thread. Returns false if the pool is not running, in which
+ * case the caller must run pn_tls_process() itself.
+ */
+bool tls_private_handshake_offload(qd_tls_session_t *session, pn_raw_connection_t *raw_conn)
+{
+    if (handshake_pool.thread_count == 0)
+        return false;
+
+    sys_mutex_lock(&handshake_pool.lock);
+    if (!handshake_pool.running) {
+        sys_mutex_unlock(&handshake_pool.lock);
+        return false;
+    }
+    assert(!IS_ATOMIC_FLAG_SET(&session->offloaded));
+    session->offload_raw_conn = raw_conn;
+    SET_ATOMIC_FLAG(&session->offloaded);
+    DEQ_INSERT_TAIL(handshake_pool.queue, session);
+    sys_cond_signal(&handshake_pool.cond);
+    sys_mutex_unlock(&handshake_pool.lock);
+    return true;
+}
+
+
+/**
+ * True while a worker thread owns the session's pn_tls_t
+ */
+bool tls_private_handshake_offloaded(const qd_tls_session_t *session)
+{
+    return IS_ATOMIC_FLAG_SET((sys_atomic_t *) &session->offloaded);
+}
+
+
+/**
+ * Called by qd_tls_session_free(). If the session is offloaded hand its release to the worker thread and return true.
+ */
+bool tls_private_handshake_defer_free(qd_tls_session_t *session)
+{
+    if (handshake_pool.thread_count == 0)
+        return false;
+
+    sys_mutex_lock(&handshake_pool.lock);
+    bool deferred = IS_ATOMIC_FLAG_SET(&session->offloaded);
+    if (deferred)
+        session->offload_free = true;
+    sys_mutex_unlock(&handshake_pool.lock);
+    return deferred;
+}
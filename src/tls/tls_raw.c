@@ -172,12 +172,17 @@ int qd_tls_session_do_io(qd_tls_session_t                *session,
         return -1;
     if (session->input_drained && session->output_flushed)
         return QD_TLS_DONE;
+    if (!session->handshake_done && tls_private_handshake_offloaded(session)) {
+        // a handshake worker owns the TLS session, the raw connection will be woken when it is done
+        return 0;
+    }
 
     do {
         size_t          capacity;
         size_t          taken;
         size_t          given;
         uint64_t        total_octets;
+        bool            input_pushed = false;
 
         // Loop until no more work can be done. "work" is considered true whenever the TLS layer produces output or
         // opens up capacity for more input
@@ -305,6 +310,7 @@ int qd_tls_session_do_io(qd_tls_session_t                *session,
                     }
                 }
                 if (pushed > 0) {
+                    input_pushed = true;
                     session->encrypted_input_bytes += total_octets;
                     qd_log(log_module, QD_LOG_DEBUG,
                            "[C%" PRIu64 "] %" PRIu64
@@ -321,16 +327,35 @@ int qd_tls_session_do_io(qd_tls_session_t                *session,
         // if pn_tls_process returns an error: there may be more outgoing buffers that have to be written to the raw
         // connection before it can be closed. This code assumes that the proton TLS library will stop giving capacity
         // for other work once the error has occurred so it is safe to continue running this work loop.
+        //
+        // While the handshake is in progress processing new input from the peer is where the expensive crypto happens.
+        // If the handshake worker pool is running pn_tls_process() is run there instead and this thread resumes the
+        // loop when the raw connection is woken.
 
         if (!session->tls_error) {
-            const bool check_if_secure = session->on_secure_cb && !pn_tls_is_secure(session->pn_raw);
-            int        err             = pn_tls_process(session->pn_raw);
+            int err = 0;
+            if (session->offload_done) {
+                err                   = session->offload_error;
+                session->offload_done = false;
+            }
+            if (!err) {
+                if (input_pushed && !session->handshake_done && !pn_tls_is_secure(session->pn_raw)
+                    && tls_private_handshake_offload(session, raw_conn)) {
+                    qd_log(log_module, QD_LOG_DEBUG, "[C%" PRIu64 "] TLS handshake step offloaded", conn_id);
+                    return 0;
+                }
+                err = pn_tls_process(session->pn_raw);
+            }
             if (err) {
                 session->tls_error = true;
                 qd_log(log_module, QD_LOG_DEBUG, "[C%" PRIu64 "] pn_tls_process failed: error=%d", conn_id, err);
-            } else if (check_if_secure && pn_tls_is_secure(session->pn_raw)) {
-                session->on_secure_cb(session, session->user_context);
-                session->on_secure_cb = 0;  // one shot
+            } else if (!session->handshake_done && pn_tls_is_secure(session->pn_raw)) {
+                // The raw TLS API does not report session resumption: every handshake is accounted as full
+                tls_private_handshake_done(session, false);
+                if (session->on_secure_cb) {
+                    session->on_secure_cb(session, session->user_context);
+                    session->on_secure_cb = 0;  // one shot
+                }
             }
         }
 
@@ -462,7 +487,8 @@ int qd_tls_session_do_io(qd_tls_session_t                *session,
 
     // check for end of input (decrypt done)
     //
-    if (pn_tls_is_input_closed(session->pn_raw)) {
+    session->input_closed = pn_tls_is_input_closed(session->pn_raw);
+    if (session->input_closed) {
         // TLS clean close signalled by remote. Do not read any more data (prevent truncation attack).
         //
         session->input_drained = true;
@@ -497,6 +523,8 @@ bool qd_tls_session_is_secure(const qd_tls_session_t *session)
 {
     if (!session || !session->pn_raw)
         return false;
+    if (!session->handshake_done && tls_private_handshake_offloaded(session))
+        return false;
     return pn_tls_is_secure(session->pn_raw);
 }
 
@@ -504,7 +532,8 @@ bool qd_tls_session_is_secure(const qd_tls_session_t *session)
 bool qd_tls_session_is_input_drained(const qd_tls_session_t *session, bool *close_notify)
 {
     assert(session);
-    *close_notify = pn_tls_is_input_closed(session->pn_raw);
+    // use the state cached by qd_tls_session_do_io(): pn_raw may be owned by a handshake worker thread
+    *close_notify = session->input_closed;
     return session->input_drained;
 }
 
@@ -2361,7 +2361,7 @@ static uint64_t _vflow_on_co_record_message(void                    *context,
                 qd_log(LOG_FLOW_LOG, QD_LOG_DEBUG, "Co-Record update received");
                 qd_iterator_t *body_iter = qd_message_field_iterator(msg, QD_FIELD_BODY);
                 if (!!body_iter) {
-                    qd_parsed_field_t *body = qd_parse(body_iter);
+                    qd_parsed_field_t *body = qd_parse_lazy(body_iter);
                     if (qd_parse_ok(body)) {
                         if (qd_parse_is_list(body)) {
                             qd_parsed_field_t *item = qd_field_first_child(body);
@@ -81,6 +81,10 @@ static char* test_alloc_basic(void *context)
         free_object_t(obj[idx]);
     if (error) return error;
 
+    // every allocation is counted, including those served from the free lists
+    if (alloc_stats_object_t().total_allocs != 40)
+        return "Incorrect total-allocs";
+
     return 0;
 }
 
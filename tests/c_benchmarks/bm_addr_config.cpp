@@ -0,0 +1,116 @@
+/*
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ *
+ */
+
+#include "../cpp/helpers/helpers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "parse_tree.h"
+#include "router_core_private.h"
+}  // extern "C"
+
+// Distinct addresses looked up per iteration: more than QDR_ADDR_CONFIG_CACHE_SIZE, so that a cache keyed by the full
+// address would never hit
+static const int ADDRESS_COUNT = 4 * QDR_ADDR_CONFIG_CACHE_SIZE;
+
+// state.range(0) prefix address configurations ("prefix_<n>/#") and unique addresses spread across them
+struct AddrConfigFixture {
+    qdr_core_t                       *core;
+    std::vector<qdr_address_config_t> configs;
+    std::vector<std::string>          addresses;
+    std::vector<qd_iterator_t *>      iters;
+
+    explicit AddrConfigFixture(int prefixes) : configs(prefixes)
+    {
+        core                  = (qdr_core_t *) calloc(1, sizeof(qdr_core_t));
+        core->addr_parse_tree = qd_parse_tree_new(QD_PARSE_TREE_ADDRESS);
+        qdr_addr_config_cache_init(&core->addr_config_cache);
+        for (int i = 0; i < prefixes; ++i) {
+            std::string pattern = "prefix_" + std::to_string(i) + "/#";
+            qd_parse_tree_add_pattern_str(core->addr_parse_tree, pattern.c_str(), &configs[i]);
+        }
+        core->addr_config_generation++;
+
+        for (int i = 0; i < ADDRESS_COUNT; ++i) {
+            addresses.push_back("prefix_" + std::to_string(i % prefixes) + "/service/queue_" + std::to_string(i));
+        }
+        for (const std::string &address : addresses) {
+            iters.push_back(qd_iterator_string(address.c_str(), ITER_VIEW_ADDRESS_NO_HOST));
+        }
+    }
+
+    ~AddrConfigFixture()
+    {
+        for (qd_iterator_t *iter : iters) {
+            qd_iterator_free(iter);
+        }
+        qdr_addr_config_cache_free(&core->addr_config_cache);
+        qd_parse_tree_free(core->addr_parse_tree);
+        free(core);
+    }
+};
+
+// Before: match every address against the parse tree
+static void BM_AddrConfigParseTreeMatch(benchmark::State &state)
+{
+    std::thread([&state] {
+        QDRMinimalEnv env{};
+        AddrConfigFixture fixture(state.range(0));
+
+        for (auto _ : state) {
+            for (qd_iterator_t *iter : fixture.iters) {
+                qdr_address_config_t *addr = 0;
+                qd_parse_tree_retrieve_match(fixture.core->addr_parse_tree, iter, (void **) &addr);
+                benchmark::DoNotOptimize(addr);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * ADDRESS_COUNT);
+    }).join();
+}
+
+BENCHMARK(BM_AddrConfigParseTreeMatch)->Unit(benchmark::kMicrosecond)->Arg(10)->Arg(100);
+
+// After: look every address up through the address configuration cache, which keys on the configured prefix
+static void BM_AddrConfigCachedLookup(benchmark::State &state)
+{
+    std::thread([&state] {
+        QDRMinimalEnv env{};
+        AddrConfigFixture fixture(state.range(0));
+
+        for (auto _ : state) {
+            for (qd_iterator_t *iter : fixture.iters) {
+                benchmark::DoNotOptimize(qdr_config_for_address_CT(fixture.core, 0, iter));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * ADDRESS_COUNT);
+        state.counters["hits"]   = fixture.core->addr_config_cache_hits;
+        state.counters["misses"] = fixture.core->addr_config_cache_misses;
+    }).join();
+}
+
+BENCHMARK(BM_AddrConfigCachedLookup)->Unit(benchmark::kMicrosecond)->Arg(10)->Arg(100);
@@ -0,0 +1,112 @@
+/*
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ *
+ */
+
+#include "../cpp/helpers/helpers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+extern "C" {
+#include "qpid/dispatch/amqp.h"
+#include "qpid/dispatch/buffer.h"
+#include "qpid/dispatch/compose.h"
+}  // extern "C"
+
+// Compose the router annotations section the way the router does on every forwarded message: a short list holding
+// flags, a to-override address, the ingress router and a trace list.
+//
+static size_t compose_router_annotations(int trace_length)
+{
+    qd_composed_field_t *field = qd_compose(QD_PERFORMATIVE_ROUTER_ANNOTATIONS, 0);
+    qd_compose_start_list(field);
+    qd_compose_insert_uint(field, 0);
+    qd_compose_insert_string(field, "multicast/override/address");
+    qd_compose_insert_string(field, "0/Router.A");
+    qd_compose_start_list(field);
+    for (int i = 0; i < trace_length; ++i) {
+        qd_compose_insert_string(field, "0/Router.B");
+    }
+    qd_compose_end_list(field);
+    qd_compose_end_list(field);
+
+    qd_buffer_list_t buffers;
+    qd_compose_take_buffers(field, &buffers);
+    qd_compose_free(field);
+    size_t encoded = qd_buffer_list_length(&buffers);
+    qd_buffer_list_free_buffers(&buffers);
+    return encoded;
+}
+
+// Compose a small map of scalar values, as the management agent and the edge address proxy do.
+//
+static size_t compose_scalar_map(int pairs)
+{
+    qd_composed_field_t *field = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
+    qd_compose_start_map(field);
+    for (int i = 0; i < pairs; ++i) {
+        qd_compose_insert_symbol(field, "key");
+        qd_compose_insert_ulong(field, 0x0102030405060708);
+    }
+    qd_compose_end_map(field);
+
+    qd_buffer_list_t buffers;
+    qd_compose_take_buffers(field, &buffers);
+    qd_compose_free(field);
+    size_t encoded = qd_buffer_list_length(&buffers);
+    qd_buffer_list_free_buffers(&buffers);
+    return encoded;
+}
+
+// Report the composition rate and the encoded size of one field, which falls when the composite fits the compact
+// list8/map8 encoding.
+//
+static void compose(benchmark::State &state, size_t (*compose_fn)(int))
+{
+    std::thread([&state, compose_fn] {
+        QDRMinimalEnv env{};
+
+        const int count = state.range(0);
+        size_t encoded  = 0;
+        for (auto _ : state) {
+            encoded = compose_fn(count);
+            benchmark::DoNotOptimize(encoded);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() * encoded);
+        state.counters["encoded_bytes"] = encoded;
+    }).join();
+}
+
+static void BM_ComposeRouterAnnotations(benchmark::State &state)
+{
+    compose(state, compose_router_annotations);
+}
+
+BENCHMARK(BM_ComposeRouterAnnotations)->Unit(benchmark::kNanosecond)->Arg(0)->Arg(4)->Arg(32);
+
+static void BM_ComposeScalarMap(benchmark::State &state)
+{
+    compose(state, compose_scalar_map);
+}
+
+BENCHMARK(BM_ComposeScalarMap)->Unit(benchmark::kNanosecond)->Arg(1)->Arg(8)->Arg(64);
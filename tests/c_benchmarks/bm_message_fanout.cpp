@@ -0,0 +1,107 @@
+/*
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ *
+ */
+
+#include "../cpp/helpers/helpers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "qpid/dispatch/amqp.h"
+#include "qpid/dispatch/compose.h"
+#include "qpid/dispatch/message.h"
+}  // extern "C"
+
+typedef int (*fanout_fn_t)(qd_message_t *msg, qd_message_t **copies, int count);
+
+// Make the fanout references the way the multicast forwarder did before it batched them: one copy and one fanout
+// increment (one content lock and buffer chain walk) per outgoing link.
+//
+static int fanout_per_copy(qd_message_t *msg, qd_message_t **copies, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        copies[i] = qd_message_copy(msg);
+        qd_message_add_fanout(copies[i]);
+    }
+    return count;
+}
+
+// A 16KB message spans several buffers, so the fanout accounting has a buffer chain to walk.
+//
+static qd_message_t *compose_message()
+{
+    std::vector<uint8_t> payload(16384, 'X');
+    qd_composed_field_t *body = qd_compose(QD_PERFORMATIVE_BODY_DATA, 0);
+    qd_compose_insert_binary(body, payload.data(), payload.size());
+    return qd_message_compose(body, 0, 0, true);
+}
+
+// Fan a message out to state.range(0) receivers and release the references again, as delivering to that many local
+// receivers of a multicast address does.  A to_override makes each copy carry router annotation overrides, as a
+// message re-forwarded with a modified destination does.
+//
+static void fanout(benchmark::State &state, fanout_fn_t make_copies, const char *to_override = nullptr)
+{
+    std::thread([&state, make_copies, to_override] {
+        QDRMinimalEnv env{};
+
+        const int count = state.range(0);
+        std::vector<qd_message_t *> copies(count);
+        qd_message_t *msg = compose_message();
+        if (to_override) {
+            qd_message_set_to_override_annotation(msg, to_override);
+        }
+
+        for (auto _ : state) {
+            const int made = make_copies(msg, copies.data(), count);
+            for (int i = 0; i < made; ++i) {
+                qd_message_free(copies[i]);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+        state.SetComplexityN(count);
+        qd_message_free(msg);
+    }).join();
+}
+
+static void BM_MessageFanoutPerCopy(benchmark::State &state)
+{
+    fanout(state, fanout_per_copy);
+}
+
+BENCHMARK(BM_MessageFanoutPerCopy)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(10)->Arg(100)->Arg(500)->Complexity();
+
+static void BM_MessageFanoutBatch(benchmark::State &state)
+{
+    fanout(state, qd_message_copy_fanout);
+}
+
+BENCHMARK(BM_MessageFanoutBatch)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(10)->Arg(100)->Arg(500)->Complexity();
+
+static void BM_MessageFanoutBatchToOverride(benchmark::State &state)
+{
+    fanout(state, qd_message_copy_fanout, "multicast/override/address");
+}
+
+BENCHMARK(BM_MessageFanoutBatchToOverride)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(10)->Arg(100)->Arg(500)->Complexity();
@@ -0,0 +1,70 @@
+/*
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ *
+ */
+
+#include "../cpp/helpers/helpers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+extern "C" {
+#include "qpid/dispatch/buffer.h"
+#include "qpid/dispatch/compose.h"
+#include "qpid/dispatch/message.h"
+}  // extern "C"
+
+// A huge (4MB) message, as streamed by test-sender -sx
+static const size_t MESSAGE_SIZE = 4 * 1024 * 1024;
+
+// Append MESSAGE_SIZE octets of full buffers to a streaming message, state.range(0) buffers per append.  Every append
+// takes the content lock, tags the buffers with the fanout and evaluates Q2, which is what qd_message_receive() does
+// once per buffer when unbatched (1) and once per QD_MESSAGE_RX_BATCH buffers when batched.
+//
+static void BM_MessageReceiveAppend(benchmark::State &state)
+{
+    std::thread([&state] {
+        QDRMinimalEnv env{};
+
+        const int    batch   = state.range(0);
+        const size_t buffers = (MESSAGE_SIZE / QD_BUFFER_SIZE + batch - 1) / batch * batch;
+
+        for (auto _ : state) {
+            qd_message_t *msg = qd_message();
+            for (size_t appended = 0; appended < buffers; appended += batch) {
+                qd_buffer_list_t list = DEQ_EMPTY;
+                for (int i = 0; i < batch; ++i) {
+                    qd_buffer_t *buf = qd_buffer();
+                    qd_buffer_insert(buf, qd_buffer_capacity(buf));
+                    DEQ_INSERT_TAIL(list, buf);
+                }
+                qd_composed_field_t *field = qd_compose_subfield(0);
+                qd_compose_insert_buffers(field, &list);
+                qd_message_extend(msg, field, 0);
+                qd_compose_free(field);
+            }
+            qd_message_free(msg);
+        }
+
+        state.SetBytesProcessed(state.iterations() * buffers * QD_BUFFER_SIZE);
+    }).join();
+}
+
+BENCHMARK(BM_MessageReceiveAppend)->Unit(benchmark::kMillisecond)->Arg(1)->Arg(QD_MESSAGE_RX_BATCH);
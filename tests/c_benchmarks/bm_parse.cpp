@@ -0,0 +1,123 @@
+/*
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ *
+ */
+
+#include "../cpp/helpers/helpers.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "qpid/dispatch/compose.h"
+#include "qpid/dispatch/parse.h"
+
+// allocator statistics of the parser's node types (see parse.c)
+qd_alloc_stats_t alloc_stats_qd_parsed_field_t(void);
+qd_alloc_stats_t alloc_stats_qd_parse_arena_t(void);
+}  // extern "C"
+
+typedef qd_parsed_field_t *(*parse_fn_t)(const qd_iterator_t *iter);
+
+// Compose a body shaped like a mobile-address-update message: a map with a few scalar entries and a list of
+// 'count' addresses.
+//
+static void compose_mau_body(qd_buffer_list_t *buffers, int count)
+{
+    qd_composed_field_t *body = qd_compose_subfield(0);
+    qd_compose_start_map(body);
+    qd_compose_insert_string(body, "id");
+    qd_compose_insert_string(body, "Router.A");
+    qd_compose_insert_string(body, "pv");
+    qd_compose_insert_long(body, 2);
+    qd_compose_insert_string(body, "mobile_seq");
+    qd_compose_insert_long(body, 12345);
+    qd_compose_insert_string(body, "add");
+    qd_compose_start_list(body);
+    for (int i = 0; i < count; ++i) {
+        std::string addr = "Mclosest/service." + std::to_string(i);
+        qd_compose_insert_string(body, addr.c_str());
+    }
+    qd_compose_end_list(body);
+    qd_compose_end_map(body);
+    qd_compose_take_buffers(body, buffers);
+    qd_compose_free(body);
+}
+
+static uint64_t heap_allocations()
+{
+    return alloc_stats_qd_parsed_field_t().total_alloc_from_heap + alloc_stats_qd_parse_arena_t().total_alloc_from_heap;
+}
+
+// Parse the body and look up its scalar header fields, the way the control-plane message handlers do.
+//
+static void parse_and_inspect(benchmark::State &state, parse_fn_t parse)
+{
+    std::thread([&state, parse] {
+        QDRMinimalEnv env{};
+
+        qd_buffer_list_t buffers = DEQ_EMPTY;
+        compose_mau_body(&buffers, state.range(0));
+        qd_iterator_t *iter = qd_iterator_buffer(DEQ_HEAD(buffers), 0, qd_buffer_list_length(&buffers), ITER_VIEW_ALL);
+
+        // Estimate the number of parse-node allocations per message by keeping a batch of parsed trees alive: the
+        // pools have to satisfy them from the heap.
+        const int batch = 100;
+        std::vector<qd_parsed_field_t *> trees(batch);
+        const uint64_t before = heap_allocations();
+        for (int i = 0; i < batch; ++i) {
+            trees[i] = parse(iter);
+            qd_parse_value_by_key(trees[i], "id");
+        }
+        const uint64_t after = heap_allocations();
+        for (int i = 0; i < batch; ++i) {
+            qd_parse_free(trees[i]);
+        }
+
+        for (auto _ : state) {
+            qd_parsed_field_t *field = parse(iter);
+            benchmark::DoNotOptimize(qd_parse_value_by_key(field, "id"));
+            benchmark::DoNotOptimize(qd_parse_value_by_key(field, "mobile_seq"));
+            qd_parse_free(field);
+        }
+
+        state.counters["allocs_per_parse"] = (double) (after - before) / batch;
+        state.SetComplexityN(state.range(0));
+
+        qd_iterator_free(iter);
+        qd_buffer_list_free_buffers(&buffers);
+    }).join();
+}
+
+static void BM_ParseFull(benchmark::State &state)
+{
+    parse_and_inspect(state, qd_parse);
+}
+
+BENCHMARK(BM_ParseFull)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->Complexity();
+
+static void BM_ParseLazy(benchmark::State &state)
+{
+    parse_and_inspect(state, qd_parse_lazy);
+}
+
+BENCHMARK(BM_ParseLazy)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->Complexity();
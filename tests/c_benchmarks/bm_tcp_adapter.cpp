@@ -30,8 +30,11 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <csignal>
 #include <iostream>
+#include <string>
+#include <vector>
 
 extern "C" {
 #include "entity_cache.h"
@@ -51,7 +54,10 @@ static unsigned short findFreePort()
     return port;
 }
 
-static std::stringstream oneRouterTcpConfig(const unsigned short tcpConnectorPort, unsigned short tcpListenerPort)
+// A warmPoolMinIdle above zero gives the tcpConnector a warm pool of pre-connected server connections.  The
+// encapsulation is applied to both the tcpListener and the tcpConnector.
+static std::stringstream oneRouterTcpConfig(const unsigned short tcpConnectorPort, unsigned short tcpListenerPort,
+                                            int warmPoolMinIdle = 0, const std::string &encapsulation = "tcp")
 {
     std::stringstream router_config;
     router_config << R"END(
@@ -70,6 +76,8 @@ tcpListener {
                   << R"END(
     address : ES
     siteId : siteId
+    encapsulation : )END" << encapsulation
+                  << R"END(
 }
 
 tcpConnector {
@@ -78,6 +86,14 @@ tcpConnector {
                   << R"END(
     address : ES
     siteId : siteId
+    encapsulation : )END" << encapsulation;
+    if (warmPoolMinIdle > 0) {
+        router_config << R"END(
+    warmPoolMinIdle : )END" << warmPoolMinIdle
+                      << R"END(
+    warmPoolMaxIdle : )END" << warmPoolMinIdle * 4;
+    }
+    router_config << R"END(
 }
 
 log {
@@ -365,3 +381,195 @@ static void DISABLED_BM_TCPEchoServerLatency2QDRSubprocess(benchmark::State &sta
 }
 
 // BENCHMARK(DISABLED_BM_TCPEchoServerLatency2QDRSubprocess)->Unit(benchmark::kMillisecond);
+
+/// Measures the time from connecting to a tcpListener to receiving the first echoed byte, with a new client
+/// connection per iteration.  Without a warm pool each client connection waits for the router to connect to the
+/// server.
+static void timeToFirstByteLoop(benchmark::State &state, unsigned short tcpListenerPort)
+{
+    const std::string servAddress = "127.0.0.1";
+    char byte                     = 'x';
+
+    auto firstByte = [&state, &servAddress, &byte](TCPSocket sock) {
+        sock.send(&byte, 1);
+        if (sock.recv(&byte, 1) != 1) {
+            state.SkipWithError("unable to read from socket");
+        }
+    };
+
+    firstByte(try_to_connect(servAddress, tcpListenerPort));  // wait for the router, and warm it up
+    for (auto _ : state) {
+        firstByte(TCPSocket(servAddress, tcpListenerPort));
+    }
+}
+
+static void DISABLED_BM_TCPTimeToFirstByteColdConnect(benchmark::State &state)
+{
+    return;  // disabled
+    MultiClientEchoServerThread est;
+    unsigned short tcpListenerPort = findFreePort();
+
+    std::string       configName    = "DISABLED_BM_TCPTimeToFirstByteColdConnect.conf";
+    std::stringstream router_config = oneRouterTcpConfig(est.port(), tcpListenerPort);
+    writeRouterConfig(configName, router_config);
+
+    {
+        DispatchRouterSubprocessTcpLatencyTest drt(configName);
+        timeToFirstByteLoop(state, tcpListenerPort);
+    }  // stop the router before the echo server so the server connections are closed
+}
+
+// BENCHMARK(DISABLED_BM_TCPTimeToFirstByteColdConnect)->Unit(benchmark::kMicrosecond);
+
+static void DISABLED_BM_TCPTimeToFirstByteWarmPool(benchmark::State &state)
+{
+    return;  // disabled
+    MultiClientEchoServerThread est;
+    unsigned short tcpListenerPort = findFreePort();
+
+    std::string       configName    = "DISABLED_BM_TCPTimeToFirstByteWarmPool.conf";
+    std::stringstream router_config = oneRouterTcpConfig(est.port(), tcpListenerPort, 4);
+    writeRouterConfig(configName, router_config);
+
+    {
+        DispatchRouterSubprocessTcpLatencyTest drt(configName);
+        timeToFirstByteLoop(state, tcpListenerPort);
+    }  // stop the router before the echo server so the server connections are closed
+}
+
+// BENCHMARK(DISABLED_BM_TCPTimeToFirstByteWarmPool)->Unit(benchmark::kMicrosecond);
+
+/// Minimal HTTP/1.1 keep-alive server answering every request with the same response.  It counts the connections it
+/// accepts so a benchmark can report how many backend connections the router opened.  Requests must not have a body.
+class HttpServerThread
+{
+    TCPServerSocket servSock{0};
+    std::atomic<int> accepted{0};
+    std::thread u;
+
+    static void handleClient(TCPSocket *sock)
+    {
+        static const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+        std::string pending;
+        char buffer[1024];
+        int size;
+        try {
+            while ((size = sock->recv(buffer, sizeof(buffer))) > 0) {
+                pending.append(buffer, size);
+                size_t end;
+                while ((end = pending.find("\r\n\r\n")) != std::string::npos) {
+                    pending.erase(0, end + 4);
+                    sock->send(response.c_str(), response.length());
+                }
+            }
+        } catch (SocketException &e) {
+            // the router reset the connection
+        }
+        delete sock;
+    }
+
+   public:
+    HttpServerThread()
+    {
+        u = std::thread([this]() {
+            std::vector<std::thread> clients;
+            try {
+                while (true) {
+                    TCPSocket *sock = servSock.accept();
+                    accepted++;
+                    clients.emplace_back(handleClient, sock);
+                }
+            } catch (SocketException &e) {
+                // the destructor shut the server socket down
+            }
+            for (auto &client : clients) {
+                client.join();
+            }
+        });
+    }
+
+    // the router must have closed its connections to the server first
+    ~HttpServerThread()
+    {
+        servSock.shutdown();
+        u.join();
+    }
+
+    unsigned short port()
+    {
+        return servSock.getLocalPort();
+    }
+
+    int connectionsAccepted() const
+    {
+        return accepted;
+    }
+};
+
+static void httpRequest(benchmark::State &state, TCPSocket &sock)
+{
+    static const std::string request = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    sock.send(request.c_str(), request.length());
+
+    // the response has a two octet body
+    std::string response;
+    char buffer[256];
+    size_t end = std::string::npos;
+    while (end == std::string::npos || response.length() < end + 4 + 2) {
+        int size = sock.recv(buffer, sizeof(buffer));
+        if (size <= 0) {
+            state.SkipWithError("unable to read from socket");
+            return;
+        }
+        response.append(buffer, size);
+        end = response.find("\r\n\r\n");
+    }
+}
+
+/// Runs state.range(0) HTTP requests on each new client connection through a router using the given encapsulation.
+/// Reports requests/s and the number of connections the router opened to the server: with tcp encapsulation every
+/// client connection pins a server connection, with http1 the requests share the connector's keep-alive pool.
+static void httpRequestsLoop(benchmark::State &state, const std::string &encapsulation, const std::string &configName)
+{
+    HttpServerThread server;
+    unsigned short tcpListenerPort = findFreePort();
+
+    std::stringstream router_config = oneRouterTcpConfig(server.port(), tcpListenerPort, 0, encapsulation);
+    writeRouterConfig(configName, router_config);
+
+    const int requestsPerConnection = state.range(0);
+    {
+        DispatchRouterSubprocessTcpLatencyTest drt(configName);
+        {
+            TCPSocket sock = try_to_connect("127.0.0.1", tcpListenerPort);
+            httpRequest(state, sock);  // wait for the router, and warm it up
+        }
+
+        for (auto _ : state) {
+            TCPSocket sock("127.0.0.1", tcpListenerPort);
+            for (int i = 0; i < requestsPerConnection; ++i) {
+                httpRequest(state, sock);
+            }
+        }
+    }  // stop the router before the server so the server connections are closed
+
+    state.SetItemsProcessed(state.iterations() * requestsPerConnection);
+    state.counters["client_connections"]  = state.iterations() + 1;
+    state.counters["backend_connections"] = server.connectionsAccepted();
+}
+
+static void DISABLED_BM_HTTP1RequestsTcpEncapsulation(benchmark::State &state)
+{
+    return;  // disabled
+    httpRequestsLoop(state, "tcp", "DISABLED_BM_HTTP1RequestsTcpEncapsulation.conf");
+}
+
+// BENCHMARK(DISABLED_BM_HTTP1RequestsTcpEncapsulation)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(10);
+
+static void DISABLED_BM_HTTP1RequestsHttp1Encapsulation(benchmark::State &state)
+{
+    return;  // disabled
+    httpRequestsLoop(state, "http1", "DISABLED_BM_HTTP1RequestsHttp1Encapsulation.conf");
+}
+
+// BENCHMARK(DISABLED_BM_HTTP1RequestsHttp1Encapsulation)->Unit(benchmark::kMicrosecond)->Arg(1)->Arg(10);
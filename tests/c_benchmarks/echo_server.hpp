@@ -28,6 +28,7 @@
 
 #include <iostream>
 #include <thread>
+#include <vector>
 int run_echo_server();
 
 void stop_echo_server();
@@ -58,6 +59,29 @@ class EchoServer
         }
     }
 
+    // will handle TCP clients, each on its own thread, until stop() is called and all clients have disconnected
+    void runMultiple()
+    {
+        std::vector<std::thread> clients;
+        try {
+            while (true) {
+                TCPSocket *sock = servSock.accept();
+                clients.emplace_back([this, sock]() {
+                    try {
+                        HandleTCPClient(sock);
+                    } catch (SocketException &e) {
+                        delete sock;  // the peer reset the connection
+                    }
+                });
+            }
+        } catch (SocketException &e) {
+            // stop() was called
+        }
+        for (auto &client : clients) {
+            client.join();
+        }
+    }
+
     void stop()
     {
         servSock.shutdown();
@@ -114,4 +138,29 @@ class EchoServerThread
     }
 };
 
+/// Echo server accepting any number of clients, for benchmarks that open a connection per iteration. The clients
+/// must disconnect before it is destroyed.
+class MultiClientEchoServerThread
+{
+    EchoServer es{0};
+    std::thread u;
+
+   public:
+    MultiClientEchoServerThread()
+    {
+        u = std::thread([this]() { es.runMultiple(); });
+    }
+
+    ~MultiClientEchoServerThread()
+    {
+        es.stop();
+        u.join();
+    }
+
+    unsigned short port()
+    {
+        return es.port();
+    }
+};
+
 #endif  // QPID_DISPATCH_ECHO_SERVER_HPP
@@ -25,63 +25,65 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static char *vector0 =
     "\x00\x53\x77"                             // amqp-value
-    "\xd0\x00\x00\x01\x26\x00\x00\x00\x0a"     // list32 with ten items
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc0\xe7\x0a"                             // list8 with ten items
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x0a"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x0b"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
-    "\xd1\x00\x00\x00\x18\x00\x00\x00\x04"     // map32 with two pairs
+    "\xc1\x15\x04"                             // map8 with two pairs
     "\xa1\x06key001"                           // str8-utf8
     "\x52\x14"                                 // smalluint
     "\xa1\x06key002"                           // str8-utf8
     "\x52\x15"                                 // smalluint
     ;
 
-static int vector0_length = 302;
+static int vector0_length = 236;
 
 static char *test_compose_list_of_maps(void *context)
 {
@@ -127,18 +129,18 @@ static char *test_compose_list_of_maps(void *context)
 
 static char *vector1 =
     "\x00\x53\x71"                             // delivery annotations
-    "\xd1\x00\x00\x00\x3d\x00\x00\x00\x04"     // map32 with two item pairs
+    "\xc1\x2c\x04"                             // map8 with two item pairs
     "\xa3\x06key001"                           // sym8
     "\x52\x0a"                                 // smalluint
     "\xa3\x06key002"                           // sym8
-    "\xd0\x00\x00\x00\x22\x00\x00\x00\x04"     // list32 with four items
+    "\xc0\x17\x04"                             // list8 with four items
     "\xa1\x05item1"                            // str8-utf8
     "\xa1\x05item2"                            // str8-utf8
     "\xa1\x05item3"                            // str8-utf8
-    "\xd0\x00\x00\x00\x04\x00\x00\x00\x00"     // list32 empty
+    "\x45"                                     // list0
     ;
 
-static int vector1_length = 69;
+static int vector1_length = 49;
 
 static char *test_compose_insert_empty_string(void *context)
 {
@@ -236,7 +238,7 @@ static char *test_compose_nested_composites(void *context)
 
 static char *vector2 =
     "\x00\x53\x73"                             // properties
-    "\xd0\x00\x00\x00\x83\x00\x00\x00\x1c"     // list32 with 28 items
+    "\xc0\x80\x1c"                             // list8 with 28 items
     "\x40"                                     // null
     "\x42"                                     // false
     "\x41"                                     // true
@@ -267,7 +269,7 @@ static char *vector2 =
     "\xa3\x06symbol"                           // sym8
     ;
 
-static int vector2_length = 139;
+static int vector2_length = 133;
 
 static char *test_compose_scalars(void *context)
 {
@@ -334,12 +336,12 @@ static char *test_compose_scalars(void *context)
 // verify composition via a set of sub-fields
 static char *vector3 =
     "\x00\x53\x72"                              // message annotations
-    "\xD1\x00\x00\x00\x1A\x00\x00\x00\x04"      // map32, 26 bytes, 4 fields
+    "\xC1\x17\x04"                              // map8, 23 bytes, 4 fields
     "\xA1\x04Key1"                              // str8
     "\x70\x00\x00\x03\xE7"                      // uint 999
     "\xA1\x04Key2"                              // str8
     "\x70\x00\x00\x03\x78";                     // uint 888
-static int vector3_length = 34;
+static int vector3_length = 28;
 
 static char *test_compose_subfields(void *context)
 {
@@ -500,6 +502,118 @@ exit:
     return error;
 }
 
+// composites too large for the one octet size or count keep the 32-bit encoding
+static char *test_compose_large_composites(void *context)
+{
+    qd_composed_field_t *field = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
+    qd_compose_start_list(field);
+    for (int i = 0; i < 300; i++)
+        qd_compose_insert_uint(field, 0);
+    qd_compose_end_list(field);
+
+    qd_buffer_t *buf = DEQ_HEAD(field->buffers);
+    if (qd_buffer_size(buf) != 3 + 9 + 300)
+        return "Incorrect length of large count list";
+    if (memcmp(qd_buffer_base(buf) + 3, "\xd0\x00\x00\x01\x30\x00\x00\x01\x2c", 9) != 0)
+        return "Large count list not encoded as list32";
+    qd_compose_free(field);
+
+    field = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
+    qd_compose_start_map(field);
+    for (int i = 0; i < 10; i++) {
+        qd_compose_insert_symbol(field, "a-symbol-key-of-some-length");
+        qd_compose_insert_string(field, "a-string-value-of-some-length");
+    }
+    qd_compose_end_map(field);
+
+    // 10 * (29 + 31) octets of body
+    buf = DEQ_HEAD(field->buffers);
+    if (qd_buffer_size(buf) != 3 + 9 + 600)
+        return "Incorrect length of large size map";
+    if (memcmp(qd_buffer_base(buf) + 3, "\xd1\x00\x00\x02\x5c\x00\x00\x00\x14", 9) != 0)
+        return "Large size map not encoded as map32";
+    qd_compose_free(field);
+
+    field = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
+    qd_compose_start_map(field);
+    qd_compose_end_map(field);
+    buf = DEQ_HEAD(field->buffers);
+    if (qd_buffer_size(buf) != 6 || memcmp(qd_buffer_base(buf) + 3, "\xc1\x01\x00", 3) != 0)
+        return "Empty map not encoded as map8";
+    qd_compose_free(field);
+
+    return 0;
+}
+
+
+// compact a list whose 32-bit header or body was split across buffers, at every offset from the end of the buffer
+static char *test_compose_compact_across_buffers(void *context)
+{
+    for (size_t pad = 0; pad < 24; pad++) {
+        char *error = 0;
+
+        // the inner list starts pad octets before the end of the first buffer
+        size_t str_len = QD_BUFFER_SIZE - 17 - pad;
+        char  *str     = malloc(str_len + 1);
+        memset(str, 'x', str_len);
+        str[str_len] = 0;
+
+        qd_composed_field_t *field = qd_compose(QD_PERFORMATIVE_BODY_AMQP_VALUE, 0);
+        qd_compose_start_list(field);
+        qd_compose_insert_string(field, str);
+        qd_compose_start_list(field);
+        qd_compose_insert_uint(field, 7);
+        qd_compose_insert_string(field, "item");
+        qd_compose_empty_list(field);
+        qd_compose_start_map(field);
+        qd_compose_insert_symbol(field, "k");
+        qd_compose_insert_uint(field, 1);
+        qd_compose_end_map(field);
+        qd_compose_end_list(field);
+        qd_compose_end_list(field);
+
+        qd_buffer_list_t blist;
+        qd_compose_take_buffers(field, &blist);
+        qd_compose_free(field);
+        free(str);
+
+        unsigned int length = qd_buffer_list_length(&blist);
+        if (length != QD_BUFFER_SIZE - pad + 20) {
+            qd_buffer_list_free_buffers(&blist);
+            return "Incorrect encoded length";
+        }
+
+        qd_iterator_t     *iter  = qd_iterator_buffer(DEQ_HEAD(blist), 3, (length - 3), ITER_VIEW_ALL);
+        qd_parsed_field_t *outer = qd_parse(iter);
+        qd_iterator_free(iter);
+
+        qd_parsed_field_t *inner = 0;
+        qd_parsed_field_t *value = 0;
+        if (!outer || !qd_parse_ok(outer) || qd_parse_tag(outer) != QD_AMQP_LIST32 || qd_parse_sub_count(outer) != 2) {
+            error = "Failed to parse outer list";
+        } else if (!(inner = qd_parse_sub_value(outer, 1)) || qd_parse_tag(inner) != QD_AMQP_LIST8
+                   || qd_parse_sub_count(inner) != 4) {
+            error = "Inner list not compacted";
+        } else if (!(value = qd_parse_sub_value(inner, 0)) || qd_parse_as_uint(value) != 7) {
+            error = "Invalid element 0";
+        } else if (!(value = qd_parse_sub_value(inner, 1)) || !qd_iterator_equal(qd_parse_raw(value), (const unsigned char*) "item")) {
+            error = "Invalid element 1";
+        } else if (!(value = qd_parse_sub_value(inner, 2)) || qd_parse_tag(value) != QD_AMQP_LIST0) {
+            error = "Invalid element 2";
+        } else if (!(value = qd_parse_sub_value(inner, 3)) || qd_parse_tag(value) != QD_AMQP_MAP8
+                   || qd_parse_as_uint(qd_parse_value_by_key(value, "k")) != 1) {
+            error = "Invalid element 3";
+        }
+
+        qd_parse_free(outer);
+        qd_buffer_list_free_buffers(&blist);
+        if (error)
+            return error;
+    }
+
+    return 0;
+}
+
 int compose_tests(void)
 {
     int result = 0;
@@ -513,6 +627,8 @@ int compose_tests(void)
     TEST_CASE(test_compose_scalars, 0);
     TEST_CASE(test_compose_subfields, 0);
     TEST_CASE(test_compose_buffer_field, 0);
+    TEST_CASE(test_compose_large_composites, 0);
+    TEST_CASE(test_compose_compact_across_buffers, 0);
 
     return result;
 }
@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "./qdr_doctest.hpp"
+#include "./helpers.hpp"  // must come after ./qdr_doctest.hpp
+
+#include <thread>
+
+extern "C" {
+#include "router_core_private.h"
+}
+
+// Data actions queued behind the control action, several times the number the core runs per pass
+static const int DATA_ACTION_FLOOD = 8 * QDR_DATA_ACTION_BATCH;
+
+/// State shared between the test thread and the actions running on the router core thread
+struct ActionFlood {
+    std::mutex mut;
+    std::condition_variable cv;
+    bool gate_entered = false;
+    bool gate_open    = false;
+    bool drained      = false;
+
+    // written by the core thread only
+    int data_run                = 0;
+    int data_run_before_fence   = -1;
+    int data_run_before_control = -1;
+
+    void set(bool &flag)
+    {
+        std::lock_guard<std::mutex> lock(mut);
+        flag = true;
+        cv.notify_all();
+    }
+
+    void wait(const bool &flag)
+    {
+        std::unique_lock<std::mutex> lock(mut);
+        cv.wait(lock, [&flag] { return flag; });
+    }
+
+    static ActionFlood *from(qdr_action_t *action) { return static_cast<ActionFlood *>(action->args.general.context_1); }
+};
+
+enum ActionClass { DATA_ACTION, FENCE_ACTION, CONTROL_ACTION };
+
+static void enqueue(qdr_core_t *core, ActionFlood &flood, qdr_action_handler_t handler,
+                    ActionClass action_class = DATA_ACTION)
+{
+    qdr_action_t *action           = qdr_action(handler, nullptr);
+    action->args.general.context_1 = &flood;
+    switch (action_class) {
+        case DATA_ACTION:
+            qdr_action_enqueue(core, action);
+            break;
+        case FENCE_ACTION:
+            qdr_action_fence_enqueue(core, action);
+            break;
+        case CONTROL_ACTION:
+            qdr_action_control_enqueue(core, action);
+            break;
+    }
+}
+
+// hold the core thread in a data action so that everything queued next is pending before any of it runs
+static void hold_core(qdr_core_t *core, ActionFlood &flood)
+{
+    enqueue(core, flood, [](qdr_core_t *, qdr_action_t *action, bool) {
+        ActionFlood *flood = ActionFlood::from(action);
+        flood->set(flood->gate_entered);
+        flood->wait(flood->gate_open);
+    });
+    flood.wait(flood.gate_entered);
+}
+
+static void enqueue_data_flood(qdr_core_t *core, ActionFlood &flood, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        enqueue(core, flood, [](qdr_core_t *, qdr_action_t *action, bool) { ActionFlood::from(action)->data_run++; });
+    }
+}
+
+static void enqueue_control(qdr_core_t *core, ActionFlood &flood)
+{
+    enqueue(
+        core, flood,
+        [](qdr_core_t *, qdr_action_t *action, bool) {
+            ActionFlood *flood             = ActionFlood::from(action);
+            flood->data_run_before_control = flood->data_run;
+        },
+        CONTROL_ACTION);
+}
+
+static void release_core(qdr_core_t *core, ActionFlood &flood)
+{
+    enqueue(core, flood, [](qdr_core_t *, qdr_action_t *action, bool) {
+        ActionFlood *flood = ActionFlood::from(action);
+        flood->set(flood->drained);
+    });
+    flood.set(flood.gate_open);
+    flood.wait(flood.drained);
+}
+
+TEST_CASE("Control actions are not starved by a flood of data actions")
+{
+    std::thread([]() {
+        QDR qdr{};
+        qdr.initialize("./minimal_silent.conf");
+        qdr.wait();
+
+        qdr_core_t *core = qdr.qd->router->router_core;
+        ActionFlood flood;
+
+        hold_core(core, flood);
+        enqueue_data_flood(core, flood, DATA_ACTION_FLOOD);
+        enqueue_control(core, flood);
+        release_core(core, flood);
+
+        // the control action was queued last but waits behind at most one batch of data actions
+        CHECK(flood.data_run == DATA_ACTION_FLOOD);
+        CHECK(flood.data_run_before_control >= 0);
+        CHECK(flood.data_run_before_control <= QDR_DATA_ACTION_BATCH);
+
+        qdr.deinitialize();
+    }).join();
+}
+
+TEST_CASE("Control actions do not overtake connection and link lifecycle actions")
+{
+    std::thread([]() {
+        QDR qdr{};
+        qdr.initialize("./minimal_silent.conf");
+        qdr.wait();
+
+        qdr_core_t *core = qdr.qd->router->router_core;
+        ActionFlood flood;
+
+        hold_core(core, flood);
+        enqueue_data_flood(core, flood, DATA_ACTION_FLOOD);
+        enqueue(
+            core, flood,
+            [](qdr_core_t *, qdr_action_t *action, bool) {
+                ActionFlood *flood           = ActionFlood::from(action);
+                flood->data_run_before_fence = flood->data_run;
+            },
+            FENCE_ACTION);
+        enqueue_control(core, flood);
+        enqueue_data_flood(core, flood, QDR_DATA_ACTION_BATCH);
+        release_core(core, flood);
+
+        // the control action keeps its FIFO position behind the fence but still runs ahead of the data queued after it
+        CHECK(flood.data_run == DATA_ACTION_FLOOD + QDR_DATA_ACTION_BATCH);
+        CHECK(flood.data_run_before_fence == DATA_ACTION_FLOOD);
+        CHECK(flood.data_run_before_control == DATA_ACTION_FLOOD);
+        CHECK(sys_atomic_get(&core->action_fences) == 0);
+
+        qdr.deinitialize();
+    }).join();
+}
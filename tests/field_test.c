@@ -19,6 +19,7 @@
 
 #include "test_case.h"
 
+#include "qpid/dispatch/alloc.h"
 #include "qpid/dispatch/hash.h"
 #include "qpid/dispatch/iterator.h"
 #include "qpid/dispatch/router.h"
@@ -26,6 +27,9 @@
 #include <stdio.h>
 #include <string.h>
 
+// allocator statistics of the iterator type (see iterator.c)
+qd_alloc_stats_t alloc_stats_qd_iterator_t(void);
+
 #define FAIL_TEXT_SIZE 10000
 static char fail_text[FAIL_TEXT_SIZE];
 
@@ -982,6 +986,58 @@ static char *test_iterator_copy_octet(void *context)
 }
 
 
+static char *test_iterator_storage(void *context)
+{
+    // verify that iterators initialized in caller storage behave like allocated iterators but do not
+    // consume qd_iterator_t instances from the pool
+    struct {const char *addr; const char *view;} cases[] = {
+    {"amqp:/_local/my-addr/sub",                "Lmy-addr/sub"},
+    {"amqp:/_topo/my-area/router/local/sub",    "Rrouter"},
+    {"amqp://host:port/_local/my-addr",         "Lmy-addr"},
+    {"amqp:/mobile",                            "Mmobile"},
+    {"amqp:/_edge/router/sub",                  "Hrouter"},
+    {0, 0}
+    };
+
+#ifdef QD_MEMORY_DEBUG
+    const uint64_t allocs = alloc_stats_qd_iterator_t().total_allocs;
+#endif
+
+    for (int idx = 0; cases[idx].addr; idx++) {
+        qd_buffer_list_t chain;
+        DEQ_INIT(chain);
+        build_buffer_chain(&chain, cases[idx].addr, 3);
+
+        qd_iterator_storage_t storage;
+        qd_iterator_t *iter = qd_iterator_buffer_init(&storage, DEQ_HEAD(chain), 0,
+                                                      strlen(cases[idx].addr),
+                                                      ITER_VIEW_ADDRESS_HASH);
+        char *ret = view_address_hash(context, iter, cases[idx].addr, cases[idx].view);
+        if (!ret) {
+            qd_iterator_storage_t dup_storage;
+            qd_iterator_t *dup = qd_iterator_dup_init(&dup_storage, iter);
+            ret = view_address_hash(context, dup, cases[idx].addr, cases[idx].view);
+            qd_iterator_free(dup);
+        }
+        if (!ret) {
+            // hash segments are still allocated and must be released by qd_iterator_free
+            qd_iterator_hash_view_segments(iter);
+            ret = check_copy(context, iter, cases[idx].addr, cases[idx].view);
+        }
+        qd_iterator_free(iter);
+        release_buffer_chain(&chain);
+        if (ret) return ret;
+    }
+
+#ifdef QD_MEMORY_DEBUG
+    if (alloc_stats_qd_iterator_t().total_allocs != allocs)
+        return "Iterators in caller storage must not be allocated from the pool";
+#endif
+
+    return 0;
+}
+
+
 int field_tests(void)
 {
     int result = 0;
@@ -1011,6 +1067,7 @@ int field_tests(void)
     TEST_CASE(test_qd_hash_retrieve_prefix_separator_exact_match_dot_at_end_1, 0);
     TEST_CASE(test_prefix_hash, 0);
     TEST_CASE(test_iterator_copy_octet, 0);
+    TEST_CASE(test_iterator_storage, 0);
 
     qd_iterator_set_address(true, "my-area", "my-router");
     TEST_CASE(test_view_address_hash_edge, 0);
@@ -608,6 +608,132 @@ exit:
 }
 
 
+// Copies of a message share their router annotation overrides until a copy
+// sets a different value.
+//
+static char* test_router_annotations_copy_on_write(void *context)
+{
+    char         *error    = 0;
+    const char    mesh[QD_DISCRIMINATOR_BYTES] = "0123456789abcdef";
+    qd_message_t *msg      = qd_message();
+    qd_message_t *copy1    = 0;
+    qd_message_t *copy2    = 0;
+
+    qd_message_set_to_override_annotation(msg, "to/override");
+    copy1 = qd_message_copy(msg);
+    copy2 = qd_message_copy(msg);
+
+    qd_message_pvt_t *pvt  = (qd_message_pvt_t*) msg;
+    qd_message_pvt_t *pvt1 = (qd_message_pvt_t*) copy1;
+    qd_message_pvt_t *pvt2 = (qd_message_pvt_t*) copy2;
+
+    if (!pvt->ra_override || pvt1->ra_override != pvt->ra_override || pvt2->ra_override != pvt->ra_override) {
+        error = "copies do not share the override annotations";
+        goto exit;
+    }
+
+    // setting an identical value must not break the sharing
+    qd_message_set_to_override_annotation(copy1, "to/override");
+    if (pvt1->ra_override != pvt->ra_override) {
+        error = "setting an unchanged value copied the override annotations";
+        goto exit;
+    }
+
+    qd_message_set_to_override_annotation(copy1, "another/override");
+    if (pvt1->ra_override == pvt->ra_override || strcmp(pvt1->ra_override->to_override, "another/override") != 0) {
+        error = "diverging copy did not get its own override annotations";
+        goto exit;
+    }
+    if (strcmp(pvt->ra_override->to_override, "to/override") != 0 || pvt2->ra_override != pvt->ra_override) {
+        error = "diverging copy modified the shared override annotations";
+        goto exit;
+    }
+
+    // the ingress mesh is per outgoing link and is not carried to new copies
+    qd_message_set_ingress_mesh(copy2, mesh);
+    if (pvt2->ra_override == pvt->ra_override || pvt->ra_override->ingress_mesh != 0) {
+        error = "setting the ingress mesh modified the shared override annotations";
+        goto exit;
+    }
+    qd_message_t *copy3 = qd_message_copy(copy2);
+    qd_message_pvt_t *pvt3 = (qd_message_pvt_t*) copy3;
+    if (!pvt3->ra_override || pvt3->ra_override->ingress_mesh != 0
+        || strcmp(pvt3->ra_override->to_override, "to/override") != 0) {
+        error = "ingress mesh copied to a new copy";
+    }
+    qd_message_free(copy3);
+
+exit:
+    qd_message_free(copy1);
+    qd_message_free(copy2);
+    qd_message_free(msg);
+    return error;
+}
+
+
+// Verify that copies sharing their override annotations share the cached router annotations encoding, that the
+// encoding is correct, and that a copy with a private override does not replace the cached encoding.
+//
+static char* test_router_annotations_encoding_cache(void *context)
+{
+    char                     *error    = 0;
+    const char                mesh[QD_DISCRIMINATOR_BYTES] = "0123456789abcdef";
+    qd_message_t             *msg      = qd_message();
+    qd_message_content_t     *content  = MSG_CONTENT(msg);
+    qd_message_ra_encoding_t *enc1     = 0;
+    qd_message_ra_encoding_t *enc2     = 0;
+    qd_message_ra_encoding_t *enc3     = 0;
+    qd_buffer_list_t          expected = DEQ_EMPTY;
+
+    qd_message_set_to_override_annotation(msg, "to/override");
+    qd_message_t *copy1 = qd_message_copy(msg);
+    qd_message_t *copy2 = qd_message_copy(msg);
+    qd_message_t *copy3 = qd_message_copy(msg);
+    qd_message_set_ingress_mesh(copy3, mesh);  // copy3 gets a private override
+
+    enc1 = _get_router_annotations((qd_message_pvt_t*) copy1, QD_MESSAGE_RA_STRIP_NONE);
+    enc2 = _get_router_annotations((qd_message_pvt_t*) copy2, QD_MESSAGE_RA_STRIP_NONE);
+    if (enc1 != enc2 || content->ra_encoding != enc1) {
+        error = "copies with shared overrides do not share the cached encoding";
+        goto exit;
+    }
+
+    uint32_t len = _compose_router_annotations((qd_message_pvt_t*) copy1, QD_MESSAGE_RA_STRIP_NONE, &expected);
+    if (enc1->length != len || qd_buffer_list_length(&enc1->buffers) != len) {
+        error = "cached encoding has the wrong length";
+        goto exit;
+    }
+    qd_buffer_t *ebuf = DEQ_HEAD(expected);
+    qd_buffer_t *cbuf = DEQ_HEAD(enc1->buffers);
+    while (ebuf && cbuf) {
+        if (qd_buffer_size(ebuf) != qd_buffer_size(cbuf)
+            || memcmp(qd_buffer_base(ebuf), qd_buffer_base(cbuf), qd_buffer_size(ebuf)) != 0) {
+            error = "cached encoding differs from the composed section";
+            goto exit;
+        }
+        ebuf = DEQ_NEXT(ebuf);
+        cbuf = DEQ_NEXT(cbuf);
+    }
+
+    enc3 = _get_router_annotations((qd_message_pvt_t*) copy3, QD_MESSAGE_RA_STRIP_NONE);
+    if (enc3 == enc1 || content->ra_encoding != enc1) {
+        error = "copy with a private override replaced the cached encoding";
+        goto exit;
+    }
+
+exit:
+    qd_buffer_list_free_buffers(&expected);
+    _release_router_annotations(enc1);
+    _release_router_annotations(enc2);
+    _release_router_annotations(enc3);
+    qd_message_free(copy1);
+    qd_message_free(copy2);
+    qd_message_free(copy3);
+    qd_message_free(msg);
+    return error;
+}
+
+
 static char* test_q2_input_holdoff_sensing(void *context)
 {
     if (QD_QLIMIT_Q2_LOWER >= QD_QLIMIT_Q2_UPPER)
@@ -1019,6 +1145,77 @@ exit:
 }
 
 
+// Verify that the buffers of a message are charged to its account as they are added, including cut-through buffers,
+// and credited back as they are consumed and when the message is freed.
+//
+static char *test_message_account(void *context)
+{
+    char *result = 0;
+    qd_message_t *msg = qd_message();
+    qd_message_content_t *content = MSG_CONTENT(msg);
+    qd_message_account_t *account = qd_message_account();
+
+    qd_composed_field_t *field = qd_compose(QD_PERFORMATIVE_HEADER, 0);
+    qd_compose_start_list(field);
+    qd_compose_insert_bool(field, 0);     // durable
+    qd_compose_insert_null(field);        // priority
+    qd_compose_end_list(field);
+    qd_message_compose_2(msg, field, false);
+    qd_compose_free(field);
+
+    // the buffers already held are charged when the account is set
+    qd_message_set_account(msg, account);
+    if (qd_message_account_buffers(account) != DEQ_SIZE(content->buffers)) {
+        result = "Existing buffers not charged";
+        goto exit;
+    }
+
+    uint8_t data[2 * QD_BUFFER_DEFAULT_SIZE] = {0};
+    qd_buffer_list_t bin_data = DEQ_EMPTY;
+    qd_buffer_list_append(&bin_data, data, sizeof(data));
+    field = qd_compose(QD_PERFORMATIVE_BODY_DATA, 0);
+    qd_compose_insert_binary_buffers(field, &bin_data);
+    qd_message_extend(msg, field, 0);
+    qd_compose_free(field);
+    if (qd_message_account_buffers(account) != DEQ_SIZE(content->buffers)) {
+        result = "Extended buffers not charged";
+        goto exit;
+    }
+
+    const uint64_t content_buffers = DEQ_SIZE(content->buffers);
+    qd_message_start_unicast_cutthrough(msg);
+    qd_buffer_list_t slot_data = DEQ_EMPTY;
+    qd_buffer_list_append(&slot_data, data, sizeof(data));
+    const uint64_t slot_buffers = DEQ_SIZE(slot_data);
+    qd_message_produce_buffers(msg, &slot_data);
+    if (qd_message_account_slot_buffers(account) != slot_buffers
+        || qd_message_account_buffers(account) != content_buffers + slot_buffers) {
+        result = "Cut-through buffers not charged";
+        goto exit;
+    }
+
+    qd_buffer_list_t consumed = DEQ_EMPTY;
+    qd_message_consume_buffers(msg, &consumed, (int) slot_buffers);
+    qd_buffer_list_free_buffers(&consumed);
+    if (qd_message_account_slot_buffers(account) != 0 || qd_message_account_buffers(account) != content_buffers) {
+        result = "Consumed cut-through buffers not credited";
+        goto exit;
+    }
+
+    qd_message_free(msg);
+    msg = 0;
+    if (qd_message_account_buffers(account) != 0) {
+        result = "Buffers of the freed message not credited";
+        goto exit;
+    }
+
+exit:
+    qd_message_free(msg);
+    qd_message_account_decref(account);
+    return result;
+}
+
+
 int message_tests(void)
 {
     int result = 0;
@@ -1029,11 +1226,14 @@ int message_tests(void)
     TEST_CASE(test_message_properties, 0);
     TEST_CASE(test_check_multiple, 0);
     TEST_CASE(test_parse_router_annotations, 0);
+    TEST_CASE(test_router_annotations_copy_on_write, 0);
+    TEST_CASE(test_router_annotations_encoding_cache, 0);
     TEST_CASE(test_q2_input_holdoff_sensing, 0);
     TEST_CASE(test_incomplete_annotations, 0);
     TEST_CASE(test_check_weird_messages, 0);
     TEST_CASE(test_q2_callback_on_disable, 0);
     TEST_CASE(test_q2_ignore_headers, 0);
+    TEST_CASE(test_message_account, 0);
 
     return result;
 }
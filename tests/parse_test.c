@@ -293,8 +293,15 @@ static char *test_integer_conversion(void *context)
 }
 
 
+// test cases that run against both parsers use the context to select qd_parse_lazy()
+//
+typedef qd_parsed_field_t *(*parse_fn_t)(const qd_iterator_t *iter);
+#define PARSE_FN(context) ((context) ? qd_parse_lazy : qd_parse)
+
+
 static char *test_map(void *context)
 {
+    parse_fn_t         parse    = PARSE_FN(context);
     qd_iterator_t     *val_iter = 0;
     qd_iterator_t     *typed_iter = 0;
     qd_iterator_t     *key_iter = 0;
@@ -312,7 +319,7 @@ static char *test_map(void *context)
     qd_buffer_list_append(&buflist, data, sizeof(data));
 
     qd_iterator_t     *data_iter = qd_iterator_buffer(DEQ_HEAD(buflist), 0, sizeof(data), ITER_VIEW_ALL);
-    qd_parsed_field_t *field     = qd_parse(data_iter);
+    qd_parsed_field_t *field     = parse(data_iter);
     qd_iterator_free(data_iter);
 
     if (!qd_parse_ok(field)) {
@@ -478,11 +485,14 @@ struct err_vector_t {
 {"\xb0\x00\x00\x00", 4, "Insufficient Data to Determine Length"},        // 7
 {"\xc0\x04",         2, "Insufficient Data to Determine Count"},         // 8
 {"\xd0\x00\x00\x00\x00\x00\x00\x00\x01",  9, "Insufficient Length to Determine Count"}, // 9
+{"\xc0\x05\x02\xa1\x01x\x21", 7, "Invalid Tag - No Length Information"},      // 10 (nested)
+{"\xc0\x06\x01\xc0\x03\x01\xa1\x05", 8, "Truncated field"},                 // 11 (nested)
 {0, 0, 0}
 };
 
 static char *test_parser_errors(void *context)
 {
+    parse_fn_t parse = PARSE_FN(context);
     int idx = 0;
     qd_buffer_list_t buflist = DEQ_EMPTY;
     static char error[1024];
@@ -495,7 +505,7 @@ static char *test_parser_errors(void *context)
             DEQ_INSERT_HEAD(buflist, tmp);
         }
         qd_iterator_t *field  = qd_iterator_buffer(DEQ_HEAD(buflist), 0, err_vectors[idx].length, ITER_VIEW_ALL);
-        qd_parsed_field_t *parsed = qd_parse(field);
+        qd_parsed_field_t *parsed = parse(field);
         if (qd_parse_ok(parsed)) {
             qd_parse_free(parsed);
             qd_iterator_free(field);
@@ -627,6 +637,7 @@ cleanup:
 
 static char *test_field_api(void *context)
 {
+    parse_fn_t parse = PARSE_FN(context);
     char *result = 0;
     qd_buffer_list_t blist = DEQ_EMPTY;
     qd_composed_field_t *comp = qd_compose_subfield(0);
@@ -645,7 +656,7 @@ static char *test_field_api(void *context)
                                              qd_buffer_list_length(&blist),
                                              ITER_VIEW_ALL);
 
-    qd_parsed_field_t *parsed = qd_parse(iter);
+    qd_parsed_field_t *parsed = parse(iter);
     if (!parsed || qd_parse_sub_count(parsed) != 3) {
         result = "failed to parse";
         goto exit;
@@ -717,6 +728,120 @@ exit:
     return result;
 }
 
+static char *test_map_lazy(void *context)         { return test_map((void*) 1); }
+static char *test_parser_errors_lazy(void *context) { return test_parser_errors((void*) 1); }
+static char *test_field_api_lazy(void *context)     { return test_field_api((void*) 1); }
+
+
+// Lazily expanded trees larger than a single arena block
+//
+static char *test_lazy_nested(void *context)
+{
+    char *result = 0;
+    qd_buffer_list_t blist = DEQ_EMPTY;
+    qd_composed_field_t *comp = qd_compose_subfield(0);
+    const int count = 50;  // spans several arena blocks
+
+    qd_compose_start_list(comp);
+    for (int i = 0; i < count; i++) {
+        qd_compose_start_map(comp);
+        qd_compose_insert_string(comp, "index");
+        qd_compose_insert_uint(comp, i);
+        qd_compose_end_map(comp);
+    }
+    qd_compose_end_list(comp);
+    qd_compose_take_buffers(comp, &blist);
+    qd_compose_free(comp);
+
+    qd_iterator_t *iter = qd_iterator_buffer(DEQ_HEAD(blist), 0,
+                                             qd_buffer_list_length(&blist),
+                                             ITER_VIEW_ALL);
+    qd_parsed_field_t *parsed = qd_parse_lazy(iter);
+    qd_parsed_field_t *dup    = 0;
+    if (!qd_parse_ok(parsed) || !qd_parse_is_list(parsed)) {
+        result = "failed to parse";
+        goto exit;
+    }
+
+    int i = 0;
+    for (qd_parsed_field_t *item = qd_field_first_child(parsed); item; item = qd_field_next_child(item), i++) {
+        qd_parsed_field_t *value = qd_parse_value_by_key(item, "index");
+        if (!value || qd_parse_as_uint(value) != (uint32_t) i) {
+            result = "wrong map value";
+            goto exit;
+        }
+        // access the raw iterators so they are released with the arena
+        if (!qd_iterator_equal(qd_parse_raw(qd_parse_sub_key(item, 0)), (const unsigned char*) "index")) {
+            result = "wrong map key";
+            goto exit;
+        }
+    }
+    if (i != count || qd_parse_sub_count(parsed) != (uint32_t) count) {
+        result = "wrong list count";
+        goto exit;
+    }
+
+    // a duplicate is independent of the arena
+    dup = qd_parse_dup(qd_parse_sub_value(parsed, count - 1));
+    qd_parse_free(parsed);
+    parsed = 0;
+    if (!qd_parse_ok(dup) || qd_parse_as_uint(qd_parse_value_by_key(dup, "index")) != (uint32_t) (count - 1)) {
+        result = "bad duplicate";
+        goto exit;
+    }
+
+exit:
+    qd_parse_free(dup);
+    qd_parse_free(parsed);
+    qd_iterator_free(iter);
+    qd_buffer_list_free_buffers(&blist);
+    return result;
+}
+
+
+// Lazily expanded trees starting in caller storage, both fitting in it and spilling into pool blocks
+//
+static char *test_lazy_storage(void *context)
+{
+    char *result = 0;
+    const int counts[] = {QD_PARSE_STORAGE_FIELDS - 1, 3 * QD_PARSE_STORAGE_FIELDS};
+
+    for (int c = 0; c < 2 && !result; c++) {
+        qd_buffer_list_t blist = DEQ_EMPTY;
+        qd_composed_field_t *comp = qd_compose_subfield(0);
+        qd_compose_start_list(comp);
+        for (int i = 0; i < counts[c]; i++) {
+            qd_compose_insert_uint(comp, i);
+        }
+        qd_compose_end_list(comp);
+        qd_compose_take_buffers(comp, &blist);
+        qd_compose_free(comp);
+
+        qd_iterator_t *iter = qd_iterator_buffer(DEQ_HEAD(blist), 0,
+                                                 qd_buffer_list_length(&blist),
+                                                 ITER_VIEW_ALL);
+        qd_parse_storage_t storage;
+        qd_parsed_field_t *parsed = qd_parse_lazy_init(&storage, iter);
+        if (!qd_parse_ok(parsed) || (char*) parsed < (char*) &storage || (char*) parsed >= (char*) (&storage + 1)) {
+            result = "failed to parse into storage";
+        } else if (qd_parse_sub_count(parsed) != (uint32_t) counts[c]) {
+            result = "wrong list count";
+        } else {
+            for (int i = 0; i < counts[c] && !result; i++) {
+                if (qd_parse_as_uint(qd_parse_sub_value(parsed, i)) != (uint32_t) i) {
+                    result = "wrong list value";
+                }
+            }
+        }
+
+        qd_parse_free(parsed);
+        qd_iterator_free(iter);
+        qd_buffer_list_free_buffers(&blist);
+    }
+    return result;
+}
+
+
 int parse_tests(void)
 {
     int result = 0;
@@ -728,6 +853,11 @@ int parse_tests(void)
     TEST_CASE(test_tracemask, 0);
     TEST_CASE(test_integer_conversion, 0);
     TEST_CASE(test_field_api, 0);
+    TEST_CASE(test_map_lazy, 0);
+    TEST_CASE(test_parser_errors_lazy, 0);
+    TEST_CASE(test_field_api_lazy, 0);
+    TEST_CASE(test_lazy_nested, 0);
+    TEST_CASE(test_lazy_storage, 0);
 
     return result;
 }
@@ -855,6 +855,97 @@ cleanup:
 }
 
 
+// Verify the token prefix used to key the core's address configuration cache
+// agrees with matching, including for empty tokens and leading or trailing
+// separators
+static char *test_prefix_tokens(void *context)
+{
+    static const struct {
+        const char *value;
+        int         count;
+        const char *rest;  // expected qd_parse_tree_skip_tokens() result
+    } skips[] = {
+        {"a..b",    2, "b"},
+        {"a..b",    1, ".b"},
+        {"a..",     2, 0},
+        {"a...",    2, "."},
+        {"a.",      1, 0},
+        {"..a.b",   1, "b"},
+        {"a/b.",    2, 0},
+        {"a.b.c",   0, "a.b.c"},
+        {"",        0, 0},
+    };
+    static const char *patterns[] = {"a.b", "a..#", "c.#", "a.b.#", "x/y"};
+    static const char *values[]   = {"a..b", "a..", "a...", "a.", "a.b.", "a.b..", "..a.b.c",
+                                     "c..", "c.", "x/y", "x/y/", "x..y", "a..b.c"};
+    char *error = 0;
+
+    qd_parse_tree_t *tree = qd_parse_tree_new(QD_PARSE_TREE_ADDRESS);
+
+    for (int i = 0; i < sizeof(skips) / sizeof(skips[0]); i++) {
+        const char *rest = qd_parse_tree_skip_tokens(tree, skips[i].value, skips[i].count);
+        if (!!rest != !!skips[i].rest || (rest && strcmp(rest, skips[i].rest) != 0)) {
+            fprintf(stderr, "skip %d tokens of '%s': expected '%s' got '%s'\n", skips[i].count, skips[i].value,
+                    skips[i].rest ? skips[i].rest : "(null)", rest ? rest : "(null)");
+            error = "qd_parse_tree_skip_tokens tokenized differently from the parse tree";
+            goto cleanup;
+        }
+    }
+
+    if (qd_parse_tree_prefix_tokens(tree) != 0) {
+        error = "expected no prefix tokens in an empty tree";
+        goto cleanup;
+    }
+
+    for (int i = 0; i < sizeof(patterns) / sizeof(patterns[0]); i++) {
+        if (qd_parse_tree_add_pattern_str(tree, patterns[i], (void *) patterns[i])) {
+            error = "failed to add pattern";
+            goto cleanup;
+        }
+    }
+
+    int prefix_tokens = qd_parse_tree_prefix_tokens(tree);
+    if (prefix_tokens != 2) {  // the empty token in "a..#" is a literal
+        error = "expected two prefix tokens";
+        goto cleanup;
+    }
+
+    // a value and its key (its first prefix_tokens tokens followed by '#') must match the same pattern
+    for (int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        const char *rest = qd_parse_tree_skip_tokens(tree, values[i], prefix_tokens);
+        if (!rest)
+            continue;  // the value is its own key
+
+        char key[64];
+        snprintf(key, sizeof(key), "%.*s#", (int) (rest - values[i]), values[i]);
+
+        void *value_match = 0;
+        void *key_match   = 0;
+        qd_parse_tree_retrieve_match_str(tree, values[i], &value_match);
+        qd_parse_tree_retrieve_match_str(tree, key, &key_match);
+        if (value_match != key_match) {
+            fprintf(stderr, "value '%s' matched '%s' but key '%s' matched '%s'\n", values[i],
+                    value_match ? (char *) value_match : "(none)", key, key_match ? (char *) key_match : "(none)");
+            error = "address key does not match the same pattern as the address";
+            goto cleanup;
+        }
+    }
+
+    if (qd_parse_tree_add_pattern_str(tree, "a.*.c", "a.*.c")) {
+        error = "failed to add pattern";
+        goto cleanup;
+    }
+    if (qd_parse_tree_prefix_tokens(tree) != -1) {
+        error = "expected no prefix tokens with a match-one wildcard";
+        goto cleanup;
+    }
+
+cleanup:
+    qd_parse_tree_free(tree);
+    return error;
+}
+
+
 int parse_tree_tests(void)
 {
     int result = 0;
@@ -867,5 +958,6 @@ int parse_tree_tests(void)
     TEST_CASE(test_matches, 0);
     TEST_CASE(test_multiple_matches, 0);
     TEST_CASE(test_validation, 0);
+    TEST_CASE(test_prefix_tokens, 0);
     return result;
 }
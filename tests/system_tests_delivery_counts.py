@@ -20,13 +20,14 @@
 from proton import Message, Delivery
 from proton.handlers import MessagingHandler
 from proton.reactor import Container
+from proton.utils import BlockingConnection
 
 from skupper_router.management.client import Node
 
 from system_test import TestCase, Qdrouterd, TIMEOUT, get_link_info
 from system_test import get_inter_router_links
 from system_test import has_mobile_dest_in_address_table, PollTimeout
-from system_test import TestTimeout, ROUTER_METRICS_TYPE
+from system_test import TestTimeout, ROUTER_METRICS_TYPE, ROUTER_LINK_TYPE, ROUTER_ADDRESS_TYPE, retry
 
 
 LARGE_PAYLOAD = ("X" * 1024) * 30
@@ -1136,6 +1137,54 @@ class OneRouterLinkCountersTest(TestCase):
         self.verify_one_credit_accepted(True)
 
 
+class OneRouterDeliveryLatencyTest(TestCase):
+    """
+    Every settled delivery is accounted for in the deliveryLatencyHistogram of its links and its address
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(OneRouterDeliveryLatencyTest, cls).setUpClass()
+        config = Qdrouterd.Config([
+            ('router', {'mode': 'standalone', 'id': 'A'}),
+            ('listener', {'port': cls.tester.get_port()})])
+        cls.router = cls.tester.qdrouterd(name="A", config=config, wait=True)
+
+    def _histograms(self, address):
+        links = self.router.management.query(type=ROUTER_LINK_TYPE).get_dicts()
+        in_hist = [link['deliveryLatencyHistogram'] for link in links
+                   if link['linkDir'] == 'in' and link['linkName'] == 'Tx_LatencyTest']
+        out_hist = [link['deliveryLatencyHistogram'] for link in links
+                    if link['linkDir'] == 'out' and link['owningAddr'] and link['owningAddr'].endswith(address)]
+        addrs = self.router.management.query(type=ROUTER_ADDRESS_TYPE).get_dicts()
+        addr_hist = [addr['deliveryLatencyHistogram'] for addr in addrs if addr['name'].endswith(address)]
+        return in_hist, out_hist, addr_hist
+
+    def test_latency_histograms(self):
+        address = 'latency.test'
+        count = 20
+        rx_conn = BlockingConnection(self.router.addresses[0], timeout=TIMEOUT)
+        receiver = rx_conn.create_receiver(address, credit=count)
+        self.router.wait_address(address, subscribers=1)
+        tx_conn = BlockingConnection(self.router.addresses[0], timeout=TIMEOUT)
+        sender = tx_conn.create_sender(address, name='Tx_LatencyTest')
+        for i in range(count):
+            sender.send(Message(body={'number': i}))
+            receiver.receive(timeout=TIMEOUT)
+            receiver.accept()
+
+        def _all_counted():
+            in_hist, out_hist, addr_hist = self._histograms(address)
+            return all(len(h) == 1 and sum(h[0]) == count for h in (in_hist, out_hist, addr_hist))
+        self.assertTrue(retry(_all_counted), "deliveryLatencyHistogram mismatch: %s" % str(self._histograms(address)))
+
+        # the histograms have one bucket per latency range
+        for hist in self._histograms(address):
+            self.assertEqual(10, len(hist[0]))
+
+        tx_conn.close()
+        rx_conn.close()
+
+
 class RouteContainerIngressCount(TestCase):
     @classmethod
     def setUpClass(cls):
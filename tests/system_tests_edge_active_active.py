@@ -0,0 +1,119 @@
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+from system_test import TestCase, Qdrouterd, main_module, unittest, retry
+from system_test import CONNECTION_TYPE
+from message_tests import DynamicAddressTest, MobileAddressAnonymousTest, MobileAddressTest
+
+
+class EdgeActiveActiveTest(TestCase):
+    """
+    An edge router in active-active uplink mode connected to two interior routers.
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(EdgeActiveActiveTest, cls).setUpClass()
+
+        def router(name, mode, *connections, extra=None):
+            config = [
+                ('router', {'mode': mode, 'id': name}),
+                ('listener', {'port': cls.tester.get_port()})
+            ]
+            if extra:
+                config[0][1].update(extra)
+            config.extend(connections)
+            config = Qdrouterd.Config(config)
+            cls.routers.append(cls.tester.qdrouterd(name, config, wait=True))
+
+        cls.routers = []
+
+        inter_router_port = cls.tester.get_port()
+        edge_port_A       = cls.tester.get_port()
+        edge_port_B       = cls.tester.get_port()
+
+        router('INT.A', 'interior',
+               ('listener', {'role': 'inter-router', 'port': inter_router_port}),
+               ('listener', {'role': 'edge', 'port': edge_port_A}))
+        router('INT.B', 'interior',
+               ('connector', {'name': 'connectorToA', 'role': 'inter-router', 'port': inter_router_port}),
+               ('listener', {'role': 'edge', 'port': edge_port_B}))
+        router('EA', 'edge',
+               ('connector', {'name': 'uplinkA', 'role': 'edge', 'port': edge_port_A}),
+               ('connector', {'name': 'uplinkB', 'role': 'edge', 'port': edge_port_B}),
+               extra={'edgeUplinkMode': 'active-active'})
+        router('EB', 'edge',
+               ('connector', {'name': 'uplinkB', 'role': 'edge', 'port': edge_port_B}))
+
+        cls.INT_A = cls.routers[0]
+        cls.INT_B = cls.routers[1]
+        cls.EA    = cls.routers[2]
+        cls.EB    = cls.routers[3]
+
+        cls.INT_A.wait_router_connected('INT.B')
+        cls.INT_B.wait_router_connected('INT.A')
+        cls.INT_A.is_edge_routers_connected(num_edges=1)
+        cls.INT_B.is_edge_routers_connected(num_edges=2)
+
+    def _uplinks(self):
+        conns = self.EA.management.query(type=CONNECTION_TYPE).get_dicts()
+        return [c for c in conns if c['role'] == 'edge' and c['dir'] == 'out']
+
+    def test_01_all_uplinks_active(self):
+        uplinks = self._uplinks()
+        self.assertEqual(2, len(uplinks))
+        for uplink in uplinks:
+            self.assertTrue(uplink['active'])
+
+    def test_02_dynamic_address(self):
+        test = DynamicAddressTest(self.EA.addresses[0], self.EB.addresses[0])
+        test.run()
+        self.assertIsNone(test.error)
+
+    def test_03_mobile_address_to_edge(self):
+        test = MobileAddressTest(self.EA.addresses[0], self.EB.addresses[0], 'test_03')
+        test.run()
+        self.assertIsNone(test.error)
+
+    def test_04_mobile_address_from_edge(self):
+        test = MobileAddressTest(self.EB.addresses[0], self.EA.addresses[0], 'test_04')
+        test.run()
+        self.assertIsNone(test.error)
+
+    def _uplink_deliveries_out(self):
+        return {u['identity']: u['deliveriesOut'] for u in self._uplinks()}
+
+    def test_05_anonymous_sender_spreads_over_uplinks(self):
+        before = self._uplink_deliveries_out()
+        test = MobileAddressAnonymousTest(self.EB.addresses[0], self.EA.addresses[0], 'test_05')
+        test.run()
+        self.assertIsNone(test.error)
+
+        # The anonymous sender's deliveries are forwarded to the interior round-robin over both uplinks: each uplink
+        # must carry a fair share of them, not just the address-tracking traffic
+        def _spread():
+            after = self._uplink_deliveries_out()
+            sent = [after[identity] - before.get(identity, 0) for identity in after]
+            return len(sent) == 2 and min(sent) >= test.n_sent // 4
+        self.assertTrue(retry(_spread),
+                        "deliveries were not spread across the uplinks: before=%s after=%s sent=%d"
+                        % (before, self._uplink_deliveries_out(), test.n_sent))
+
+
+if __name__ == '__main__':
+    unittest.main(main_module())
@@ -0,0 +1,297 @@
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import time
+from threading import Event, Thread
+
+from proton import Message
+from proton.handlers import MessagingHandler
+from proton.reactor import Container
+
+from system_test import TestCase, Qdrouterd, SkManager, main_module, unittest, retry, TestTimeout
+from system_test import AMQP_CONNECTOR_TYPE, CONNECTION_TYPE, ROUTER_LINK_TYPE, ROUTER_TYPE, TIMEOUT
+from message_tests import MobileAddressAnonymousTest, MobileAddressTest
+
+
+class ManyReceivers(MessagingHandler):
+    """
+    Attach count receivers, one per address, over a single connection and keep them attached in a background
+    thread until stop() is called.
+    """
+    def __init__(self, url, address_fmt, count):
+        super(ManyReceivers, self).__init__(prefetch=0)
+        self.url         = url
+        self.address_fmt = address_fmt
+        self.count       = count
+        self.opened      = 0
+        self.ready       = Event()
+        self._conn       = None
+        self._stop       = False
+        self._container  = Container(self)
+        self._thread     = Thread(target=self._main)
+        self._thread.daemon = True
+        self._thread.start()
+
+    def _main(self):
+        self._container.timeout = 0.5
+        self._container.start()
+        while self._container.process():
+            if self._stop and self._conn:
+                self._conn.close()
+                self._conn = None
+
+    def on_start(self, event):
+        self._conn = event.container.connect(self.url)
+        for i in range(self.count):
+            event.container.create_receiver(self._conn, self.address_fmt % i)
+
+    def on_link_opened(self, event):
+        if event.receiver:
+            self.opened += 1
+            if self.opened == self.count:
+                self.ready.set()
+
+    def stop(self):
+        self._stop = True
+        self._container.wakeup()
+        self._thread.join(timeout=TIMEOUT)
+
+
+class ProducerWatchTest(MessagingHandler):
+    """
+    Watch the address on the watch_host through the router test hooks, attach a sender to it on the producer_host and
+    check that the watch counts the producer and then drops it when the sender detaches.
+    """
+    def __init__(self, address, watch_host, producer_host):
+        super(ProducerWatchTest, self).__init__()
+        self.address       = address
+        self.watch_host    = watch_host
+        self.producer_host = producer_host
+
+        self.conn_watch    = None
+        self.conn_producer = None
+        self.watch_sender  = None
+        self.receiver      = None
+        self.producer      = None
+        self.timer         = None
+        self.error         = None
+        self.phase         = "START"
+
+    def fail(self, error=None):
+        self.error = error
+        if self.conn_watch:
+            self.conn_watch.close()
+        if self.conn_producer:
+            self.conn_producer.close()
+        self.timer.cancel()
+
+    def timeout(self):
+        self.fail("Timeout Expired - Phase: %s" % self.phase)
+
+    def watch(self, opcode):
+        self.watch_sender.send(Message(subject='watch', properties={'opcode': opcode, 'address': self.address}))
+
+    def on_start(self, event):
+        self.timer         = event.reactor.schedule(TIMEOUT, TestTimeout(self))
+        self.conn_watch    = event.container.connect(self.watch_host.addresses[0])
+        self.conn_producer = event.container.connect(self.producer_host.addresses[0])
+        self.receiver      = event.container.create_receiver(self.conn_watch, "_local/_testhook/watch_event")
+
+    def on_link_opened(self, event):
+        if event.receiver == self.receiver:
+            self.watch_sender = event.container.create_sender(self.conn_watch, "_local/_testhook/address_watch")
+
+    def on_sendable(self, event):
+        if event.sender == self.watch_sender and self.phase == "START":
+            self.phase = "SET-WATCH"
+            self.watch('watch-on')
+
+    def on_accepted(self, event):
+        if self.phase == "UNWATCH":
+            self.fail(None)
+
+    def on_message(self, event):
+        ap        = event.message.properties
+        producers = ap['local_producers']
+
+        if ap['address'] != self.address:
+            self.fail("Received a watch for an unexpected address: expected %s, got %s" % (self.address, ap['address']))
+        elif self.phase == "SET-WATCH":
+            if producers == 0:
+                self.phase    = "PRODUCING"
+                self.producer = event.container.create_sender(self.conn_producer, self.address)
+            else:
+                self.fail("Expected 0 producers, got %d" % producers)
+        elif self.phase == "PRODUCING":
+            if producers == 1:
+                self.phase = "CLOSING"
+                self.producer.close()
+            elif producers > 1:
+                self.fail("Expected 1 producer, got %d" % producers)
+        elif self.phase == "CLOSING":
+            if producers == 0:
+                self.phase = "UNWATCH"
+                self.watch('watch-off')
+
+    def run(self):
+        Container(self).run()
+
+
+class EdgeMultiplexedProxyTest(TestCase):
+    """
+    An edge router in multiplexed address proxy mode (router edgeAddressProxy) and an edge router in per-address
+    mode connected to the same interior router.
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(EdgeMultiplexedProxyTest, cls).setUpClass()
+
+        def router(name, mode, *connections, extra=None):
+            config = [
+                ('router', {'mode': mode, 'id': name}),
+                ('listener', {'port': cls.tester.get_port()})
+            ]
+            if extra:
+                config[0][1].update(extra)
+            config.extend(connections)
+            config = Qdrouterd.Config(config)
+            # The interior enables the test hooks for its address watches
+            cl_args = ["-T"] if mode == 'interior' else None
+            cls.routers.append(cls.tester.qdrouterd(name, config, wait=True, cl_args=cl_args))
+
+        cls.routers = []
+
+        cls.edge_port = cls.tester.get_port()
+
+        router('INT.A', 'interior',
+               ('listener', {'role': 'edge', 'port': cls.edge_port}))
+        router('EA', 'edge',
+               ('connector', {'name': 'uplink', 'role': 'edge', 'port': cls.edge_port}),
+               extra={'edgeAddressProxy': 'multiplexed'})
+        router('EB', 'edge',
+               ('connector', {'name': 'uplink', 'role': 'edge', 'port': cls.edge_port}))
+
+        cls.INT_A = cls.routers[0]
+        cls.EA    = cls.routers[1]
+        cls.EB    = cls.routers[2]
+
+        cls.INT_A.is_edge_routers_connected(num_edges=2)
+
+    def _edge_conn_id(self, container):
+        conns = self.INT_A.management.query(type=CONNECTION_TYPE).get_dicts()
+        ids = [c['identity'] for c in conns if c['role'] == 'edge' and c['container'] == container]
+        return ids[0] if ids else None
+
+    def _links_on(self, conn_id):
+        links = self.INT_A.management.query(type=ROUTER_LINK_TYPE).get_dicts()
+        return len([link for link in links if link['connectionId'] == conn_id])
+
+    def _addr_count(self):
+        return self.INT_A.management.query(type=ROUTER_TYPE).get_dicts()[0]['addrCount']
+
+    def test_01_mobile_address_to_multiplexed_edge(self):
+        test = MobileAddressTest(self.EA.addresses[0], self.EB.addresses[0], 'test_01')
+        test.run()
+        self.assertIsNone(test.error)
+
+    def test_02_mobile_address_from_multiplexed_edge(self):
+        test = MobileAddressTest(self.EB.addresses[0], self.EA.addresses[0], 'test_02')
+        test.run()
+        self.assertIsNone(test.error)
+
+    def test_03_anonymous_sender_on_multiplexed_edge(self):
+        test = MobileAddressAnonymousTest(self.EB.addresses[0], self.EA.addresses[0], 'test_03')
+        test.run()
+        self.assertIsNone(test.error)
+
+    def test_04_link_count_independent_of_addresses(self):
+        conn_id = self._edge_conn_id('EA')
+        self.assertIsNotNone(conn_id)
+        links_before = self._links_on(conn_id)
+        addrs_before = self._addr_count()
+
+        receivers = ManyReceivers(self.EA.addresses[0], 'test_04.%d', 200)
+        try:
+            self.assertTrue(receivers.ready.wait(TIMEOUT), "receivers were not attached")
+            self.assertTrue(retry(lambda: self._addr_count() >= addrs_before + 200),
+                            "interior did not learn the edge's addresses")
+            self.assertEqual(links_before, self._links_on(conn_id))
+        finally:
+            receivers.stop()
+
+        self.assertTrue(retry(lambda: self._addr_count() <= addrs_before),
+                        "interior did not withdraw the edge's addresses")
+
+    def _reestablish_uplink(self, edge, address_fmt, count):
+        """
+        Attach count receivers on the edge, drop and re-create its uplink and return the seconds it took the interior
+        to relearn all of the edge's addresses.
+        """
+        addrs_before = self._addr_count()
+
+        receivers = ManyReceivers(edge.addresses[0], address_fmt, count)
+        try:
+            self.assertTrue(receivers.ready.wait(TIMEOUT * 2), "receivers were not attached")
+            self.assertTrue(retry(lambda: self._addr_count() >= addrs_before + count, timeout=TIMEOUT * 2),
+                            "interior did not learn the edge's addresses")
+
+            mgmt = SkManager(address=edge.addresses[0])
+            mgmt.delete(AMQP_CONNECTOR_TYPE, name='uplink')
+            self.assertTrue(retry(lambda: self._addr_count() <= addrs_before, timeout=TIMEOUT * 2),
+                            "interior did not drop the edge's addresses")
+
+            start = time.time()
+            mgmt.create(AMQP_CONNECTOR_TYPE, {'name': 'uplink', 'role': 'edge', 'port': self.edge_port})
+            self.assertTrue(retry(lambda: self._addr_count() >= addrs_before + count, timeout=TIMEOUT * 2),
+                            "interior did not relearn the edge's addresses")
+            elapsed = time.time() - start
+        finally:
+            receivers.stop()
+
+        self.assertTrue(retry(lambda: self._addr_count() <= addrs_before, timeout=TIMEOUT * 2),
+                        "interior did not withdraw the edge's addresses")
+        return elapsed
+
+    def test_05_uplink_reestablishment_with_many_addresses(self):
+        """
+        Both edges relearn all of their addresses after the uplink is re-created. The timings are only reported: a
+        wall clock comparison is too noisy to assert on in CI. The multiplexed edge sends its interest in a few
+        batched messages instead of attaching two links per address.
+        """
+        count = 1000
+
+        multiplexed = self._reestablish_uplink(self.EA, 'test_05.mux.%d', count)
+        per_address = self._reestablish_uplink(self.EB, 'test_05.link.%d', count)
+
+        print("uplink re-established with %d addresses in %.3fs multiplexed, %.3fs per-address"
+              % (count, multiplexed, per_address), flush=True)
+
+    def test_06_interior_watch_counts_multiplexed_producers(self):
+        test = ProducerWatchTest('test_06.mux', self.INT_A, self.EA)
+        test.run()
+        self.assertIsNone(test.error)
+
+    def test_07_interior_watch_counts_per_address_producers(self):
+        test = ProducerWatchTest('test_07.link', self.INT_A, self.EB)
+        test.run()
+        self.assertIsNone(test.error)
+
+
+if __name__ == '__main__':
+    unittest.main(main_module())
@@ -27,7 +27,7 @@ from skupper_router.management.error import ForbiddenStatus
 
 from system_test import TestCase, Qdrouterd, main_module, TIMEOUT, MgmtMsgProxy, TestTimeout
 from system_test import unittest
-from system_test import CONNECTION_TYPE, ROUTER_ADDRESS_TYPE
+from system_test import CONNECTION_TYPE, ROUTER_ADDRESS_TYPE, ROUTER_METRICS_TYPE
 
 from message_tests import DynamicAddressTest, MobileAddressTest
 from message_tests import MobileAddressOneSenderTwoReceiversTest, MobileAddressMulticastTest
@@ -618,6 +618,42 @@ class EdgeRouterTest(EdgeBase):
         test.run()
         self.assertIsNone(test.error)
 
+    def test_37_mobile_address_churn_many_addresses(self):
+        """
+        Many mobile addresses with senders on both EA1 and EA2 become
+        reachable at once through INT.B.  INT.A must coalesce the
+        reachability updates for each edge into batched address-tracking
+        messages, and every address must still become usable from both
+        edges.
+        """
+        if self.skip['test_37'] :
+            self.skipTest("Test skipped during development.")
+
+        count = 50
+
+        def tracking_metrics():
+            node = Node.connect(self.routers[0].addresses[0], timeout=TIMEOUT)
+            metrics = node.query(type=ROUTER_METRICS_TYPE).get_dicts()[0]
+            node.close()
+            return metrics['edgeAddressTrackingMessages'], metrics['edgeAddressTrackingUpdates']
+
+        messages_before, updates_before = tracking_metrics()
+
+        test = MobileAddressChurnTest([self.routers[2].addresses[0], self.routers[3].addresses[0]],
+                                      self.routers[1].addresses[0],
+                                      ["churn.37.%d" % i for i in range(count)])
+        test.run()
+        self.assertIsNone(test.error)
+
+        messages_after, updates_after = tracking_metrics()
+        messages = messages_after - messages_before
+        updates = updates_after - updates_before
+
+        # every address became reachable for both edges...
+        self.assertGreaterEqual(updates, 2 * count)
+        # ...using fewer messages than one per address per edge
+        self.assertLess(messages, updates)
+
 
 class ConnectivityTest(MessagingHandler):
     def __init__(self, interior_host, edge_host, edge_id):
@@ -673,6 +709,71 @@ class ConnectivityTest(MessagingHandler):
         Container(self).run()
 
 
+class MobileAddressChurnTest(MessagingHandler):
+    """
+    Attach one sender per address on each edge, then attach all the
+    receivers at once so the addresses become reachable in a single burst.
+    One message is sent per sender as soon as the edge grants credit.
+    """
+    def __init__(self, edge_hosts, receiver_host, addresses):
+        super(MobileAddressChurnTest, self).__init__()
+        self.edge_hosts    = edge_hosts
+        self.receiver_host = receiver_host
+        self.addresses     = addresses
+        self.expected      = len(edge_hosts) * len(addresses)
+
+        self.conns         = []
+        self.senders       = []
+        self.receivers     = []
+        self.sent          = set()
+        self.n_opened      = 0
+        self.n_rcvd        = 0
+        self.timer         = None
+        self.error         = None
+
+    def timeout(self):
+        self.error = "Timeout Expired - senders_opened=%d, sent=%d, rcvd=%d" % \
+                     (self.n_opened, len(self.sent), self.n_rcvd)
+        self.close()
+
+    def close(self):
+        for conn in self.conns:
+            conn.close()
+
+    def on_start(self, event):
+        self.timer = event.reactor.schedule(TIMEOUT, TestTimeout(self))
+        for host in self.edge_hosts:
+            conn = event.container.connect(host)
+            self.conns.append(conn)
+            for addr in self.addresses:
+                self.senders.append(event.container.create_sender(conn, addr))
+        self.receiver_conn = event.container.connect(self.receiver_host)
+        self.conns.append(self.receiver_conn)
+
+    def on_link_opened(self, event):
+        if event.sender in self.senders:
+            self.n_opened += 1
+            if self.n_opened == self.expected:
+                for addr in self.addresses:
+                    self.receivers.append(event.container.create_receiver(self.receiver_conn, addr))
+
+    def on_sendable(self, event):
+        if event.sender not in self.sent:
+            self.sent.add(event.sender)
+            event.sender.send(Message(body=event.sender.target.address))
+
+    def on_message(self, event):
+        if event.message.body != event.receiver.source.address:
+            self.error = "Message for %s received on %s" % (event.message.body, event.receiver.source.address)
+        self.n_rcvd += 1
+        if self.n_rcvd == self.expected:
+            self.timer.cancel()
+            self.close()
+
+    def run(self):
+        Container(self).run()
+
+
 class MobileAddressEventTest(MessagingHandler):
     def __init__(self, receiver1_host, receiver2_host, receiver3_host,
                  sender_host, interior_host, address, check_remote=False, subscriber_count=0):
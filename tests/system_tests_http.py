@@ -219,10 +219,37 @@ class RouterTestHttp(TestCase):
                       "qdr_deliveries_delayed_10sec_total",
                       "qdr_deliveries_stuck_total",
                       "qdr_links_blocked_total",
+                      "qdr_delivery_latency_lt_100us_total",
+                      "qdr_delivery_latency_lt_200us_total",
+                      "qdr_delivery_latency_lt_500us_total",
+                      "qdr_delivery_latency_lt_1ms_total",
+                      "qdr_delivery_latency_lt_2ms_total",
+                      "qdr_delivery_latency_lt_5ms_total",
+                      "qdr_delivery_latency_lt_10ms_total",
+                      "qdr_delivery_latency_lt_100ms_total",
+                      "qdr_delivery_latency_lt_1s_total",
+                      "qdr_delivery_latency_ge_1s_total",
                       "qdr_tcp_service_connections",
                       "qdr_amqp_service_connections",
                       "qdr_http1_service_connections",
-                      "qdr_http2_service_connections"]
+                      "qdr_http2_service_connections",
+                      "qdr_memory_pressure_level",
+                      "qdr_memory_buffer_ceiling",
+                      "qdr_memory_buffers_in_use",
+                      "qdr_memory_pressure_transitions_total",
+                      "qdr_memory_shed_connections_total",
+                      "qdr_granted_read_buffers",
+                      "qdr_python_queue_depth",
+                      "qdr_python_queue_depth_max",
+                      "qdr_python_calls_total",
+                      "qdr_python_queue_usec_total",
+                      "qdr_python_call_usec_total",
+                      "qdr_io_thread_0_batches_total",
+                      "qdr_io_thread_0_busy_usec_total",
+                      "qdr_tls_handshake_threads",
+                      "qdr_tls_handshake_queue_depth",
+                      "qdr_tls_handshake_offloads_total",
+                      "qdr_tls_handshake_busy_usec_total"]
         for stat in r.management.query(type=ALLOCATOR_TYPE).get_dicts():
             stat_names.append(stat['typeName'])
 
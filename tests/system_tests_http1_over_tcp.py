@@ -21,7 +21,9 @@ from http1_tests import CommonHttp1OneRouterTest, Http1OneRouterTestBase
 from http1_tests import TestServer, RequestHandler10
 from http1_tests import Http1Edge2EdgeTestBase
 from http1_tests import CommonHttp1Edge2EdgeTest
+from http1_tests import ThreadedTestClient
 from http1_tests import wait_tcp_listeners_up
+from system_test import TCP_CONNECTOR_TYPE, TCP_LISTENER_TYPE
 
 
 class Http1OverTcpOneRouterTest(Http1OneRouterTestBase,
@@ -76,6 +78,89 @@ class Http1OverTcpOneRouterTest(Http1OneRouterTestBase,
         super().tearDownClass()
 
 
+class Http1EncapsulationOneRouterTest(Http1OneRouterTestBase,
+                                      CommonHttp1OneRouterTest):
+    """
+    Test HTTP servers and clients attached to a standalone router using the
+    TCP adaptor's http1 encapsulation: each request/response is carried in its
+    own stream and the connector runs them over pooled server connections
+    """
+    @classmethod
+    def setUpClass(cls):
+        """Start a router"""
+        super(Http1EncapsulationOneRouterTest, cls).setUpClass()
+
+        # configuration: same as Http1OverTcpOneRouterTest. The test servers
+        # serve one connection at a time so the pool is limited to a single
+        # connection per server.
+
+        super(Http1EncapsulationOneRouterTest, cls).router('INT.A', 'standalone',
+                                                           [('tcpConnector', {'name': 'connector11',
+                                                                              'port': cls.server11_port,
+                                                                              'host': cls.server11_host,
+                                                                              'address': 'testServer11',
+                                                                              'encapsulation': 'http1',
+                                                                              'maxPooledConnections': 1}),
+                                                            ('tcpConnector', {'name': 'connector10',
+                                                                              'port': cls.server10_port,
+                                                                              'host': cls.server10_host,
+                                                                              'address': 'testServer10',
+                                                                              'encapsulation': 'http1',
+                                                                              'maxPooledConnections': 1}),
+                                                            ('tcpListener', {'name': 'listener11',
+                                                                             'port': cls.listener11_port,
+                                                                             'host': cls.listener11_host,
+                                                                             'address': 'testServer11',
+                                                                             'encapsulation': 'http1'}),
+                                                            ('tcpListener', {'name': 'listener10',
+                                                                             'port': cls.listener10_port,
+                                                                             'host': cls.listener10_host,
+                                                                             'address': 'testServer10',
+                                                                             'encapsulation': 'http1'})
+                                                            ])
+
+        cls.INT_A = cls.routers[0]
+        cls.INT_A.listener = cls.INT_A.addresses[0]
+
+        cls.http11_server = TestServer.new_server(server_port=cls.server11_port, client_port=cls.listener11_port, tests=cls.TESTS_11)
+        cls.http10_server = TestServer.new_server(server_port=cls.server10_port, client_port=cls.listener10_port, tests=cls.TESTS_10,
+                                                  handler_cls=RequestHandler10)
+        cls.INT_A.wait_connectors()
+        wait_tcp_listeners_up(cls.INT_A.listener)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.http10_server.wait()
+        cls.http11_server.wait()
+        super().tearDownClass()
+
+    def test_100_pooled_server_connection(self):
+        """
+        Run several concurrent keep-alive clients and verify all of their
+        requests are served over the single pooled server connection
+        """
+        # error responses cause the server to close its connection, skip them
+        tests = {"GET": [t for t in self.TESTS_11["GET"] if not t[1].error]}
+        expected = 2 * len(tests["GET"])
+
+        mgmt = self.INT_A.sk_manager
+        before = mgmt.read(TCP_CONNECTOR_TYPE, name='connector11')
+        clients = [ThreadedTestClient(tests, self.listener11_host_port, repeat=2)
+                   for _ in range(4)]
+        for client in clients:
+            client.wait()
+            self.assertIsNone(client.error)
+            client.check_count(expected)
+
+        after = mgmt.read(TCP_CONNECTOR_TYPE, name='connector11')
+        # all clients share the one pooled server connection
+        self.assertLessEqual(after['connectionsOpened'] - before['connectionsOpened'], 1)
+        self.assertGreaterEqual(after['requests'] - before['requests'], len(clients) * expected)
+
+        listener = mgmt.read(TCP_LISTENER_TYPE, name='listener11')
+        self.assertGreaterEqual(listener['requests'], len(clients) * expected)
+
+
 class Http1OverTcpEdge2EdgeTest(Http1Edge2EdgeTestBase, CommonHttp1Edge2EdgeTest):
     """
     Test an HTTP servers and clients attached to edge routers separated by an
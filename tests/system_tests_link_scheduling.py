@@ -0,0 +1,173 @@
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+from proton import Message
+from proton.handlers import MessagingHandler
+from proton.reactor import Container
+
+from skupper_router.management.client import Node
+
+from system_test import TestCase, Qdrouterd, main_module, unittest, retry, TIMEOUT, TestTimeout
+from system_test import ROUTER_LINK_TYPE
+
+
+class LinkSchedulingTest(TestCase):
+    """
+    Links of one priority on the same connection share the connection's I/O turn deficit-round-robin.
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(LinkSchedulingTest, cls).setUpClass()
+        config = Qdrouterd.Config([
+            ('router', {'mode': 'standalone', 'id': 'QDR', 'linkSchedulingQuanta': '2048'}),
+            ('listener', {'port': cls.tester.get_port()}),
+            ('address', {'prefix': 'closest', 'distribution': 'closest'})
+        ])
+        cls.router = cls.tester.qdrouterd('QDR', config, wait=True)
+
+    def _outgoing_link(self, address):
+        links = self.router.management.query(type=ROUTER_LINK_TYPE).get_dicts()
+        for link in links:
+            if link['linkDir'] == 'out' and link['owningAddr'] and link['owningAddr'].endswith(address):
+                return link
+        return None
+
+    def test_01_bulk_and_interactive_links_share_connection(self):
+        bulk_count        = 200
+        interactive_count = 10
+
+        test = BulkInteractiveTest(self.router.addresses[0], bulk_count, interactive_count)
+        test.run()
+        self.assertIsNone(test.error)
+
+        # nothing may be lost or reordered within a link
+        bulk_bodies = [body for addr, body in test.received if addr == 'closest.bulk']
+        self.assertEqual(['bulk-%d' % i for i in range(bulk_count)], bulk_bodies)
+        interactive_bodies = [body for addr, body in test.received if addr == 'closest.interactive']
+        self.assertEqual(['ping-%d' % i for i in range(interactive_count)], interactive_bodies)
+
+        # Both links had their full backlog queued when credit arrived, bulk first.  With a quantum smaller than
+        # one bulk message the bulk link yields after every delivery, so the interactive link is served within
+        # the first rounds instead of waiting behind the bulk backlog.
+        positions = [i for i, (addr, _) in enumerate(test.received) if addr == 'closest.interactive']
+        self.assertLess(positions[-1], interactive_count + bulk_count // 4,
+                        "interactive deliveries were delayed behind the bulk flow: %s" % positions)
+
+        # every delivery sent on the outgoing links is accounted for in the queueing-delay histogram
+        for address, count in (('closest.bulk', bulk_count), ('closest.interactive', interactive_count)):
+            self.assertTrue(retry(lambda: sum(self._outgoing_link(address)['queueDelayHistogram']) == count),
+                            "queueDelayHistogram mismatch for %s: %s" % (address, self._outgoing_link(address)))
+
+
+class BacklogTimer:
+    def __init__(self, parent):
+        self.parent = parent
+
+    def on_timer_task(self, event):
+        self.parent.check_backlog()
+
+
+class BulkInteractiveTest(MessagingHandler):
+    """
+    Queue a bulk backlog and an interactive backlog on two outgoing links of the same connection while the receiver
+    grants no credit, then grant credit to the bulk link and the interactive link and record the order in which the
+    deliveries arrive.
+    """
+    def __init__(self, address, bulk_count, interactive_count):
+        super(BulkInteractiveTest, self).__init__(prefetch=0)
+        self.address           = address
+        self.bulk_count        = bulk_count
+        self.interactive_count = interactive_count
+        self.payload           = 'X' * 16384
+        self.rx_conn           = None
+        self.tx_conn           = None
+        self.bulk              = None
+        self.interactive       = None
+        self.sender            = None
+        self.n_opened          = 0
+        self.n_sent            = 0
+        self.credit_granted    = False
+        self.received          = []
+        self.timer             = None
+        self.error             = None
+
+    def timeout(self):
+        self.error = "Timeout Expired - sent=%d received=%d credit_granted=%s" % \
+                     (self.n_sent, len(self.received), self.credit_granted)
+        self.rx_conn.close()
+        self.tx_conn.close()
+
+    def on_start(self, event):
+        self.timer       = event.reactor.schedule(TIMEOUT, TestTimeout(self))
+        self.reactor     = event.reactor
+        self.rx_conn     = event.container.connect(self.address)
+        self.tx_conn     = event.container.connect(self.address)
+        self.bulk        = event.container.create_receiver(self.rx_conn, 'closest.bulk')
+        self.interactive = event.container.create_receiver(self.rx_conn, 'closest.interactive')
+
+    def on_link_opened(self, event):
+        if event.receiver in (self.bulk, self.interactive):
+            self.n_opened += 1
+            if self.n_opened == 2:
+                self.sender = event.container.create_sender(self.tx_conn, None)
+
+    def on_sendable(self, event):
+        total = self.bulk_count + self.interactive_count
+        while event.sender.credit > 0 and self.n_sent < total:
+            if self.n_sent < self.bulk_count:
+                msg = Message(address='closest.bulk', body='bulk-%d' % self.n_sent,
+                              properties={'payload': self.payload})
+            else:
+                msg = Message(address='closest.interactive', body='ping-%d' % (self.n_sent - self.bulk_count))
+            event.sender.send(msg)
+            self.n_sent += 1
+        if self.n_sent == total and not self.credit_granted:
+            self.reactor.schedule(0.2, BacklogTimer(self))
+
+    def check_backlog(self):
+        node = Node.connect(self.address, timeout=TIMEOUT)
+        links = node.query(type=ROUTER_LINK_TYPE).get_dicts()
+        node.close()
+        undelivered = {}
+        for link in links:
+            if link['linkDir'] == 'out' and link['owningAddr']:
+                for addr in ('closest.bulk', 'closest.interactive'):
+                    if link['owningAddr'].endswith(addr):
+                        undelivered[addr] = link['undeliveredCount']
+        if undelivered.get('closest.bulk') == self.bulk_count \
+                and undelivered.get('closest.interactive') == self.interactive_count:
+            self.credit_granted = True
+            self.bulk.flow(self.bulk_count)
+            self.interactive.flow(self.interactive_count)
+        else:
+            self.reactor.schedule(0.2, BacklogTimer(self))
+
+    def on_message(self, event):
+        self.received.append((event.receiver.source.address, event.message.body))
+        if len(self.received) == self.bulk_count + self.interactive_count:
+            self.timer.cancel()
+            self.rx_conn.close()
+            self.tx_conn.close()
+
+    def run(self):
+        Container(self).run()
+
+
+if __name__ == '__main__':
+    unittest.main(main_module())
@@ -27,6 +27,7 @@ from itertools import chain
 from proton import Message
 from proton.handlers import MessagingHandler
 from proton.reactor import Container
+from proton.utils import BlockingConnection
 
 from skupper_router.management.client import Node, Url
 from skupper_router.management.error import ManagementError, BadRequestStatus, NotImplementedStatus, NotFoundStatus
@@ -41,6 +42,7 @@ from system_test import MANAGEMENT_TYPE, CONFIG_ENTITY_TYPE, OPER_ENTITY_TYPE
 from system_test import AMQP_LISTENER_TYPE, AMQP_CONNECTOR_TYPE, DUMMY_TYPE
 from system_test import ROUTER_TYPE, ROUTER_LINK_TYPE
 from system_test import ROUTER_NODE_TYPE, CONFIG_ADDRESS_TYPE, LOG_TYPE, CONNECTION_TYPE
+from system_test import ROUTER_ADDRESS_TYPE, ROUTER_METRICS_TYPE, TIMEOUT, retry
 
 
 def short_name(name):
@@ -293,6 +295,37 @@ class ManagementTest(system_test.TestCase):
         self.assertRaises(NotFoundStatus, self.node.read,
                           type=CONFIG_ADDRESS_TYPE, name='patternAddr')
 
+    def test_config_address_cache(self):
+        """Address configuration matches are cached until the address configuration changes"""
+        def _cache_hits():
+            return self.node.query(type=ROUTER_METRICS_TYPE).get_dicts()[0]['addressConfigCacheHits']
+
+        def _addresses(address):
+            addrs = self.node.query(type=ROUTER_ADDRESS_TYPE).get_dicts()
+            return [a for a in addrs if a['name'].endswith(address)]
+
+        def _attach_twice(address):
+            conn = BlockingConnection(self.router.addresses[0], timeout=TIMEOUT)
+            conn.create_receiver(address)
+            conn.create_receiver(address)
+            self.router.wait_address(address, subscribers=2)
+            distribution = _addresses(address)[0]['distribution']
+            conn.close()
+            self.assertTrue(retry(lambda: not _addresses(address)))
+            return distribution
+
+        self.assert_create_ok(CONFIG_ADDRESS_TYPE, 'cacheAddr', dict(prefix='cacheA', distribution='multicast'))
+        hits = _cache_hits()
+        self.assertEqual('multicast', _attach_twice('cacheA.one'))
+        # the second attach to the address is resolved from the cache
+        self.assertGreater(_cache_hits(), hits)
+
+        # replacing the configuration invalidates the cached match
+        self.node.delete(CONFIG_ADDRESS_TYPE, name='cacheAddr')
+        self.assert_create_ok(CONFIG_ADDRESS_TYPE, 'cacheAddr', dict(prefix='cacheA', distribution='balanced'))
+        self.assertEqual('balanced', _attach_twice('cacheA.one'))
+        self.node.delete(CONFIG_ADDRESS_TYPE, name='cacheAddr')
+
     def test_dummy(self):
         """Test all operations on the dummy test entity"""
         entity = self.node.read(type=AMQP_LISTENER_TYPE, name='l0')
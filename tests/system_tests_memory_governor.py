@@ -0,0 +1,141 @@
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import os
+import socket
+import threading
+from urllib.request import urlopen
+
+from proton import Message
+from proton.utils import BlockingConnection
+
+from system_test import TestCase, Qdrouterd, Logger, main_module, unittest, retry, TIMEOUT
+from system_test import wait_tcp_listeners_up
+from TCP_echo_server import TcpEchoServer
+
+PRESSURE_CRITICAL = 3
+
+
+class MemoryGovernorTest(TestCase):
+    """
+    Run a router with a tiny buffer memory ceiling so that a few large in-flight messages drive the memory governor to
+    critical pressure. Verify messages still get through under backpressure and that new tcpListener connections are
+    shed when memoryShedding is enabled.
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(MemoryGovernorTest, cls).setUpClass()
+        cls.listener_port = cls.tester.get_port()
+        cls.http_port = cls.tester.get_port()
+        cls.server_logger = Logger(title="MemoryGovernorTest",
+                                   print_to_console=False,
+                                   save_for_dump=False)
+        cls.echo_server = TcpEchoServer(prefix="ECHO_SERVER_MemoryGovernorTest",
+                                        port=0,
+                                        logger=cls.server_logger)
+        assert cls.echo_server.is_running
+
+        config = [
+            ('router', {'mode': 'standalone', 'id': 'QDR.GOV', 'memoryShedding': True}),
+            ('listener', {'role': 'normal', 'port': cls.tester.get_port()}),
+            ('listener', {'port': cls.http_port, 'http': True}),
+            ('address', {'prefix': 'closest', 'distribution': 'closest'}),
+            ('tcpListener', {'name': "governor-listener",
+                             'host': "localhost",
+                             'port': cls.listener_port,
+                             'address': 'ES_GOVERNOR'}),
+            ('tcpConnector', {'name': "governor-connector",
+                              'host': "localhost",
+                              'port': cls.echo_server.port,
+                              'address': 'ES_GOVERNOR'})
+        ]
+
+        # the ceiling is rounded up to the 100 buffer minimum
+        os.environ['SKUPPER_ROUTER_MEMORY_CEILING'] = '1'
+        try:
+            cls.router = cls.tester.qdrouterd('MemoryGovernor', Qdrouterd.Config(config), wait=True)
+        finally:
+            del os.environ['SKUPPER_ROUTER_MEMORY_CEILING']
+        wait_tcp_listeners_up(cls.router.addresses[0])
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.echo_server.wait()
+        super(MemoryGovernorTest, cls).tearDownClass()
+
+    def _metrics(self):
+        resp = urlopen(f"http://localhost:{self.http_port}/metrics")
+        metrics = {}
+        for line in resp.read().decode('utf-8').splitlines():
+            if not line.startswith('#'):
+                name, value = line.split()
+                metrics[name] = int(value)
+        return metrics
+
+    def test_01_buffer_ceiling(self):
+        self.router.wait_log_message("Router buffer memory ceiling: .* \\(100 buffers\\), shedding new connections")
+        self.assertEqual(100, self._metrics()['qdr_memory_buffer_ceiling'])
+
+    def test_02_backpressure_and_shedding(self):
+        sender_count = 8
+        payload = 'G' * 200000
+        errors = []
+
+        rx_conn = BlockingConnection(self.router.addresses[0], timeout=TIMEOUT)
+        receiver = rx_conn.create_receiver('closest.governor', credit=1)
+        self.router.wait_address('closest.governor', subscribers=1)
+
+        # each sender blocks until its message is accepted, so the router buffers all but one of them
+        def _sender(index):
+            try:
+                conn = BlockingConnection(self.router.addresses[0], timeout=TIMEOUT)
+                conn.create_sender('closest.governor').send(Message(body=payload, properties={'index': index}))
+                conn.close()
+            except Exception as exc:
+                errors.append("sender %d: %s" % (index, exc))
+
+        senders = [threading.Thread(target=_sender, args=(i,)) for i in range(sender_count)]
+        for sender in senders:
+            sender.start()
+
+        self.assertTrue(retry(lambda: self._metrics()['qdr_memory_pressure_level'] == PRESSURE_CRITICAL),
+                        "memory pressure did not reach critical: %s" % self._metrics())
+
+        # a new tcpListener connection is refused: the router closes it without reading
+        with socket.create_connection(("localhost", self.listener_port), timeout=TIMEOUT) as sock:
+            self.assertEqual(b'', sock.recv(1))
+        self.assertGreaterEqual(self._metrics()['qdr_memory_shed_connections_total'], 1)
+
+        # drain the receiver: every message gets through intact despite the reduced Q2 limits
+        indexes = []
+        for _ in range(sender_count):
+            msg = receiver.receive(timeout=TIMEOUT)
+            receiver.accept()
+            self.assertEqual(payload, msg.body)
+            indexes.append(msg.properties['index'])
+        for sender in senders:
+            sender.join(timeout=TIMEOUT)
+        self.assertEqual([], errors)
+        self.assertEqual(list(range(sender_count)), sorted(indexes))
+        self.assertGreaterEqual(self._metrics()['qdr_memory_pressure_transitions_total'], 1)
+        rx_conn.close()
+
+
+if __name__ == '__main__':
+    unittest.main(main_module())
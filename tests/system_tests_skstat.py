@@ -262,6 +262,15 @@ class SkstatTest(SkstatTestBase):
             m_regexp = r"(.*)\bVmSize\b[ \t]+\bRSS\b[ \t]+\bPooled\b(.*)"
             self.assertIsNotNone(re.match(m_regexp, out, flags=re.DOTALL), out)
 
+    def test_memory_connections(self):
+        out = self.run_skstat(['--memory'])
+        if "No memory statistics available" in out:
+            self.skipTest("router built without memory pool statistics")
+        # skstat's own management connection is always present
+        self.assertIn("Top Connections by Memory", out)
+        regexp = r"(.*)\bmsg-bufs\b[ \t]+\bct-bufs\b[ \t]+\braw-bufs\b[ \t]+\bunsettled\b[ \t]+\bmemory\b(.*)"
+        self.assertIsNotNone(re.match(regexp, out, flags=re.DOTALL), out)
+
     def test_memory_csv(self):
         out = self.run_skstat(['--memory', '--csv'])
         self.assertIn("QDR.A", out)
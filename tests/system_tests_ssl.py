@@ -32,6 +32,7 @@ from proton.utils import BlockingConnection
 
 from system_test import TIMEOUT, TestCase, main_module, Qdrouterd, Process
 from system_test import unittest, retry, CONNECTION_TYPE, ROUTER_NODE_TYPE, ssl_file
+from system_test import AMQP_CONNECTOR_TYPE, AMQP_LISTENER_TYPE
 from system_test import CA_CERT, BAD_CA_CERT, CA2_CERT, SSL_PROFILE_TYPE
 from system_test import CLIENT_CERTIFICATE, CLIENT_PRIVATE_KEY, CLIENT_PRIVATE_KEY_PASSWORD
 from system_test import SERVER_CERTIFICATE, SERVER_PRIVATE_KEY, SERVER_PRIVATE_KEY_PASSWORD
@@ -613,6 +614,37 @@ class RouterTestSslInterRouter(RouterTestSslBase):
         self.bad_router.wait_log_message(f"Connection to 0.0.0.0:{self.PORT_TLS_ALL} failed")
         self.router_a.wait_log_message("Connection from .* failed: amqp:connection:policy-error Client connection unencrypted")
 
+    def test_tls_handshake_stats(self):
+        """
+        Every TLS handshake on the inter-router connections is accounted for
+        on both the connector and the listener, either as full or resumed
+        """
+        if self.DISABLE_SSL_TESTING:
+            self.skipTest(self.DISABLE_REASON)
+
+        if not SASL.extended():
+            self.skipTest("Cyrus library not available. skipping test")
+
+        self.router_unrestricted.wait_router_connected("QDR.A")
+
+        def _handshakes(router, entity_type, port=None):
+            records = router.management.query(type=entity_type,
+                                              attribute_names=['port',
+                                                               'tlsHandshakesFull',
+                                                               'tlsHandshakesResumed',
+                                                               'tlsHandshakeHistogram']).get_dicts()
+            records = [r for r in records if port is None or r['port'] == str(port)]
+            self.assertEqual(1, len(records), f"unexpected records {records}")
+            record = records[0]
+            total = record['tlsHandshakesFull'] + record['tlsHandshakesResumed']
+            self.assertEqual(total, sum(record['tlsHandshakeHistogram']), f"histogram mismatch {record}")
+            return total
+
+        self.assertTrue(retry(lambda: _handshakes(self.router_unrestricted, AMQP_CONNECTOR_TYPE)
+                              >= self.inter_router_conn_count))
+        self.assertGreaterEqual(_handshakes(self.router_a, AMQP_LISTENER_TYPE, self.PORT_TLS_ALL),
+                                self.inter_router_conn_count)
+
 
 class RouterTestSslInterRouterWithInvalidCertPaths(RouterTestSslBase):
     """
@@ -28,10 +28,12 @@ import traceback
 from subprocess import PIPE
 from subprocess import STDOUT
 from typing import List, Optional, Mapping, Tuple
+from urllib.request import urlopen
 
 from proton import Message
 from proton.handlers import MessagingHandler
 from proton.reactor import Container
+from proton.utils import BlockingConnection
 
 from skupper_router.management.error import ForbiddenStatus
 
@@ -1622,6 +1624,186 @@ class TcpAdaptorManagementTest(TestCase):
                 retry(_retry_until_fail, delay=0.25)
 
 
+    @unittest.skipIf(DISABLE_SELECTOR_TESTS, DISABLE_SELECTOR_REASON)
+    def test_03_mgmt_link_capacity(self):
+        """
+        Verify that the configured linkCapacity is applied to the connector's
+        out-link and that adaptiveLinkCapacity backs it off when connecting to
+        the server fails.
+        """
+        mgmt = self.e_router.management
+        van_address = self.test_name + "/test_03_mgmt_link_capacity"
+        connector_name = "AdaptiveConnector"
+        listener_name = "AdaptiveListener"
+
+        # no server is listening on tcp_server_port: every connect will fail
+        mgmt.create(type=TCP_LISTENER_TYPE,
+                    name=listener_name,
+                    attributes={'address': van_address,
+                                'port': self.tcp_listener_port,
+                                'host': '127.0.0.1'})
+        mgmt.create(type=TCP_CONNECTOR_TYPE,
+                    name=connector_name,
+                    attributes={'address': van_address,
+                                'port': self.tcp_server_port,
+                                'host': '127.0.0.1',
+                                'linkCapacity': 4,
+                                'adaptiveLinkCapacity': True})
+        self.assertEqual(4, mgmt.read(type=TCP_CONNECTOR_TYPE, name=connector_name)['currentLinkCapacity'])
+
+        def _out_link_capacity():
+            for link in self.e_router.management.query(type=ROUTER_LINK_TYPE).get_dicts():
+                if link['linkDir'] == 'out' and link['owningAddr'] and link['owningAddr'].endswith(van_address):
+                    return link['capacity']
+            return None
+        self.assertTrue(retry(lambda: _out_link_capacity() == 4))
+
+        # each failed connect to the server halves the capacity
+        def _fail_one_connect():
+            try:
+                client_conn = socket.create_connection(('127.0.0.1', self.tcp_listener_port), timeout=5)
+                client_conn.sendall(b'hello')
+                client_conn.recv(10)
+                client_conn.close()
+            except OSError:
+                pass
+            return mgmt.read(type=TCP_CONNECTOR_TYPE, name=connector_name)['currentLinkCapacity'] == 1
+        self.assertTrue(retry(_fail_one_connect, delay=0.25))
+        self.assertTrue(retry(lambda: _out_link_capacity() == 1))
+
+        mgmt.delete(type=TCP_CONNECTOR_TYPE, name=connector_name)
+        mgmt.delete(type=TCP_LISTENER_TYPE, name=listener_name)
+        self.i_router.wait_address_unsubscribed(van_address)
+
+    @unittest.skipIf(DISABLE_SELECTOR_TESTS, DISABLE_SELECTOR_REASON)
+    def test_04_mgmt_accept_limits(self):
+        """
+        Verify that a tcpListener with an acceptRate queues the setup of a burst
+        of client connections and that maxPendingSetup refuses the connections
+        beyond it.
+        """
+        mgmt = self.e_router.management
+        van_address = self.test_name + "/test_04_mgmt_accept_limits"
+        connector_name = "AcceptLimitConnector"
+        listener_name = "AcceptLimitListener"
+
+        # one connection setup per second with at most two pending
+        mgmt.create(type=TCP_LISTENER_TYPE,
+                    name=listener_name,
+                    attributes={'address': van_address,
+                                'port': self.tcp_listener_port,
+                                'host': '127.0.0.1',
+                                'acceptRate': 1,
+                                'maxPendingSetup': 2})
+        mgmt.create(type=TCP_CONNECTOR_TYPE,
+                    name=connector_name,
+                    attributes={'address': van_address,
+                                'port': self.tcp_server_port,
+                                'host': '127.0.0.1'})
+        self.assertTrue(retry(lambda: mgmt.read(type=TCP_LISTENER_TYPE, name=listener_name)['operStatus'] == 'up'))
+
+        clients = [socket.create_connection(('127.0.0.1', self.tcp_listener_port), timeout=TIMEOUT)
+                   for _ in range(5)]
+
+        def _counters():
+            listener = mgmt.read(type=TCP_LISTENER_TYPE, name=listener_name)
+            return listener['connectionsQueued'], listener['connectionsRejected']
+        self.assertTrue(retry(lambda: _counters()[0] >= 1 and _counters()[1] >= 1), "counters: %s" % (_counters(),))
+
+        for client in clients:
+            client.close()
+
+        mgmt.delete(type=TCP_CONNECTOR_TYPE, name=connector_name)
+        mgmt.delete(type=TCP_LISTENER_TYPE, name=listener_name)
+        self.i_router.wait_address_unsubscribed(van_address)
+
+    @unittest.skipIf(DISABLE_SELECTOR_TESTS, DISABLE_SELECTOR_REASON)
+    def test_05_mgmt_address_watch_notifications(self):
+        """
+        A tcpListener watches its address.  Verify that the watch notifications
+        are counted in the router metrics, and that a burst of changes to the
+        address is folded into a pending notification.
+        """
+        mgmt = self.e_router.management
+        van_address = self.test_name + "/test_05_mgmt_address_watch_notifications"
+        listener_name = "AddressWatchListener"
+
+        def _notifications():
+            metrics = mgmt.query(type=ROUTER_METRICS_TYPE).get_dicts()[0]
+            return metrics['addressWatchNotifications'], metrics['addressWatchNotificationsCoalesced']
+
+        before, coalesced_before = _notifications()
+        mgmt.create(type=TCP_LISTENER_TYPE,
+                    name=listener_name,
+                    attributes={'address': van_address,
+                                'port': self.tcp_listener_port,
+                                'host': '127.0.0.1'})
+        # the watch delivers an initial snapshot of the address
+        self.assertTrue(retry(lambda: _notifications()[0] > before))
+
+        # Flap the address: closing the connection detaches all of its
+        # receivers in one core action, so only the first change posts a
+        # notification and the rest are coalesced into it.
+        conn = BlockingConnection("127.0.0.1:%d" % self.edge_mgmt_port, timeout=TIMEOUT)
+        for _ in range(10):
+            conn.create_receiver(van_address)
+        conn.close()
+        self.assertTrue(retry(lambda: _notifications()[1] > coalesced_before),
+                        "notifications: %s" % (_notifications(),))
+
+        mgmt.delete(type=TCP_LISTENER_TYPE, name=listener_name)
+
+    @unittest.skipIf(DISABLE_SELECTOR_TESTS, DISABLE_SELECTOR_REASON)
+    def test_06_mgmt_warm_pool(self):
+        """
+        Verify that a tcpConnector with a warm pool connects to the server
+        ahead of demand, hands a client flow an already open connection and
+        replaces it.
+        """
+        mgmt = self.e_router.management
+        van_address = self.test_name + "/test_06_mgmt_warm_pool"
+        connector_name = "WarmPoolConnector"
+        listener_name = "WarmPoolListener"
+
+        logger = Logger(title="WarmPoolEchoServer")
+        echo_server = TcpEchoServer(prefix="WarmPoolEchoServer", port=0, logger=logger)
+        assert echo_server.is_running
+
+        mgmt.create(type=TCP_LISTENER_TYPE,
+                    name=listener_name,
+                    attributes={'address': van_address,
+                                'port': self.tcp_listener_port,
+                                'host': '127.0.0.1'})
+        mgmt.create(type=TCP_CONNECTOR_TYPE,
+                    name=connector_name,
+                    attributes={'address': van_address,
+                                'port': echo_server.port,
+                                'host': '127.0.0.1',
+                                'warmPoolMinIdle': 2,
+                                'warmPoolMaxIdle': 4})
+
+        def _connector():
+            return mgmt.read(type=TCP_CONNECTOR_TYPE, name=connector_name)
+        self.assertTrue(retry(lambda: _connector()['warmPoolIdle'] == 2), "connector: %s" % _connector())
+        self.assertTrue(retry(lambda: mgmt.read(type=TCP_LISTENER_TYPE, name=listener_name)['operStatus'] == 'up'))
+
+        client_conn = socket.create_connection(('127.0.0.1', self.tcp_listener_port), timeout=TIMEOUT)
+        client_conn.sendall(b'warm')
+        self.assertEqual(b'warm', client_conn.recv(4))
+        client_conn.close()
+
+        connector = _connector()
+        self.assertGreaterEqual(connector['warmPoolHits'], 1)
+        self.assertEqual(0, connector['warmPoolMisses'])
+        # the connection taken from the pool is replaced
+        self.assertTrue(retry(lambda: _connector()['warmPoolIdle'] == 2), "connector: %s" % _connector())
+
+        mgmt.delete(type=TCP_CONNECTOR_TYPE, name=connector_name)
+        mgmt.delete(type=TCP_LISTENER_TYPE, name=listener_name)
+        self.i_router.wait_address_unsubscribed(van_address)
+        echo_server.wait()
+
+
 class TcpAdaptorManagementLiteTest(TcpAdaptorManagementTest):
     """
     Test Creation and deletion of TCP management entities
@@ -1967,6 +2149,75 @@ class TcpDeleteConnectionTest(TestCase):
         client_conn.close()
 
 
+class TcpAdaptorReadGrantTest(TestCase):
+    """
+    Verify that the read buffers granted to the TCP adaptor's connections ramp
+    up during a burst of data and shrink again once the connections go quiet.
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(TcpAdaptorReadGrantTest, cls).setUpClass()
+        cls.listener_port = cls.tester.get_port()
+        cls.metrics_port = cls.tester.get_port()
+        cls.server_logger = Logger(title="TcpAdaptorReadGrantTest")
+        cls.echo_server = TcpEchoServer(prefix="ECHO_SERVER_ReadGrant",
+                                        port=0,
+                                        logger=cls.server_logger)
+        assert cls.echo_server.is_running
+
+        config = [
+            ('router', {'mode': 'interior', 'id': 'ReadGrant'}),
+            ('listener', {'role': 'normal', 'port': cls.tester.get_port()}),
+            ('listener', {'port': cls.metrics_port, 'http': 'yes'}),
+            ('tcpListener', {'name': 'grant-listener',
+                             'host': 'localhost',
+                             'port': cls.listener_port,
+                             'address': 'ReadGrant'}),
+            ('tcpConnector', {'name': 'grant-connector',
+                              'host': 'localhost',
+                              'port': cls.echo_server.port,
+                              'address': 'ReadGrant'}),
+        ]
+        cls.router = cls.tester.qdrouterd('ReadGrant', Qdrouterd.Config(config), wait=True)
+        wait_tcp_listeners_up(cls.router.addresses[0])
+
+    def _granted_read_buffers(self):
+        metrics = urlopen("http://localhost:%d/metrics" % self.metrics_port, timeout=TIMEOUT).read().decode('utf-8')
+        for line in metrics.splitlines():
+            if line.startswith('qdr_granted_read_buffers '):
+                return int(line.split()[1])
+        self.fail("qdr_granted_read_buffers is missing from the metrics: %s" % metrics)
+
+    def _echo(self, client, data):
+        client.sendall(data)
+        received = b''
+        while len(received) < len(data):
+            chunk = client.recv(len(data) - len(received))
+            self.assertNotEqual(b'', chunk, "the router closed the connection")
+            received += chunk
+        self.assertEqual(data, received)
+
+    def test_01_grant_shrinks_when_idle(self):
+        client = socket.create_connection(('127.0.0.1', self.listener_port), timeout=TIMEOUT)
+        try:
+            # a burst ramps up the grants of the listener and connector side connections
+            for _ in range(32):
+                self._echo(client, b'B' * 65536)
+            burst = self._granted_read_buffers()
+
+            # once quiet, the grant limits decay and small reads release the buffers held since the burst
+            time.sleep(1.0)
+
+            def _shrunk():
+                self._echo(client, b'x')
+                return self._granted_read_buffers() <= 4
+            self.assertTrue(retry(_shrunk, delay=0.05),
+                            "granted read buffers: burst=%d now=%d" % (burst, self._granted_read_buffers()))
+            self.assertLess(self._granted_read_buffers(), burst)
+        finally:
+            client.close()
+
+
 class TcpAdaptorConnCounter(TestCase):
     """
     Validate the TCP service connection counter
@@ -19,13 +19,19 @@
 
 #
 import os
+import socket
+import ssl
+import struct
+import threading
+from urllib.request import urlopen
+
 import system_test
-from system_test import unittest, TestCase, Qdrouterd, NcatException, Logger, Process, run_curl, get_digest, \
+from system_test import unittest, TestCase, Qdrouterd, NcatException, Logger, Process, run_curl, get_digest, TIMEOUT, \
     CA_CERT, CLIENT_CERTIFICATE, CLIENT_PRIVATE_KEY, CLIENT_PRIVATE_KEY_PASSWORD, \
     SERVER_CERTIFICATE, SERVER_PRIVATE_KEY, SERVER_PRIVATE_KEY_PASSWORD, SERVER_PRIVATE_KEY_NO_PASS, BAD_CA_CERT, \
     CHAINED_CERT, curl_available, nginx_available, CA2_CERT, CLIENT2_CERTIFICATE, CLIENT2_PRIVATE_KEY, \
     CLIENT2_PRIVATE_KEY_PASSWORD, SERVER2_CERTIFICATE, SERVER2_PRIVATE_KEY, SERVER2_PRIVATE_KEY_PASSWORD, \
-    SSL_PROFILE_TYPE, is_pattern_present
+    SSL_PROFILE_TYPE, TCP_LISTENER_TYPE, is_pattern_present, retry, retry_assertion
 from system_tests_ssl import RouterTestSslBase
 from system_tests_tcp_adaptor import TcpAdaptorBase, CommonTcpTests, ncat_available
 from http1_tests import wait_tcp_listeners_up
@@ -1212,3 +1218,205 @@ class TcpAdaptorSslProfileDeleteTests(TestCase):
         except Exception:
             echo_client.logger.dump()
             raise
+
+
+class TcpTlsHandshakeOffloadTest(TestCase):
+    """
+    Run tcpListener TLS handshakes on the handshake worker pool (tlsHandshakeThreads) and verify traffic passes and the
+    offloads are reported in the /metrics output.
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(TcpTlsHandshakeOffloadTest, cls).setUpClass()
+        cls.listener_port = cls.tester.get_port()
+        cls.http_port = cls.tester.get_port()
+        cls.server_logger = Logger(title="TcpTlsHandshakeOffloadTest",
+                                   print_to_console=False,
+                                   save_for_dump=False)
+        cls.echo_server = TcpEchoServer(prefix="ECHO_SERVER_TcpTlsHandshakeOffloadTest",
+                                        port=0,
+                                        logger=cls.server_logger)
+        assert cls.echo_server.is_running
+
+        config = [
+            ('router', {'mode': 'interior', 'id': 'INTA', 'tlsHandshakeThreads': 2}),
+            ('listener', {'role': 'normal', 'port': cls.tester.get_port()}),
+            ('listener', {'port': cls.http_port, 'http': True}),
+            ('sslProfile', {'name': 'tcp-listener-ssl-profile',
+                            'caCertFile': CA_CERT,
+                            'certFile': SERVER_CERTIFICATE,
+                            'privateKeyFile': SERVER_PRIVATE_KEY,
+                            'password': SERVER_PRIVATE_KEY_PASSWORD}),
+            ('tcpListener', {'name': "offload-listener",
+                             'host': "localhost",
+                             'port': cls.listener_port,
+                             'sslProfile': 'tcp-listener-ssl-profile',
+                             'address': 'ES_HANDSHAKE_OFFLOAD'}),
+            ('tcpConnector', {'name': "offload-connector",
+                              'host': "localhost",
+                              'port': cls.echo_server.port,
+                              'address': 'ES_HANDSHAKE_OFFLOAD'})
+        ]
+        cls.router = cls.tester.qdrouterd('TcpTlsHandshakeOffload', Qdrouterd.Config(config), wait=True)
+        wait_tcp_listeners_up(cls.router.addresses[0])
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.echo_server.wait()
+        super(TcpTlsHandshakeOffloadTest, cls).tearDownClass()
+
+    def _metrics(self):
+        resp = urlopen(f"http://localhost:{self.http_port}/metrics")
+        metrics = {}
+        for line in resp.read().decode('utf-8').splitlines():
+            if not line.startswith('#'):
+                name, value = line.split()
+                metrics[name] = int(value)
+        return metrics
+
+    def test_concurrent_handshakes(self):
+        self.router.wait_log_message("Running TLS handshakes on 2 worker threads")
+
+        client_count = 20
+        errors = []
+        ctxt = ssl.SSLContext(protocol=ssl.PROTOCOL_TLS_CLIENT)
+        ctxt.load_verify_locations(cafile=CA_CERT)
+
+        def _client(index):
+            try:
+                payload = b'handshake-offload-%d' % index
+                with socket.create_connection(("localhost", self.listener_port), timeout=TIMEOUT) as sock:
+                    with ctxt.wrap_socket(sock, server_hostname="localhost") as tls_sock:
+                        tls_sock.sendall(payload)
+                        echoed = b''
+                        while len(echoed) < len(payload):
+                            data = tls_sock.recv(len(payload) - len(echoed))
+                            if not data:
+                                break
+                            echoed += data
+                if echoed != payload:
+                    errors.append("client %d: expected %s got %s" % (index, payload, echoed))
+            except Exception as exc:
+                errors.append("client %d: %s" % (index, exc))
+
+        clients = [threading.Thread(target=_client, args=(i,)) for i in range(client_count)]
+        for client in clients:
+            client.start()
+        for client in clients:
+            client.join(timeout=TIMEOUT)
+        self.assertEqual([], errors)
+
+        metrics = self._metrics()
+        self.assertEqual(2, metrics['qdr_tls_handshake_threads'])
+        self.assertGreaterEqual(metrics['qdr_tls_handshake_offloads_total'], client_count)
+        self.assertIn('qdr_io_thread_0_busy_usec_total', metrics)
+
+    def test_abort_during_handshake(self):
+        """
+        Reset client connections right after the ClientHello so the raw connection sees its closed events while the
+        handshake step may still be owned by a worker thread. The I/O thread must not touch the TLS session until the
+        worker hands it back: run under ThreadSanitizer any access that races with the worker is reported.
+        """
+        self.router.wait_log_message("Running TLS handshakes on 2 worker threads")
+        before = self._metrics()['qdr_tls_handshake_offloads_total']
+
+        ctxt = ssl.SSLContext(protocol=ssl.PROTOCOL_TLS_CLIENT)
+        ctxt.load_verify_locations(cafile=CA_CERT)
+
+        client_count = 20
+        for _ in range(client_count):
+            # generate a ClientHello without a socket, then send it and reset the connection
+            outgoing = ssl.MemoryBIO()
+            tls_obj = ctxt.wrap_bio(ssl.MemoryBIO(), outgoing, server_hostname="localhost")
+            with self.assertRaises(ssl.SSLWantReadError):
+                tls_obj.do_handshake()
+            with socket.create_connection(("localhost", self.listener_port), timeout=TIMEOUT) as sock:
+                sock.sendall(outgoing.read())
+                sock.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack('ii', 1, 0))
+
+        # the aborted handshakes were offloaded and the router still completes new ones
+        retry_assertion(lambda: self.assertGreaterEqual(self._metrics()['qdr_tls_handshake_offloads_total'],
+                                                        before + client_count))
+        payload = b'after-abort'
+        with socket.create_connection(("localhost", self.listener_port), timeout=TIMEOUT) as sock:
+            with ctxt.wrap_socket(sock, server_hostname="localhost") as tls_sock:
+                tls_sock.sendall(payload)
+                echoed = b''
+                while len(echoed) < len(payload):
+                    data = tls_sock.recv(len(payload) - len(echoed))
+                    if not data:
+                        break
+                    echoed += data
+        self.assertEqual(payload, echoed)
+
+
+class TcpListenerPendingSetupTest(TestCase):
+    """
+    Verify that clients stalled in their TLS handshake with a tcpListener whose server is unreachable do not keep their
+    maxPendingSetup slots forever: new clients are admitted again once the stalled ones give up or time out.
+    """
+    @classmethod
+    def setUpClass(cls):
+        super(TcpListenerPendingSetupTest, cls).setUpClass()
+        cls.listener_port = cls.tester.get_port()
+        cls.unreachable_port = cls.tester.get_port()  # nothing listens here
+
+        config = [
+            ('router', {'mode': 'interior', 'id': 'INTA'}),
+            ('listener', {'role': 'normal', 'port': cls.tester.get_port()}),
+            ('sslProfile', {'name': 'tcp-listener-ssl-profile',
+                            'caCertFile': CA_CERT,
+                            'certFile': SERVER_CERTIFICATE,
+                            'privateKeyFile': SERVER_PRIVATE_KEY,
+                            'password': SERVER_PRIVATE_KEY_PASSWORD}),
+            ('tcpListener', {'name': "pending-setup-listener",
+                             'host': "localhost",
+                             'port': cls.listener_port,
+                             'sslProfile': 'tcp-listener-ssl-profile',
+                             'maxPendingSetup': 2,
+                             'address': 'ES_PENDING_SETUP'}),
+            ('tcpConnector', {'name': "pending-setup-connector",
+                              'host': "localhost",
+                              'port': cls.unreachable_port,
+                              'address': 'ES_PENDING_SETUP'})
+        ]
+        cls.router = cls.tester.qdrouterd('TcpListenerPendingSetup', Qdrouterd.Config(config), wait=True)
+        wait_tcp_listeners_up(cls.router.addresses[0])
+
+    def _listener(self):
+        return self.router.management.read(type=TCP_LISTENER_TYPE, name="pending-setup-listener")
+
+    def _stall(self, count):
+        # connect clients that never start their TLS handshake
+        opened = self._listener()['connectionsOpened']
+        clients = [socket.create_connection(("localhost", self.listener_port), timeout=TIMEOUT) for _ in range(count)]
+        self.assertTrue(retry(lambda: self._listener()['connectionsOpened'] == opened + count))
+        return clients
+
+    def _admitted(self):
+        # True if a new client is accepted rather than refused by maxPendingSetup
+        listener = self._listener()
+        with socket.create_connection(("localhost", self.listener_port), timeout=TIMEOUT):
+            self.assertTrue(retry(lambda: self._listener()['connectionsOpened'] > listener['connectionsOpened']
+                                  or self._listener()['connectionsRejected'] > listener['connectionsRejected']))
+        return self._listener()['connectionsOpened'] > listener['connectionsOpened']
+
+    def test_01_stalled_clients_give_up(self):
+        clients = self._stall(2)
+        self.assertEqual(2, self._listener()['connectionsPendingSetup'])
+        self.assertFalse(self._admitted())
+
+        for client in clients:
+            client.close()
+        self.assertTrue(retry(lambda: self._listener()['connectionsPendingSetup'] == 0))
+        self.assertTrue(self._admitted())
+
+    def test_02_stalled_clients_time_out(self):
+        self.assertTrue(retry(lambda: self._listener()['connectionsPendingSetup'] == 0))
+        clients = self._stall(2)
+        self.assertFalse(self._admitted())
+
+        # the stalled clients stay connected but stop counting after the setup timeout
+        self.assertTrue(retry(self._admitted, delay=1))
+        for client in clients:
+            client.close()
@@ -139,6 +139,44 @@ class TwoRouterTest(TestCase):
         test.run()
         self.assertIsNone(test.error)
 
+    def test_05_core_action_metrics(self):
+        """
+        The route table updates from the routing protocol run as control
+        actions, everything else as data actions. Both are counted. The wait
+        of every control action is measured, data action waits are sampled.
+        The starvation bound and the ordering behind connection and link
+        lifecycle actions are covered by the cpp_system core action tests.
+
+        A new subscriber on the far router advances its mobile sequence, which
+        reaches this router as control actions. They must both be counted and
+        make the address routable.
+        """
+        def query_metrics():
+            local_node = Node.connect(self.routers[0].addresses[0], timeout=TIMEOUT)
+            try:
+                return local_node.query(type=ROUTER_METRICS_TYPE).get_dicts()[0]
+            finally:
+                local_node.close()
+
+        before = query_metrics()
+        self.assertGreater(before['controlActions'], 0)
+
+        receiver = AsyncTestReceiver(self.routers[1].addresses[0], "core/action/metrics")
+        try:
+            self.routers[0].wait_address("core/action/metrics", remotes=1)
+        finally:
+            receiver.stop()
+
+        metrics = query_metrics()
+        self.assertGreater(metrics['controlActions'], before['controlActions'])
+        self.assertGreater(metrics['dataActions'], 0)
+        self.assertGreaterEqual(metrics['controlActionQueueDepth'], 0)
+        self.assertGreaterEqual(metrics['dataActionQueueDepth'], 0)
+        self.assertGreaterEqual(metrics['controlActionWaitUsec'], metrics['controlActionMaxWaitUsec'])
+        self.assertGreaterEqual(metrics['dataActionWaitUsec'], metrics['dataActionMaxWaitUsec'])
+        self.assertGreater(metrics['dataActionWaitSamples'], 0)
+        self.assertLessEqual(metrics['dataActionWaitSamples'], metrics['dataActions'])
+
     def test_06_semantics_closest_is_local(self):
         test = SemanticsClosestIsLocal(self.routers[0].addresses[0], self.routers[1].addresses[0])
         test.run()
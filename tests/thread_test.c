@@ -261,6 +261,79 @@ char *test_threading_mode(void *context)
     return 0;
 }
 
+#ifdef QD_LOCK_PROFILING
+// run by test_lock_profiling
+//
+static void *_lock_profile_thread(void *arg)
+{
+    sys_mutex_lock(&mutex);
+    *(int *) arg = 1;
+    sys_mutex_unlock(&mutex);
+    return 0;
+}
+#endif
+
+
+static char *test_lock_profiling(void *context)
+{
+#ifdef QD_LOCK_PROFILING
+    if (!sys_lock_profiling_enabled())
+        return 0;  // requires SKUPPER_ROUTER_LOCK_PROFILING in the environment
+
+    sys_mutex_init_named(&mutex, "thread_test.mutex");
+
+    sys_lock_class_t *lock_class = mutex.lock_class;
+    if (!lock_class)
+        return "mutex not assigned a lock class";
+    if (strcmp(sys_lock_class_name(lock_class), "thread_test.mutex") != 0)
+        return "lock class not given the mutex name";
+
+    bool found = false;
+    for (sys_lock_class_t *lc = sys_lock_class_first(); lc; lc = sys_lock_class_next(lc)) {
+        found = found || lc == lock_class;
+    }
+    if (!found)
+        return "lock class not registered";
+
+    sys_lock_stats_t before;
+    sys_lock_class_stats(lock_class, &before);
+
+    // hold the mutex while the thread tries to take it
+    int done = 0;
+    sys_mutex_lock(&mutex);
+    sys_thread_t *thread = sys_thread(SYS_THREAD_PROACTOR, _lock_profile_thread, &done);
+    usleep(10000);
+    sys_mutex_unlock(&mutex);
+    sys_thread_join(thread);
+    sys_thread_free(thread);
+
+    sys_lock_stats_t after;
+    sys_lock_class_stats(lock_class, &after);
+    sys_mutex_free(&mutex);
+
+    if (!done)
+        return "thread did not run";
+    if (after.acquired - before.acquired != 2)
+        return "expected two acquisitions";
+    if (after.contended - before.contended != 1)
+        return "expected one contended acquisition";
+    if (after.hold_nsec - before.hold_nsec < 10000000)
+        return "hold time not accounted";
+    uint64_t waits = 0;
+    for (int i = 0; i < SYS_LOCK_HISTOGRAM_BUCKETS; ++i) {
+        waits += after.wait_histogram[i] - before.wait_histogram[i];
+    }
+    if (waits != 1 || after.wait_nsec == before.wait_nsec)
+        return "wait time not accounted";
+#else
+    if (sys_lock_profiling_enabled() || sys_lock_class_first())
+        return "lock profiling active without QD_LOCK_PROFILING";
+#endif
+
+    return 0;
+}
+
+
 int thread_tests(void)
 {
     int result = 0;
@@ -270,6 +343,7 @@ int thread_tests(void)
     TEST_CASE(test_condition, 0);
     TEST_CASE(test_threading_roles_names, 0);
     TEST_CASE(test_threading_mode, 0);
+    TEST_CASE(test_lock_profiling, 0);
 
     return result;
 }